@@ -38,6 +38,7 @@
 #ifndef _ARUPDATER_DOWNLOADER_H_
 #define _ARUPDATER_DOWNLOADER_H_
 
+#include <stdint.h>
 #include <libARUpdater/ARUPDATER_Manager.h>
 #include <libARSAL/ARSAL_MD5_Manager.h>
 #include <libARDiscovery/ARDISCOVERY_Discovery.h>
@@ -54,13 +55,31 @@ typedef struct ARUPDATER_DownloadInformation_t
     char *downloadUrl;
     char *md5Expected;
     char *plfVersion;
-    int remoteSize;
+    int64_t remoteSize;
     eARDISCOVERY_PRODUCT product;
+    char *hashAlgorithm; /**< name of the hash advertised by the server ("sha256", "sha256tree"...), NULL if none */
+    char *hashExpected; /**< hexadecimal digest of hashAlgorithm, NULL if none */
+    char *manifestUrl; /**< url of the chunk manifest of the plf, NULL if none */
     
 }ARUPDATER_DownloadInformation_t;
 
 typedef struct ARUPDATER_Downloader_t ARUPDATER_Downloader_t;
 
+/**
+ * @brief Occupancy of the buffers between the network and the storage during a plf download
+ * @see ARUPDATER_Downloader_GetPipelineStats ()
+ */
+typedef struct
+{
+    int bufferCount; /**< number of buffers, 0 if the network thread writes the file itself */
+    int64_t bufferSize; /**< size of each buffer in bytes */
+    int occupancy; /**< number of buffers received and not written yet */
+    int maxOccupancy; /**< highest occupancy of the download */
+    float averageOccupancy; /**< occupancy averaged each time a buffer is received */
+    int64_t networkWaitCount; /**< number of times the network waited for a free buffer, the storage is the bottleneck */
+    int64_t writerWaitCount; /**< number of times the storage waited for a received buffer, the network is the bottleneck */
+} ARUPDATER_Downloader_PipelineStats_t;
+
 /**
  * @brief Whether the plf file should be updated or not
  * @param arg The pointer of the user custom argument
@@ -85,6 +104,15 @@ typedef void (*ARUPDATER_Downloader_WillDownloadPlfCallback_t) (void* arg, eARDI
  */
 typedef void (*ARUPDATER_Downloader_PlfDownloadProgressCallback_t) (void* arg, float percent);
 
+/**
+ * @brief Progress callback of the plf download in bytes
+ * @param arg The pointer of the user custom argument
+ * @param downloadedSize The number of bytes of the plf file already downloaded
+ * @param totalSize The size of the plf file in bytes, 0 if unknown
+ * @see ARUPDATER_Downloader_SetPlfDownloadProgressBytesCallback ()
+ */
+typedef void (*ARUPDATER_Downloader_PlfDownloadProgressBytesCallback_t) (void* arg, int64_t downloadedSize, int64_t totalSize);
+
 /**
  * @brief Completion callback of the Media download
  * @param arg The pointer of the user custom argument
@@ -135,6 +163,52 @@ eARUPDATER_ERROR ARUPDATER_Downloader_Delete(ARUPDATER_Manager_t *manager);
 eARUPDATER_ERROR ARUPDATER_Downloader_SetUpdatesProductList(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT *productList, int productCount);
 
 
+/**
+ * @brief Set a callback which tells the progress of the download in bytes
+ * @details This callback is called in addition to the percent progress callback given to ARUPDATER_Downloader_New()
+ * @param manager : pointer on the manager
+ * @param[in] progressBytesCallback : callback which tells the progress of the download in bytes. Can be null to remove it
+ * @param[in|out] progressBytesArg : arg given to the progressBytesCallback
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfDownloadProgressBytesCallback(ARUPDATER_Manager_t *manager, ARUPDATER_Downloader_PlfDownloadProgressBytesCallback_t progressBytesCallback, void *progressBytesArg);
+
+/**
+ * @brief Set the folder of a store shared by all products and managers, where the plf files are kept by md5
+ * @details The product folders are hardlinked (or cloned) from the store, and a plf already in the store is not downloaded again
+ * @param manager : pointer on the manager
+ * @param[in] storeFolder : folder of the store, it should be on the same filesystem than the root folder. Can be null to disable the store
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfStoreFolder(ARUPDATER_Manager_t *manager, const char *const storeFolder);
+
+/**
+ * @brief Set how many previous plf files are kept when a new one is installed
+ * @details The previous plf files are moved into a versions folder of the product folder, they can be selected again with ARUPDATER_Manager_SelectRetainedPlfVersion(). By default no previous plf is kept
+ * @param manager : pointer on the manager
+ * @param[in] maxVersions : the number of previous versions to keep for each product, 0 to keep none
+ * @param[in] maxBytes : the maximum size in bytes of the previous versions of a product, 0 for no limit
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfRetention(ARUPDATER_Manager_t *manager, int maxVersions, int64_t maxBytes);
+
+/**
+ * @brief Set the memory of the buffers between the network and the storage
+ * @details The data received is queued into buffers written and checked by another thread, so that a slow storage does not stall the network. The network waits when all the buffers are full. By default 8 MB are used
+ * @param manager : pointer on the manager
+ * @param[in] maxMemory : the memory of all the buffers in bytes, at least 32 kB, 0 to write the file from the network thread
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_BAD_PARAMETER if maxMemory is too small, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPipelineMemory(ARUPDATER_Manager_t *manager, int64_t maxMemory);
+
+/**
+ * @brief Get the occupancy of the buffers of the running plf download, or of the last one
+ * @param manager : pointer on the manager
+ * @param[out] stats : the occupancy of the buffers, zeroed if no plf has been downloaded
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Downloader_GetPipelineStats(ARUPDATER_Manager_t *manager, ARUPDATER_Downloader_PipelineStats_t *stats);
+
 /**
  * @brief Check if updates are available asynchrounously
  * @post call ARUPDATER_Downloader_ShouldDownloadPlfCallback_t at the end of the execution
@@ -58,6 +58,10 @@ typedef enum
     
     ARUPDATER_ERROR_PLF = -3000,                        /**< Generic PLF error */
     ARUPDATER_ERROR_PLF_FILE_NOT_FOUND,                 /**< Plf File not found */
+    ARUPDATER_ERROR_PLF_BAD_HEADER,                     /**< The header of the file is not a valid plf header */
+    ARUPDATER_ERROR_PLF_BAD_SECTION,                    /**< A section of the plf file goes past the end of the file */
+    ARUPDATER_ERROR_PLF_BAD_CRC,                        /**< The CRC32 of a section of the plf file does not match */
+    ARUPDATER_ERROR_PLF_BAD_PACK,                       /**< The index of the plf pack file is not valid */
     
     ARUPDATER_ERROR_DOWNLOADER = -4000,                    /**< Generic Updater error */
     ARUPDATER_ERROR_DOWNLOADER_ARUTILS_ERROR,              /**< error on a ARUtils operation */
@@ -68,11 +72,16 @@ typedef enum
     ARUPDATER_ERROR_DOWNLOADER_RENAME_FILE,                /**< error when renaming files */
     ARUPDATER_ERROR_DOWNLOADER_FILE_NOT_FOUND,             /**< Plf file not found in the downloader */
     ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH,             /**< MD5 checksum does not match with the remote file */
+    ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE,           /**< Not enough free space on the disk to store the plf files */
     
     ARUPDATER_ERROR_UPLOADER = -5000,                   /**< Generic Uploader error */
     ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR,             /**< error on a ARUtils operation in uploader*/
     ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR,      /**< error on a ARDataTransfer operation in uploader*/
     ARUPDATER_ERROR_UPLOADER_ARSAL_ERROR,               /**< error on a ARSAL operation in uploader*/
+    ARUPDATER_ERROR_UPLOADER_TRANSFER,                  /**< error on a ftp transfer made by the library itself (fan-out, ftp client) */
+    ARUPDATER_ERROR_UPLOADER_CANCELED,                  /**< a ftp transfer made by the library itself has been canceled */
+    ARUPDATER_ERROR_UPLOADER_ALREADY_UP_TO_DATE,        /**< the device already runs the version of the plf, nothing has been uploaded */
+    ARUPDATER_ERROR_UPLOADER_VERIFICATION_FAILED,       /**< the plf sent does not match the plf on the device, it has not been renamed */
     
 } eARUPDATER_ERROR;
 
@@ -0,0 +1,169 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_FanOut.h
+ * @brief libARUpdater FanOut header file. Upload of one plf to several products at once.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FANOUT_H_
+#define _ARUPDATER_FANOUT_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Manager.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+
+/**
+ * @brief Maximum number of targets uploaded at once
+ */
+#define ARUPDATER_FANOUT_MAX_CONCURRENT_UPLOADS     32
+
+typedef struct ARUPDATER_FanOut_t ARUPDATER_FanOut_t;
+
+/**
+ * @brief State of the upload to a target
+ */
+typedef enum
+{
+    ARUPDATER_FANOUT_TARGET_STATE_WAITING = 0,  /**< waiting for a free upload slot */
+    ARUPDATER_FANOUT_TARGET_STATE_UPLOADING,    /**< the plf is being uploaded */
+    ARUPDATER_FANOUT_TARGET_STATE_DONE,         /**< the plf has been uploaded and renamed */
+    ARUPDATER_FANOUT_TARGET_STATE_FAILED,       /**< the upload failed, see the error of the target */
+    ARUPDATER_FANOUT_TARGET_STATE_CANCELED,     /**< the upload has been canceled */
+    ARUPDATER_FANOUT_TARGET_STATE_MAX,
+} eARUPDATER_FANOUT_TARGET_STATE;
+
+/**
+ * @brief Status of the upload to a target
+ * @see ARUPDATER_FanOut_GetTargetStatus ()
+ */
+typedef struct
+{
+    eARUPDATER_FANOUT_TARGET_STATE state;
+    int isResumed;          /**< 1 if the upload resumed a partial plf of the target */
+    int64_t sentSize;       /**< size of the plf on the target, the resumed part included */
+    int64_t totalSize;      /**< size of the plf */
+    eARUPDATER_ERROR error; /**< error of a failed upload */
+} ARUPDATER_FanOut_TargetStatus_t;
+
+/**
+ * @brief Progress callback of the upload to a target
+ * @param arg The pointer of the user custom argument
+ * @param target The index of the target, as returned by ARUPDATER_FanOut_AddTarget()
+ * @param percent The percent size of the plf file already uploaded to the target
+ */
+typedef void (*ARUPDATER_FanOut_ProgressCallback_t) (void* arg, int target, float percent);
+
+/**
+ * @brief Completion callback of the upload to a target
+ * @param arg The pointer of the user custom argument
+ * @param target The index of the target, as returned by ARUPDATER_FanOut_AddTarget()
+ * @param error The error status of the upload to the target
+ */
+typedef void (*ARUPDATER_FanOut_CompletionCallback_t) (void* arg, int target, eARUPDATER_ERROR error);
+
+/**
+ * @brief Create an object to upload the plf file of a product to several products at once
+ * @details The plf is read once, then streamed from memory to each target over its own ftp session
+ * @warning this function allocates memory
+ * @post ARUPDATER_FanOut_Delete should be called
+ * @param manager : pointer on the manager
+ * @param[in] rootFolder : root folder
+ * @param[in] product : product whose plf is uploaded
+ * @param[in] maxConcurrentUploads : maximum number of targets uploaded at once, up to ARUPDATER_FANOUT_MAX_CONCURRENT_UPLOADS
+ * @param[in] progressCallback : callback which tells the progress of the upload to a target
+ * @param[in|out] progressArg : arg given to the progressCallback
+ * @param[in] completionCallback : callback which tells when the upload to a target is completed
+ * @param[in|out] completionArg : arg given to the completionCallback
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_FanOut_Delete()
+ */
+eARUPDATER_ERROR ARUPDATER_FanOut_New(ARUPDATER_Manager_t* manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, int maxConcurrentUploads, ARUPDATER_FanOut_ProgressCallback_t progressCallback, void *progressArg, ARUPDATER_FanOut_CompletionCallback_t completionCallback, void *completionArg);
+
+/**
+ * @brief Delete the FanOut of the Manager
+ * @warning This function frees memory
+ * @param manager a pointer on the ARUpdater Manager
+ * @see ARUPDATER_FanOut_New ()
+ */
+eARUPDATER_ERROR ARUPDATER_FanOut_Delete(ARUPDATER_Manager_t *manager);
+
+/**
+ * @brief Add a product to upload the plf to
+ * @warning The targets can not be added while the upload is running
+ * @param manager : pointer on the manager
+ * @param[in] address : ip address of the ftp server of the product
+ * @param[in] port : port of the ftp server of the product
+ * @param[in] username : ftp user name, NULL for an anonymous login
+ * @param[in] password : ftp password, can be NULL
+ * @param[out] error : pointer on an error. This can be null
+ * @return the index of the target, -1 if an error occurred
+ */
+int ARUPDATER_FanOut_AddTarget(ARUPDATER_Manager_t *manager, const char *const address, int port, const char *const username, const char *const password, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Get the status of the upload to a target
+ * @details Can be called while the upload is running
+ * @param manager : pointer on the manager
+ * @param[in] target : index of the target
+ * @param[out] status : status of the upload to the target
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FanOut_GetTargetStatus(ARUPDATER_Manager_t *manager, int target, ARUPDATER_FanOut_TargetStatus_t *status);
+
+/**
+ * @brief Upload the plf to all the targets
+ * @details Each target is resumed or fails on its own, the other uploads go on
+ * @warning This function must be called in its own thread.
+ * @post ARUPDATER_FanOut_CancelThread() must be called after.
+ * @param managerArg : thread data of type ARUPDATER_Manager_t*
+ * @return ARUPDATER_OK if the plf has been uploaded to all the targets, the error of the first failed target otherwise
+ * @see ARUPDATER_FanOut_CancelThread()
+ */
+void* ARUPDATER_FanOut_ThreadRun(void *managerArg);
+
+/**
+ * @brief cancel the uploads
+ * @details Used to kill the thread calling ARUPDATER_FanOut_ThreadRun().
+ * @param manager : pointer on the manager
+ * @see ARUPDATER_FanOut_ThreadRun()
+ */
+eARUPDATER_ERROR ARUPDATER_FanOut_CancelThread(ARUPDATER_Manager_t *manager);
+
+/**
+ * @brief Get if the thread is still running
+ * @param manager : pointer on the manager
+ * @param[out] error : pointer on an error. This can be null
+ * @return 1 if the upload thread is running, 0 otherwise
+ */
+int ARUPDATER_FanOut_ThreadIsRunning(ARUPDATER_Manager_t* manager, eARUPDATER_ERROR *error);
+
+#endif
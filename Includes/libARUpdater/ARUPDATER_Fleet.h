@@ -0,0 +1,205 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Fleet.h
+ * @brief libARUpdater Fleet header file. Update of several connected products at once.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FLEET_H_
+#define _ARUPDATER_FLEET_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Manager.h>
+#include <libARUpdater/ARUPDATER_Downloader.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARSAL/ARSAL_MD5_Manager.h>
+#include <libARUtils/ARUTILS_Manager.h>
+
+/**
+ * @brief Maximum number of devices updated at once
+ */
+#define ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS      64
+
+/**
+ * @brief Fleet structure
+ * @see ARUPDATER_Fleet_New ()
+ */
+typedef struct ARUPDATER_Fleet_t ARUPDATER_Fleet_t;
+
+/**
+ * @brief State of the update of a device
+ */
+typedef enum
+{
+    ARUPDATER_FLEET_DEVICE_STATE_WAITING = 0,   /**< waiting for the download of the plf files or for a free upload slot */
+    ARUPDATER_FLEET_DEVICE_STATE_UPLOADING,     /**< the plf is being uploaded */
+    ARUPDATER_FLEET_DEVICE_STATE_DONE,          /**< the plf has been uploaded */
+    ARUPDATER_FLEET_DEVICE_STATE_FAILED,        /**< the upload failed, see the error of the device */
+    ARUPDATER_FLEET_DEVICE_STATE_CANCELED,      /**< the update has been canceled before the upload ended */
+    ARUPDATER_FLEET_DEVICE_STATE_MAX,
+} eARUPDATER_FLEET_DEVICE_STATE;
+
+/**
+ * @brief Status of the update of a device
+ * @see ARUPDATER_Fleet_GetDeviceStatus ()
+ */
+typedef struct
+{
+    eARDISCOVERY_PRODUCT product;
+    eARUPDATER_FLEET_DEVICE_STATE state;
+    float percent;              /**< percent of the plf uploaded */
+    int64_t uploadTimeUs;       /**< duration of the upload, 0 if it has not ended */
+    eARUPDATER_ERROR error;     /**< error of a failed upload */
+} ARUPDATER_Fleet_DeviceStatus_t;
+
+/**
+ * @brief Summary of the update of the fleet
+ * @see ARUPDATER_Fleet_GetSummary ()
+ */
+typedef struct
+{
+    int deviceCount;
+    int productCount;               /**< number of distinct products of the devices */
+    int stateCount[ARUPDATER_FLEET_DEVICE_STATE_MAX]; /**< number of devices in each state */
+    eARUPDATER_ERROR downloadError; /**< error of the update check and download shared by the devices */
+    int64_t downloadTimeUs;         /**< duration of the update check and download */
+    int64_t uploadTimeUs;           /**< duration of the uploads, from the first start to the last end */
+} ARUPDATER_Fleet_Summary_t;
+
+/**
+ * @brief Callback called on each change of the state of a device
+ * @param arg The pointer of the user custom argument
+ * @param device The index of the device, as returned by ARUPDATER_Fleet_AddDevice()
+ * @param state The new state of the device
+ * @param error The error of the update of the device
+ */
+typedef void (*ARUPDATER_Fleet_DeviceStateCallback_t) (void* arg, int device, eARUPDATER_FLEET_DEVICE_STATE state, eARUPDATER_ERROR error);
+
+/**
+ * @brief Create a new Fleet
+ * @warning This function allocates memory
+ * @param[in] rootFolder : root folder of the plf files
+ * @param[in] md5Manager : md5 manager
+ * @param[in] maxConcurrentUploads : maximum number of devices updated at once, up to ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS
+ * @param[in] stateCallback : callback called on each change of the state of a device, can be NULL
+ * @param[in|out] stateArg : arg given to the stateCallback
+ * @param[out] error A pointer on the error output. Can be null
+ * @return Pointer on the new Fleet
+ * @see ARUPDATER_Fleet_Delete ()
+ */
+ARUPDATER_Fleet_t* ARUPDATER_Fleet_New(const char *const rootFolder, ARSAL_MD5_Manager_t *md5Manager, int maxConcurrentUploads, ARUPDATER_Fleet_DeviceStateCallback_t stateCallback, void *stateArg, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Delete the Fleet
+ * @warning This function frees memory
+ * @param fleetPtrAddr address of the pointer on the Fleet
+ * @see ARUPDATER_Fleet_New ()
+ */
+void ARUPDATER_Fleet_Delete(ARUPDATER_Fleet_t **fleetPtrAddr);
+
+/**
+ * @brief Check the updates of the products of the fleet and download them before the uploads
+ * @details Without this call, the plf files already in the root folder are uploaded
+ * @param fleet : pointer on the fleet
+ * @param[in] appPlatform : platform of the application
+ * @param[in] appVersion : version of the application
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Fleet_SetUpdatesCheck(ARUPDATER_Fleet_t *fleet, eARUPDATER_Downloader_Platforms appPlatform, const char *const appVersion);
+
+/**
+ * @brief Set the storage of the plf files of the fleet
+ * @param fleet : pointer on the fleet
+ * @param[in] storage : storage of the plf files
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Manager_SetPlfStorage ()
+ */
+eARUPDATER_ERROR ARUPDATER_Fleet_SetPlfStorage(ARUPDATER_Fleet_t *fleet, eARUPDATER_Manager_PlfStorage storage);
+
+/**
+ * @brief Add a device to update
+ * @warning The devices can not be added while the update is running
+ * @param fleet : pointer on the fleet
+ * @param[in] ftpManager : ftp manager connected to the device
+ * @param[in] product : product of the device
+ * @param[out] error : pointer on an error. This can be null
+ * @return the index of the device, -1 if an error occurred
+ */
+int ARUPDATER_Fleet_AddDevice(ARUPDATER_Fleet_t *fleet, ARUTILS_Manager_t *ftpManager, eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Get the status of the update of a device
+ * @details Can be called while the update is running
+ * @param fleet : pointer on the fleet
+ * @param[in] device : index of the device
+ * @param[out] status : status of the update of the device
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Fleet_GetDeviceStatus(ARUPDATER_Fleet_t *fleet, int device, ARUPDATER_Fleet_DeviceStatus_t *status);
+
+/**
+ * @brief Get the summary of the update of the fleet
+ * @details Can be called while the update is running
+ * @param fleet : pointer on the fleet
+ * @param[out] summary : summary of the update
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Fleet_GetSummary(ARUPDATER_Fleet_t *fleet, ARUPDATER_Fleet_Summary_t *summary);
+
+/**
+ * @brief Update the fleet
+ * @details Checks and downloads the plf of each distinct product once, if enabled, then uploads them to the devices
+ * @warning This function must be called in its own thread.
+ * @post ARUPDATER_Fleet_CancelThread() must be called after.
+ * @param fleetArg : thread data of type ARUPDATER_Fleet_t*
+ * @return ARUPDATER_OK if all the devices have been updated, the error of the first failed device otherwise
+ * @see ARUPDATER_Fleet_CancelThread()
+ */
+void* ARUPDATER_Fleet_ThreadRun(void *fleetArg);
+
+/**
+ * @brief cancel the update of the fleet
+ * @details Used to kill the thread calling ARUPDATER_Fleet_ThreadRun().
+ * @param fleet : pointer on the fleet
+ * @see ARUPDATER_Fleet_ThreadRun()
+ */
+eARUPDATER_ERROR ARUPDATER_Fleet_CancelThread(ARUPDATER_Fleet_t *fleet);
+
+/**
+ * @brief Get if the thread is still running
+ * @param fleet : pointer on the fleet
+ * @param[out] error : pointer on an error. This can be null
+ * @return 1 if the update thread is running, 0 otherwise
+ */
+int ARUPDATER_Fleet_ThreadIsRunning(ARUPDATER_Fleet_t *fleet, eARUPDATER_ERROR *error);
+
+#endif
@@ -49,6 +49,29 @@
  */
 typedef struct ARUPDATER_Manager_t ARUPDATER_Manager_t;
 
+/**
+ * @brief Storage of the plf files of a manager
+ * @see ARUPDATER_Manager_SetPlfStorage ()
+ */
+typedef enum
+{
+    ARUPDATER_MANAGER_PLF_STORAGE_FOLDERS = 0,  /**< one folder per product in plfFolder/ (default) */
+    ARUPDATER_MANAGER_PLF_STORAGE_PACK,         /**< all the plf files in plfFolder/plf.pack, found through its index without listing any folder */
+    ARUPDATER_MANAGER_PLF_STORAGE_MAX,
+} eARUPDATER_Manager_PlfStorage;
+
+/**
+ * @brief Version of a plf file
+ * @see ARUPDATER_Manager_GetPlfVersions ()
+ */
+typedef struct
+{
+    int version;
+    int edition;
+    int extension;
+    int isRetained;     /**< 1 for a previous version kept by the downloader, which can be selected by ARUPDATER_Manager_SelectRetainedPlfVersion () */
+} ARUPDATER_Manager_PlfVersion_t;
+
 /**
  * @brief Create a new ARUpdater Manager
  * @warning This function allocates memory
@@ -82,7 +105,8 @@ void ARUPDATER_Manager_Delete (ARUPDATER_Manager_t **managerPtrAddr);
 int ARUPDATER_Manager_PlfVersionIsUpToDate(ARUPDATER_Manager_t *manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, int version, int edition, int extension, const char *localVersionBuffer, int bufferSize, eARUPDATER_ERROR *error);
 
 /**
- * @brief get if a given plf file is black listed
+ * @brief get if a given plf file is in the black list compiled in the library
+ * @see ARUPDATER_Manager_IsBlacklisted() to also check the versions blacklisted at runtime
  * @param[in] product : the plf of the product to be tested
  * @param[in] version : the version of the remote plf
  * @param[in] edition : the edition of the remote plf
@@ -91,6 +115,75 @@ int ARUPDATER_Manager_PlfVersionIsUpToDate(ARUPDATER_Manager_t *manager, const c
  */
 int ARUPDATER_Manager_PlfVersionIsBlacklisted(eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
 
+/**
+ * @brief get if a given plf file is black listed in the manager
+ * @details The black list of the manager holds the versions compiled in the library, the ones loaded from a file and the ones given by the update server
+ * @param manager : pointer on the manager
+ * @param[in] product : the plf of the product to be tested
+ * @param[in] version : the version of the plf
+ * @param[in] edition : the edition of the plf
+ * @param[in] extension : the extension of the plf
+ * @return 1 if the version is black listed
+ */
+int ARUPDATER_Manager_IsBlacklisted(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
+
+/**
+ * @brief add a plf version to the black list of the manager
+ * @param manager : pointer on the manager
+ * @param[in] product : the product of the plf
+ * @param[in] version : the version of the plf
+ * @param[in] edition : the edition of the plf
+ * @param[in] extension : the extension of the plf
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Manager_AddBlacklistedVersion(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
+
+/**
+ * @brief add the plf versions listed in a file to the black list of the manager
+ * @details Each line holds the product id in hexadecimal followed by a comma separated version list, as "0901 3.1.0,3.1.1". Lines beginning with # are ignored
+ * @param manager : pointer on the manager
+ * @param[in] filePath : path of the black list file
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Manager_LoadBlacklist(ARUPDATER_Manager_t *manager, const char *const filePath);
+
+/**
+ * @brief select a previous plf kept by the downloader as the plf to upload
+ * @details The plf is moved back into place without being copied nor downloaded, the current plf is kept in exchange
+ * @param manager : pointer on the manager
+ * @param[in] rootFolder : root folder of the plf
+ * @param[in] product : the product of the plf
+ * @param[in] version : the version of the plf to select
+ * @param[in] edition : the edition of the plf to select
+ * @param[in] extension : the extension of the plf to select
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if this version has not been kept, the description of the error otherwise
+ * @see ARUPDATER_Downloader_SetPlfRetention()
+ */
+eARUPDATER_ERROR ARUPDATER_Manager_SelectRetainedPlfVersion(ARUPDATER_Manager_t *manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
+
+/**
+ * @brief set where the downloader stores the plf files and where the uploader reads them
+ * @details With the pack storage, the uploader extracts the plf into a temporary file of the product folder before sending it. The plf files already stored are not moved from one storage to the other
+ * @param manager : pointer on the manager
+ * @param[in] storage : the storage of the plf files
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Manager_SetPlfStorage(ARUPDATER_Manager_t *manager, eARUPDATER_Manager_PlfStorage storage);
+
+/**
+ * @brief get the versions of the plf files of a product
+ * @details A product folder can hold several plf files, the newest one is the one checked and uploaded. The headers are read again only when the product folder changes.
+ * The plf files of the product folder (or the current plf of the pack) are listed first, the newest first, followed by the previous versions retained by the downloader, with isRetained set
+ * @param manager : pointer on the manager
+ * @param[in] rootFolder : root folder of the plf
+ * @param[in] product : the product of the plf files
+ * @param[out] versions : the versions of the plf files. Can be null if maxCount is 0
+ * @param[in] maxCount : the size of versions
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the number of plf files and retained versions of the product, which may be greater than maxCount
+ */
+int ARUPDATER_Manager_GetPlfVersions(ARUPDATER_Manager_t *manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, eARUPDATER_ERROR *error);
+
 #endif /* _ARUPDATER_MANAGER_H_ */
 
 
@@ -42,8 +42,54 @@
 #include <libARDiscovery/ARDISCOVERY_Discovery.h>
 #include <libARSAL/ARSAL_MD5_Manager.h>
 
+/**
+ * @brief Maximum number of data connections of an upload
+ * @see ARUPDATER_Uploader_SetStreamCount ()
+ */
+#define ARUPDATER_UPLOADER_MAX_STREAMS 8
+
 typedef struct ARUPDATER_Uploader_t ARUPDATER_Uploader_t;
 
+/**
+ * @brief Parameters and throughput of the last plf transfer of an uploader sending through the ftp client of the library
+ * @see ARUPDATER_Uploader_SetFtpTarget ()
+ */
+typedef struct
+{
+    int isAdaptive;         /**< 1 if the block size and the send buffer followed the link, 0 if the block size was fixed */
+    int isZeroCopy;         /**< 1 if the plf went from the file to the data connection without being copied by the library */
+    int blockSize;          /**< size of the blocks written on the data connection at the end of the transfer */
+    int socketBufferSize;   /**< size of the send buffer of the data connection at the end of the transfer, as reported by the system */
+    int rttUs;              /**< round trip time of the data connection, 0 if unknown */
+    int adaptationCount;    /**< number of changes of the block size and of the send buffer, of all the streams */
+    int streamCount;        /**< number of data connections, the block size, the send buffer and the rtt are the ones of the first */
+    int64_t sentSize;       /**< number of bytes sent, the resumed part excluded */
+    int64_t durationUs;     /**< duration of the transfer */
+    int64_t throughput;     /**< average throughput of the transfer, in bytes per second */
+} ARUPDATER_Uploader_TransferStats_t;
+
+/**
+ * @brief Default time an ftp session of the library is kept open between two uploads
+ */
+#define ARUPDATER_UPLOADER_DEFAULT_SESSION_IDLE_TIMEOUT_MS (60 * 1000)
+
+/**
+ * @brief Default number of bytes of the plf read back from the device to check it
+ */
+#define ARUPDATER_UPLOADER_DEFAULT_VERIFICATION_SIZE (256 * 1024)
+
+/**
+ * @brief Check of the plf on the device once it is sent, before it is renamed
+ */
+typedef enum
+{
+    ARUPDATER_UPLOADER_VERIFICATION_NONE = 0,   /**< the plf has not been checked, or not sent */
+    ARUPDATER_UPLOADER_VERIFICATION_SIZE,       /**< only the size of the plf on the device has been checked */
+    ARUPDATER_UPLOADER_VERIFICATION_SAMPLED,    /**< the size and the md5 of chunks read back from the device match the plf */
+    ARUPDATER_UPLOADER_VERIFICATION_FULL,       /**< the md5 of the whole plf, computed by the device, matches the plf */
+    ARUPDATER_UPLOADER_VERIFICATION_MISMATCH,   /**< the plf on the device does not match, the upload ends with ARUPDATER_ERROR_UPLOADER_VERIFICATION_FAILED */
+} eARUPDATER_UPLOADER_VERIFICATION;
+
 /**
  * @brief Progress callback of the upload
  * @param arg The pointer of the user custom argument
@@ -56,6 +102,7 @@ typedef void (*ARUPDATER_Uploader_PlfUploadProgressCallback_t) (void* arg, float
  * @brief Completion callback of the Plf upload
  * @param arg The pointer of the user custom argument
  * @param error The error status to indicate the plf upload status
+ * @note ARUPDATER_Uploader_GetVerification() tells from the callback how the plf has been checked on the device
  * @see ARUPDATER_Manager_CheckLocaleVersionThreadRun ()
  */
 typedef void (*ARUPDATER_Uploader_PlfUploadCompletionCallback_t) (void* arg, eARUPDATER_ERROR error);
@@ -87,6 +134,116 @@ eARUPDATER_ERROR ARUPDATER_Uploader_New(ARUPDATER_Manager_t* manager, const char
  */
 eARUPDATER_ERROR ARUPDATER_Uploader_Delete(ARUPDATER_Manager_t *manager);
 
+/**
+ * @brief Send the plf with the ftp client of the library instead of ARDataTransfer
+ * @details The client measures the throughput and the round trip time of the link during the transfer to adapt its block size and its socket buffer.
+ * It also negotiates the resume and sends the md5 file, the ftp manager given to ARUPDATER_Uploader_New() is not used. Its sessions are kept open between two uploads
+ * @param manager : pointer on the manager
+ * @param[in] address : address of the ftp server of the device, the one given to ARUTILS_Manager_InitWifiFtp()
+ * @param[in] port : port of the ftp server of the device
+ * @param[in] username : user name, anonymous if null or empty
+ * @param[in] password : password. Can be null
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetBlockSize(), ARUPDATER_Uploader_GetTransferStats()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetFtpTarget(ARUPDATER_Manager_t *manager, const char *const address, int port, const char *const username, const char *const password);
+
+/**
+ * @brief Fix the size of the blocks sent by the ftp client of the library
+ * @param manager : pointer on the manager
+ * @param[in] blockSize : size of the blocks, 0 to adapt it to the link (default)
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetFtpTarget()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetBlockSize(ARUPDATER_Manager_t *manager, int blockSize);
+
+/**
+ * @brief Choose how the ftp client of the library reads the plf
+ * @details With zero copy, the system sends the plf from the file to the data connection (sendfile on Linux and Android).
+ * The client falls back on copying the plf through a buffer where the system or the file does not support it
+ * @param manager : pointer on the manager
+ * @param[in] isZeroCopy : 1 to send the plf without copying it (default), 0 to copy it through a buffer
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetFtpTarget(), ARUPDATER_Uploader_GetTransferStats()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetZeroCopy(ARUPDATER_Manager_t *manager, int isZeroCopy);
+
+/**
+ * @brief Send the plf on several data connections at once
+ * @details The plf is split in ranges written at their offset in the partial plf (REST then STOR), each on its own ftp session.
+ * The partial plf is renamed only once all the ranges are sent. Plf files smaller than 1 MB per stream use fewer streams.
+ * A multi-stream upload is not resumed after an interruption: the md5 file of the device is removed until the plf is complete
+ * @param manager : pointer on the manager
+ * @param[in] streamCount : number of data connections, from 1 (default) to ARUPDATER_UPLOADER_MAX_STREAMS
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetFtpTarget()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetStreamCount(ARUPDATER_Manager_t *manager, int streamCount);
+
+/**
+ * @brief Set the time the ftp sessions of the library are kept open after an upload, to be used by the next one
+ * @details The sessions stay logged in on the device given to ARUPDATER_Uploader_SetFtpTarget(). The next upload checks them with NOOP
+ * before using them, for the resume negotiation, the md5 file and the plf. The sessions idle for longer than the timeout are closed by the next upload,
+ * by ARUPDATER_Uploader_CloseIdleSessions(), ARUPDATER_Uploader_CancelThread() and ARUPDATER_Uploader_Delete()
+ * @param manager : pointer on the manager
+ * @param[in] timeoutMs : idle timeout in milliseconds, ARUPDATER_UPLOADER_DEFAULT_SESSION_IDLE_TIMEOUT_MS by default, 0 to close the sessions after each upload
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetFtpTarget()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetSessionIdleTimeout(ARUPDATER_Manager_t *manager, int timeoutMs);
+
+/**
+ * @brief Close the ftp sessions kept open since longer than the idle timeout
+ * @param manager : pointer on the manager
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetSessionIdleTimeout()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_CloseIdleSessions(ARUPDATER_Manager_t *manager);
+
+/**
+ * @brief Set the number of bytes of the plf read back from the device to check it, before it is renamed
+ * @details The size of the plf on the device is checked first. The ftp client of the library asks the md5 of the whole plf to the device if its server has XMD5,
+ * otherwise it reads chunks spread over the plf, the first and the last included. ARDataTransfer reads the end of the plf.
+ * @param manager : pointer on the manager
+ * @param[in] verificationSize : maximum number of bytes read back, ARUPDATER_UPLOADER_DEFAULT_VERIFICATION_SIZE by default, 0 to check the size only, negative to not check the plf
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_GetVerification()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetVerificationSize(ARUPDATER_Manager_t *manager, int64_t verificationSize);
+
+/**
+ * @brief Get how the last plf sent has been checked on the device
+ * @note Can be called from the completion callback
+ * @param manager : pointer on the manager
+ * @param[out] verification : the check of the plf on the device
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetVerificationSize()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_GetVerification(ARUPDATER_Manager_t *manager, eARUPDATER_UPLOADER_VERIFICATION *verification);
+
+/**
+ * @brief Get the parameters and the throughput of the last plf transfer
+ * @param manager : pointer on the manager
+ * @param[out] stats : the parameters and the throughput, cleared if the plf has not been sent by the ftp client of the library
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Uploader_SetFtpTarget()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_GetTransferStats(ARUPDATER_Manager_t *manager, ARUPDATER_Uploader_TransferStats_t *stats);
+
+/**
+ * @brief Give the version run by the device, to upload the plf only if the device does not run it already
+ * @details The version of the local plf is taken from the index of the plf folder or of the pack. When the device runs the same version,
+ * ARUPDATER_Uploader_ThreadRun() returns ARUPDATER_ERROR_UPLOADER_ALREADY_UP_TO_DATE without opening any ftp session nor computing any hash
+ * The version only applies to the next ARUPDATER_Uploader_ThreadRun(), it is forgotten once the upload ends
+ * @param manager : pointer on the manager
+ * @param[in] version : the version reported by the device
+ * @param[in] edition : the edition reported by the device
+ * @param[in] extension : the extension reported by the device
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Manager_PlfVersionIsUpToDate()
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SetDeviceVersion(ARUPDATER_Manager_t *manager, int version, int edition, int extension);
+
 /**
  * @brief Upload a plf
  * @warning This function must be called in its own thread.
@@ -42,4 +42,6 @@
 #include <libARUpdater/ARUPDATER_Manager.h>
 #include <libARUpdater/ARUPDATER_Downloader.h>
 #include <libARUpdater/ARUPDATER_Uploader.h>
+#include <libARUpdater/ARUPDATER_FanOut.h>
+#include <libARUpdater/ARUPDATER_Fleet.h>
 #endif /* _ARUPDATER_H_ */
\ No newline at end of file
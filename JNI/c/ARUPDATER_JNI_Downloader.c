@@ -900,7 +900,7 @@ int ARUPDATER_JNI_Downloader_NewDownloadInfoJNI(JNIEnv *env)
 
         if (error == JNI_OK)
         {
-            methodId_DownloadInfo_init = (*env)->GetMethodID(env, classDownloadInfo, "<init>", "(Ljava/lang/String;Ljava/lang/String;I)V");
+            methodId_DownloadInfo_init = (*env)->GetMethodID(env, classDownloadInfo, "<init>", "(Ljava/lang/String;Ljava/lang/String;IJ)V");
 
             if (methodId_DownloadInfo_init == NULL)
             {
@@ -960,7 +960,7 @@ jobject ARUPDATER_JNI_Downloader_NewDownloadInfo(JNIEnv *env, ARUPDATER_Download
 
     if (error == JNI_OK)
     {
-        jInfo = (*env)->NewObject(env, classDownloadInfo, methodId_DownloadInfo_init, jDownloadUrl, jPlfVersion, (jint)ARDISCOVERY_getProductID(info->product));
+        jInfo = (*env)->NewObject(env, classDownloadInfo, methodId_DownloadInfo_init, jDownloadUrl, jPlfVersion, (jint)ARDISCOVERY_getProductID(info->product), (jlong)info->remoteSize);
     }
 
     // clean local refs
@@ -39,15 +39,17 @@ public class ARUpdaterDownloadInfo
         public final String downloadUrl;
         public final String plfVersion;
         public final ARDISCOVERY_PRODUCT_ENUM product;
+        public final long remoteSize;
 
 	/**
      * @brief Info about the plf version on server
      */
-	public ARUpdaterDownloadInfo(String downloadUrl, String plfVersion, int product)
+	public ARUpdaterDownloadInfo(String downloadUrl, String plfVersion, int product, long remoteSize)
     {
         this.downloadUrl = downloadUrl;
         this.plfVersion = plfVersion;
         this.product = ARDiscoveryService.getProductFromProductID(product);
+        this.remoteSize = remoteSize;
     }
 
 }
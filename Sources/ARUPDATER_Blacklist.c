@@ -0,0 +1,366 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Blacklist.c
+ * @brief libARUpdater blacklist c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+#include "ARUPDATER_Blacklist.h"
+#include "ARUPDATER_Utils.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_BLACKLIST_TAG                 "ARUPDATER_Blacklist"
+
+#define ARUPDATER_BLACKLIST_INITIAL_CAPACITY    16
+#define ARUPDATER_BLACKLIST_FIELD_MAX           0xFFFF
+#define ARUPDATER_BLACKLIST_EMPTY_KEY           UINT64_MAX
+#define ARUPDATER_BLACKLIST_VERSION_SEPARATOR   ","
+#define ARUPDATER_BLACKLIST_LINE_MAX_LENGTH     1024
+
+/**
+ * @brief open addressing table of the packed keys, at most half full
+ */
+struct ARUPDATER_Blacklist_t
+{
+    ARSAL_Mutex_t lock;
+    uint64_t *keys;
+    uint32_t capacity;
+    uint32_t count;
+};
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+/**
+ * @brief pack a plf version on 64 bits, 16 bits per field
+ * @return the key, ARUPDATER_BLACKLIST_EMPTY_KEY if a field does not fit
+ */
+static uint64_t ARUPDATER_Blacklist_Key(eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    if (((int)product < 0) || ((int)product >= ARUPDATER_BLACKLIST_FIELD_MAX) ||
+        (version < 0) || (version > ARUPDATER_BLACKLIST_FIELD_MAX) ||
+        (edition < 0) || (edition > ARUPDATER_BLACKLIST_FIELD_MAX) ||
+        (extension < 0) || (extension > ARUPDATER_BLACKLIST_FIELD_MAX))
+    {
+        return ARUPDATER_BLACKLIST_EMPTY_KEY;
+    }
+
+    return ((uint64_t)product << 48) | ((uint64_t)version << 32) | ((uint64_t)edition << 16) | (uint64_t)extension;
+}
+
+static uint32_t ARUPDATER_Blacklist_Slot(uint64_t key, uint32_t capacity)
+{
+    // splitmix64 finalizer, capacity is a power of two
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return (uint32_t)key & (capacity - 1);
+}
+
+static void ARUPDATER_Blacklist_Insert(uint64_t *keys, uint32_t capacity, uint64_t key, uint32_t *count)
+{
+    uint32_t slot = ARUPDATER_Blacklist_Slot(key, capacity);
+
+    while ((keys[slot] != ARUPDATER_BLACKLIST_EMPTY_KEY) && (keys[slot] != key))
+    {
+        slot = (slot + 1) & (capacity - 1);
+    }
+
+    if (keys[slot] == ARUPDATER_BLACKLIST_EMPTY_KEY)
+    {
+        keys[slot] = key;
+        (*count)++;
+    }
+}
+
+static eARUPDATER_ERROR ARUPDATER_Blacklist_Grow(ARUPDATER_Blacklist_t *blacklist)
+{
+    uint32_t newCapacity = blacklist->capacity * 2;
+    uint32_t newCount = 0;
+    uint64_t *newKeys = malloc(newCapacity * sizeof(uint64_t));
+    uint32_t i = 0;
+
+    if (newKeys == NULL)
+    {
+        return ARUPDATER_ERROR_ALLOC;
+    }
+
+    memset(newKeys, 0xFF, newCapacity * sizeof(uint64_t));
+    for (i = 0; i < blacklist->capacity; i++)
+    {
+        if (blacklist->keys[i] != ARUPDATER_BLACKLIST_EMPTY_KEY)
+        {
+            ARUPDATER_Blacklist_Insert(newKeys, newCapacity, blacklist->keys[i], &newCount);
+        }
+    }
+
+    free(blacklist->keys);
+    blacklist->keys = newKeys;
+    blacklist->capacity = newCapacity;
+    blacklist->count = newCount;
+
+    return ARUPDATER_OK;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Blacklist_t* ARUPDATER_Blacklist_New(eARUPDATER_ERROR *error)
+{
+    ARUPDATER_Blacklist_t *blacklist = NULL;
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+
+    blacklist = malloc(sizeof(ARUPDATER_Blacklist_t));
+    if (blacklist == NULL)
+    {
+        err = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        blacklist->capacity = ARUPDATER_BLACKLIST_INITIAL_CAPACITY;
+        blacklist->count = 0;
+        blacklist->keys = malloc(blacklist->capacity * sizeof(uint64_t));
+        if (blacklist->keys == NULL)
+        {
+            free(blacklist);
+            blacklist = NULL;
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        memset(blacklist->keys, 0xFF, blacklist->capacity * sizeof(uint64_t));
+        if (ARSAL_Mutex_Init(&blacklist->lock) != 0)
+        {
+            free(blacklist->keys);
+            free(blacklist);
+            blacklist = NULL;
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return blacklist;
+}
+
+void ARUPDATER_Blacklist_Delete(ARUPDATER_Blacklist_t **blacklist)
+{
+    if ((blacklist != NULL) && (*blacklist != NULL))
+    {
+        ARSAL_Mutex_Destroy(&(*blacklist)->lock);
+        free((*blacklist)->keys);
+        free(*blacklist);
+        *blacklist = NULL;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Blacklist_Add(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint64_t key = ARUPDATER_Blacklist_Key(product, version, edition, extension);
+
+    if ((blacklist == NULL) || (key == ARUPDATER_BLACKLIST_EMPTY_KEY))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&blacklist->lock);
+
+        if ((blacklist->count + 1) * 2 > blacklist->capacity)
+        {
+            error = ARUPDATER_Blacklist_Grow(blacklist);
+        }
+
+        if (error == ARUPDATER_OK)
+        {
+            ARUPDATER_Blacklist_Insert(blacklist->keys, blacklist->capacity, key, &blacklist->count);
+        }
+
+        ARSAL_Mutex_Unlock(&blacklist->lock);
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Blacklist_AddVersionList(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, const char *const versionList)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *list = NULL;
+    char *savePtr = NULL;
+    char *versionStr = NULL;
+
+    if ((blacklist == NULL) || (versionList == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        list = strdup(versionList);
+        if (list == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        versionStr = strtok_r(list, ARUPDATER_BLACKLIST_VERSION_SEPARATOR, &savePtr);
+    }
+
+    while ((error == ARUPDATER_OK) && (versionStr != NULL))
+    {
+        int version, edition, extension;
+
+        error = ARUPDATER_Utils_ParseVersion(versionStr, &version, &edition, &extension);
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Blacklist_Add(blacklist, product, version, edition, extension);
+        }
+        else
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_BLACKLIST_TAG, "bad version %s", versionStr);
+        }
+
+        versionStr = strtok_r(NULL, ARUPDATER_BLACKLIST_VERSION_SEPARATOR, &savePtr);
+    }
+
+    free(list);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Blacklist_LoadFile(ARUPDATER_Blacklist_t *blacklist, const char *const filePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    FILE *file = NULL;
+    char line[ARUPDATER_BLACKLIST_LINE_MAX_LENGTH];
+    int lineNumber = 0;
+
+    if ((blacklist == NULL) || (filePath == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        file = fopen(filePath, "r");
+        if (file == NULL)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    while ((error == ARUPDATER_OK) && (fgets(line, sizeof(line), file) != NULL))
+    {
+        unsigned int productId = 0;
+        char versionList[ARUPDATER_BLACKLIST_LINE_MAX_LENGTH];
+        eARDISCOVERY_PRODUCT product;
+
+        lineNumber++;
+        if ((line[0] == '#') || (sscanf(line, "%x %1023s", &productId, versionList) != 2))
+        {
+            continue;
+        }
+
+        product = ARDISCOVERY_getProductFromProductID((uint16_t)productId);
+        if ((productId > ARUPDATER_BLACKLIST_FIELD_MAX) || (product == ARDISCOVERY_PRODUCT_MAX))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_BLACKLIST_TAG, "%s:%d unknown product %04x", filePath, lineNumber, productId);
+            continue;
+        }
+
+        error = ARUPDATER_Blacklist_AddVersionList(blacklist, product, versionList);
+    }
+
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return error;
+}
+
+int ARUPDATER_Blacklist_Contains(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    int contains = 0;
+    uint64_t key = ARUPDATER_Blacklist_Key(product, version, edition, extension);
+
+    if ((blacklist != NULL) && (key != ARUPDATER_BLACKLIST_EMPTY_KEY))
+    {
+        uint32_t slot;
+
+        ARSAL_Mutex_Lock(&blacklist->lock);
+
+        slot = ARUPDATER_Blacklist_Slot(key, blacklist->capacity);
+        while (blacklist->keys[slot] != ARUPDATER_BLACKLIST_EMPTY_KEY)
+        {
+            if (blacklist->keys[slot] == key)
+            {
+                contains = 1;
+                break;
+            }
+            slot = (slot + 1) & (blacklist->capacity - 1);
+        }
+
+        ARSAL_Mutex_Unlock(&blacklist->lock);
+    }
+
+    return contains;
+}
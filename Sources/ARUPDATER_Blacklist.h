@@ -0,0 +1,107 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Blacklist.h
+ * @brief libARUpdater blacklist header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_BLACKLIST_PRIVATE_H_
+#define _ARUPDATER_BLACKLIST_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+
+/**
+ * @brief Set of blacklisted plf versions, hashed on (product, version, edition, extension)
+ * @details All the functions can be called from any thread
+ * @see ARUPDATER_Blacklist_New ()
+ */
+typedef struct ARUPDATER_Blacklist_t ARUPDATER_Blacklist_t;
+
+/**
+ * @brief Create an empty blacklist
+ * @warning This function allocates memory
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the new blacklist, NULL if an error occurred
+ * @see ARUPDATER_Blacklist_Delete ()
+ */
+ARUPDATER_Blacklist_t* ARUPDATER_Blacklist_New(eARUPDATER_ERROR *error);
+
+/**
+ * @brief Delete a blacklist
+ * @warning This function frees memory
+ * @param blacklist : address of the pointer on the blacklist
+ * @see ARUPDATER_Blacklist_New ()
+ */
+void ARUPDATER_Blacklist_Delete(ARUPDATER_Blacklist_t **blacklist);
+
+/**
+ * @brief Blacklist a plf version
+ * @param blacklist : pointer on the blacklist
+ * @param[in] product : the product of the plf
+ * @param[in] version : the version of the plf
+ * @param[in] edition : the edition of the plf
+ * @param[in] extension : the extension of the plf
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Blacklist_Add(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
+
+/**
+ * @brief Blacklist the plf versions of a comma separated list
+ * @param blacklist : pointer on the blacklist
+ * @param[in] product : the product of the plf
+ * @param[in] versionList : the list of versions (pattern : X.Y.Z,X.Y.Z...)
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Blacklist_AddVersionList(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, const char *const versionList);
+
+/**
+ * @brief Blacklist the plf versions listed in a file
+ * @details Each line holds the product id in hexadecimal followed by a version list, as "0901 3.1.0,3.1.1". Lines beginning with # are ignored
+ * @param blacklist : pointer on the blacklist
+ * @param[in] filePath : path of the file
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Blacklist_LoadFile(ARUPDATER_Blacklist_t *blacklist, const char *const filePath);
+
+/**
+ * @brief Tell whether a plf version is blacklisted
+ * @param blacklist : pointer on the blacklist
+ * @param[in] product : the product of the plf
+ * @param[in] version : the version of the plf
+ * @param[in] edition : the edition of the plf
+ * @param[in] extension : the extension of the plf
+ * @return 1 if the version is blacklisted, 0 otherwise
+ */
+int ARUPDATER_Blacklist_Contains(ARUPDATER_Blacklist_t *blacklist, eARDISCOVERY_PRODUCT product, int version, int edition, int extension);
+
+#endif
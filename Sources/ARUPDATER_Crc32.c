@@ -0,0 +1,308 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Crc32.c
+ * @brief libARUpdater CRC32 c file.
+ * @date 19/10/2026
+ **/
+
+#include <string.h>
+#include <pthread.h>
+
+#include "ARUPDATER_Crc32.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARUPDATER_CRC32_HAVE_PCLMUL
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_FEATURE_CRC32)
+#define ARUPDATER_CRC32_HAVE_ARMV8
+#include <arm_acle.h>
+#endif
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_CRC32_POLYNOMIAL              0xEDB88320 // reflected 0x04C11DB7
+#define ARUPDATER_CRC32_PCLMUL_MIN_SIZE         64
+
+typedef uint32_t (*ARUPDATER_Crc32_Kernel_t) (uint32_t crc, const uint8_t *data, size_t size);
+
+static uint32_t ARUPDATER_Crc32_Tables[8][256];
+static pthread_once_t ARUPDATER_Crc32_TablesOnce = PTHREAD_ONCE_INIT;
+
+static ARUPDATER_Crc32_Kernel_t ARUPDATER_Crc32_Kernel = NULL;
+static pthread_once_t ARUPDATER_Crc32_KernelOnce = PTHREAD_ONCE_INIT;
+
+/* ***************************************
+ *
+ *             scalar kernel :
+ *
+ *****************************************/
+
+static void ARUPDATER_Crc32_InitTables(void)
+{
+    uint32_t i = 0;
+    int j = 0;
+
+    for (i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (j = 0; j < 8; j++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ ARUPDATER_CRC32_POLYNOMIAL : crc >> 1;
+        }
+        ARUPDATER_Crc32_Tables[0][i] = crc;
+    }
+
+    for (i = 0; i < 256; i++)
+    {
+        for (j = 1; j < 8; j++)
+        {
+            uint32_t previous = ARUPDATER_Crc32_Tables[j - 1][i];
+            ARUPDATER_Crc32_Tables[j][i] = (previous >> 8) ^ ARUPDATER_Crc32_Tables[0][previous & 0xFF];
+        }
+    }
+}
+
+/**
+ * @brief slicing-by-8 on the inverted crc
+ */
+static uint32_t ARUPDATER_Crc32_Scalar(uint32_t crc, const uint8_t *data, size_t size)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    while (size >= 8)
+    {
+        uint32_t low, high;
+        memcpy(&low, data, sizeof(low));
+        memcpy(&high, data + 4, sizeof(high));
+        low ^= crc;
+
+        crc = ARUPDATER_Crc32_Tables[7][low & 0xFF] ^
+              ARUPDATER_Crc32_Tables[6][(low >> 8) & 0xFF] ^
+              ARUPDATER_Crc32_Tables[5][(low >> 16) & 0xFF] ^
+              ARUPDATER_Crc32_Tables[4][low >> 24] ^
+              ARUPDATER_Crc32_Tables[3][high & 0xFF] ^
+              ARUPDATER_Crc32_Tables[2][(high >> 8) & 0xFF] ^
+              ARUPDATER_Crc32_Tables[1][(high >> 16) & 0xFF] ^
+              ARUPDATER_Crc32_Tables[0][high >> 24];
+
+        data += 8;
+        size -= 8;
+    }
+#endif
+
+    while (size > 0)
+    {
+        crc = (crc >> 8) ^ ARUPDATER_Crc32_Tables[0][(crc ^ *data) & 0xFF];
+        data++;
+        size--;
+    }
+
+    return crc;
+}
+
+/* ***************************************
+ *
+ *             ARMv8 kernel :
+ *
+ *****************************************/
+
+#ifdef ARUPDATER_CRC32_HAVE_ARMV8
+static uint32_t ARUPDATER_Crc32_Armv8(uint32_t crc, const uint8_t *data, size_t size)
+{
+    while ((size > 0) && (((uintptr_t)data & 7) != 0))
+    {
+        crc = __crc32b(crc, *data);
+        data++;
+        size--;
+    }
+
+    while (size >= 8)
+    {
+        uint64_t value;
+        memcpy(&value, data, sizeof(value));
+        crc = __crc32d(crc, value);
+        data += 8;
+        size -= 8;
+    }
+
+    while (size > 0)
+    {
+        crc = __crc32b(crc, *data);
+        data++;
+        size--;
+    }
+
+    return crc;
+}
+#endif
+
+/* ***************************************
+ *
+ *             x86 PCLMULQDQ kernel :
+ *
+ *****************************************/
+
+#ifdef ARUPDATER_CRC32_HAVE_PCLMUL
+/**
+ * @brief fold 64 bytes at a time with carry-less multiplications, then reduce with Barrett
+ * @details From "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel), constants for the reflected IEEE polynomial. size is a multiple of 16, at least 64
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32_t ARUPDATER_Crc32_PclmulFold(uint32_t crc, const uint8_t *data, size_t size)
+{
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596LL, 0x0154442bd4LL);
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009eLL, 0x01751997d0LL);
+    const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163cd6124LL);
+    const __m128i poly = _mm_set_epi64x(0x01f7011641LL, 0x01db710641LL);
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    __m128i x1, x2, x3, x4, t1, t2, t3, t4;
+
+    x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(data + 0x00)), _mm_cvtsi32_si128((int)crc));
+    x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+    data += 64;
+    size -= 64;
+
+    // fold the 4 lanes over the next 64 bytes
+    while (size >= 64)
+    {
+        t1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        t2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        t3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        t4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, t1), _mm_loadu_si128((const __m128i *)(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, t2), _mm_loadu_si128((const __m128i *)(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, t3), _mm_loadu_si128((const __m128i *)(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, t4), _mm_loadu_si128((const __m128i *)(data + 0x30)));
+
+        data += 64;
+        size -= 64;
+    }
+
+    // fold the 4 lanes into one
+    t1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x2), t1);
+    t1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x3), t1);
+    t1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), x4), t1);
+
+    // fold the remaining 16 bytes blocks
+    while (size >= 16)
+    {
+        t1 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k3k4, 0x11), _mm_loadu_si128((const __m128i *)data)), t1);
+        data += 16;
+        size -= 16;
+    }
+
+    // 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5k0, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+static uint32_t ARUPDATER_Crc32_Pclmul(uint32_t crc, const uint8_t *data, size_t size)
+{
+    if (size >= ARUPDATER_CRC32_PCLMUL_MIN_SIZE)
+    {
+        size_t foldSize = size & ~(size_t)15;
+        crc = ARUPDATER_Crc32_PclmulFold(crc, data, foldSize);
+        data += foldSize;
+        size -= foldSize;
+    }
+
+    return ARUPDATER_Crc32_Scalar(crc, data, size);
+}
+#endif
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+static void ARUPDATER_Crc32_InitKernel(void)
+{
+    pthread_once(&ARUPDATER_Crc32_TablesOnce, ARUPDATER_Crc32_InitTables);
+
+#if defined(ARUPDATER_CRC32_HAVE_ARMV8)
+    ARUPDATER_Crc32_Kernel = ARUPDATER_Crc32_Armv8;
+#elif defined(ARUPDATER_CRC32_HAVE_PCLMUL)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1"))
+    {
+        ARUPDATER_Crc32_Kernel = ARUPDATER_Crc32_Pclmul;
+    }
+    else
+    {
+        ARUPDATER_Crc32_Kernel = ARUPDATER_Crc32_Scalar;
+    }
+#else
+    ARUPDATER_Crc32_Kernel = ARUPDATER_Crc32_Scalar;
+#endif
+}
+
+uint32_t ARUPDATER_Crc32_Update(uint32_t crc, const uint8_t *data, size_t size)
+{
+    pthread_once(&ARUPDATER_Crc32_KernelOnce, ARUPDATER_Crc32_InitKernel);
+
+    if ((data == NULL) || (size == 0))
+    {
+        return crc;
+    }
+
+    return ~ARUPDATER_Crc32_Kernel(~crc, data, size);
+}
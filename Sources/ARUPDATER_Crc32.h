@@ -0,0 +1,53 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Crc32.h
+ * @brief libARUpdater CRC32 header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_CRC32_PRIVATE_H_
+#define _ARUPDATER_CRC32_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Update a CRC32 (IEEE 802.3, same as zlib crc32()) with a buffer
+ * @details Uses the ARMv8 CRC32 instructions or the x86 PCLMULQDQ folding when the CPU has them, a slicing-by-8 table otherwise
+ * @param[in] crc : the CRC32 of the previous data, 0 for the first buffer
+ * @param[in] data : the buffer
+ * @param[in] size : the size of the buffer
+ * @return the CRC32 of the previous data followed by the buffer
+ */
+uint32_t ARUPDATER_Crc32_Update(uint32_t crc, const uint8_t *data, size_t size);
+
+#endif
@@ -0,0 +1,350 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Dir.c
+ * @brief libARUpdater folders opened once c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+#include "ARUPDATER_Dir.h"
+#include "ARUPDATER_Manager.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_DIR_TAG                       "ARUPDATER_Dir"
+
+#define ARUPDATER_DIR_OPEN_FLAGS                (O_RDONLY | O_DIRECTORY | O_CLOEXEC)
+
+typedef struct
+{
+    uint16_t productId;
+    int fd;
+} ARUPDATER_Dir_Product_t;
+
+struct ARUPDATER_Dir_t
+{
+    char *rootFolder;
+    int rootFd;
+    int plfFolderFd;
+    ARUPDATER_Dir_Product_t products[ARUPDATER_DIR_MAX_PRODUCTS];
+    int productCount;
+    ARSAL_Mutex_t lock;
+};
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+/**
+ * @brief tell whether an opened folder has been removed
+ */
+static int ARUPDATER_Dir_IsRemoved(int fd)
+{
+    struct stat statbuf;
+
+    return (fstat(fd, &statbuf) != 0) || (statbuf.st_nlink == 0);
+}
+
+/**
+ * @brief open a folder relative to an opened one, creating it if asked
+ */
+static int ARUPDATER_Dir_OpenAt(int parentFd, const char *const name, int isCreated, eARUPDATER_ERROR *error)
+{
+    int fd = openat(parentFd, name, ARUPDATER_DIR_OPEN_FLAGS);
+
+    if ((fd < 0) && (errno == ENOENT) && isCreated)
+    {
+        if ((mkdirat(parentFd, name, S_IRWXU) == 0) || (errno == EEXIST))
+        {
+            fd = openat(parentFd, name, ARUPDATER_DIR_OPEN_FLAGS);
+        }
+    }
+
+    if (fd < 0)
+    {
+        *error = (errno == ENOENT) ? ARUPDATER_ERROR_PLF_FILE_NOT_FOUND : ARUPDATER_ERROR_SYSTEM;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief get the descriptor of the plf folder, to be called with the lock held
+ * @return the descriptor owned by dir, -1 on error
+ */
+static int ARUPDATER_Dir_GetPlfFolderFd(ARUPDATER_Dir_t *dir, int isCreated, eARUPDATER_ERROR *error)
+{
+    int i = 0;
+
+    // a removed folder is opened again, as well as the folders opened in it
+    if ((dir->plfFolderFd >= 0) && ARUPDATER_Dir_IsRemoved(dir->plfFolderFd))
+    {
+        for (i = 0; i < dir->productCount; i++)
+        {
+            close(dir->products[i].fd);
+        }
+        dir->productCount = 0;
+        close(dir->plfFolderFd);
+        dir->plfFolderFd = -1;
+    }
+    if ((dir->rootFd >= 0) && (dir->plfFolderFd < 0) && ARUPDATER_Dir_IsRemoved(dir->rootFd))
+    {
+        close(dir->rootFd);
+        dir->rootFd = -1;
+    }
+
+    if (dir->rootFd < 0)
+    {
+        dir->rootFd = ARUPDATER_Dir_OpenAt(AT_FDCWD, dir->rootFolder, isCreated, error);
+    }
+
+    if ((dir->rootFd >= 0) && (dir->plfFolderFd < 0))
+    {
+        dir->plfFolderFd = ARUPDATER_Dir_OpenAt(dir->rootFd, ARUPDATER_MANAGER_PLF_FOLDER, isCreated, error);
+    }
+
+    return dir->plfFolderFd;
+}
+
+/**
+ * @brief duplicate a descriptor for the caller
+ */
+static int ARUPDATER_Dir_Dup(int fd, eARUPDATER_ERROR *error)
+{
+    int dupFd = -1;
+
+    if (fd >= 0)
+    {
+        dupFd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+        if (dupFd < 0)
+        {
+            *error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    return dupFd;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Dir_t *ARUPDATER_Dir_New(const char *const rootFolder, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Dir_t *dir = NULL;
+
+    if (rootFolder == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        dir = calloc(1, sizeof(ARUPDATER_Dir_t));
+        if (dir == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        dir->rootFd = -1;
+        dir->plfFolderFd = -1;
+        dir->rootFolder = strdup(rootFolder);
+        if (dir->rootFolder == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if ((err == ARUPDATER_OK) && (ARSAL_Mutex_Init(&dir->lock) != 0))
+    {
+        err = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if ((err != ARUPDATER_OK) && (dir != NULL))
+    {
+        free(dir->rootFolder);
+        free(dir);
+        dir = NULL;
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return dir;
+}
+
+void ARUPDATER_Dir_Delete(ARUPDATER_Dir_t **dirAddr)
+{
+    int i = 0;
+
+    if ((dirAddr != NULL) && (*dirAddr != NULL))
+    {
+        ARUPDATER_Dir_t *dir = *dirAddr;
+
+        for (i = 0; i < dir->productCount; i++)
+        {
+            close(dir->products[i].fd);
+        }
+        if (dir->plfFolderFd >= 0)
+        {
+            close(dir->plfFolderFd);
+        }
+        if (dir->rootFd >= 0)
+        {
+            close(dir->rootFd);
+        }
+        ARSAL_Mutex_Destroy(&dir->lock);
+        free(dir->rootFolder);
+        free(dir);
+
+        *dirAddr = NULL;
+    }
+}
+
+int ARUPDATER_Dir_OpenPlfFolder(ARUPDATER_Dir_t *dir, int isCreated, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int fd = -1;
+
+    if (dir == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&dir->lock);
+        fd = ARUPDATER_Dir_Dup(ARUPDATER_Dir_GetPlfFolderFd(dir, isCreated, &err), &err);
+        ARSAL_Mutex_Unlock(&dir->lock);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return fd;
+}
+
+int ARUPDATER_Dir_OpenProductFolder(ARUPDATER_Dir_t *dir, uint16_t productId, int isCreated, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    char device[ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE];
+    int plfFolderFd = -1;
+    int productFd = -1;
+    int fd = -1;
+    int i = 0;
+
+    if (dir == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&dir->lock);
+
+        plfFolderFd = ARUPDATER_Dir_GetPlfFolderFd(dir, isCreated, &err);
+
+        for (i = 0; (plfFolderFd >= 0) && (i < dir->productCount) && (productFd < 0); i++)
+        {
+            if (dir->products[i].productId == productId)
+            {
+                if (ARUPDATER_Dir_IsRemoved(dir->products[i].fd))
+                {
+                    close(dir->products[i].fd);
+                    dir->products[i] = dir->products[dir->productCount - 1];
+                    dir->productCount--;
+                }
+                else
+                {
+                    productFd = dir->products[i].fd;
+                }
+            }
+        }
+
+        if ((plfFolderFd >= 0) && (productFd < 0))
+        {
+            snprintf(device, sizeof(device), "%04x", productId);
+            productFd = ARUPDATER_Dir_OpenAt(plfFolderFd, device, isCreated, &err);
+
+            if ((productFd >= 0) && (dir->productCount < ARUPDATER_DIR_MAX_PRODUCTS))
+            {
+                dir->products[dir->productCount].productId = productId;
+                dir->products[dir->productCount].fd = productFd;
+                dir->productCount++;
+            }
+            else if (productFd >= 0)
+            {
+                // not kept, given as is
+                fd = productFd;
+                productFd = -1;
+            }
+        }
+
+        if (productFd >= 0)
+        {
+            fd = ARUPDATER_Dir_Dup(productFd, &err);
+        }
+
+        ARSAL_Mutex_Unlock(&dir->lock);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return fd;
+}
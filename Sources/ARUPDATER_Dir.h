@@ -0,0 +1,93 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Dir.h
+ * @brief libARUpdater folders opened once header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_DIR_PRIVATE_H_
+#define _ARUPDATER_DIR_PRIVATE_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+
+/**
+ * @brief Number of product folders kept opened
+ */
+#define ARUPDATER_DIR_MAX_PRODUCTS                      32
+
+/**
+ * @brief Folders of a root folder, opened once then used with openat (), renameat (), unlinkat () and fstatat ()
+ * @see ARUPDATER_Dir_New ()
+ */
+typedef struct ARUPDATER_Dir_t ARUPDATER_Dir_t;
+
+/**
+ * @brief Create the folders of a root folder
+ * @details Nothing is opened before the first use, the root folder may not exist yet
+ * @warning This function allocates memory
+ * @param[in] rootFolder : the root folder
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the folders, NULL on error
+ * @see ARUPDATER_Dir_Delete ()
+ */
+ARUPDATER_Dir_t *ARUPDATER_Dir_New(const char *const rootFolder, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Close the folders
+ * @warning This function frees memory
+ * @param dirAddr : address of the pointer on the folders
+ */
+void ARUPDATER_Dir_Delete(ARUPDATER_Dir_t **dirAddr);
+
+/**
+ * @brief Get a descriptor on the plf folder of the root folder
+ * @details The folder is opened once, its descriptor is duplicated for each call. A folder removed since is opened again
+ * @param dir : the folders
+ * @param[in] isCreated : 1 to create the folder if it does not exist
+ * @param[out] error : ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the folder does not exist, the description of the error otherwise. Can be null
+ * @return the descriptor to close, -1 on error
+ */
+int ARUPDATER_Dir_OpenPlfFolder(ARUPDATER_Dir_t *dir, int isCreated, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Get a descriptor on the folder of a product
+ * @details The folder is opened once, its descriptor is duplicated for each call. A folder removed since is opened again
+ * @param dir : the folders
+ * @param[in] productId : the id of the product
+ * @param[in] isCreated : 1 to create the folder and the plf folder if they do not exist
+ * @param[out] error : ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the folder does not exist, the description of the error otherwise. Can be null
+ * @return the descriptor to close, -1 on error
+ */
+int ARUPDATER_Dir_OpenProductFolder(ARUPDATER_Dir_t *dir, uint16_t productId, int isCreated, eARUPDATER_ERROR *error);
+
+#endif
@@ -55,7 +55,7 @@
  *
  *****************************************/
 
-ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *const downloadUrl, const char *const md5Expected, const char *const plfVersion, int remoteSize, const eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error)
+ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *const downloadUrl, const char *const md5Expected, const char *const plfVersion, int64_t remoteSize, const eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error)
 {
     ARUPDATER_DownloadInformation_t *downloadInfo = NULL;
     eARUPDATER_ERROR err = ARUPDATER_OK;
@@ -106,6 +106,10 @@ ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *c
         downloadInfo->remoteSize = remoteSize;
         
         downloadInfo->product = product;
+        
+        downloadInfo->hashAlgorithm = NULL;
+        downloadInfo->hashExpected = NULL;
+        downloadInfo->manifestUrl = NULL;
     }
     
     /* delete the downloader if an error occurred */
@@ -125,6 +129,68 @@ ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *c
 
 }
 
+eARUPDATER_ERROR ARUPDATER_DownloadInformation_SetHash(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const hashAlgorithm, const char *const hashExpected)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    char *algorithmCopy = NULL;
+    char *expectedCopy = NULL;
+    
+    if ((downloadInfo == NULL) || (hashAlgorithm == NULL) || (hashExpected == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        algorithmCopy = strdup(hashAlgorithm);
+        expectedCopy = strdup(hashExpected);
+        if ((algorithmCopy == NULL) || (expectedCopy == NULL))
+        {
+            free(algorithmCopy);
+            free(expectedCopy);
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        free(downloadInfo->hashAlgorithm);
+        free(downloadInfo->hashExpected);
+        downloadInfo->hashAlgorithm = algorithmCopy;
+        downloadInfo->hashExpected = expectedCopy;
+    }
+    
+    return err;
+}
+
+eARUPDATER_ERROR ARUPDATER_DownloadInformation_SetManifestUrl(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const manifestUrl)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    char *urlCopy = NULL;
+    
+    if ((downloadInfo == NULL) || (manifestUrl == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        urlCopy = strdup(manifestUrl);
+        if (urlCopy == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        free(downloadInfo->manifestUrl);
+        downloadInfo->manifestUrl = urlCopy;
+    }
+    
+    return err;
+}
+
 void ARUPDATER_DownloadInformation_Delete(ARUPDATER_DownloadInformation_t **downloadInfo)
 {
     ARUPDATER_DownloadInformation_t *downloadInfoPtr = NULL;
@@ -154,6 +220,13 @@ void ARUPDATER_DownloadInformation_Delete(ARUPDATER_DownloadInformation_t **down
                 downloadInfoPtr->plfVersion = NULL;
             }
             
+            free(downloadInfoPtr->hashAlgorithm);
+            downloadInfoPtr->hashAlgorithm = NULL;
+            free(downloadInfoPtr->hashExpected);
+            downloadInfoPtr->hashExpected = NULL;
+            free(downloadInfoPtr->manifestUrl);
+            downloadInfoPtr->manifestUrl = NULL;
+            
             free (downloadInfoPtr);
             downloadInfoPtr = NULL;
         }
@@ -43,7 +43,24 @@
 #include <libARUpdater/ARUPDATER_Downloader.h>
 
 
-ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *const downloadUrl, const char *const md5Expected, const char *const plfVersion, int remoteSize, const eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error);
+ARUPDATER_DownloadInformation_t* ARUPDATER_DownloadInformation_New(const char *const downloadUrl, const char *const md5Expected, const char *const plfVersion, int64_t remoteSize, const eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Set the hash advertised by the server for the plf file
+ * @param downloadInfo : the download information
+ * @param[in] hashAlgorithm : the name of the algorithm
+ * @param[in] hashExpected : the expected digest as an hexadecimal string
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_DownloadInformation_SetHash(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const hashAlgorithm, const char *const hashExpected);
+
+/**
+ * @brief Set the url of the chunk manifest of the plf file
+ * @param downloadInfo : the download information
+ * @param[in] manifestUrl : the url of the manifest
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_DownloadInformation_SetManifestUrl(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const manifestUrl);
 
 void ARUPDATER_DownloadInformation_Delete(ARUPDATER_DownloadInformation_t **downloadInfo);
 
@@ -37,7 +37,10 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <libARSAL/ARSAL_Print.h>
 #include <libARSAL/ARSAL_Error.h>
@@ -45,6 +48,15 @@
 #include "ARUPDATER_Manager.h"
 #include "ARUPDATER_Downloader.h"
 #include "ARUPDATER_Utils.h"
+#include "ARUPDATER_PlfStore.h"
+#include "ARUPDATER_Versions.h"
+#include "ARUPDATER_Hash.h"
+#include "ARUPDATER_HashCache.h"
+#include "ARUPDATER_Manifest.h"
+#include "ARUPDATER_FileIO.h"
+#include "ARUPDATER_Pipeline.h"
+#include "ARUPDATER_PlfPack.h"
+#include "ARUPDATER_Dir.h"
 
 /* ***************************************
  *
@@ -66,18 +78,25 @@
 #define ARUPDATER_DOWNLOADER_VERSION_SEPARATOR             "."
 #define ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_PREFIX        "tmp_"
 #define ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_SUFFIX        ".tmp"
+#define ARUPDATER_DOWNLOADER_MANIFEST_SUFFIX               ".manifest"
 #define ARUPDATER_DOWNLOADER_SERIAL_DEFAULT_VALUE          "0000"
 
 #define ARUPDATER_DOWNLOADER_PHP_ERROR_OK                       "0"
 #define ARUPDATER_DOWNLOADER_PHP_ERROR_UPDATE                   "5"
 #define ARUPDATER_DOWNLOADER_PHP_ERROR_APP_VERSION_OUT_TO_DATE  "3"
 
-#define ARUPDATER_DOWNLOADER_CHUNK_SIZE                    255
 #define ARUPDATER_DOWNLOADER_MD5_TXT_SIZE                  32
 #define ARUPDATER_DOWNLOADER_MD5_HEX_SIZE                  16
 
 #define ARUPDATER_DOWNLOADER_HTTP_HEADER                   "http://"
 
+#define ARUPDATER_DOWNLOADER_DEFAULT_PIPELINE_MEMORY       (8 * 1024 * 1024)
+
+#define ARUPDATER_DOWNLOADER_PHP_FIELD_SEPARATOR           "|"
+#define ARUPDATER_DOWNLOADER_PHP_HASH_FIELD                "hash="
+#define ARUPDATER_DOWNLOADER_PHP_MANIFEST_FIELD            "manifest="
+#define ARUPDATER_DOWNLOADER_PHP_BLACKLIST_FIELD           "blacklist="
+
 #define ARUPDATER_DOWNLOADER_ANDROID_PLATFORM_NAME         "Android"
 #define ARUPDATER_DOWNLOADER_IOS_PLATFORM_NAME             "iOS"
 
@@ -155,6 +174,15 @@ eARUPDATER_ERROR ARUPDATER_Downloader_New(ARUPDATER_Manager_t* manager, const ch
         downloader->willDownloadPlfCallback = willDownloadPlfCallback;
         downloader->plfDownloadProgressCallback = progressCallback;
         downloader->plfDownloadCompletionCallback = completionCallback;
+        downloader->plfDownloadProgressBytesCallback = NULL;
+        downloader->progressBytesArg = NULL;
+        downloader->downloadTotalSize = 0;
+        downloader->lastProgressPercent = -1;
+        downloader->storeFolder = NULL;
+        downloader->maxRetainedVersions = 0;
+        downloader->maxRetainedBytes = 0;
+        downloader->pipelineMemory = ARUPDATER_DOWNLOADER_DEFAULT_PIPELINE_MEMORY;
+        memset(&downloader->pipelineStats, 0, sizeof(downloader->pipelineStats));
 
         downloader->isRunning = 0;
         downloader->isCanceled = 0;
@@ -163,6 +191,8 @@ eARUPDATER_ERROR ARUPDATER_Downloader_New(ARUPDATER_Manager_t* manager, const ch
         downloader->requestConnection = NULL;
         downloader->downloadConnection = NULL;
 
+        downloader->dir = ARUPDATER_Dir_New(downloader->rootFolder, &err);
+
         downloader->downloadInfos = malloc(sizeof(ARUPDATER_DownloadInformation_t*) * ARDISCOVERY_PRODUCT_MAX);
         if (downloader->downloadInfos == NULL)
         {
@@ -245,10 +275,14 @@ eARUPDATER_ERROR ARUPDATER_Downloader_Delete(ARUPDATER_Manager_t *manager)
                 ARSAL_Mutex_Destroy(&manager->downloader->requestLock);
                 ARSAL_Mutex_Destroy(&manager->downloader->downloadLock);
 
+                ARUPDATER_Dir_Delete(&manager->downloader->dir);
+
                 free(manager->downloader->rootFolder);
 
                 free(manager->downloader->appVersion);
 
+                free(manager->downloader->storeFolder);
+
                 int product = 0;
                 for (product = 0; product < ARDISCOVERY_PRODUCT_MAX; product++)
                 {
@@ -334,6 +368,163 @@ eARUPDATER_ERROR ARUPDATER_Downloader_SetUpdatesProductList(ARUPDATER_Manager_t
     return error;
 }
 
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfDownloadProgressBytesCallback(ARUPDATER_Manager_t *manager, ARUPDATER_Downloader_PlfDownloadProgressBytesCallback_t progressBytesCallback, void *progressBytesArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if (manager == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader->isRunning != 0))
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        manager->downloader->plfDownloadProgressBytesCallback = progressBytesCallback;
+        manager->downloader->progressBytesArg = progressBytesArg;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfStoreFolder(ARUPDATER_Manager_t *manager, const char *const storeFolder)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *storeFolderCopy = NULL;
+
+    if (manager == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader->isRunning != 0))
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+
+    if ((error == ARUPDATER_OK) && (storeFolder != NULL))
+    {
+        storeFolderCopy = strdup(storeFolder);
+        if (storeFolderCopy == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (storeFolderCopy != NULL))
+    {
+        mkdir(storeFolderCopy, S_IRWXU);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        free(manager->downloader->storeFolder);
+        manager->downloader->storeFolder = storeFolderCopy;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPlfRetention(ARUPDATER_Manager_t *manager, int maxVersions, int64_t maxBytes)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((manager == NULL) || (maxVersions < 0) || (maxBytes < 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader->isRunning != 0))
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        manager->downloader->maxRetainedVersions = maxVersions;
+        manager->downloader->maxRetainedBytes = maxBytes;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Downloader_SetPipelineMemory(ARUPDATER_Manager_t *manager, int64_t maxMemory)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((manager == NULL) || (maxMemory < 0) || ((maxMemory > 0) && (maxMemory < ARUPDATER_PIPELINE_MIN_MEMORY)))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader->isRunning != 0))
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        manager->downloader->pipelineMemory = maxMemory;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Downloader_GetPipelineStats(ARUPDATER_Manager_t *manager, ARUPDATER_Downloader_PipelineStats_t *stats)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((manager == NULL) || (stats == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (manager->downloader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&manager->downloader->downloadLock);
+        if (manager->downloader->downloadConnection != NULL)
+        {
+            error = ARUPDATER_Http_Connection_GetPipelineStats(manager->downloader->downloadConnection, stats);
+        }
+        else
+        {
+            *stats = manager->downloader->pipelineStats;
+        }
+        ARSAL_Mutex_Unlock(&manager->downloader->downloadLock);
+    }
+
+    return error;
+}
+
 int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDATER_ERROR *err)
 {
     eARUPDATER_ERROR error = ARUPDATER_OK;
@@ -357,18 +548,25 @@ int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDAT
     int edit;
     int ext;
     eARUTILS_ERROR utilsError = ARUTILS_OK;
-    char *device = NULL;
-    char *deviceFolder = NULL;
-    char *existingPlfFilePath = NULL;
+    char device[ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE];
+    int productFd = -1;
     uint32_t dataSize;
     char *dataPtr = NULL;
     char *data;
     ARSAL_Sem_t requestSem;
     char *platform = NULL;
 
-    char *plfFolder = malloc(strlen(manager->downloader->rootFolder) + strlen(ARUPDATER_MANAGER_PLF_FOLDER) + 1);
-    strcpy(plfFolder, manager->downloader->rootFolder);
-    strcat(plfFolder, ARUPDATER_MANAGER_PLF_FOLDER);
+    char *packPath = NULL;
+
+    // the pack is only read when the plf are stored in it
+    if ((error == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
+    {
+        packPath = ARUPDATER_Manager_GetPlfPackPath(manager->downloader->rootFolder);
+        if (packPath == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
 
     if (error == ARUPDATER_OK)
     {
@@ -386,56 +584,70 @@ int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDAT
         eARDISCOVERY_PRODUCT product = manager->downloader->productList[productIndex];
         uint16_t productId = ARDISCOVERY_getProductID(product);
 
-        device = malloc(ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE);
         snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
         
-        // read the header of the plf file
-        deviceFolder = malloc(strlen(plfFolder) + strlen(device) + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) + 1);
-        strcpy(deviceFolder, plfFolder);
-        strcat(deviceFolder, device);
-        strcat(deviceFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
+        // the product folder receives the download, it is created if it does not exist
+        productFd = ARUPDATER_Dir_OpenProductFolder(manager->downloader->dir, productId, 1, &error);
 
+        // read the header of the plf file
         char *fileName = NULL;
-        error = ARUPDATER_Utils_GetPlfInFolder(deviceFolder, &fileName);
-        if (error == ARUPDATER_OK)
+        if (error != ARUPDATER_OK)
         {
-            // file path = deviceFolder + plfFilename + \0
-            existingPlfFilePath = malloc(strlen(deviceFolder) + strlen(fileName) + 1);
-            strcpy(existingPlfFilePath, deviceFolder);
-            strcat(existingPlfFilePath, fileName);
-
-            error = ARUPDATER_Utils_GetPlfVersion(existingPlfFilePath, &version, &edit, &ext);
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "the folder of %s can not be opened", device);
         }
-        // else if the file does not exist, force to download
-        else if (error == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND)
+        else if (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK)
         {
-            version = 0;
-            edit = 0;
-            ext = 0;
-            error = ARUPDATER_OK;
-
-            // also check that the directory exists
-            FILE *dir = fopen(plfFolder, "r");
-            if (dir == NULL)
+            // the version is given by the index of the pack, the product folder only holds the temporary files
+            ARUPDATER_PlfPack_Entry_t packEntry;
+            error = ARUPDATER_PlfPack_Find(packPath, productId, &packEntry);
+            if (error == ARUPDATER_OK)
             {
-                mkdir(plfFolder, S_IRWXU);
+                version = packEntry.version;
+                edit = packEntry.edition;
+                ext = packEntry.extension;
             }
-            else
+            // a corrupted pack is replaced when the remote plf is added
+            else if (error == ARUPDATER_ERROR_PLF_BAD_PACK)
             {
-                fclose(dir);
+                ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "%s is not a valid pack", packPath);
+                version = 0;
+                edit = 0;
+                ext = 0;
+                error = ARUPDATER_OK;
             }
+        }
+        else
+        {
+            error = ARUPDATER_Utils_GetPlfInFolderAt(productFd, &fileName);
+        }
+        if ((error == ARUPDATER_OK) && (fileName != NULL))
+        {
+            error = ARUPDATER_Utils_GetPlfVersionAt(productFd, fileName, &version, &edit, &ext);
 
-            dir = fopen(deviceFolder, "r");
-            if (dir == NULL)
-            {
-                mkdir(deviceFolder, S_IRWXU);
-            }
-            else
+            // a corrupted plf is replaced by the remote one
+            if (error == ARUPDATER_ERROR_PLF_BAD_HEADER)
             {
-                fclose(dir);
+                ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "%s of %s is not a valid plf", fileName, device);
+                version = 0;
+                edit = 0;
+                ext = 0;
+                error = ARUPDATER_OK;
             }
         }
+        // else if the file does not exist, force to download
+        else if (error == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND)
+        {
+            version = 0;
+            edit = 0;
+            ext = 0;
+            error = ARUPDATER_OK;
+        }
 
+        if (productFd >= 0)
+        {
+            close(productFd);
+            productFd = -1;
+        }
         free(fileName);
 
         // init the request semaphore
@@ -542,18 +754,39 @@ int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDAT
             // if this plf is not up to date
             if(strcmp(result, ARUPDATER_DOWNLOADER_PHP_ERROR_UPDATE) == 0)
             {
-                nbUpdatesToDownload++;
                 char *downloadUrl = strtok(NULL, "|");
                 char *remoteMD5 = strtok(NULL, "|");
                 char *remoteSizeStr = strtok(NULL, "|");
-                int remoteSize = 0;
-                if (remoteSizeStr != NULL)
+                int64_t remoteSize = 0;
+                if ((remoteSizeStr != NULL) && (ARUPDATER_Utils_ParseSize(remoteSizeStr, &remoteSize) != ARUPDATER_OK))
                 {
-                    remoteSize = atoi(remoteSizeStr);
+                    error = ARUPDATER_ERROR_DOWNLOADER_PHP_ERROR;
                 }
                 char *remoteVersion = strtok(NULL, "|");
+                ARUPDATER_DownloadInformation_t *downloadInfo = NULL;
+                if (error == ARUPDATER_OK)
+                {
+                    downloadInfo = ARUPDATER_DownloadInformation_New(downloadUrl, remoteMD5, remoteVersion, remoteSize, product, &error);
+                }
+
+                // the optional key=value fields
+                char *field = NULL;
+                while ((field = strtok(NULL, ARUPDATER_DOWNLOADER_PHP_FIELD_SEPARATOR)) != NULL)
+                {
+                    ARUPDATER_Downloader_ParseExtraField(manager, product, downloadInfo, field);
+                }
 
-                manager->downloader->downloadInfos[product] = ARUPDATER_DownloadInformation_New(downloadUrl, remoteMD5, remoteVersion, remoteSize, product, &error);
+                // do not spend bandwidth on a blacklisted plf
+                if ((error == ARUPDATER_OK) && ARUPDATER_Downloader_VersionIsBlacklisted(manager, product, remoteVersion))
+                {
+                    ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "%s is blacklisted, not downloaded", remoteVersion);
+                    ARUPDATER_DownloadInformation_Delete(&downloadInfo);
+                }
+                else if (error == ARUPDATER_OK)
+                {
+                    nbUpdatesToDownload++;
+                }
+                manager->downloader->downloadInfos[product] = downloadInfo;
             }
             else if(strcmp(result, ARUPDATER_DOWNLOADER_PHP_ERROR_OK) == 0)
             {
@@ -569,21 +802,6 @@ int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDAT
             }
         }
 
-        if (deviceFolder != NULL)
-        {
-            free(deviceFolder);
-            deviceFolder = NULL;
-        }
-        if (existingPlfFilePath != NULL)
-        {
-            free(existingPlfFilePath);
-            existingPlfFilePath = NULL;
-        }
-        if (device != NULL)
-        {
-            free(device);
-            device = NULL;
-        }
         if (dataPtr != NULL)
         {
             free(dataPtr);
@@ -593,8 +811,8 @@ int ARUPDATER_Downloader_CheckUpdatesSync(ARUPDATER_Manager_t *manager, eARUPDAT
         productIndex++;
     }
 
-    free(plfFolder);
-    plfFolder = NULL;
+    free(packPath);
+    packPath = NULL;
 
     if (err != NULL)
     {
@@ -681,17 +899,53 @@ void* ARUPDATER_Downloader_ThreadRun(void *managerArg)
     }
 
 
+    // fail before using any bandwidth if all the plf files can not be stored
+    if ((ARUPDATER_OK == error) && shouldDownload != 0)
+    {
+        int64_t requiredSize = 0;
+        int productIndex = 0;
+        for (productIndex = 0; productIndex < manager->downloader->productCount; productIndex++)
+        {
+            ARUPDATER_DownloadInformation_t *downloadInfo = manager->downloader->downloadInfos[manager->downloader->productList[productIndex]];
+            // the plf files already in the store will not be downloaded
+            if ((downloadInfo != NULL) && (downloadInfo->remoteSize > 0) &&
+                ((manager->downloader->storeFolder == NULL) || !ARUPDATER_PlfStore_Exists(manager->downloader->storeFolder, downloadInfo->md5Expected)))
+            {
+                // saturate instead of wrapping around
+                if (requiredSize > INT64_MAX - downloadInfo->remoteSize)
+                {
+                    requiredSize = INT64_MAX;
+                }
+                else
+                {
+                    requiredSize += downloadInfo->remoteSize;
+                }
+            }
+        }
+
+        error = ARUPDATER_Utils_CheckFreeSpace(manager->downloader->rootFolder, requiredSize);
+    }
+
     if ((ARUPDATER_OK == error) && shouldDownload != 0)
     {
-        eARUTILS_ERROR utilsError = ARUTILS_OK;
-        char *device = NULL;
         char *deviceFolder = NULL;
-        char *existingPlfFilePath = NULL;
-        ARSAL_Sem_t dlSem;
+        char *existingPlfFileName = NULL;
+        char *packPath = NULL;
+        char *hashCachePath = NULL;
 
-        char *plfFolder = malloc(strlen(manager->downloader->rootFolder) + strlen(ARUPDATER_MANAGER_PLF_FOLDER) + 1);
-        strcpy(plfFolder, manager->downloader->rootFolder);
-        strcat(plfFolder, ARUPDATER_MANAGER_PLF_FOLDER);
+        // the pack or the hash cache is shared by all the products
+        if (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK)
+        {
+            packPath = ARUPDATER_Manager_GetPlfPackPath(manager->downloader->rootFolder);
+        }
+        else
+        {
+            hashCachePath = ARUPDATER_Utils_BuildPath(manager->downloader->rootFolder, ARUPDATER_MANAGER_PLF_FOLDER, ARUPDATER_HASH_CACHE_FILE_NAME, NULL);
+        }
+        if ((packPath == NULL) && (hashCachePath == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
 
         int productIndex = 0;
         while ((error == ARUPDATER_OK) && (productIndex < manager->downloader->productCount) && (manager->downloader->isCanceled == 0))
@@ -700,15 +954,23 @@ void* ARUPDATER_Downloader_ThreadRun(void *managerArg)
             eARDISCOVERY_PRODUCT product = manager->downloader->productList[productIndex];
             uint16_t productId = ARDISCOVERY_getProductID(product);
 
-            device = malloc(ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE);
-            snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
-
-            deviceFolder = malloc(strlen(plfFolder) + strlen(device) + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) + 1);
-            strcpy(deviceFolder, plfFolder);
-            strcat(deviceFolder, device);
-            strcat(deviceFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
+            // the versions and the other stores of the product still take paths
+            deviceFolder = ARUPDATER_Manager_GetProductFolderPath(manager->downloader->rootFolder, productId);
+            if (deviceFolder == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+                break;
+            }
 
             ARUPDATER_DownloadInformation_t *downloadInfo = manager->downloader->downloadInfos[product];
+
+            // the blacklist may have been updated since the check
+            if ((downloadInfo != NULL) && ARUPDATER_Downloader_VersionIsBlacklisted(manager, product, downloadInfo->plfVersion))
+            {
+                ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "%s is blacklisted, not downloaded", downloadInfo->plfVersion);
+                downloadInfo = NULL;
+            }
+
             if (downloadInfo != NULL)
             {
                 const char *const downloadUrl = downloadInfo->downloadUrl;
@@ -720,115 +982,216 @@ void* ARUPDATER_Downloader_ThreadRun(void *managerArg)
                     manager->downloader->willDownloadPlfCallback(manager->downloader->completionArg, product, remoteVersion);
                 }
 
-                char *downloadEndUrl;
-                char *downloadServer;
                 char *downloadedFileName = strrchr(downloadUrl, ARUPDATER_MANAGER_FOLDER_SEPARATOR[0]);
                 if(downloadedFileName != NULL && strlen(downloadedFileName) > 0)
                 {
                     downloadedFileName = &downloadedFileName[1];
                 }
 
-                char *downloadedFilePath = malloc(strlen(deviceFolder) + strlen(ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_PREFIX) + strlen(downloadedFileName) + strlen(ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_SUFFIX) + 1);
-                strcpy(downloadedFilePath, deviceFolder);
-                strcat(downloadedFilePath, ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_PREFIX);
-                strcat(downloadedFilePath, downloadedFileName);
-                strcat(downloadedFilePath, ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_SUFFIX);
+                // the files of the product are handled from its folder, the paths are kept for the store, the manifest and the hashes
+                char *downloadedTempFileName = NULL;
+                char *downloadedFilePath = NULL;
+                char *downloadedFinalFilePath = NULL;
+                int productFd = -1;
+
+                if (downloadedFileName == NULL)
+                {
+                    error = ARUPDATER_ERROR_DOWNLOADER_PHP_ERROR;
+                }
+                else
+                {
+                    downloadedTempFileName = ARUPDATER_Utils_BuildPath(ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_PREFIX, downloadedFileName, ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_SUFFIX, NULL);
+                    downloadedFilePath = ARUPDATER_Utils_BuildPath(deviceFolder, ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_PREFIX, downloadedFileName, ARUPDATER_DOWNLOADER_DOWNLOADED_FILE_SUFFIX, NULL);
+                    downloadedFinalFilePath = ARUPDATER_Utils_BuildPath(deviceFolder, downloadedFileName, NULL);
+                    if ((downloadedTempFileName == NULL) || (downloadedFilePath == NULL) || (downloadedFinalFilePath == NULL))
+                    {
+                        error = ARUPDATER_ERROR_ALLOC;
+                    }
+                }
+
+                if (error == ARUPDATER_OK)
+                {
+                    productFd = ARUPDATER_Dir_OpenProductFolder(manager->downloader->dir, productId, 1, &error);
+                }
 
-                char *downloadedFinalFilePath = malloc(strlen(deviceFolder) + strlen(downloadedFileName) + 1);
-                strcpy(downloadedFinalFilePath, deviceFolder);
-                strcat(downloadedFinalFilePath, downloadedFileName);
+                ARUPDATER_FileIO_t *downloadedFile = NULL;
+                int64_t downloadedSize = 0;
+                int isFromStore = 0;
+                ARUPDATER_Manifest_t *manifest = NULL;
+                ARUPDATER_Manifest_Verifier_t verifier;
 
-                // explode the download url into server and endUrl
+                // only plain http urls are given by the server
                 if (strncmp(downloadUrl, ARUPDATER_DOWNLOADER_HTTP_HEADER, strlen(ARUPDATER_DOWNLOADER_HTTP_HEADER)) != 0)
                 {
                     error = ARUPDATER_ERROR_DOWNLOADER_PHP_ERROR;
                 }
 
-                // construct the url
-                if (error == ARUPDATER_OK)
+                // the same plf may already have been downloaded for another product or by another manager
+                if ((error == ARUPDATER_OK) && (manager->downloader->storeFolder != NULL) && ARUPDATER_PlfStore_Contains(manager->downloader->storeFolder, remoteMD5))
                 {
-                    const char *const urlWithoutHttpHeader = downloadUrl + strlen(ARUPDATER_DOWNLOADER_HTTP_HEADER);
-                    const char delimiter = '/';
-
-                    downloadEndUrl = strchr(urlWithoutHttpHeader, delimiter);
-                    int serverLength = strlen(urlWithoutHttpHeader) - strlen(downloadEndUrl);
-                    downloadServer = malloc(serverLength + 1);
-                    strncpy(downloadServer, urlWithoutHttpHeader, serverLength);
-                    downloadServer[serverLength] = '\0';
+                    unlinkat(productFd, downloadedTempFileName, 0);
+                    if (ARUPDATER_PlfStore_LinkTo(manager->downloader->storeFolder, remoteMD5, downloadedFilePath) == ARUPDATER_OK)
+                    {
+                        ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_DOWNLOADER_TAG, "%s taken from the store", downloadedFileName);
+                        isFromStore = 1;
+                    }
+                }
+
+                // create the temporary file with all its blocks reserved, written by the backend measured as the fastest on this storage
+                if ((error == ARUPDATER_OK) && (isFromStore == 0))
+                {
+                    ARUPDATER_FileIO_SelectBackend(deviceFolder);
+                    downloadedFile = ARUPDATER_FileIO_NewAt(productFd, downloadedTempFileName, ARUPDATER_FILEIO_MODE_WRITE, ARUPDATER_FILEIO_BACKEND_DEFAULT, &error);
+                }
+
+                if ((error == ARUPDATER_OK) && (isFromStore == 0))
+                {
+                    error = ARUPDATER_Utils_PreallocateFile(ARUPDATER_FileIO_GetFd(downloadedFile), downloadInfo->remoteSize);
                 }
 
                 ARSAL_Mutex_Lock(&manager->downloader->downloadLock);
-                // init the request semaphore
-                if (error == ARUPDATER_OK)
+                if ((error == ARUPDATER_OK) && (isFromStore == 0))
+                {
+                    manager->downloader->downloadConnection = ARUPDATER_Http_Connection_New(&error);
+                }
+                ARSAL_Mutex_Unlock(&manager->downloader->downloadLock);
+
+                // with a chunk manifest, the chunks are checked as they land and only the corrupted ones are fetched again
+                if ((error == ARUPDATER_OK) && (isFromStore == 0) && (downloadInfo->manifestUrl != NULL) && (manager->downloader->isCanceled == 0))
                 {
-                    int resultSys = ARSAL_Sem_Init(&dlSem, 0, 0);
-                    if (resultSys != 0)
+                    manifest = ARUPDATER_Downloader_GetManifest(manager, downloadInfo, downloadedFilePath);
+                    if ((manifest != NULL) && (ARUPDATER_Manifest_Verifier_Init(&verifier, manifest) == ARUPDATER_OK))
+                    {
+                        ARUPDATER_Http_Connection_SetDataCallback(manager->downloader->downloadConnection, ARUPDATER_Manifest_Verifier_DataCallback, &verifier);
+                    }
+                    else
                     {
-                        error = ARUPDATER_ERROR_SYSTEM;
+                        ARUPDATER_Manifest_Delete(&manifest);
                     }
                 }
 
-                if (error == ARUPDATER_OK)
+                // download the file
+                if ((error == ARUPDATER_OK) && (isFromStore == 0) && (manager->downloader->isCanceled == 0))
                 {
-                    manager->downloader->downloadConnection = ARUTILS_Http_Connection_New(&dlSem, downloadServer, 80, HTTPS_PROTOCOL_FALSE, NULL, NULL, &utilsError);
-                    if (utilsError != ARUTILS_OK)
+                    manager->downloader->downloadTotalSize = downloadInfo->remoteSize;
+                    manager->downloader->lastProgressPercent = -1;
+                    // only the plf is worth a writing thread, the manifest was written by the network thread
+                    ARUPDATER_Http_Connection_SetPipelineMemory(manager->downloader->downloadConnection, manager->downloader->pipelineMemory);
+                    error = ARUPDATER_Http_GetToFile(manager->downloader->downloadConnection, downloadUrl, downloadedFile, &downloadedSize, ARUPDATER_Downloader_ProgressCallback, manager);
+                    ARUPDATER_Http_Connection_SetDataCallback(manager->downloader->downloadConnection, NULL, NULL);
+
+                    // an interrupted transfer is completed chunk by chunk
+                    if ((error == ARUPDATER_ERROR_DOWNLOADER_DOWNLOAD) && (manifest != NULL) && (manager->downloader->isCanceled == 0))
                     {
-                        ARUTILS_Http_Connection_Delete(&manager->downloader->downloadConnection);
-                        manager->downloader->downloadConnection = NULL;
-                        ARSAL_Sem_Destroy(&dlSem);
-                        error = ARUPDATER_ERROR_DOWNLOADER_ARUTILS_ERROR;
+                        error = ARUPDATER_OK;
                     }
                 }
-                ARSAL_Mutex_Unlock(&manager->downloader->downloadLock);
 
-                // download the file
-                if ((error == ARUPDATER_OK) && (manager->downloader->isCanceled == 0))
+                // drop the reserved blocks the server did not send
+                if ((error == ARUPDATER_OK) && (isFromStore == 0))
+                {
+                    error = ARUPDATER_FileIO_Truncate(downloadedFile, downloadedSize);
+                }
+
+                ARUPDATER_FileIO_Delete(&downloadedFile);
+
+                // fetch again the chunks found corrupted or missing during the transfer
+                if ((error == ARUPDATER_OK) && (manifest != NULL) && (ARUPDATER_Manifest_Verifier_Finish(&verifier) > 0))
+                {
+                    error = ARUPDATER_Manifest_Repair(manifest, manager->downloader->downloadConnection, downloadUrl, downloadedFilePath, verifier.isBad);
+                }
+
+                if ((error != ARUPDATER_OK) && (productFd >= 0))
+                {
+                    unlinkat(productFd, downloadedTempFileName, 0);
+                }
+
+                // check the hash advertised by the server (md5 if none), the stored files have already been checked
+                if ((error == ARUPDATER_OK) && (isFromStore == 0))
                 {
-                    utilsError = ARUTILS_Http_Get(manager->downloader->downloadConnection, downloadEndUrl, downloadedFilePath, manager->downloader->plfDownloadProgressCallback, manager->downloader->progressArg);
-                    if (utilsError != ARUTILS_OK)
+                    error = ARUPDATER_Downloader_CheckDownloadedFile(downloadInfo, downloadedFilePath);
+
+                    // the file may have been corrupted once written, check all its chunks
+                    if ((error != ARUPDATER_OK) && (manifest != NULL) && (manager->downloader->isCanceled == 0) &&
+                        (ARUPDATER_Manifest_Repair(manifest, manager->downloader->downloadConnection, downloadUrl, downloadedFilePath, NULL) == ARUPDATER_OK))
                     {
-                        error = ARUPDATER_ERROR_DOWNLOADER_ARUTILS_ERROR;
+                        error = ARUPDATER_Downloader_CheckDownloadedFile(downloadInfo, downloadedFilePath);
+                    }
+
+                    if (error != ARUPDATER_OK)
+                    {
+                        // delete the downloaded file if the hash does not match
+                        unlinkat(productFd, downloadedTempFileName, 0);
+                        error = ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH;
                     }
                 }
 
                 ARSAL_Mutex_Lock(&manager->downloader->downloadLock);
                 if (manager->downloader->downloadConnection != NULL)
                 {
-                    ARUTILS_Http_Connection_Delete(&manager->downloader->downloadConnection);
-                    manager->downloader->downloadConnection = NULL;
-                    ARSAL_Sem_Destroy(&dlSem);
+                    ARUPDATER_Http_Connection_GetPipelineStats(manager->downloader->downloadConnection, &manager->downloader->pipelineStats);
+                    ARUPDATER_Http_Connection_Delete(&manager->downloader->downloadConnection);
                 }
                 ARSAL_Mutex_Unlock(&manager->downloader->downloadLock);
 
-                // check md5 match
-                if (error == ARUPDATER_OK)
+                if (manifest != NULL)
+                {
+                    ARUPDATER_Manifest_Verifier_Clear(&verifier);
+                    ARUPDATER_Manifest_Delete(&manifest);
+                }
+
+                // share the verified file, the download is still valid if the store can not be written
+                if ((error == ARUPDATER_OK) && (isFromStore == 0) && (manager->downloader->storeFolder != NULL))
                 {
-                    eARSAL_ERROR arsalError = ARSAL_MD5_Manager_Check(manager->downloader->md5Manager, downloadedFilePath, remoteMD5);
-                    if(ARSAL_OK != arsalError)
+                    eARUPDATER_ERROR storeError = ARUPDATER_PlfStore_Insert(manager->downloader->storeFolder, remoteMD5, downloadedFilePath);
+                    if (storeError != ARUPDATER_OK)
                     {
-                        // delete the downloaded file if md5 don't match
-                        unlink(downloadedFilePath);
-                        error = ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH;
+                        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "could not store %s: %s", downloadedFileName, ARUPDATER_Error_ToString(storeError));
                     }
                 }
 
-                if (error == ARUPDATER_OK)
+                if ((error == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
+                {
+                    // the pack keeps the previous plf as a previous version (or deletes it), the temporary file is not needed anymore
+                    error = ARUPDATER_PlfPack_Add(packPath, productId, downloadedFilePath, downloadedFileName, remoteMD5, manager->downloader->maxRetainedVersions, manager->downloader->maxRetainedBytes);
+                    unlinkat(productFd, downloadedTempFileName, 0);
+                }
+                else if (error == ARUPDATER_OK)
                 {
-                    // if the existingPlfFilePath was set, a plf was in the folder, so delete it before renaming the file
-                    if (existingPlfFilePath != NULL)
+                    // if a plf is in the folder, keep it as a previous version (or delete it) before renaming the file
+                    if (ARUPDATER_Utils_GetPlfInFolderAt(productFd, &existingPlfFileName) == ARUPDATER_OK)
                     {
-                        unlink(existingPlfFilePath);
+                        eARUPDATER_ERROR retainError = ARUPDATER_Versions_Retain(deviceFolder, existingPlfFileName, manager->downloader->maxRetainedVersions, manager->downloader->maxRetainedBytes);
+                        if (retainError != ARUPDATER_OK)
+                        {
+                            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_DOWNLOADER_TAG, "the previous plf %s has not been retained: %s", existingPlfFileName, ARUPDATER_Error_ToString(retainError));
+                        }
                     }
-                    if (rename(downloadedFilePath, downloadedFinalFilePath) != 0)
+                    if (renameat(productFd, downloadedTempFileName, productFd, downloadedFileName) != 0)
                     {
                         error = ARUPDATER_ERROR_DOWNLOADER_RENAME_FILE;
                     }
                 }
 
-                if (downloadServer != NULL)
+                // the file has just been verified, the uploaders will not have to hash it again
+                if ((error == ARUPDATER_OK) && (hashCachePath != NULL))
+                {
+                    // when an other hash has been checked, the md5 is the one given by the server for this same content
+                    ARUPDATER_HashCache_Store(hashCachePath, ARUPDATER_HASH_MD5, downloadedFinalFilePath, remoteMD5);
+                    if ((ARUPDATER_Hash_FromName(downloadInfo->hashAlgorithm) != ARUPDATER_HASH_MAX) && (downloadInfo->hashExpected != NULL))
+                    {
+                        ARUPDATER_HashCache_Store(hashCachePath, ARUPDATER_Hash_FromName(downloadInfo->hashAlgorithm), downloadedFinalFilePath, downloadInfo->hashExpected);
+                    }
+                }
+
+                if (productFd >= 0)
+                {
+                    close(productFd);
+                }
+                if (downloadedTempFileName != NULL)
                 {
-                    free(downloadServer);
-                    downloadServer = NULL;
+                    free(downloadedTempFileName);
+                    downloadedTempFileName = NULL;
                 }
                 if (downloadedFilePath != NULL)
                 {
@@ -847,24 +1210,24 @@ void* ARUPDATER_Downloader_ThreadRun(void *managerArg)
                 free(deviceFolder);
                 deviceFolder = NULL;
             }
-            if (existingPlfFilePath != NULL)
-            {
-                free(existingPlfFilePath);
-                existingPlfFilePath = NULL;
-            }
-            if (device != NULL)
+            if (existingPlfFileName != NULL)
             {
-                free(device);
-                device = NULL;
+                free(existingPlfFileName);
+                existingPlfFileName = NULL;
             }
 
             productIndex++;
         }
 
-        if (plfFolder != NULL)
+        if (packPath != NULL)
         {
-            free(plfFolder);
-            plfFolder = NULL;
+            free(packPath);
+            packPath = NULL;
+        }
+        if (hashCachePath != NULL)
+        {
+            free(hashCachePath);
+            hashCachePath = NULL;
         }
     }
 
@@ -932,7 +1295,7 @@ eARUPDATER_ERROR ARUPDATER_Downloader_CancelThread(ARUPDATER_Manager_t *manager)
         ARSAL_Mutex_Lock(&manager->downloader->downloadLock);
         if (manager->downloader->downloadConnection != NULL)
         {
-            ARUTILS_Http_Connection_Cancel(manager->downloader->downloadConnection);
+            ARUPDATER_Http_Connection_Cancel(manager->downloader->downloadConnection);
         }
         ARSAL_Mutex_Unlock(&manager->downloader->downloadLock);
 
@@ -973,6 +1336,168 @@ int ARUPDATER_Downloader_ThreadIsRunning(ARUPDATER_Manager_t* manager, eARUPDATE
     return isRunning;
 }
 
+void ARUPDATER_Downloader_ProgressCallback(void* arg, int64_t downloadedSize, int64_t totalSize)
+{
+    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)arg;
+    ARUPDATER_Downloader_t *downloader = manager->downloader;
+
+    // the server may not give the size, fall back on the one announced by the update check
+    if (totalSize <= 0)
+    {
+        totalSize = downloader->downloadTotalSize;
+    }
+
+    if (downloader->plfDownloadProgressBytesCallback != NULL)
+    {
+        downloader->plfDownloadProgressBytesCallback(downloader->progressBytesArg, downloadedSize, totalSize);
+    }
+
+    if ((downloader->plfDownloadProgressCallback != NULL) && (totalSize > 0))
+    {
+        int percent = (int)(((double)downloadedSize * 100.0) / (double)totalSize);
+        if (percent > 100)
+        {
+            percent = 100;
+        }
+
+        // only notify integer steps, the callback may cross the JNI
+        if (percent != downloader->lastProgressPercent)
+        {
+            downloader->lastProgressPercent = percent;
+            downloader->plfDownloadProgressCallback(downloader->progressArg, (float)percent);
+        }
+    }
+}
+
+void ARUPDATER_Downloader_ParseExtraField(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, ARUPDATER_DownloadInformation_t *downloadInfo, const char *const field)
+{
+    if (strncmp(field, ARUPDATER_DOWNLOADER_PHP_BLACKLIST_FIELD, strlen(ARUPDATER_DOWNLOADER_PHP_BLACKLIST_FIELD)) == 0)
+    {
+        eARUPDATER_ERROR error = ARUPDATER_Blacklist_AddVersionList(manager->blacklist, product, field + strlen(ARUPDATER_DOWNLOADER_PHP_BLACKLIST_FIELD));
+        if (error != ARUPDATER_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "bad blacklist from server: %s", ARUPDATER_Error_ToString(error));
+        }
+    }
+    else if ((downloadInfo != NULL) && (strncmp(field, ARUPDATER_DOWNLOADER_PHP_MANIFEST_FIELD, strlen(ARUPDATER_DOWNLOADER_PHP_MANIFEST_FIELD)) == 0))
+    {
+        ARUPDATER_DownloadInformation_SetManifestUrl(downloadInfo, field + strlen(ARUPDATER_DOWNLOADER_PHP_MANIFEST_FIELD));
+    }
+    else if ((downloadInfo != NULL) && (strncmp(field, ARUPDATER_DOWNLOADER_PHP_HASH_FIELD, strlen(ARUPDATER_DOWNLOADER_PHP_HASH_FIELD)) == 0))
+    {
+        // hash=<algorithm>:<hexadecimal digest>
+        const char *algorithm = field + strlen(ARUPDATER_DOWNLOADER_PHP_HASH_FIELD);
+        const char *colon = strchr(algorithm, ':');
+        char *algorithmName = (colon != NULL) ? strndup(algorithm, colon - algorithm) : NULL;
+
+        if ((algorithmName != NULL) && (ARUPDATER_Hash_FromName(algorithmName) != ARUPDATER_HASH_MAX))
+        {
+            ARUPDATER_DownloadInformation_SetHash(downloadInfo, algorithmName, colon + 1);
+        }
+        else
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "unsupported hash from server: %s", algorithm);
+        }
+
+        free(algorithmName);
+    }
+    // unknown fields are left for newer versions of the library
+}
+
+eARUPDATER_ERROR ARUPDATER_Downloader_CheckDownloadedFile(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const filePath)
+{
+    eARUPDATER_HASH hashAlgorithm = ARUPDATER_Hash_FromName(downloadInfo->hashAlgorithm);
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((hashAlgorithm != ARUPDATER_HASH_MAX) && (downloadInfo->hashExpected != NULL))
+    {
+        error = ARUPDATER_Hash_CheckFile(hashAlgorithm, filePath, downloadInfo->hashExpected);
+    }
+    else
+    {
+        error = ARUPDATER_Hash_CheckFile(ARUPDATER_HASH_MD5, filePath, downloadInfo->md5Expected);
+    }
+
+    return error;
+}
+
+ARUPDATER_Manifest_t *ARUPDATER_Downloader_GetManifest(ARUPDATER_Manager_t *manager, ARUPDATER_DownloadInformation_t *downloadInfo, const char *const downloadedFilePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Manifest_t *manifest = NULL;
+    uint8_t root[ARUPDATER_SHA256_DIGEST_SIZE];
+    char rootHex[ARUPDATER_SHA256_DIGEST_SIZE * 2 + 1];
+    char *manifestPath = ARUPDATER_Utils_BuildPath(downloadedFilePath, ARUPDATER_DOWNLOADER_MANIFEST_SUFFIX, NULL);
+    ARUPDATER_FileIO_t *manifestFile = NULL;
+
+    if (manifestPath == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        manifestFile = ARUPDATER_FileIO_New(manifestPath, ARUPDATER_FILEIO_MODE_WRITE, ARUPDATER_FILEIO_BACKEND_DEFAULT, &error);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Http_GetToFile(manager->downloader->downloadConnection, downloadInfo->manifestUrl, manifestFile, NULL, NULL, NULL);
+    }
+
+    ARUPDATER_FileIO_Delete(&manifestFile);
+
+    if (error == ARUPDATER_OK)
+    {
+        manifest = ARUPDATER_Manifest_New(manifestPath, &error);
+    }
+
+    // the manifest must describe the advertised file
+    if ((error == ARUPDATER_OK) && (downloadInfo->remoteSize > 0) && (manifest->fileSize != downloadInfo->remoteSize))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    // with a sha256tree hash, the chunk digests are its leaves
+    if ((error == ARUPDATER_OK) && (manifest->chunkSize == ARUPDATER_HASH_TREE_CHUNK_SIZE) &&
+        (ARUPDATER_Hash_FromName(downloadInfo->hashAlgorithm) == ARUPDATER_HASH_SHA256_TREE) && (downloadInfo->hashExpected != NULL))
+    {
+        ARUPDATER_Manifest_GetRoot(manifest, root);
+        ARUPDATER_Hash_ToHex(root, sizeof(root), rootHex);
+        if (strcasecmp(rootHex, downloadInfo->hashExpected) != 0)
+        {
+            error = ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH;
+        }
+    }
+
+    if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "manifest %s not used: %s", downloadInfo->manifestUrl, ARUPDATER_Error_ToString(error));
+        ARUPDATER_Manifest_Delete(&manifest);
+    }
+
+    if (manifestPath != NULL)
+    {
+        unlink(manifestPath);
+        free(manifestPath);
+    }
+
+    return manifest;
+}
+
+int ARUPDATER_Downloader_VersionIsBlacklisted(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, const char *const versionStr)
+{
+    int version, edition, extension;
+    int isBlacklisted = 0;
+
+    if (ARUPDATER_Utils_ParseVersion(versionStr, &version, &edition, &extension) == ARUPDATER_OK)
+    {
+        isBlacklisted = ARUPDATER_Blacklist_Contains(manager->blacklist, product, version, edition, extension);
+    }
+
+    return isBlacklisted;
+}
+
 char *ARUPDATER_Downloader_GetPlatformName(eARUPDATER_Downloader_Platforms platform)
 {
     char *toReturn = NULL;
@@ -1143,17 +1668,39 @@ int ARUPDATER_Downloader_GetUpdatesInfoSync(ARUPDATER_Manager_t *manager, eARUPD
             // if this plf is not up to date
             if(strcmp(result, ARUPDATER_DOWNLOADER_PHP_ERROR_UPDATE) == 0)
             {
-                nbUpdatesToDownload++;
                 char *downloadUrl = strtok(NULL, "|");
                 char *remoteMD5 = strtok(NULL, "|");
                 char *remoteSizeStr = strtok(NULL, "|");
-                int remoteSize = 0;
-                if (remoteSizeStr != NULL)
+                int64_t remoteSize = 0;
+                if ((remoteSizeStr != NULL) && (ARUPDATER_Utils_ParseSize(remoteSizeStr, &remoteSize) != ARUPDATER_OK))
                 {
-                    remoteSize = atoi(remoteSizeStr);
+                    error = ARUPDATER_ERROR_DOWNLOADER_PHP_ERROR;
                 }
                 char *remoteVersion = strtok(NULL, "|");
-                manager->downloader->downloadInfos[productIndex] = ARUPDATER_DownloadInformation_New(downloadUrl, remoteMD5, remoteVersion, remoteSize, product, &error);
+                ARUPDATER_DownloadInformation_t *downloadInfo = NULL;
+                if (error == ARUPDATER_OK)
+                {
+                    downloadInfo = ARUPDATER_DownloadInformation_New(downloadUrl, remoteMD5, remoteVersion, remoteSize, product, &error);
+                }
+
+                // the optional key=value fields
+                char *field = NULL;
+                while ((field = strtok(NULL, ARUPDATER_DOWNLOADER_PHP_FIELD_SEPARATOR)) != NULL)
+                {
+                    ARUPDATER_Downloader_ParseExtraField(manager, product, downloadInfo, field);
+                }
+
+                // a blacklisted plf is not an update, the downloader would not fetch it
+                if ((error == ARUPDATER_OK) && ARUPDATER_Downloader_VersionIsBlacklisted(manager, product, remoteVersion))
+                {
+                    ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_DOWNLOADER_TAG, "%s is blacklisted, not downloaded", remoteVersion);
+                    ARUPDATER_DownloadInformation_Delete(&downloadInfo);
+                }
+                else if (error == ARUPDATER_OK)
+                {
+                    nbUpdatesToDownload++;
+                }
+                manager->downloader->downloadInfos[productIndex] = downloadInfo;
             }
             else if(strcmp(result, ARUPDATER_DOWNLOADER_PHP_ERROR_OK) == 0)
             {
@@ -43,10 +43,14 @@
 #include <libARUpdater/ARUPDATER_Downloader.h>
 #include <libARSAL/ARSAL_Mutex.h>
 #include "ARUPDATER_DownloadInformation.h"
+#include "ARUPDATER_Http.h"
+#include "ARUPDATER_Manifest.h"
+#include "ARUPDATER_Dir.h"
 
 struct ARUPDATER_Downloader_t
 {
     char *rootFolder;
+    ARUPDATER_Dir_t *dir; /**< the folders of rootFolder, opened once */
 
     eARUPDATER_Downloader_Platforms appPlatform;
     char *appVersion;
@@ -69,14 +73,32 @@ struct ARUPDATER_Downloader_t
     ARSAL_Mutex_t requestLock;
     ARSAL_Mutex_t downloadLock;
     ARUTILS_Http_Connection_t *requestConnection;
-    ARUTILS_Http_Connection_t *downloadConnection;
+    ARUPDATER_Http_Connection_t *downloadConnection;
 
     ARUPDATER_Downloader_ShouldDownloadPlfCallback_t shouldDownloadCallback;
     ARUPDATER_Downloader_WillDownloadPlfCallback_t willDownloadPlfCallback;
     ARUPDATER_Downloader_PlfDownloadProgressCallback_t plfDownloadProgressCallback;
     ARUPDATER_Downloader_PlfDownloadCompletionCallback_t plfDownloadCompletionCallback;
+
+    ARUPDATER_Downloader_PlfDownloadProgressBytesCallback_t plfDownloadProgressBytesCallback;
+    void *progressBytesArg;
+    int64_t downloadTotalSize;
+    int lastProgressPercent;
+
+    char *storeFolder;
+
+    int maxRetainedVersions;
+    int64_t maxRetainedBytes;
+
+    int64_t pipelineMemory;
+    ARUPDATER_Downloader_PipelineStats_t pipelineStats;
 };
 
 char *ARUPDATER_Downloader_GetPlatformName(eARUPDATER_Downloader_Platforms platform);
+void ARUPDATER_Downloader_ProgressCallback(void* arg, int64_t downloadedSize, int64_t totalSize);
+void ARUPDATER_Downloader_ParseExtraField(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, ARUPDATER_DownloadInformation_t *downloadInfo, const char *const field);
+int ARUPDATER_Downloader_VersionIsBlacklisted(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, const char *const versionStr);
+eARUPDATER_ERROR ARUPDATER_Downloader_CheckDownloadedFile(ARUPDATER_DownloadInformation_t *downloadInfo, const char *const filePath);
+ARUPDATER_Manifest_t *ARUPDATER_Downloader_GetManifest(ARUPDATER_Manager_t *manager, ARUPDATER_DownloadInformation_t *downloadInfo, const char *const downloadedFilePath);
 
 #endif
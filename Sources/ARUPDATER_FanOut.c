@@ -0,0 +1,1071 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_FanOut.c
+ * @brief libARUpdater FanOut c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <curl/curl.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include "ARUPDATER_Manager.h"
+
+#include "ARUPDATER_FanOut.h"
+#include "ARUPDATER_Uploader.h"
+#include "ARUPDATER_Utils.h"
+#include "ARUPDATER_PlfValidator.h"
+#include "ARUPDATER_PlfPack.h"
+#include "ARUPDATER_Hash.h"
+#include "ARUPDATER_Dir.h"
+#include "ARUPDATER_Http.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_FANOUT_TAG                    "ARUPDATER_FanOut"
+#define ARUPDATER_FANOUT_EXTRACTED_FILE_FORMAT  "extracted_fanout_%d_%p.tmp"
+#define ARUPDATER_FANOUT_EXTRACTED_FILE_SIZE    64
+
+#define ARUPDATER_FANOUT_URL_SIZE               512
+#define ARUPDATER_FANOUT_COMMAND_SIZE           512
+#define ARUPDATER_FANOUT_RANGE_SIZE             64
+#define ARUPDATER_FANOUT_CONNECT_TIMEOUT_SEC    10
+#define ARUPDATER_FANOUT_LOW_SPEED_LIMIT        1
+#define ARUPDATER_FANOUT_LOW_SPEED_TIME_SEC     30
+
+/**
+ * @brief Ftp session of a worker with a target
+ */
+typedef struct
+{
+    ARUPDATER_FanOut_t *fanOut;
+    int target;
+    CURL *curl;
+    
+    const uint8_t *data; /**< bytes sent by the read callback */
+    int64_t dataSize;
+    int64_t dataOffset;
+    int isSendingPlf;
+    int64_t resumeOffset; /**< size of the partial plf already on the target */
+    
+    char received[ARUPDATER_MD5_DIGEST_SIZE * 2 + 1]; /**< remote md5 */
+    size_t receivedSize;
+    
+    uint8_t *tail; /**< end of the partial plf read from the target */
+    int64_t tailSize;
+    int64_t tailCapacity;
+} ARUPDATER_FanOut_Session_t;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static size_t ARUPDATER_FanOut_ReadCallback(char *buffer, size_t size, size_t nitems, void *userData)
+{
+    ARUPDATER_FanOut_Session_t *session = (ARUPDATER_FanOut_Session_t *)userData;
+    size_t length = size * nitems;
+    
+    if (session->fanOut->isCanceled != 0)
+    {
+        return CURL_READFUNC_ABORT;
+    }
+    
+    if ((int64_t)length > session->dataSize - session->dataOffset)
+    {
+        length = (size_t)(session->dataSize - session->dataOffset);
+    }
+    memcpy(buffer, session->data + session->dataOffset, length);
+    session->dataOffset += length;
+    
+    return length;
+}
+
+static size_t ARUPDATER_FanOut_WriteCallback(void *ptr, size_t size, size_t nmemb, void *userData)
+{
+    ARUPDATER_FanOut_Session_t *session = (ARUPDATER_FanOut_Session_t *)userData;
+    size_t length = size * nmemb;
+    
+    // anything longer than a md5 is not the md5 of the plf
+    if (length > sizeof(session->received) - 1 - session->receivedSize)
+    {
+        return 0;
+    }
+    memcpy(session->received + session->receivedSize, ptr, length);
+    session->receivedSize += length;
+    session->received[session->receivedSize] = '\0';
+    
+    return length;
+}
+
+static size_t ARUPDATER_FanOut_TailCallback(void *ptr, size_t size, size_t nmemb, void *userData)
+{
+    ARUPDATER_FanOut_Session_t *session = (ARUPDATER_FanOut_Session_t *)userData;
+    size_t length = size * nmemb;
+    
+    // a server which ignores the range sends more than the checked part
+    if ((int64_t)length > session->tailCapacity - session->tailSize)
+    {
+        return 0;
+    }
+    memcpy(session->tail + session->tailSize, ptr, length);
+    session->tailSize += length;
+    
+    return length;
+}
+
+static size_t ARUPDATER_FanOut_DiscardCallback(void *ptr, size_t size, size_t nmemb, void *userData)
+{
+    // the size of a remote file is reported as a header
+    return size * nmemb;
+}
+
+static int ARUPDATER_FanOut_ProgressInternalCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    ARUPDATER_FanOut_Session_t *session = (ARUPDATER_FanOut_Session_t *)clientp;
+    ARUPDATER_FanOut_t *fanOut = session->fanOut;
+    int64_t sentSize = 0;
+    int64_t previousSize = 0;
+    
+    if (session->isSendingPlf)
+    {
+        sentSize = session->resumeOffset + (int64_t)ulnow;
+        
+        ARSAL_Mutex_Lock(&fanOut->statusLock);
+        previousSize = fanOut->targets[session->target].status.sentSize;
+        fanOut->targets[session->target].status.sentSize = sentSize;
+        ARSAL_Mutex_Unlock(&fanOut->statusLock);
+        
+        if ((fanOut->progressCallback != NULL) && (sentSize != previousSize) && (fanOut->plfSize > 0))
+        {
+            fanOut->progressCallback(fanOut->progressArg, session->target, (float)sentSize * 100.f / (float)fanOut->plfSize);
+        }
+    }
+    
+    // a non zero value aborts the transfer
+    return fanOut->isCanceled;
+}
+
+/**
+ * @brief Prepare the session for a command on a remote file of the target
+ */
+static void ARUPDATER_FanOut_SetOptions(ARUPDATER_FanOut_Session_t *session, const char *const remoteFileName, const char *const suffix)
+{
+    ARUPDATER_FanOut_Target_t *target = &session->fanOut->targets[session->target];
+    char url[ARUPDATER_FANOUT_URL_SIZE];
+    
+    snprintf(url, sizeof(url), "ftp://%s:%d%s%s%s", target->address, target->port, ARUPDATER_UPLOADER_REMOTE_FOLDER, remoteFileName, suffix);
+    
+    // the reset keeps the control connection opened by the previous command
+    curl_easy_reset(session->curl);
+    curl_easy_setopt(session->curl, CURLOPT_URL, url);
+    curl_easy_setopt(session->curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(session->curl, CURLOPT_CONNECTTIMEOUT, (long)ARUPDATER_FANOUT_CONNECT_TIMEOUT_SEC);
+    curl_easy_setopt(session->curl, CURLOPT_LOW_SPEED_LIMIT, (long)ARUPDATER_FANOUT_LOW_SPEED_LIMIT);
+    curl_easy_setopt(session->curl, CURLOPT_LOW_SPEED_TIME, (long)ARUPDATER_FANOUT_LOW_SPEED_TIME_SEC);
+    curl_easy_setopt(session->curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(session->curl, CURLOPT_XFERINFOFUNCTION, ARUPDATER_FanOut_ProgressInternalCallback);
+    curl_easy_setopt(session->curl, CURLOPT_XFERINFODATA, session);
+    if (target->username != NULL)
+    {
+        curl_easy_setopt(session->curl, CURLOPT_USERNAME, target->username);
+        curl_easy_setopt(session->curl, CURLOPT_PASSWORD, (target->password != NULL) ? target->password : "");
+    }
+}
+
+/**
+ * @brief Send bytes to a remote file of the target, appended to it if isAppended is set
+ */
+static CURLcode ARUPDATER_FanOut_Put(ARUPDATER_FanOut_Session_t *session, const uint8_t *data, int64_t size, int isAppended)
+{
+    session->data = data;
+    session->dataSize = size;
+    session->dataOffset = 0;
+    
+    curl_easy_setopt(session->curl, CURLOPT_UPLOAD, 1L);
+    curl_easy_setopt(session->curl, CURLOPT_APPEND, (long)isAppended);
+    curl_easy_setopt(session->curl, CURLOPT_READFUNCTION, ARUPDATER_FanOut_ReadCallback);
+    curl_easy_setopt(session->curl, CURLOPT_READDATA, session);
+    curl_easy_setopt(session->curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)size);
+    
+    return curl_easy_perform(session->curl);
+}
+
+/**
+ * @brief Get the size of a remote file of the target
+ * @param session : the session with the target
+ * @param[in] remoteFileName : name of the remote file
+ * @param[in] suffix : suffix of the name of the remote file
+ * @param[out] size : size of the remote file, -1 if it does not exist
+ * @return CURLE_OK if the size has been got or if the file does not exist, the curl error otherwise
+ */
+static CURLcode ARUPDATER_FanOut_Size(ARUPDATER_FanOut_Session_t *session, const char *const remoteFileName, const char *const suffix, curl_off_t *size)
+{
+    CURLcode code = CURLE_OK;
+    
+    *size = -1;
+    
+    // the size of a file is asked without its content
+    ARUPDATER_FanOut_SetOptions(session, remoteFileName, suffix);
+    curl_easy_setopt(session->curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(session->curl, CURLOPT_WRITEFUNCTION, ARUPDATER_FanOut_DiscardCallback);
+    code = curl_easy_perform(session->curl);
+    if (code == CURLE_OK)
+    {
+        curl_easy_getinfo(session->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, size);
+    }
+    else if ((code == CURLE_REMOTE_FILE_NOT_FOUND) || (code == CURLE_FTP_COULDNT_RETR_FILE))
+    {
+        code = CURLE_OK;
+    }
+    
+    return code;
+}
+
+/**
+ * @brief Check the end of the partial plf of the target against the plf, as ARUPDATER_Uploader_VerifyPartialPlf() does
+ * @details the checked chunks at the end are read from the target and compared with the mapped plf, the upload is only appended to the partial plf: the resume offset is its size if they match, 0 otherwise or if they can not be read
+ * @param session : the session with the target
+ * @param[in] partialSize : size of the partial plf
+ * @return ARUPDATER_OK, ARUPDATER_ERROR_UPLOADER_CANCELED if the fan-out has been canceled
+ */
+static eARUPDATER_ERROR ARUPDATER_FanOut_VerifyPartialPlf(ARUPDATER_FanOut_Session_t *session, int64_t partialSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FanOut_t *fanOut = session->fanOut;
+    int64_t checkOffset = ARUPDATER_Uploader_GetTailOffset(partialSize, ARUPDATER_UPLOADER_RESUME_CHECKED_CHUNKS);
+    int isMatching = 0;
+    char range[ARUPDATER_FANOUT_RANGE_SIZE];
+    CURLcode code = CURLE_OK;
+    
+    session->tailCapacity = partialSize - checkOffset;
+    session->tailSize = 0;
+    session->tail = malloc((size_t)session->tailCapacity);
+    if (session->tail == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        snprintf(range, sizeof(range), "%lld-%lld", (long long)checkOffset, (long long)(partialSize - 1));
+        ARUPDATER_FanOut_SetOptions(session, fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX);
+        curl_easy_setopt(session->curl, CURLOPT_RANGE, range);
+        curl_easy_setopt(session->curl, CURLOPT_WRITEFUNCTION, ARUPDATER_FanOut_TailCallback);
+        curl_easy_setopt(session->curl, CURLOPT_WRITEDATA, session);
+        code = curl_easy_perform(session->curl);
+        if ((code != CURLE_OK) || (session->tailSize != session->tailCapacity))
+        {
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    // the bytes read are compared with the mapped plf
+    if (error == ARUPDATER_OK)
+    {
+        isMatching = (memcmp(fanOut->plf.data + checkOffset, session->tail, (size_t)session->tailSize) == 0);
+    }
+    
+    free(session->tail);
+    session->tail = NULL;
+    session->tailCapacity = 0;
+    session->tailSize = 0;
+    
+    if ((error != ARUPDATER_OK) && (fanOut->isCanceled != 0))
+    {
+        error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+    }
+    
+    // the upload does not depend on the check, a partial plf which can not be checked is sent again
+    if ((error != ARUPDATER_OK) && (error != ARUPDATER_ERROR_UPLOADER_CANCELED))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FANOUT_TAG, "target %d: the end of the partial plf can not be checked (%s), it is sent again", session->target, ARUPDATER_Error_ToString(error));
+        isMatching = 0;
+        error = ARUPDATER_OK;
+    }
+    
+    // the upload can only be appended to the partial plf, it is sent again if its end does not match
+    session->resumeOffset = (isMatching) ? partialSize : 0;
+    
+    if ((error == ARUPDATER_OK) && (session->resumeOffset == 0))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FANOUT_TAG, "target %d: the end of the partial plf does not match the plf, it is sent again", session->target);
+    }
+    
+    return error;
+}
+
+/**
+ * @brief Decide whether the upload to the target can be resumed, as ARUPDATER_Uploader_NegotiateResume() does
+ */
+static eARUPDATER_ERROR ARUPDATER_FanOut_NegotiateResume(ARUPDATER_FanOut_Session_t *session)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FanOut_t *fanOut = session->fanOut;
+    CURLcode code = CURLE_OK;
+    curl_off_t partialSize = -1;
+    
+    session->resumeOffset = 0;
+    
+    // the size of the partial plf, a missing file is not an error
+    code = ARUPDATER_FanOut_Size(session, fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX, &partialSize);
+    if (code != CURLE_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: %s", session->target, curl_easy_strerror(code));
+        error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    // the partial plf is kept only if the md5 left by its upload is the one of the plf
+    if ((error == ARUPDATER_OK) && (partialSize > 0) && ((int64_t)partialSize <= fanOut->plfSize))
+    {
+        session->receivedSize = 0;
+        session->received[0] = '\0';
+        ARUPDATER_FanOut_SetOptions(session, ARUPDATER_UPLOADER_MD5_FILENAME, "");
+        curl_easy_setopt(session->curl, CURLOPT_WRITEFUNCTION, ARUPDATER_FanOut_WriteCallback);
+        curl_easy_setopt(session->curl, CURLOPT_WRITEDATA, session);
+        code = curl_easy_perform(session->curl);
+        if ((code == CURLE_OK) && (strcmp(session->received, fanOut->md5Txt) == 0))
+        {
+            error = ARUPDATER_FanOut_VerifyPartialPlf(session, (int64_t)partialSize);
+        }
+    }
+    
+    // a new upload first leaves the md5 of the plf on the target
+    if ((error == ARUPDATER_OK) && (session->resumeOffset == 0))
+    {
+        ARUPDATER_FanOut_SetOptions(session, ARUPDATER_UPLOADER_MD5_FILENAME, "");
+        code = ARUPDATER_FanOut_Put(session, (const uint8_t *)fanOut->md5Txt, strlen(fanOut->md5Txt), 0);
+        if (code != CURLE_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: md5 not sent: %s", session->target, curl_easy_strerror(code));
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    return error;
+}
+
+/**
+ * @brief Upload the plf to a target and rename it once its size is the one of the plf
+ */
+static eARUPDATER_ERROR ARUPDATER_FanOut_UploadTarget(ARUPDATER_FanOut_Session_t *session)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FanOut_t *fanOut = session->fanOut;
+    ARUPDATER_FanOut_Target_t *target = &fanOut->targets[session->target];
+    struct curl_slist *renameCommands = NULL;
+    char command[ARUPDATER_FANOUT_COMMAND_SIZE];
+    CURLcode code = CURLE_OK;
+    curl_off_t uploadedSize = 0;
+    
+    session->curl = curl_easy_init();
+    if (session->curl == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_FanOut_NegotiateResume(session);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fanOut->statusLock);
+        target->status.isResumed = (session->resumeOffset > 0);
+        target->status.sentSize = session->resumeOffset;
+        ARSAL_Mutex_Unlock(&fanOut->statusLock);
+        
+        // the rename is only sent once the size of the uploaded plf is the one of the plf
+        snprintf(command, sizeof(command), "RNFR %s%s", fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX);
+        renameCommands = curl_slist_append(renameCommands, command);
+        snprintf(command, sizeof(command), "RNTO %s", fanOut->fileName);
+        renameCommands = (renameCommands != NULL) ? curl_slist_append(renameCommands, command) : NULL;
+        if (renameCommands == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_FanOut_SetOptions(session, fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX);
+        session->isSendingPlf = 1;
+        code = ARUPDATER_FanOut_Put(session, fanOut->plf.data + session->resumeOffset, fanOut->plfSize - session->resumeOffset, (session->resumeOffset > 0));
+        session->isSendingPlf = 0;
+        
+        if (code == CURLE_OK)
+        {
+            curl_easy_getinfo(session->curl, CURLINFO_SIZE_UPLOAD_T, &uploadedSize);
+        }
+        if ((code != CURLE_OK) || ((int64_t)uploadedSize != fanOut->plfSize - session->resumeOffset))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: plf not sent: %s", session->target, curl_easy_strerror(code));
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        code = ARUPDATER_FanOut_Size(session, fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX, &uploadedSize);
+        if (code != CURLE_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: uploaded plf not checked: %s", session->target, curl_easy_strerror(code));
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+        else if ((int64_t)uploadedSize != fanOut->plfSize)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: the uploaded plf has %lld bytes instead of %lld, it is not renamed", session->target, (long long)uploadedSize, (long long)fanOut->plfSize);
+            error = ARUPDATER_ERROR_UPLOADER_VERIFICATION_FAILED;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        // the rename follows the size check of the same file, on the same control connection
+        ARUPDATER_FanOut_SetOptions(session, fanOut->fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX);
+        curl_easy_setopt(session->curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(session->curl, CURLOPT_WRITEFUNCTION, ARUPDATER_FanOut_DiscardCallback);
+        curl_easy_setopt(session->curl, CURLOPT_POSTQUOTE, renameCommands);
+        code = curl_easy_perform(session->curl);
+        if (code != CURLE_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "target %d: plf not renamed: %s", session->target, curl_easy_strerror(code));
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    if ((error != ARUPDATER_OK) && (fanOut->isCanceled != 0))
+    {
+        error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+    }
+    
+    if (renameCommands != NULL)
+    {
+        curl_slist_free_all(renameCommands);
+    }
+    if (session->curl != NULL)
+    {
+        curl_easy_cleanup(session->curl);
+        session->curl = NULL;
+    }
+    
+    return error;
+}
+
+/**
+ * @brief Upload the plf to the targets left, until there is none or the upload is canceled
+ */
+static void* ARUPDATER_FanOut_WorkerRun(void *arg)
+{
+    ARUPDATER_FanOut_t *fanOut = (ARUPDATER_FanOut_t *)arg;
+    ARUPDATER_FanOut_Session_t session;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int target = -1;
+    
+    memset(&session, 0, sizeof(session));
+    session.fanOut = fanOut;
+    
+    do
+    {
+        ARSAL_Mutex_Lock(&fanOut->statusLock);
+        target = -1;
+        if ((fanOut->isCanceled == 0) && (fanOut->nextTarget < fanOut->targetCount))
+        {
+            target = fanOut->nextTarget;
+            fanOut->nextTarget++;
+            fanOut->targets[target].status.state = ARUPDATER_FANOUT_TARGET_STATE_UPLOADING;
+        }
+        ARSAL_Mutex_Unlock(&fanOut->statusLock);
+        
+        if (target >= 0)
+        {
+            session.target = target;
+            error = ARUPDATER_FanOut_UploadTarget(&session);
+            
+            ARSAL_Mutex_Lock(&fanOut->statusLock);
+            fanOut->targets[target].status.error = error;
+            if (error == ARUPDATER_OK)
+            {
+                fanOut->targets[target].status.state = ARUPDATER_FANOUT_TARGET_STATE_DONE;
+            }
+            else if (error == ARUPDATER_ERROR_UPLOADER_CANCELED)
+            {
+                fanOut->targets[target].status.state = ARUPDATER_FANOUT_TARGET_STATE_CANCELED;
+            }
+            else
+            {
+                fanOut->targets[target].status.state = ARUPDATER_FANOUT_TARGET_STATE_FAILED;
+            }
+            ARSAL_Mutex_Unlock(&fanOut->statusLock);
+            
+            if (fanOut->completionCallback != NULL)
+            {
+                fanOut->completionCallback(fanOut->completionArg, target, error);
+            }
+        }
+    }
+    while (target >= 0);
+    
+    return NULL;
+}
+
+/**
+ * @brief Map the plf of the product once, check it and compute its md5
+ */
+static eARUPDATER_ERROR ARUPDATER_FanOut_LoadPlf(ARUPDATER_Manager_t *manager)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FanOut_t *fanOut = manager->fanOut;
+    uint16_t productId = ARDISCOVERY_getProductID(fanOut->product);
+    char device[ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE];
+    int productFd = -1;
+    char *sourceFileFolder = NULL;
+    char *sourceFilePath = NULL;
+    char *packPath = NULL;
+    char extractedFileName[ARUPDATER_FANOUT_EXTRACTED_FILE_SIZE];
+    ARUPDATER_PlfPack_Entry_t packEntry;
+    plf_file_t plf;
+    ARUPDATER_Hash_Context_t md5Context;
+    uint8_t digest[ARUPDATER_MD5_DIGEST_SIZE];
+    
+    memset(&plf, 0, sizeof(plf));
+    snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
+    
+    // the plf validator and the plf mapping still take paths
+    sourceFileFolder = ARUPDATER_Manager_GetProductFolderPath(fanOut->rootFolder, productId);
+    if (sourceFileFolder == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    else
+    {
+        // the product folder receives the extracted plf of a pack
+        productFd = ARUPDATER_Dir_OpenProductFolder(fanOut->dir, productId, (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK), &error);
+    }
+    
+    free(fanOut->fileName);
+    fanOut->fileName = NULL;
+    if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "the folder of %s can not be opened", device);
+    }
+    else if (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK)
+    {
+        // the uploaders of other managers may extract the plf of the same product at once
+        snprintf(extractedFileName, sizeof(extractedFileName), ARUPDATER_FANOUT_EXTRACTED_FILE_FORMAT, (int)getpid(), (void *)fanOut);
+        packPath = ARUPDATER_Manager_GetPlfPackPath(fanOut->rootFolder);
+        sourceFilePath = ARUPDATER_Utils_BuildPath(sourceFileFolder, extractedFileName, NULL);
+        if ((packPath == NULL) || (sourceFilePath == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            error = ARUPDATER_PlfPack_Extract(packPath, productId, sourceFilePath, &packEntry);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            fanOut->fileName = strdup(packEntry.fileName);
+            if (fanOut->fileName == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+            }
+        }
+    }
+    else
+    {
+        error = ARUPDATER_Utils_GetPlfInFolderAt(productFd, &fanOut->fileName);
+        if (error == ARUPDATER_OK)
+        {
+            sourceFilePath = ARUPDATER_Utils_BuildPath(sourceFileFolder, fanOut->fileName, NULL);
+            if (sourceFilePath == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+            }
+        }
+    }
+    
+    // do not send a corrupted plf to the whole fleet
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfValidator_Check(sourceFilePath);
+    }
+    
+    // the mapping outlives the extracted file of a pack, which is removed below
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Plf_Open(sourceFilePath, &plf);
+    }
+    
+    // the md5 is computed from the bytes which are sent
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Hash_Init(&md5Context, ARUPDATER_HASH_MD5);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Hash_Update(&md5Context, plf.data, plf.mapSize);
+        ARUPDATER_Hash_Final(&md5Context, digest);
+        ARUPDATER_Hash_ToHex(digest, sizeof(digest), fanOut->md5Txt);
+        
+        ARUPDATER_Plf_Close(&fanOut->plf);
+        fanOut->plf = plf;
+        fanOut->plfSize = (int64_t)plf.mapSize;
+        memset(&plf, 0, sizeof(plf));
+    }
+    
+    ARUPDATER_Plf_Close(&plf);
+    if ((packPath != NULL) && (productFd >= 0))
+    {
+        unlinkat(productFd, extractedFileName, 0);
+    }
+    free(packPath);
+    free(sourceFilePath);
+    free(sourceFileFolder);
+    if (productFd >= 0)
+    {
+        close(productFd);
+    }
+    
+    return error;
+}
+
+/* ***************************************
+ *
+ *             function implementation :
+ *
+ *****************************************/
+
+eARUPDATER_ERROR ARUPDATER_FanOut_New(ARUPDATER_Manager_t* manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, int maxConcurrentUploads, ARUPDATER_FanOut_ProgressCallback_t progressCallback, void *progressArg, ARUPDATER_FanOut_CompletionCallback_t completionCallback, void *completionArg)
+{
+    ARUPDATER_FanOut_t *fanOut = NULL;
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    
+    // Check parameters
+    if ((manager == NULL) || (rootFolder == NULL) || (maxConcurrentUploads < 1))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    // the workers create their curl handles at the same time
+    if (err == ARUPDATER_OK)
+    {
+        err = ARUPDATER_Http_GlobalInit();
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        /* Create the fan-out */
+        fanOut = calloc(1, sizeof(ARUPDATER_FanOut_t));
+        if (fanOut == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        if (manager->fanOut != NULL)
+        {
+            err = ARUPDATER_ERROR_MANAGER_ALREADY_INITIALIZED;
+            free(fanOut);
+            fanOut = NULL;
+        }
+        else
+        {
+            manager->fanOut = fanOut;
+        }
+    }
+    
+    /* Initialize to default values */
+    if (err == ARUPDATER_OK)
+    {
+        size_t rootFolderLength = strlen(rootFolder);
+        
+        fanOut->rootFolder = malloc(rootFolderLength + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) + 1);
+        if (fanOut->rootFolder == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            strcpy(fanOut->rootFolder, rootFolder);
+            if ((rootFolderLength == 0) || (rootFolder[rootFolderLength - 1] != ARUPDATER_MANAGER_FOLDER_SEPARATOR[0]))
+            {
+                strcat(fanOut->rootFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
+            }
+        }
+        
+        fanOut->product = product;
+        fanOut->maxConcurrentUploads = (maxConcurrentUploads < ARUPDATER_FANOUT_MAX_CONCURRENT_UPLOADS) ? maxConcurrentUploads : ARUPDATER_FANOUT_MAX_CONCURRENT_UPLOADS;
+        
+        fanOut->progressCallback = progressCallback;
+        fanOut->progressArg = progressArg;
+        fanOut->completionCallback = completionCallback;
+        fanOut->completionArg = completionArg;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        fanOut->dir = ARUPDATER_Dir_New(fanOut->rootFolder, &err);
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Mutex_Init(&fanOut->statusLock) != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
+    /* delete the fan-out if an error occurred */
+    if ((err != ARUPDATER_OK) && (fanOut != NULL))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "error: %s", ARUPDATER_Error_ToString (err));
+        ARUPDATER_Dir_Delete(&fanOut->dir);
+        free(fanOut->rootFolder);
+        free(fanOut);
+        manager->fanOut = NULL;
+    }
+    
+    return err;
+}
+
+eARUPDATER_ERROR ARUPDATER_FanOut_Delete(ARUPDATER_Manager_t *manager)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int i = 0;
+    
+    if (manager == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (manager->fanOut == NULL)
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    else if (manager->fanOut->isRunning != 0)
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    else
+    {
+        ARUPDATER_FanOut_t *fanOut = manager->fanOut;
+        
+        for (i = 0; i < fanOut->targetCount; i++)
+        {
+            free(fanOut->targets[i].address);
+            free(fanOut->targets[i].username);
+            free(fanOut->targets[i].password);
+        }
+        free(fanOut->targets);
+        
+        ARSAL_Mutex_Destroy(&fanOut->statusLock);
+        ARUPDATER_Dir_Delete(&fanOut->dir);
+        ARUPDATER_Plf_Close(&fanOut->plf);
+        free(fanOut->fileName);
+        free(fanOut->rootFolder);
+        
+        free(fanOut);
+        manager->fanOut = NULL;
+    }
+    
+    return error;
+}
+
+int ARUPDATER_FanOut_AddTarget(ARUPDATER_Manager_t *manager, const char *const address, int port, const char *const username, const char *const password, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_FanOut_t *fanOut = NULL;
+    ARUPDATER_FanOut_Target_t *target = NULL;
+    int index = -1;
+    
+    if ((manager == NULL) || (address == NULL) || (port <= 0) || (port > 65535))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (manager->fanOut == NULL)
+    {
+        err = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    else if (manager->fanOut->isRunning != 0)
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        fanOut = manager->fanOut;
+        if (fanOut->targetCount == fanOut->targetCapacity)
+        {
+            int capacity = (fanOut->targetCapacity > 0) ? fanOut->targetCapacity * 2 : 16;
+            ARUPDATER_FanOut_Target_t *targets = realloc(fanOut->targets, capacity * sizeof(ARUPDATER_FanOut_Target_t));
+            if (targets == NULL)
+            {
+                err = ARUPDATER_ERROR_ALLOC;
+            }
+            else
+            {
+                fanOut->targets = targets;
+                fanOut->targetCapacity = capacity;
+            }
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        target = &fanOut->targets[fanOut->targetCount];
+        memset(target, 0, sizeof(ARUPDATER_FanOut_Target_t));
+        target->port = port;
+        target->address = strdup(address);
+        target->username = (username != NULL) ? strdup(username) : NULL;
+        target->password = (password != NULL) ? strdup(password) : NULL;
+        if ((target->address == NULL) || ((username != NULL) && (target->username == NULL)) || ((password != NULL) && (target->password == NULL)))
+        {
+            free(target->address);
+            free(target->username);
+            free(target->password);
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        target->status.state = ARUPDATER_FANOUT_TARGET_STATE_WAITING;
+        target->status.error = ARUPDATER_OK;
+        
+        ARSAL_Mutex_Lock(&fanOut->statusLock);
+        index = fanOut->targetCount;
+        fanOut->targetCount++;
+        ARSAL_Mutex_Unlock(&fanOut->statusLock);
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return index;
+}
+
+eARUPDATER_ERROR ARUPDATER_FanOut_GetTargetStatus(ARUPDATER_Manager_t *manager, int target, ARUPDATER_FanOut_TargetStatus_t *status)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (status == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (manager->fanOut == NULL)
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&manager->fanOut->statusLock);
+        if ((target < 0) || (target >= manager->fanOut->targetCount))
+        {
+            error = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+        else
+        {
+            *status = manager->fanOut->targets[target].status;
+        }
+        ARSAL_Mutex_Unlock(&manager->fanOut->statusLock);
+    }
+    
+    return error;
+}
+
+void* ARUPDATER_FanOut_ThreadRun(void *managerArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)managerArg;
+    ARUPDATER_FanOut_t *fanOut = NULL;
+    ARSAL_Thread_t threads[ARUPDATER_FANOUT_MAX_CONCURRENT_UPLOADS];
+    int threadCount = 0;
+    int i = 0;
+    
+    if ((manager == NULL) || (manager->fanOut == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        fanOut = manager->fanOut;
+        fanOut->isRunning = 1;
+        // a cancel only stops the run it was made for
+        fanOut->isCanceled = 0;
+        
+        error = ARUPDATER_FanOut_LoadPlf(manager);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fanOut->statusLock);
+        for (i = 0; i < fanOut->targetCount; i++)
+        {
+            memset(&fanOut->targets[i].status, 0, sizeof(ARUPDATER_FanOut_TargetStatus_t));
+            fanOut->targets[i].status.state = ARUPDATER_FANOUT_TARGET_STATE_WAITING;
+            fanOut->targets[i].status.totalSize = fanOut->plfSize;
+            fanOut->targets[i].status.error = ARUPDATER_OK;
+        }
+        fanOut->nextTarget = 0;
+        ARSAL_Mutex_Unlock(&fanOut->statusLock);
+        
+        threadCount = (fanOut->targetCount < fanOut->maxConcurrentUploads) ? fanOut->targetCount : fanOut->maxConcurrentUploads;
+        
+        // each worker takes the next waiting target once its upload is over, the calling thread is one of them
+        for (i = 1; i < threadCount; i++)
+        {
+            if (ARSAL_Thread_Create(&threads[i], ARUPDATER_FanOut_WorkerRun, fanOut) != 0)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FANOUT_TAG, "only %d concurrent uploads", i);
+                threadCount = i;
+            }
+        }
+        
+        if (threadCount > 0)
+        {
+            ARUPDATER_FanOut_WorkerRun(fanOut);
+        }
+        
+        for (i = 1; i < threadCount; i++)
+        {
+            ARSAL_Thread_Join(threads[i], NULL);
+            ARSAL_Thread_Destroy(&threads[i]);
+        }
+        
+        // the targets which have not been started are canceled
+        for (i = 0; i < fanOut->targetCount; i++)
+        {
+            int isCanceled = 0;
+            
+            ARSAL_Mutex_Lock(&fanOut->statusLock);
+            if (fanOut->targets[i].status.state == ARUPDATER_FANOUT_TARGET_STATE_WAITING)
+            {
+                fanOut->targets[i].status.state = ARUPDATER_FANOUT_TARGET_STATE_CANCELED;
+                fanOut->targets[i].status.error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+                isCanceled = 1;
+            }
+            if (error == ARUPDATER_OK)
+            {
+                error = fanOut->targets[i].status.error;
+            }
+            ARSAL_Mutex_Unlock(&fanOut->statusLock);
+            
+            if ((isCanceled) && (fanOut->completionCallback != NULL))
+            {
+                fanOut->completionCallback(fanOut->completionArg, i, ARUPDATER_ERROR_UPLOADER_CANCELED);
+            }
+        }
+    }
+    
+    if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_FANOUT_TAG, "error: %s", ARUPDATER_Error_ToString (error));
+    }
+    
+    if (fanOut != NULL)
+    {
+        // the plf is only mapped during the upload
+        ARUPDATER_Plf_Close(&fanOut->plf);
+        fanOut->plfSize = 0;
+        fanOut->isRunning = 0;
+    }
+    
+    return (void*)error;
+}
+
+eARUPDATER_ERROR ARUPDATER_FanOut_CancelThread(ARUPDATER_Manager_t *manager)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if (manager == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((error == ARUPDATER_OK) && (manager->fanOut == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        // the transfers in progress are aborted by their progress callback
+        manager->fanOut->isCanceled = 1;
+    }
+    
+    return error;
+}
+
+int ARUPDATER_FanOut_ThreadIsRunning(ARUPDATER_Manager_t* manager, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int isRunning = 0;
+    
+    if (manager == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->fanOut == NULL))
+    {
+        err = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        isRunning = manager->fanOut->isRunning;
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return isRunning;
+}
@@ -0,0 +1,86 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_FanOut.h
+ * @brief libARUpdater FanOut private header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FANOUT_PRIVATE_H_
+#define _ARUPDATER_FANOUT_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_FanOut.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include "ARUPDATER_Dir.h"
+#include "ARUPDATER_Md5.h"
+#include "ARUPDATER_Plf.h"
+
+/**
+ * @brief Product the plf is uploaded to
+ */
+typedef struct
+{
+    char *address;
+    int port;
+    char *username;
+    char *password;
+    ARUPDATER_FanOut_TargetStatus_t status; /**< protected by the statusLock of the fan-out */
+} ARUPDATER_FanOut_Target_t;
+
+struct ARUPDATER_FanOut_t
+{
+    char *rootFolder;
+    ARUPDATER_Dir_t *dir; /**< the folders of rootFolder, opened once */
+    eARDISCOVERY_PRODUCT product;
+    int maxConcurrentUploads;
+    
+    ARUPDATER_FanOut_Target_t *targets;
+    int targetCount;
+    int targetCapacity;
+    int nextTarget; /**< index of the next target to upload, protected by statusLock */
+    
+    int isRunning;
+    volatile int isCanceled;
+    
+    plf_file_t plf; /**< the plf mapped read-only, shared by all the uploads: its pages are the ones of the page cache, not a copy per fan-out */
+    int64_t plfSize;
+    char *fileName;
+    char md5Txt[ARUPDATER_MD5_DIGEST_SIZE * 2 + 1];
+    
+    ARSAL_Mutex_t statusLock;
+    
+    ARUPDATER_FanOut_ProgressCallback_t progressCallback;
+    ARUPDATER_FanOut_CompletionCallback_t completionCallback;
+    void *progressArg;
+    void *completionArg;
+};
+
+#endif
@@ -0,0 +1,1497 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_FileIO.c
+ * @brief libARUpdater file io c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ARUPDATER_FILEIO_HAS_IO_URING
+#endif
+#endif
+#endif
+
+#include "ARUPDATER_FileIO.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_FILEIO_TAG                    "ARUPDATER_FileIO"
+
+#define ARUPDATER_FILEIO_ALIGNMENT              4096
+#define ARUPDATER_FILEIO_MAX_BLOCKS             4                   /**< blocks of the io_uring backend, filled or written in the background */
+#define ARUPDATER_FILEIO_URING_DEPTH            8
+#define ARUPDATER_FILEIO_URING_READ_SIZE        (256 * 1024)        /**< size of each read request of a batch */
+#define ARUPDATER_FILEIO_URING_READ_FLAG        0x100               /**< set in the user data of the read requests */
+#define ARUPDATER_FILEIO_MMAP_WINDOW_SIZE       (8 * 1024 * 1024)
+#define ARUPDATER_FILEIO_BENCHMARK_WRITE_SIZE   (16 * 1024)         /**< size of the data given at once by the http transfers */
+#define ARUPDATER_FILEIO_BENCHMARK_FILE_NAME    "fileio_benchXXXXXX"
+
+/**
+ * @brief Contiguous writes gathered before reaching the file
+ */
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+    int64_t offset;
+    int isInFlight;
+} ARUPDATER_FileIO_Block_t;
+
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+/**
+ * @brief Submission and completion queues shared with the kernel
+ */
+typedef struct
+{
+    int fd;
+    unsigned *sqHead;
+    unsigned *sqTail;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned *sqArray;
+    unsigned *cqHead;
+    unsigned *cqTail;
+    unsigned cqMask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sqRing;
+    size_t sqRingSize;
+    void *cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+} ARUPDATER_FileIO_Ring_t;
+#endif
+
+typedef struct
+{
+    eARUPDATER_ERROR (*open) (ARUPDATER_FileIO_t *file);
+    eARUPDATER_ERROR (*write) (ARUPDATER_FileIO_t *file, const uint8_t *data, size_t size, int64_t offset);
+    eARUPDATER_ERROR (*read) (ARUPDATER_FileIO_t *file, uint8_t *data, size_t size, int64_t offset, size_t *readSize);
+    eARUPDATER_ERROR (*flush) (ARUPDATER_FileIO_t *file);
+    void (*close) (ARUPDATER_FileIO_t *file);
+} ARUPDATER_FileIO_Ops_t;
+
+struct ARUPDATER_FileIO_t
+{
+    const ARUPDATER_FileIO_Ops_t *ops;
+    eARUPDATER_FILEIO_BACKEND backend;
+    eARUPDATER_FILEIO_MODE mode;
+    int fd;
+    int64_t size; /**< size of the file, pending writes included */
+    ARSAL_Mutex_t readLock; /**< serializes the reads which share a state */
+    int hasReadLock;
+
+    // pwrite and io_uring
+    ARUPDATER_FileIO_Block_t blocks[ARUPDATER_FILEIO_MAX_BLOCKS];
+    int blockCount;
+    int currentBlock;
+    eARUPDATER_ERROR backgroundError; /**< first error of the writes done in the background */
+
+    // mmap
+    uint8_t *window;
+    int64_t windowOffset;
+    int64_t allocatedSize; /**< size of the file once extended to hold the window */
+    int isExtended;
+    uint8_t *readMap;
+    size_t readMapSize;
+
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+    ARUPDATER_FileIO_Ring_t ring;
+    int hasRing;
+    int isRingBroken; /**< a request could not be submitted, the ring is not used anymore */
+    int readResults[ARUPDATER_FILEIO_URING_DEPTH];
+    int readPending;
+#endif
+};
+
+static const char *const ARUPDATER_FileIO_BackendNames[ARUPDATER_FILEIO_BACKEND_MAX] =
+{
+    "default",
+    "pwrite",
+    "io_uring",
+    "mmap",
+};
+
+static pthread_mutex_t ARUPDATER_FileIO_SelectLock = PTHREAD_MUTEX_INITIALIZER;
+static eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_DefaultBackend = ARUPDATER_FILEIO_BACKEND_PWRITE;
+static int ARUPDATER_FileIO_IsSelected = 0;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_ErrnoToError(int errnoValue)
+{
+    eARUPDATER_ERROR error = ARUPDATER_ERROR_SYSTEM;
+
+    if (errnoValue == ENOSPC)
+    {
+        error = ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE;
+    }
+#ifdef EDQUOT
+    else if (errnoValue == EDQUOT)
+    {
+        error = ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE;
+    }
+#endif
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_PwriteAll(int fd, const uint8_t *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        ssize_t ret = pwrite(fd, data, size, (off_t)offset);
+        if (ret > 0)
+        {
+            data += ret;
+            size -= (size_t)ret;
+            offset += ret;
+        }
+        else if ((ret == 0) || (errno != EINTR))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FILEIO_TAG, "write of %zu bytes at %lld failed: %s", size, (long long)offset, strerror(errno));
+            error = ARUPDATER_FileIO_ErrnoToError((ret == 0) ? EIO : errno);
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Read until size bytes are read or the end of the file is reached
+ */
+static eARUPDATER_ERROR ARUPDATER_FileIO_PreadAll(int fd, uint8_t *data, size_t size, int64_t offset, size_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    size_t total = 0;
+    int isEnd = 0;
+
+    while ((error == ARUPDATER_OK) && (isEnd == 0) && (total < size))
+    {
+        ssize_t ret = pread(fd, data + total, size - total, (off_t)(offset + total));
+        if (ret > 0)
+        {
+            total += (size_t)ret;
+        }
+        else if (ret == 0)
+        {
+            isEnd = 1;
+        }
+        else if (errno != EINTR)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    *readSize = total;
+
+    return error;
+}
+
+static int64_t ARUPDATER_FileIO_GetTimeUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_AllocBlocks(ARUPDATER_FileIO_t *file, int blockCount)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int i = 0;
+
+    // the reads only need the blocks to see the pending writes
+    if (file->mode == ARUPDATER_FILEIO_MODE_READ)
+    {
+        blockCount = 0;
+    }
+
+    for (i = 0; (error == ARUPDATER_OK) && (i < blockCount); i++)
+    {
+        void *data = NULL;
+        if (posix_memalign(&data, ARUPDATER_FILEIO_ALIGNMENT, ARUPDATER_FILEIO_BLOCK_SIZE) != 0)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            file->blocks[i].data = (uint8_t *)data;
+            file->blockCount++;
+        }
+    }
+
+    return error;
+}
+
+static void ARUPDATER_FileIO_FreeBlocks(ARUPDATER_FileIO_t *file)
+{
+    int i = 0;
+
+    for (i = 0; i < file->blockCount; i++)
+    {
+        free(file->blocks[i].data);
+        file->blocks[i].data = NULL;
+    }
+    file->blockCount = 0;
+}
+
+/**
+ * @brief Copy data at the end of a block
+ * @return the number of bytes copied, 0 if the data does not follow the block or if the block is full
+ */
+static size_t ARUPDATER_FileIO_Gather(ARUPDATER_FileIO_Block_t *block, const uint8_t *data, size_t size, int64_t offset)
+{
+    size_t copySize = 0;
+
+    if (block->size == 0)
+    {
+        block->offset = offset;
+    }
+
+    if ((offset == block->offset + (int64_t)block->size) && (block->size < ARUPDATER_FILEIO_BLOCK_SIZE))
+    {
+        copySize = ARUPDATER_FILEIO_BLOCK_SIZE - block->size;
+        if (copySize > size)
+        {
+            copySize = size;
+        }
+        memcpy(block->data + block->size, data, copySize);
+        block->size += copySize;
+    }
+
+    return copySize;
+}
+
+/* pwrite backend */
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Pwrite_Open(ARUPDATER_FileIO_t *file)
+{
+    return ARUPDATER_FileIO_AllocBlocks(file, 1);
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Pwrite_Flush(ARUPDATER_FileIO_t *file)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_Block_t *block = &file->blocks[0];
+
+    if ((file->blockCount > 0) && (block->size > 0))
+    {
+        error = ARUPDATER_FileIO_PwriteAll(file->fd, block->data, block->size, block->offset);
+        block->size = 0;
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Pwrite_Write(ARUPDATER_FileIO_t *file, const uint8_t *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_Block_t *block = &file->blocks[0];
+
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        size_t copySize = 0;
+
+        if ((block->size == 0) && (size >= ARUPDATER_FILEIO_BLOCK_SIZE))
+        {
+            // big enough to be written without a copy
+            error = ARUPDATER_FileIO_PwriteAll(file->fd, data, size, offset);
+            copySize = size;
+        }
+        else
+        {
+            copySize = ARUPDATER_FileIO_Gather(block, data, size, offset);
+            if (copySize == 0)
+            {
+                error = ARUPDATER_FileIO_Pwrite_Flush(file);
+            }
+        }
+
+        data += copySize;
+        size -= copySize;
+        offset += copySize;
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Pwrite_Read(ARUPDATER_FileIO_t *file, uint8_t *data, size_t size, int64_t offset, size_t *readSize)
+{
+    return ARUPDATER_FileIO_PreadAll(file->fd, data, size, offset, readSize);
+}
+
+static void ARUPDATER_FileIO_Pwrite_Close(ARUPDATER_FileIO_t *file)
+{
+    ARUPDATER_FileIO_FreeBlocks(file);
+}
+
+static const ARUPDATER_FileIO_Ops_t ARUPDATER_FileIO_PwriteOps =
+{
+    ARUPDATER_FileIO_Pwrite_Open,
+    ARUPDATER_FileIO_Pwrite_Write,
+    ARUPDATER_FileIO_Pwrite_Read,
+    ARUPDATER_FileIO_Pwrite_Flush,
+    ARUPDATER_FileIO_Pwrite_Close,
+};
+
+/* io_uring backend */
+
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+
+static int ARUPDATER_FileIO_Ring_Enter(ARUPDATER_FileIO_Ring_t *ring, unsigned toSubmit, unsigned minComplete)
+{
+    int ret = 0;
+
+    do
+    {
+        ret = (int)syscall(__NR_io_uring_enter, ring->fd, toSubmit, minComplete, (minComplete > 0) ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while ((ret < 0) && (errno == EINTR));
+
+    return ret;
+}
+
+static void ARUPDATER_FileIO_Ring_Clear(ARUPDATER_FileIO_Ring_t *ring)
+{
+    if (ring->sqes != NULL)
+    {
+        munmap(ring->sqes, ring->sqesSize);
+    }
+    if ((ring->cqRing != NULL) && (ring->cqRing != ring->sqRing))
+    {
+        munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != NULL)
+    {
+        munmap(ring->sqRing, ring->sqRingSize);
+    }
+    if (ring->fd >= 0)
+    {
+        close(ring->fd);
+    }
+    memset(ring, 0, sizeof(ARUPDATER_FileIO_Ring_t));
+    ring->fd = -1;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Ring_Init(ARUPDATER_FileIO_Ring_t *ring, unsigned entries)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct io_uring_params params;
+    uint8_t *sqRing = NULL;
+    uint8_t *cqRing = NULL;
+
+    memset(ring, 0, sizeof(ARUPDATER_FileIO_Ring_t));
+    memset(&params, 0, sizeof(params));
+
+    // refused by old kernels and by some seccomp policies
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0)
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if (ring->cqRingSize > ring->sqRingSize)
+            {
+                ring->sqRingSize = ring->cqRingSize;
+            }
+            ring->cqRingSize = ring->sqRingSize;
+        }
+
+        ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sqRing == MAP_FAILED)
+        {
+            ring->sqRing = NULL;
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            ring->cqRing = ring->sqRing;
+        }
+        else
+        {
+            ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+            if (ring->cqRing == MAP_FAILED)
+            {
+                ring->cqRing = NULL;
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+        if (ring->sqes == MAP_FAILED)
+        {
+            ring->sqes = NULL;
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        sqRing = (uint8_t *)ring->sqRing;
+        cqRing = (uint8_t *)ring->cqRing;
+        ring->sqHead = (unsigned *)(sqRing + params.sq_off.head);
+        ring->sqTail = (unsigned *)(sqRing + params.sq_off.tail);
+        ring->sqMask = *(unsigned *)(sqRing + params.sq_off.ring_mask);
+        ring->sqEntries = params.sq_entries;
+        ring->sqArray = (unsigned *)(sqRing + params.sq_off.array);
+        ring->cqHead = (unsigned *)(cqRing + params.cq_off.head);
+        ring->cqTail = (unsigned *)(cqRing + params.cq_off.tail);
+        ring->cqMask = *(unsigned *)(cqRing + params.cq_off.ring_mask);
+        ring->cqes = (struct io_uring_cqe *)(cqRing + params.cq_off.cqes);
+    }
+    else
+    {
+        ARUPDATER_FileIO_Ring_Clear(ring);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Queue a read or a write, submitted by the next ARUPDATER_FileIO_Ring_Enter
+ */
+static void ARUPDATER_FileIO_Ring_Queue(ARUPDATER_FileIO_Ring_t *ring, uint8_t opcode, int fd, void *data, size_t size, int64_t offset, uint64_t userData)
+{
+    unsigned tail = *ring->sqTail;
+    unsigned index = tail & ring->sqMask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = (uint32_t)size;
+    sqe->off = (uint64_t)offset;
+    sqe->user_data = userData;
+    ring->sqArray[index] = index;
+
+    __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Handle the completed requests, waiting for at least minComplete of them
+ */
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_Reap(ARUPDATER_FileIO_t *file, unsigned minComplete)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_Ring_t *ring = &file->ring;
+    unsigned head = 0;
+
+    if ((minComplete > 0) && (ARUPDATER_FileIO_Ring_Enter(ring, 0, minComplete) < 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    head = *ring->cqHead;
+    while (head != __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE))
+    {
+        struct io_uring_cqe *cqe = &ring->cqes[head & ring->cqMask];
+
+        if (cqe->user_data & ARUPDATER_FILEIO_URING_READ_FLAG)
+        {
+            file->readResults[cqe->user_data & (ARUPDATER_FILEIO_URING_READ_FLAG - 1)] = cqe->res;
+            file->readPending--;
+        }
+        else if (cqe->user_data < (uint64_t)file->blockCount)
+        {
+            ARUPDATER_FileIO_Block_t *block = &file->blocks[cqe->user_data];
+            eARUPDATER_ERROR blockError = ARUPDATER_OK;
+
+            if (cqe->res < 0)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FILEIO_TAG, "write of %zu bytes at %lld failed: %s", block->size, (long long)block->offset, strerror(-cqe->res));
+                blockError = ARUPDATER_FileIO_ErrnoToError(-cqe->res);
+            }
+            else if ((size_t)cqe->res < block->size)
+            {
+                blockError = ARUPDATER_FileIO_PwriteAll(file->fd, block->data + cqe->res, block->size - (size_t)cqe->res, block->offset + cqe->res);
+            }
+
+            if (file->backgroundError == ARUPDATER_OK)
+            {
+                file->backgroundError = blockError;
+            }
+            block->size = 0;
+            block->isInFlight = 0;
+        }
+
+        head++;
+        __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_SubmitBlock(ARUPDATER_FileIO_t *file, int blockIndex)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_Block_t *block = &file->blocks[blockIndex];
+
+    if (file->isRingBroken == 0)
+    {
+        ARUPDATER_FileIO_Ring_Queue(&file->ring, IORING_OP_WRITE, file->fd, block->data, block->size, block->offset, (uint64_t)blockIndex);
+        if (ARUPDATER_FileIO_Ring_Enter(&file->ring, 1, 0) == 1)
+        {
+            block->isInFlight = 1;
+        }
+        else
+        {
+            // the request stays queued, it must never be submitted with the next ones
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FILEIO_TAG, "io_uring submission failed: %s", strerror(errno));
+            file->isRingBroken = 1;
+        }
+    }
+
+    if (block->isInFlight == 0)
+    {
+        error = ARUPDATER_FileIO_PwriteAll(file->fd, block->data, block->size, block->offset);
+        block->size = 0;
+    }
+
+    file->currentBlock = (blockIndex + 1) % file->blockCount;
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_Flush(ARUPDATER_FileIO_t *file)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int i = 0;
+    int inFlight = 0;
+
+    if ((file->blockCount > 0) && (file->blocks[file->currentBlock].size > 0) && (file->blocks[file->currentBlock].isInFlight == 0))
+    {
+        error = ARUPDATER_FileIO_Uring_SubmitBlock(file, file->currentBlock);
+    }
+
+    do
+    {
+        inFlight = 0;
+        for (i = 0; i < file->blockCount; i++)
+        {
+            inFlight += file->blocks[i].isInFlight;
+        }
+        if ((error == ARUPDATER_OK) && (inFlight > 0))
+        {
+            error = ARUPDATER_FileIO_Uring_Reap(file, 1);
+        }
+    } while ((error == ARUPDATER_OK) && (inFlight > 0));
+
+    if (error == ARUPDATER_OK)
+    {
+        error = file->backgroundError;
+        file->backgroundError = ARUPDATER_OK;
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_Open(ARUPDATER_FileIO_t *file)
+{
+    eARUPDATER_ERROR error = ARUPDATER_FileIO_Ring_Init(&file->ring, ARUPDATER_FILEIO_URING_DEPTH);
+
+    if (error == ARUPDATER_OK)
+    {
+        file->hasRing = 1;
+        error = ARUPDATER_FileIO_AllocBlocks(file, ARUPDATER_FILEIO_MAX_BLOCKS);
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_Write(ARUPDATER_FileIO_t *file, const uint8_t *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = file->backgroundError;
+
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        ARUPDATER_FileIO_Block_t *block = &file->blocks[file->currentBlock];
+        size_t copySize = 0;
+
+        if (block->isInFlight)
+        {
+            // all the blocks are being written
+            error = ARUPDATER_FileIO_Uring_Reap(file, 1);
+            if (error == ARUPDATER_OK)
+            {
+                error = file->backgroundError;
+            }
+        }
+        else if ((block->size > 0) && (offset != block->offset + (int64_t)block->size))
+        {
+            // the writes in flight must not overlap
+            error = ARUPDATER_FileIO_Uring_Flush(file);
+        }
+        else
+        {
+            copySize = ARUPDATER_FileIO_Gather(block, data, size, offset);
+            if (block->size == ARUPDATER_FILEIO_BLOCK_SIZE)
+            {
+                error = ARUPDATER_FileIO_Uring_SubmitBlock(file, file->currentBlock);
+            }
+        }
+
+        data += copySize;
+        size -= copySize;
+        offset += copySize;
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Uring_Read(ARUPDATER_FileIO_t *file, uint8_t *data, size_t size, int64_t offset, size_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    size_t total = 0;
+    size_t endSize = 0;
+    int isEnd = 0;
+
+    while ((error == ARUPDATER_OK) && (isEnd == 0) && (total < size) && (file->isRingBroken == 0))
+    {
+        size_t batchSize = size - total;
+        int count = 0;
+        int submitted = 0;
+        int i = 0;
+
+        // one system call for a batch of requests the storage can serve in parallel
+        for (count = 0; (count < ARUPDATER_FILEIO_URING_DEPTH) && ((size_t)count * ARUPDATER_FILEIO_URING_READ_SIZE < batchSize); count++)
+        {
+            size_t requestOffset = (size_t)count * ARUPDATER_FILEIO_URING_READ_SIZE;
+            size_t requestSize = batchSize - requestOffset;
+            if (requestSize > ARUPDATER_FILEIO_URING_READ_SIZE)
+            {
+                requestSize = ARUPDATER_FILEIO_URING_READ_SIZE;
+            }
+            ARUPDATER_FileIO_Ring_Queue(&file->ring, IORING_OP_READ, file->fd, data + total + requestOffset, requestSize, offset + (int64_t)(total + requestOffset), ARUPDATER_FILEIO_URING_READ_FLAG | (uint64_t)count);
+        }
+
+        submitted = ARUPDATER_FileIO_Ring_Enter(&file->ring, (unsigned)count, (unsigned)count);
+        if (submitted != count)
+        {
+            // the requests left in the queue must never be submitted with the next ones
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FILEIO_TAG, "io_uring submission failed: %s", strerror(errno));
+            file->isRingBroken = 1;
+        }
+
+        // the submitted requests write into the buffer until they complete
+        file->readPending = (submitted > 0) ? submitted : 0;
+        while ((error == ARUPDATER_OK) && (file->readPending > 0))
+        {
+            error = ARUPDATER_FileIO_Uring_Reap(file, 0);
+            if ((error == ARUPDATER_OK) && (file->readPending > 0))
+            {
+                error = ARUPDATER_FileIO_Uring_Reap(file, 1);
+            }
+        }
+
+        for (i = 0; (error == ARUPDATER_OK) && (file->isRingBroken == 0) && (i < count) && (isEnd == 0); i++)
+        {
+            size_t requestSize = batchSize - (size_t)i * ARUPDATER_FILEIO_URING_READ_SIZE;
+            if (requestSize > ARUPDATER_FILEIO_URING_READ_SIZE)
+            {
+                requestSize = ARUPDATER_FILEIO_URING_READ_SIZE;
+            }
+
+            if (file->readResults[i] < 0)
+            {
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+            else
+            {
+                total += (size_t)file->readResults[i];
+                // end of the file, or a short read completed below
+                isEnd = ((size_t)file->readResults[i] < requestSize);
+            }
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (total < size))
+    {
+        error = ARUPDATER_FileIO_PreadAll(file->fd, data + total, size - total, offset + (int64_t)total, &endSize);
+        total += endSize;
+    }
+
+    *readSize = total;
+
+    return error;
+}
+
+static void ARUPDATER_FileIO_Uring_Close(ARUPDATER_FileIO_t *file)
+{
+    if (file->hasRing)
+    {
+        ARUPDATER_FileIO_Ring_Clear(&file->ring);
+        file->hasRing = 0;
+    }
+    ARUPDATER_FileIO_FreeBlocks(file);
+}
+
+static const ARUPDATER_FileIO_Ops_t ARUPDATER_FileIO_UringOps =
+{
+    ARUPDATER_FileIO_Uring_Open,
+    ARUPDATER_FileIO_Uring_Write,
+    ARUPDATER_FileIO_Uring_Read,
+    ARUPDATER_FileIO_Uring_Flush,
+    ARUPDATER_FileIO_Uring_Close,
+};
+
+static int ARUPDATER_FileIO_UringIsAvailable = 0;
+static pthread_once_t ARUPDATER_FileIO_UringOnce = PTHREAD_ONCE_INIT;
+
+static void ARUPDATER_FileIO_CheckUring(void)
+{
+    ARUPDATER_FileIO_Ring_t ring;
+
+    if (ARUPDATER_FileIO_Ring_Init(&ring, 1) == ARUPDATER_OK)
+    {
+        ARUPDATER_FileIO_UringIsAvailable = 1;
+        ARUPDATER_FileIO_Ring_Clear(&ring);
+    }
+}
+
+#endif /* ARUPDATER_FILEIO_HAS_IO_URING */
+
+/* mmap backend */
+
+static void ARUPDATER_FileIO_Mmap_Unmap(ARUPDATER_FileIO_t *file)
+{
+    if (file->window != NULL)
+    {
+        munmap(file->window, ARUPDATER_FILEIO_MMAP_WINDOW_SIZE);
+        file->window = NULL;
+    }
+}
+
+/**
+ * @brief Map the window holding an offset, the file is extended to the end of the window
+ */
+static eARUPDATER_ERROR ARUPDATER_FileIO_Mmap_MapWindow(ARUPDATER_FileIO_t *file, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int64_t windowOffset = offset - (offset % ARUPDATER_FILEIO_MMAP_WINDOW_SIZE);
+    int64_t windowEnd = windowOffset + ARUPDATER_FILEIO_MMAP_WINDOW_SIZE;
+    struct stat fileStat;
+    int result = 0;
+
+    ARUPDATER_FileIO_Mmap_Unmap(file);
+
+    // a size set from outside, by a preallocation for example, is kept
+    if ((file->isExtended == 0) && (fstat(file->fd, &fileStat) == 0))
+    {
+        file->allocatedSize = (int64_t)fileStat.st_size;
+        if (file->size < file->allocatedSize)
+        {
+            file->size = file->allocatedSize;
+        }
+    }
+
+    // the blocks are reserved so that a full storage fails here, not with a SIGBUS on the copy
+    if (file->allocatedSize < windowEnd)
+    {
+#if defined(__APPLE__)
+        result = (ftruncate(file->fd, (off_t)windowEnd) == 0) ? 0 : errno;
+#else
+        result = posix_fallocate(file->fd, (off_t)file->allocatedSize, (off_t)(windowEnd - file->allocatedSize));
+#endif
+        if (result != 0)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FILEIO_TAG, "cannot extend the file to %lld: %s", (long long)windowEnd, strerror(result));
+            error = ARUPDATER_FileIO_ErrnoToError(result);
+        }
+        else
+        {
+            file->allocatedSize = windowEnd;
+            file->isExtended = 1;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        void *window = mmap(NULL, ARUPDATER_FILEIO_MMAP_WINDOW_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, (off_t)windowOffset);
+        if (window == MAP_FAILED)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            file->window = (uint8_t *)window;
+            file->windowOffset = windowOffset;
+        }
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Mmap_Open(ARUPDATER_FileIO_t *file)
+{
+    void *map = NULL;
+
+    if ((file->mode == ARUPDATER_FILEIO_MODE_READ) && (file->size > 0) && ((uint64_t)file->size <= SIZE_MAX))
+    {
+        // without enough address space, the reads fall back to pread
+        map = mmap(NULL, (size_t)file->size, PROT_READ, MAP_SHARED, file->fd, 0);
+        if (map != MAP_FAILED)
+        {
+            file->readMap = (uint8_t *)map;
+            file->readMapSize = (size_t)file->size;
+#ifdef MADV_SEQUENTIAL
+            madvise(map, file->readMapSize, MADV_SEQUENTIAL);
+#endif
+        }
+    }
+
+    return ARUPDATER_OK;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Mmap_Write(ARUPDATER_FileIO_t *file, const uint8_t *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        if ((file->window == NULL) || (offset < file->windowOffset) || (offset >= file->windowOffset + ARUPDATER_FILEIO_MMAP_WINDOW_SIZE))
+        {
+            error = ARUPDATER_FileIO_Mmap_MapWindow(file, offset);
+        }
+        else
+        {
+            size_t copySize = (size_t)(file->windowOffset + ARUPDATER_FILEIO_MMAP_WINDOW_SIZE - offset);
+            if (copySize > size)
+            {
+                copySize = size;
+            }
+            memcpy(file->window + (offset - file->windowOffset), data, copySize);
+            data += copySize;
+            size -= copySize;
+            offset += copySize;
+        }
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Mmap_Read(ARUPDATER_FileIO_t *file, uint8_t *data, size_t size, int64_t offset, size_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    // the file may have been extended beyond its data
+    if (offset >= file->size)
+    {
+        size = 0;
+    }
+    else if ((int64_t)size > file->size - offset)
+    {
+        size = (size_t)(file->size - offset);
+    }
+
+    if (file->readMap != NULL)
+    {
+        if ((int64_t)size > (int64_t)file->readMapSize - offset)
+        {
+            size = (offset < (int64_t)file->readMapSize) ? file->readMapSize - (size_t)offset : 0;
+        }
+        memcpy(data, file->readMap + offset, size);
+        *readSize = size;
+    }
+    else
+    {
+        // the shared mapping and the page cache are the same pages
+        error = ARUPDATER_FileIO_PreadAll(file->fd, data, size, offset, readSize);
+    }
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_FileIO_Mmap_Flush(ARUPDATER_FileIO_t *file)
+{
+    return ARUPDATER_OK;
+}
+
+static void ARUPDATER_FileIO_Mmap_Close(ARUPDATER_FileIO_t *file)
+{
+    ARUPDATER_FileIO_Mmap_Unmap(file);
+
+    if (file->readMap != NULL)
+    {
+        munmap(file->readMap, file->readMapSize);
+        file->readMap = NULL;
+    }
+
+    // drop the end of the last window
+    if (file->isExtended && (file->allocatedSize > file->size))
+    {
+        if (ftruncate(file->fd, (off_t)file->size) != 0)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FILEIO_TAG, "cannot truncate the file to %lld", (long long)file->size);
+        }
+    }
+}
+
+static const ARUPDATER_FileIO_Ops_t ARUPDATER_FileIO_MmapOps =
+{
+    ARUPDATER_FileIO_Mmap_Open,
+    ARUPDATER_FileIO_Mmap_Write,
+    ARUPDATER_FileIO_Mmap_Read,
+    ARUPDATER_FileIO_Mmap_Flush,
+    ARUPDATER_FileIO_Mmap_Close,
+};
+
+static const ARUPDATER_FileIO_Ops_t *ARUPDATER_FileIO_GetOps(eARUPDATER_FILEIO_BACKEND backend)
+{
+    const ARUPDATER_FileIO_Ops_t *ops = &ARUPDATER_FileIO_PwriteOps;
+
+    switch (backend)
+    {
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+    case ARUPDATER_FILEIO_BACKEND_IO_URING:
+        ops = &ARUPDATER_FileIO_UringOps;
+        break;
+#endif
+    case ARUPDATER_FILEIO_BACKEND_MMAP:
+        ops = &ARUPDATER_FileIO_MmapOps;
+        break;
+    default:
+        break;
+    }
+
+    return ops;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+ARUPDATER_FileIO_t *ARUPDATER_FileIO_New(const char *const filePath, eARUPDATER_FILEIO_MODE mode, eARUPDATER_FILEIO_BACKEND backend, eARUPDATER_ERROR *error)
+{
+    return ARUPDATER_FileIO_NewAt(AT_FDCWD, filePath, mode, backend, error);
+}
+
+ARUPDATER_FileIO_t *ARUPDATER_FileIO_NewAt(int dirFd, const char *const filePath, eARUPDATER_FILEIO_MODE mode, eARUPDATER_FILEIO_BACKEND backend, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_FileIO_t *file = NULL;
+    struct stat fileStat;
+    int flags = O_RDONLY;
+
+    if ((filePath == NULL) || (backend < 0) || (backend >= ARUPDATER_FILEIO_BACKEND_MAX))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        file = calloc(1, sizeof(ARUPDATER_FileIO_t));
+        if (file == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        file->mode = mode;
+        file->fd = -1;
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+        file->ring.fd = -1;
+#endif
+
+        if (backend == ARUPDATER_FILEIO_BACKEND_DEFAULT)
+        {
+            pthread_mutex_lock(&ARUPDATER_FileIO_SelectLock);
+            backend = ARUPDATER_FileIO_DefaultBackend;
+            pthread_mutex_unlock(&ARUPDATER_FileIO_SelectLock);
+        }
+        if (ARUPDATER_FileIO_IsAvailable(backend) == 0)
+        {
+            backend = ARUPDATER_FILEIO_BACKEND_PWRITE;
+        }
+
+        if (mode == ARUPDATER_FILEIO_MODE_WRITE)
+        {
+            // the mapped windows are read back by the system when they are written
+            flags = (backend == ARUPDATER_FILEIO_BACKEND_MMAP) ? (O_RDWR | O_CREAT | O_TRUNC) : (O_WRONLY | O_CREAT | O_TRUNC);
+        }
+        else if (mode == ARUPDATER_FILEIO_MODE_UPDATE)
+        {
+            flags = O_RDWR;
+        }
+
+        file->fd = openat(dirFd, filePath, flags | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if ((file->fd < 0) || (fstat(file->fd, &fileStat) != 0))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FILEIO_TAG, "cannot open %s: %s", filePath, strerror(errno));
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            file->size = (int64_t)fileStat.st_size;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Mutex_Init(&file->readLock) != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            file->hasReadLock = 1;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        file->backend = backend;
+        file->ops = ARUPDATER_FileIO_GetOps(backend);
+        err = file->ops->open(file);
+        if ((err != ARUPDATER_OK) && (backend != ARUPDATER_FILEIO_BACKEND_PWRITE))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FILEIO_TAG, "%s backend not usable for %s, using pwrite", ARUPDATER_FileIO_BackendNames[backend], filePath);
+            file->ops->close(file);
+            file->backend = ARUPDATER_FILEIO_BACKEND_PWRITE;
+            file->ops = &ARUPDATER_FileIO_PwriteOps;
+            err = file->ops->open(file);
+        }
+        if (err != ARUPDATER_OK)
+        {
+            file->ops->close(file);
+            file->ops = NULL;
+        }
+    }
+
+    if (err != ARUPDATER_OK)
+    {
+        ARUPDATER_FileIO_Delete(&file);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return file;
+}
+
+void ARUPDATER_FileIO_Delete(ARUPDATER_FileIO_t **fileAddr)
+{
+    if (fileAddr != NULL)
+    {
+        ARUPDATER_FileIO_t *file = *fileAddr;
+        if (file != NULL)
+        {
+            if (file->ops != NULL)
+            {
+                file->ops->flush(file);
+                file->ops->close(file);
+            }
+            if (file->hasReadLock)
+            {
+                ARSAL_Mutex_Destroy(&file->readLock);
+            }
+            if (file->fd >= 0)
+            {
+                close(file->fd);
+            }
+            free(file);
+        }
+        *fileAddr = NULL;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_FileIO_Write(ARUPDATER_FileIO_t *file, const void *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((file == NULL) || ((data == NULL) && (size > 0)) || (offset < 0) || (file->mode == ARUPDATER_FILEIO_MODE_READ))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (size > 0))
+    {
+        error = file->ops->write(file, (const uint8_t *)data, size, offset);
+    }
+
+    if ((error == ARUPDATER_OK) && (offset + (int64_t)size > file->size))
+    {
+        file->size = offset + (int64_t)size;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_FileIO_Read(ARUPDATER_FileIO_t *file, void *data, size_t size, int64_t offset, size_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int isLocked = 0;
+    size_t dataSize = 0;
+
+    if ((file == NULL) || ((data == NULL) && (size > 0)) || (offset < 0) || (readSize == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    // the io_uring queues are shared by all the reads
+    if ((error == ARUPDATER_OK) && ((file->mode != ARUPDATER_FILEIO_MODE_READ) || (file->backend == ARUPDATER_FILEIO_BACKEND_IO_URING)))
+    {
+        ARSAL_Mutex_Lock(&file->readLock);
+        isLocked = 1;
+    }
+
+    if ((error == ARUPDATER_OK) && (file->mode != ARUPDATER_FILEIO_MODE_READ))
+    {
+        error = file->ops->flush(file);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = file->ops->read(file, (uint8_t *)data, size, offset, &dataSize);
+    }
+
+    if (isLocked)
+    {
+        ARSAL_Mutex_Unlock(&file->readLock);
+    }
+
+    if (readSize != NULL)
+    {
+        *readSize = dataSize;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_FileIO_Flush(ARUPDATER_FileIO_t *file)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if (file == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        error = file->ops->flush(file);
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_FileIO_Truncate(ARUPDATER_FileIO_t *file, int64_t size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((file == NULL) || (size < 0) || (file->mode == ARUPDATER_FILEIO_MODE_READ))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = file->ops->flush(file);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        // the window may go beyond the new end of the file
+        ARUPDATER_FileIO_Mmap_Unmap(file);
+        if (ftruncate(file->fd, (off_t)size) != 0)
+        {
+            error = ARUPDATER_FileIO_ErrnoToError(errno);
+        }
+        else
+        {
+            file->size = size;
+            file->allocatedSize = size;
+            file->isExtended = 0;
+        }
+    }
+
+    return error;
+}
+
+int ARUPDATER_FileIO_GetFd(ARUPDATER_FileIO_t *file)
+{
+    return (file != NULL) ? file->fd : -1;
+}
+
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_GetBackend(ARUPDATER_FileIO_t *file)
+{
+    return (file != NULL) ? file->backend : ARUPDATER_FILEIO_BACKEND_MAX;
+}
+
+const char *ARUPDATER_FileIO_GetBackendName(eARUPDATER_FILEIO_BACKEND backend)
+{
+    return ((backend >= 0) && (backend < ARUPDATER_FILEIO_BACKEND_MAX)) ? ARUPDATER_FileIO_BackendNames[backend] : NULL;
+}
+
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_GetBackendFromName(const char *const name)
+{
+    eARUPDATER_FILEIO_BACKEND backend = ARUPDATER_FILEIO_BACKEND_MAX;
+    int i = 0;
+
+    for (i = 0; (name != NULL) && (i < ARUPDATER_FILEIO_BACKEND_MAX); i++)
+    {
+        if (strcasecmp(name, ARUPDATER_FileIO_BackendNames[i]) == 0)
+        {
+            backend = (eARUPDATER_FILEIO_BACKEND)i;
+            break;
+        }
+    }
+
+    return backend;
+}
+
+int ARUPDATER_FileIO_IsAvailable(eARUPDATER_FILEIO_BACKEND backend)
+{
+    int isAvailable = 0;
+
+    switch (backend)
+    {
+    case ARUPDATER_FILEIO_BACKEND_DEFAULT:
+    case ARUPDATER_FILEIO_BACKEND_PWRITE:
+    case ARUPDATER_FILEIO_BACKEND_MMAP:
+        isAvailable = 1;
+        break;
+    case ARUPDATER_FILEIO_BACKEND_IO_URING:
+#ifdef ARUPDATER_FILEIO_HAS_IO_URING
+        pthread_once(&ARUPDATER_FileIO_UringOnce, ARUPDATER_FileIO_CheckUring);
+        isAvailable = ARUPDATER_FileIO_UringIsAvailable;
+#endif
+        break;
+    default:
+        break;
+    }
+
+    return isAvailable;
+}
+
+eARUPDATER_ERROR ARUPDATER_FileIO_Benchmark(const char *const folder, eARUPDATER_FILEIO_BACKEND backend, int64_t size, int64_t *writeTimeUs, int64_t *readTimeUs)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_t *file = NULL;
+    char *filePath = NULL;
+    int isCreated = 0;
+    uint8_t *buffer = NULL;
+    int64_t offset = 0;
+    int64_t startTime = 0;
+    size_t readSize = 0;
+    int fd = -1;
+    size_t i = 0;
+
+    if ((folder == NULL) || (size <= 0) || (writeTimeUs == NULL) || (readTimeUs == NULL) || (ARUPDATER_FileIO_IsAvailable(backend) == 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        filePath = malloc(strlen(folder) + strlen(ARUPDATER_FILEIO_BENCHMARK_FILE_NAME) + 1);
+        buffer = malloc(ARUPDATER_FILEIO_BLOCK_SIZE);
+        if ((filePath == NULL) || (buffer == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        strcpy(filePath, folder);
+        strcat(filePath, ARUPDATER_FILEIO_BENCHMARK_FILE_NAME);
+        fd = mkstemp(filePath);
+        if (fd < 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            isCreated = 1;
+            close(fd);
+        }
+
+        // data the storage can not compress
+        for (i = 0; i < ARUPDATER_FILEIO_BLOCK_SIZE; i++)
+        {
+            buffer[i] = (uint8_t)((i * 2654435761u) >> 24);
+        }
+    }
+
+    // written in the pieces given by a download, until the data is on the storage
+    if (error == ARUPDATER_OK)
+    {
+        startTime = ARUPDATER_FileIO_GetTimeUs();
+        file = ARUPDATER_FileIO_New(filePath, ARUPDATER_FILEIO_MODE_WRITE, backend, &error);
+        for (offset = 0; (error == ARUPDATER_OK) && (offset < size); offset += ARUPDATER_FILEIO_BENCHMARK_WRITE_SIZE)
+        {
+            size_t writeSize = ((size - offset) < ARUPDATER_FILEIO_BENCHMARK_WRITE_SIZE) ? (size_t)(size - offset) : ARUPDATER_FILEIO_BENCHMARK_WRITE_SIZE;
+            error = ARUPDATER_FileIO_Write(file, buffer + (offset % ARUPDATER_FILEIO_BLOCK_SIZE), writeSize, offset);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_FileIO_Flush(file);
+        }
+        if ((error == ARUPDATER_OK) && (fsync(ARUPDATER_FileIO_GetFd(file)) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        ARUPDATER_FileIO_Delete(&file);
+        *writeTimeUs = ARUPDATER_FileIO_GetTimeUs() - startTime;
+    }
+
+#ifdef POSIX_FADV_DONTNEED
+    if (error == ARUPDATER_OK)
+    {
+        fd = open(filePath, O_RDONLY);
+        if (fd >= 0)
+        {
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+    }
+#endif
+
+    // read back in the blocks used to hash a file
+    if (error == ARUPDATER_OK)
+    {
+        startTime = ARUPDATER_FileIO_GetTimeUs();
+        file = ARUPDATER_FileIO_New(filePath, ARUPDATER_FILEIO_MODE_READ, backend, &error);
+        offset = 0;
+        do
+        {
+            if (error == ARUPDATER_OK)
+            {
+                error = ARUPDATER_FileIO_Read(file, buffer, ARUPDATER_FILEIO_BLOCK_SIZE, offset, &readSize);
+                offset += readSize;
+            }
+        } while ((error == ARUPDATER_OK) && (readSize > 0));
+        ARUPDATER_FileIO_Delete(&file);
+        *readTimeUs = ARUPDATER_FileIO_GetTimeUs() - startTime;
+
+        if ((error == ARUPDATER_OK) && (offset != size))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (isCreated)
+    {
+        unlink(filePath);
+    }
+    free(filePath);
+    free(buffer);
+
+    return error;
+}
+
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_SelectBackend(const char *const folder)
+{
+    eARUPDATER_FILEIO_BACKEND selected = ARUPDATER_FILEIO_BACKEND_PWRITE;
+    int64_t bestTimeUs = -1;
+    int backend = 0;
+
+    pthread_mutex_lock(&ARUPDATER_FileIO_SelectLock);
+
+    for (backend = ARUPDATER_FILEIO_BACKEND_PWRITE; (ARUPDATER_FileIO_IsSelected == 0) && (folder != NULL) && (backend < ARUPDATER_FILEIO_BACKEND_MAX); backend++)
+    {
+        int64_t writeTimeUs = 0;
+        int64_t readTimeUs = 0;
+
+        if ((ARUPDATER_FileIO_IsAvailable(backend)) && (ARUPDATER_FileIO_Benchmark(folder, backend, ARUPDATER_FILEIO_SELECT_SIZE, &writeTimeUs, &readTimeUs) == ARUPDATER_OK))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_FILEIO_TAG, "%s: write %lld us, read %lld us", ARUPDATER_FileIO_BackendNames[backend], (long long)writeTimeUs, (long long)readTimeUs);
+            if ((bestTimeUs < 0) || (writeTimeUs + readTimeUs < bestTimeUs))
+            {
+                bestTimeUs = writeTimeUs + readTimeUs;
+                selected = (eARUPDATER_FILEIO_BACKEND)backend;
+            }
+        }
+    }
+
+    // measured again on the next call if the storage could not be written
+    if (bestTimeUs >= 0)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_INFO, ARUPDATER_FILEIO_TAG, "%s backend selected for %s", ARUPDATER_FileIO_BackendNames[selected], folder);
+        ARUPDATER_FileIO_DefaultBackend = selected;
+        ARUPDATER_FileIO_IsSelected = 1;
+    }
+    selected = ARUPDATER_FileIO_DefaultBackend;
+
+    pthread_mutex_unlock(&ARUPDATER_FileIO_SelectLock);
+
+    return selected;
+}
@@ -0,0 +1,209 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_FileIO.h
+ * @brief libARUpdater file io header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FILEIO_PRIVATE_H_
+#define _ARUPDATER_FILEIO_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+
+/**
+ * @brief Size of the data written by each backend in one system call
+ */
+#define ARUPDATER_FILEIO_BLOCK_SIZE         (1024 * 1024)
+
+/**
+ * @brief Size of the file written and read by ARUPDATER_FileIO_SelectBackend for each backend
+ */
+#define ARUPDATER_FILEIO_SELECT_SIZE        (8 * 1024 * 1024)
+
+/**
+ * @brief Backends moving the plf bytes between the memory and the storage
+ * @details The uploads do not go through these backends: ARUPDATER_Ftp_Put () gives the plain descriptor of the plf to sendfile, and reads it with pread when sendfile is not supported
+ */
+typedef enum
+{
+    ARUPDATER_FILEIO_BACKEND_DEFAULT = 0,   /**< Backend chosen by ARUPDATER_FileIO_SelectBackend, buffered pwrite until it has been called */
+    ARUPDATER_FILEIO_BACKEND_PWRITE,        /**< "pwrite" : writes gathered in page aligned blocks of ARUPDATER_FILEIO_BLOCK_SIZE, pread */
+    ARUPDATER_FILEIO_BACKEND_IO_URING,      /**< "io_uring" : blocks written in the background while the next ones are filled, reads split in a batch of requests. Linux only */
+    ARUPDATER_FILEIO_BACKEND_MMAP,          /**< "mmap" : copies into windows of the file mapped in memory */
+    ARUPDATER_FILEIO_BACKEND_MAX,           /**< Unknown backend */
+} eARUPDATER_FILEIO_BACKEND;
+
+/**
+ * @brief Ways to open a file
+ */
+typedef enum
+{
+    ARUPDATER_FILEIO_MODE_READ = 0,         /**< Read an existing file */
+    ARUPDATER_FILEIO_MODE_WRITE,            /**< Create the file, or empty it if it exists */
+    ARUPDATER_FILEIO_MODE_UPDATE,           /**< Read and write an existing file */
+} eARUPDATER_FILEIO_MODE;
+
+/**
+ * @brief File opened through one of the backends
+ * @details The reads of a file opened with ARUPDATER_FILEIO_MODE_READ can be done from several threads at once, the other calls must not be concurrent
+ * @see ARUPDATER_FileIO_New ()
+ */
+typedef struct ARUPDATER_FileIO_t ARUPDATER_FileIO_t;
+
+/**
+ * @brief Open a file
+ * @warning This function allocates memory
+ * @param[in] filePath : path of the file
+ * @param[in] mode : the way to open the file
+ * @param[in] backend : the backend to use, an unavailable backend is replaced by the buffered pwrite one
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the opened file, NULL if an error occurred
+ * @see ARUPDATER_FileIO_Delete ()
+ */
+ARUPDATER_FileIO_t *ARUPDATER_FileIO_New(const char *const filePath, eARUPDATER_FILEIO_MODE mode, eARUPDATER_FILEIO_BACKEND backend, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Open a file of an opened folder
+ * @see ARUPDATER_FileIO_New ()
+ * @param[in] dirFd : descriptor of the folder, AT_FDCWD for the current folder
+ * @param[in] filePath : path of the file, relative to the folder
+ * @param[in] mode : the way to open the file
+ * @param[in] backend : the backend to use, an unavailable backend is replaced by the buffered pwrite one
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the opened file, NULL if an error occurred
+ */
+ARUPDATER_FileIO_t *ARUPDATER_FileIO_NewAt(int dirFd, const char *const filePath, eARUPDATER_FILEIO_MODE mode, eARUPDATER_FILEIO_BACKEND backend, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Close a file, the pending writes are flushed
+ * @warning This function frees memory
+ * @param fileAddr : address of the pointer on the file
+ * @see ARUPDATER_FileIO_Flush () to get the errors of the pending writes
+ */
+void ARUPDATER_FileIO_Delete(ARUPDATER_FileIO_t **fileAddr);
+
+/**
+ * @brief Write data into a file
+ * @details Contiguous writes are gathered, the data may only reach the file on the next flush
+ * @param file : pointer on the file
+ * @param[in] data : the data
+ * @param[in] size : size of the data
+ * @param[in] offset : position of the data in the file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE if the storage is full, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FileIO_Write(ARUPDATER_FileIO_t *file, const void *data, size_t size, int64_t offset);
+
+/**
+ * @brief Read data from a file opened with ARUPDATER_FILEIO_MODE_READ or ARUPDATER_FILEIO_MODE_UPDATE
+ * @details The pending writes of an updated file are flushed first, so that they are read. A file opened with ARUPDATER_FILEIO_MODE_WRITE can not be read
+ * @param file : pointer on the file
+ * @param[out] data : buffer receiving the data
+ * @param[in] size : size of the buffer
+ * @param[in] offset : position of the data in the file
+ * @param[out] readSize : number of bytes read, lower than size only at the end of the file
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FileIO_Read(ARUPDATER_FileIO_t *file, void *data, size_t size, int64_t offset, size_t *readSize);
+
+/**
+ * @brief Hand the pending writes of a file to the system
+ * @param file : pointer on the file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE if the storage is full, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FileIO_Flush(ARUPDATER_FileIO_t *file);
+
+/**
+ * @brief Set the size of a file, after flushing its pending writes
+ * @param file : pointer on the file
+ * @param[in] size : the new size
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FileIO_Truncate(ARUPDATER_FileIO_t *file, int64_t size);
+
+/**
+ * @brief Get the file descriptor of a file, to preallocate it for example
+ * @param file : pointer on the file
+ * @return the file descriptor, -1 if file is NULL
+ */
+int ARUPDATER_FileIO_GetFd(ARUPDATER_FileIO_t *file);
+
+/**
+ * @brief Get the backend used by a file
+ * @param file : pointer on the file
+ * @return the backend, ARUPDATER_FILEIO_BACKEND_MAX if file is NULL
+ */
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_GetBackend(ARUPDATER_FileIO_t *file);
+
+/**
+ * @brief Get the name of a backend
+ * @param[in] backend : the backend
+ * @return the name, NULL if the backend is unknown
+ */
+const char *ARUPDATER_FileIO_GetBackendName(eARUPDATER_FILEIO_BACKEND backend);
+
+/**
+ * @brief Get a backend from its name
+ * @param[in] name : the name of the backend
+ * @return the backend, ARUPDATER_FILEIO_BACKEND_MAX if the name is unknown
+ */
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_GetBackendFromName(const char *const name);
+
+/**
+ * @brief Check if a backend can be used on this system
+ * @param[in] backend : the backend
+ * @return 1 if the backend can be used, 0 otherwise
+ */
+int ARUPDATER_FileIO_IsAvailable(eARUPDATER_FILEIO_BACKEND backend);
+
+/**
+ * @brief Measure a backend on a storage
+ * @details A temporary file is written the way a download writes it and synced, then read back the way it is hashed, out of the page cache when the system allows it
+ * @param[in] folder : folder on the storage to measure, ended by a folder separator
+ * @param[in] backend : the backend
+ * @param[in] size : number of bytes written and read
+ * @param[out] writeTimeUs : time of the writes in microseconds
+ * @param[out] readTimeUs : time of the reads in microseconds
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_FileIO_Benchmark(const char *const folder, eARUPDATER_FILEIO_BACKEND backend, int64_t size, int64_t *writeTimeUs, int64_t *readTimeUs);
+
+/**
+ * @brief Choose the fastest backend on a storage as ARUPDATER_FILEIO_BACKEND_DEFAULT
+ * @details The backends are measured with ARUPDATER_FILEIO_SELECT_SIZE bytes on the first call only, the next calls return the same backend
+ * @param[in] folder : folder on the storage where the plf files are written, ended by a folder separator
+ * @return the backend selected
+ */
+eARUPDATER_FILEIO_BACKEND ARUPDATER_FileIO_SelectBackend(const char *const folder);
+
+#endif /* _ARUPDATER_FILEIO_PRIVATE_H_ */
@@ -0,0 +1,722 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Fleet.c
+ * @brief libARUpdater Fleet c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+#include <libARSAL/ARSAL_Thread.h>
+#include "ARUPDATER_Manager.h"
+
+#include "ARUPDATER_Fleet.h"
+#include "ARUPDATER_Downloader.h"
+#include "ARUPDATER_Uploader.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_FLEET_TAG                     "ARUPDATER_Fleet"
+#define ARUPDATER_FLEET_DEVICES_MIN_CAPACITY    16
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static int64_t ARUPDATER_Fleet_GetTimeUs(void)
+{
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * @brief Get the distinct products of the devices
+ * @param[out] products : array of deviceCount products
+ * @return the number of distinct products
+ */
+static int ARUPDATER_Fleet_GetProducts(ARUPDATER_Fleet_t *fleet, eARDISCOVERY_PRODUCT *products)
+{
+    int productCount = 0;
+    int i = 0;
+    int j = 0;
+    
+    for (i = 0; i < fleet->deviceCount; i++)
+    {
+        for (j = 0; (j < productCount) && (products[j] != fleet->devices[i].status.product); j++);
+        if (j == productCount)
+        {
+            products[productCount] = fleet->devices[i].status.product;
+            productCount++;
+        }
+    }
+    
+    return productCount;
+}
+
+static void ARUPDATER_Fleet_SetState(ARUPDATER_Fleet_t *fleet, int device, eARUPDATER_FLEET_DEVICE_STATE state, eARUPDATER_ERROR error)
+{
+    ARSAL_Mutex_Lock(&fleet->lock);
+    fleet->devices[device].status.state = state;
+    fleet->devices[device].status.error = error;
+    ARSAL_Mutex_Unlock(&fleet->lock);
+    
+    if (fleet->stateCallback != NULL)
+    {
+        fleet->stateCallback(fleet->stateArg, device, state, error);
+    }
+}
+
+static void ARUPDATER_Fleet_ProgressCallback(void *arg, float percent)
+{
+    ARUPDATER_Fleet_Slot_t *slot = (ARUPDATER_Fleet_Slot_t *)arg;
+    
+    ARSAL_Mutex_Lock(&slot->fleet->lock);
+    if (slot->device >= 0)
+    {
+        slot->fleet->devices[slot->device].status.percent = percent;
+    }
+    ARSAL_Mutex_Unlock(&slot->fleet->lock);
+}
+
+/**
+ * @brief Check and download the plf of each distinct product of the devices, once
+ */
+static eARUPDATER_ERROR ARUPDATER_Fleet_Download(ARUPDATER_Fleet_t *fleet)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARUPDATER_ERROR deleteError = ARUPDATER_OK;
+    ARUPDATER_Manager_t *manager = NULL;
+    eARDISCOVERY_PRODUCT *products = NULL;
+    int productCount = 0;
+    
+    products = malloc(fleet->deviceCount * sizeof(eARDISCOVERY_PRODUCT));
+    if (products == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    else
+    {
+        productCount = ARUPDATER_Fleet_GetProducts(fleet, products);
+        manager = ARUPDATER_Manager_New(&error);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Manager_SetPlfStorage(manager, fleet->plfStorage);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Downloader_New(manager, fleet->rootFolder, fleet->md5Manager, fleet->appPlatform, fleet->appVersion, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Downloader_SetUpdatesProductList(manager, products, productCount);
+    }
+    
+    // the manager is visible to ARUPDATER_Fleet_CancelThread during the download
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        fleet->downloadManager = manager;
+        ARSAL_Mutex_Unlock(&fleet->lock);
+        
+        if (fleet->isCanceled == 0)
+        {
+            error = (eARUPDATER_ERROR)(intptr_t)ARUPDATER_Downloader_ThreadRun(manager);
+        }
+        
+        ARSAL_Mutex_Lock(&fleet->lock);
+        fleet->downloadManager = NULL;
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    if ((manager != NULL) && (manager->downloader != NULL))
+    {
+        deleteError = ARUPDATER_Downloader_Delete(manager);
+        if (error == ARUPDATER_OK)
+        {
+            error = deleteError;
+        }
+    }
+    ARUPDATER_Manager_Delete(&manager);
+    free(products);
+    
+    return error;
+}
+
+/**
+ * @brief Upload the plf to the devices left, one after the other, until there is none or the update is canceled
+ */
+static void* ARUPDATER_Fleet_SlotRun(void *arg)
+{
+    ARUPDATER_Fleet_Slot_t *slot = (ARUPDATER_Fleet_Slot_t *)arg;
+    ARUPDATER_Fleet_t *fleet = slot->fleet;
+    ARUPDATER_Fleet_Device_t *device = NULL;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARUPDATER_FLEET_DEVICE_STATE state = ARUPDATER_FLEET_DEVICE_STATE_WAITING;
+    int index = -1;
+    int64_t now = 0;
+    
+    do
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        index = -1;
+        if ((fleet->isCanceled == 0) && (fleet->nextDevice < fleet->deviceCount))
+        {
+            index = fleet->nextDevice;
+            fleet->nextDevice++;
+            
+            device = &fleet->devices[index];
+            device->uploadStartUs = ARUPDATER_Fleet_GetTimeUs();
+            if (fleet->uploadStartUs == 0)
+            {
+                fleet->uploadStartUs = device->uploadStartUs;
+            }
+            slot->device = index;
+            
+            // the uploader is created under the lock, ARUPDATER_Fleet_CancelThread may cancel it at once
+            error = ARUPDATER_Uploader_New(slot->manager, fleet->rootFolder, device->ftpManager, fleet->md5Manager, device->status.product, ARUPDATER_Fleet_ProgressCallback, slot, NULL, NULL);
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+        
+        if (index >= 0)
+        {
+            ARUPDATER_Fleet_SetState(fleet, index, ARUPDATER_FLEET_DEVICE_STATE_UPLOADING, ARUPDATER_OK);
+            
+            if (error == ARUPDATER_OK)
+            {
+                error = (eARUPDATER_ERROR)(intptr_t)ARUPDATER_Uploader_ThreadRun(slot->manager);
+                
+                ARSAL_Mutex_Lock(&fleet->lock);
+                ARUPDATER_Uploader_Delete(slot->manager);
+                ARSAL_Mutex_Unlock(&fleet->lock);
+            }
+            
+            // a canceled uploader stops without error
+            if (fleet->isCanceled != 0)
+            {
+                state = ARUPDATER_FLEET_DEVICE_STATE_CANCELED;
+                error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+            }
+            else
+            {
+                state = (error == ARUPDATER_OK) ? ARUPDATER_FLEET_DEVICE_STATE_DONE : ARUPDATER_FLEET_DEVICE_STATE_FAILED;
+            }
+            
+            now = ARUPDATER_Fleet_GetTimeUs();
+            ARSAL_Mutex_Lock(&fleet->lock);
+            slot->device = -1;
+            device->status.uploadTimeUs = now - device->uploadStartUs;
+            if (now > fleet->uploadEndUs)
+            {
+                fleet->uploadEndUs = now;
+            }
+            ARSAL_Mutex_Unlock(&fleet->lock);
+            
+            ARUPDATER_Fleet_SetState(fleet, index, state, error);
+        }
+    }
+    while (index >= 0);
+    
+    return NULL;
+}
+
+/* ***************************************
+ *
+ *             function implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Fleet_t* ARUPDATER_Fleet_New(const char *const rootFolder, ARSAL_MD5_Manager_t *md5Manager, int maxConcurrentUploads, ARUPDATER_Fleet_DeviceStateCallback_t stateCallback, void *stateArg, eARUPDATER_ERROR *error)
+{
+    ARUPDATER_Fleet_t *fleet = NULL;
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int i = 0;
+    
+    /* Check parameters */
+    if ((rootFolder == NULL) || (md5Manager == NULL) || (maxConcurrentUploads < 1))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        /* Create the Fleet */
+        fleet = calloc(1, sizeof(ARUPDATER_Fleet_t));
+        if (fleet == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    /* Initialize to default values */
+    if (err == ARUPDATER_OK)
+    {
+        fleet->rootFolder = strdup(rootFolder);
+        if (fleet->rootFolder == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        
+        fleet->md5Manager = md5Manager;
+        fleet->maxConcurrentUploads = (maxConcurrentUploads < ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS) ? maxConcurrentUploads : ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS;
+        fleet->plfStorage = ARUPDATER_MANAGER_PLF_STORAGE_FOLDERS;
+        fleet->stateCallback = stateCallback;
+        fleet->stateArg = stateArg;
+        for (i = 0; i < ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS; i++)
+        {
+            fleet->slots[i].fleet = fleet;
+            fleet->slots[i].device = -1;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Mutex_Init(&fleet->lock) != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
+    /* delete the Fleet if an error occurred */
+    if ((err != ARUPDATER_OK) && (fleet != NULL))
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_FLEET_TAG, "error: %s", ARUPDATER_Error_ToString (err));
+        free(fleet->rootFolder);
+        free(fleet);
+        fleet = NULL;
+    }
+    
+    /* return the error */
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return fleet;
+}
+
+void ARUPDATER_Fleet_Delete(ARUPDATER_Fleet_t **fleetPtrAddr)
+{
+    if (fleetPtrAddr != NULL)
+    {
+        ARUPDATER_Fleet_t *fleet = *fleetPtrAddr;
+        
+        if ((fleet != NULL) && (fleet->isRunning == 0))
+        {
+            ARSAL_Mutex_Destroy(&fleet->lock);
+            free(fleet->devices);
+            free(fleet->appVersion);
+            free(fleet->rootFolder);
+            
+            free(fleet);
+            *fleetPtrAddr = NULL;
+        }
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Fleet_SetUpdatesCheck(ARUPDATER_Fleet_t *fleet, eARUPDATER_Downloader_Platforms appPlatform, const char *const appVersion)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *version = NULL;
+    
+    if ((fleet == NULL) || (appVersion == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (fleet->isRunning != 0)
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        version = strdup(appVersion);
+        if (version == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        free(fleet->appVersion);
+        fleet->appVersion = version;
+        fleet->appPlatform = appPlatform;
+        fleet->isUpdatesChecked = 1;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Fleet_SetPlfStorage(ARUPDATER_Fleet_t *fleet, eARUPDATER_Manager_PlfStorage storage)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((fleet == NULL) || (storage < 0) || (storage >= ARUPDATER_MANAGER_PLF_STORAGE_MAX))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (fleet->isRunning != 0)
+    {
+        error = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    else
+    {
+        fleet->plfStorage = storage;
+    }
+    
+    return error;
+}
+
+int ARUPDATER_Fleet_AddDevice(ARUPDATER_Fleet_t *fleet, ARUTILS_Manager_t *ftpManager, eARDISCOVERY_PRODUCT product, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Fleet_Device_t *device = NULL;
+    int index = -1;
+    
+    if ((fleet == NULL) || (ftpManager == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (fleet->isRunning != 0)
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (fleet->deviceCount == fleet->deviceCapacity))
+    {
+        int capacity = (fleet->deviceCapacity > 0) ? fleet->deviceCapacity * 2 : ARUPDATER_FLEET_DEVICES_MIN_CAPACITY;
+        ARUPDATER_Fleet_Device_t *devices = NULL;
+        
+        ARSAL_Mutex_Lock(&fleet->lock);
+        devices = realloc(fleet->devices, capacity * sizeof(ARUPDATER_Fleet_Device_t));
+        if (devices == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            fleet->devices = devices;
+            fleet->deviceCapacity = capacity;
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        index = fleet->deviceCount;
+        device = &fleet->devices[index];
+        memset(device, 0, sizeof(ARUPDATER_Fleet_Device_t));
+        device->ftpManager = ftpManager;
+        device->status.product = product;
+        device->status.state = ARUPDATER_FLEET_DEVICE_STATE_WAITING;
+        device->status.error = ARUPDATER_OK;
+        fleet->deviceCount++;
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return index;
+}
+
+eARUPDATER_ERROR ARUPDATER_Fleet_GetDeviceStatus(ARUPDATER_Fleet_t *fleet, int device, ARUPDATER_Fleet_DeviceStatus_t *status)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((fleet == NULL) || (status == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        if ((device < 0) || (device >= fleet->deviceCount))
+        {
+            error = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+        else
+        {
+            *status = fleet->devices[device].status;
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Fleet_GetSummary(ARUPDATER_Fleet_t *fleet, ARUPDATER_Fleet_Summary_t *summary)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARDISCOVERY_PRODUCT *products = NULL;
+    int i = 0;
+    
+    if ((fleet == NULL) || (summary == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        memset(summary, 0, sizeof(ARUPDATER_Fleet_Summary_t));
+        summary->deviceCount = fleet->deviceCount;
+        
+        products = malloc((fleet->deviceCount > 0) ? fleet->deviceCount * sizeof(eARDISCOVERY_PRODUCT) : 1);
+        if (products == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            summary->productCount = ARUPDATER_Fleet_GetProducts(fleet, products);
+        }
+        
+        for (i = 0; i < fleet->deviceCount; i++)
+        {
+            summary->stateCount[fleet->devices[i].status.state]++;
+        }
+        
+        summary->downloadError = fleet->downloadError;
+        summary->downloadTimeUs = fleet->downloadTimeUs;
+        if (fleet->uploadStartUs != 0)
+        {
+            // the uploads still running count up to now
+            summary->uploadTimeUs = ((summary->stateCount[ARUPDATER_FLEET_DEVICE_STATE_UPLOADING] > 0) ? ARUPDATER_Fleet_GetTimeUs() : fleet->uploadEndUs) - fleet->uploadStartUs;
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+        
+        free(products);
+    }
+    
+    return error;
+}
+
+void* ARUPDATER_Fleet_ThreadRun(void *fleetArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Fleet_t *fleet = (ARUPDATER_Fleet_t *)fleetArg;
+    ARSAL_Thread_t threads[ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS];
+    int64_t start = 0;
+    int slotCount = 0;
+    int threadCount = 0;
+    int i = 0;
+    
+    if (fleet == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        fleet->isRunning = 1;
+        
+        ARSAL_Mutex_Lock(&fleet->lock);
+        for (i = 0; i < fleet->deviceCount; i++)
+        {
+            eARDISCOVERY_PRODUCT product = fleet->devices[i].status.product;
+            memset(&fleet->devices[i].status, 0, sizeof(ARUPDATER_Fleet_DeviceStatus_t));
+            fleet->devices[i].status.product = product;
+            fleet->devices[i].status.state = ARUPDATER_FLEET_DEVICE_STATE_WAITING;
+            fleet->devices[i].status.error = ARUPDATER_OK;
+            fleet->devices[i].uploadStartUs = 0;
+        }
+        fleet->nextDevice = 0;
+        fleet->isCanceled = 0;
+        fleet->downloadError = ARUPDATER_OK;
+        fleet->downloadTimeUs = 0;
+        fleet->uploadStartUs = 0;
+        fleet->uploadEndUs = 0;
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    // the plf of a product is checked and downloaded once for all its devices
+    // the devices are still updated with the plf files already there if the download fails
+    if ((error == ARUPDATER_OK) && (fleet->isUpdatesChecked != 0) && (fleet->deviceCount > 0))
+    {
+        start = ARUPDATER_Fleet_GetTimeUs();
+        fleet->downloadError = ARUPDATER_Fleet_Download(fleet);
+        fleet->downloadTimeUs = ARUPDATER_Fleet_GetTimeUs() - start;
+        
+        if (fleet->downloadError != ARUPDATER_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FLEET_TAG, "download: %s, the local plf files are uploaded", ARUPDATER_Error_ToString(fleet->downloadError));
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        slotCount = (fleet->deviceCount < fleet->maxConcurrentUploads) ? fleet->deviceCount : fleet->maxConcurrentUploads;
+        
+        // each slot has its manager, the uploader of a manager sends to one device at a time
+        for (i = 0; (error == ARUPDATER_OK) && (i < slotCount); i++)
+        {
+            ARUPDATER_Manager_t *manager = ARUPDATER_Manager_New(&error);
+            if (error == ARUPDATER_OK)
+            {
+                error = ARUPDATER_Manager_SetPlfStorage(manager, fleet->plfStorage);
+            }
+            
+            ARSAL_Mutex_Lock(&fleet->lock);
+            fleet->slots[i].manager = manager;
+            ARSAL_Mutex_Unlock(&fleet->lock);
+        }
+        
+        // each slot takes the next waiting device once its upload is over, the calling thread runs the first one
+        for (threadCount = 1; (error == ARUPDATER_OK) && (threadCount < slotCount); threadCount++)
+        {
+            if (ARSAL_Thread_Create(&threads[threadCount], ARUPDATER_Fleet_SlotRun, &fleet->slots[threadCount]) != 0)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_FLEET_TAG, "only %d concurrent uploads", threadCount);
+                break;
+            }
+        }
+        
+        if ((error == ARUPDATER_OK) && (slotCount > 0))
+        {
+            ARUPDATER_Fleet_SlotRun(&fleet->slots[0]);
+        }
+        
+        for (i = 1; i < threadCount; i++)
+        {
+            ARSAL_Thread_Join(threads[i], NULL);
+            ARSAL_Thread_Destroy(&threads[i]);
+        }
+        
+        ARSAL_Mutex_Lock(&fleet->lock);
+        for (i = 0; i < slotCount; i++)
+        {
+            ARUPDATER_Manager_Delete(&fleet->slots[i].manager);
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    if (fleet != NULL)
+    {
+        // the devices which have not been started are canceled
+        for (i = 0; i < fleet->deviceCount; i++)
+        {
+            if (fleet->devices[i].status.state == ARUPDATER_FLEET_DEVICE_STATE_WAITING)
+            {
+                ARUPDATER_Fleet_SetState(fleet, i, ARUPDATER_FLEET_DEVICE_STATE_CANCELED, (error != ARUPDATER_OK) ? error : ARUPDATER_ERROR_UPLOADER_CANCELED);
+            }
+            if (error == ARUPDATER_OK)
+            {
+                error = fleet->devices[i].status.error;
+            }
+        }
+        
+        fleet->isRunning = 0;
+    }
+    
+    if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_FLEET_TAG, "error: %s", ARUPDATER_Error_ToString (error));
+    }
+    
+    return (void*)error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Fleet_CancelThread(ARUPDATER_Fleet_t *fleet)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int i = 0;
+    
+    if (fleet == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&fleet->lock);
+        fleet->isCanceled = 1;
+        
+        if ((fleet->downloadManager != NULL) && (fleet->downloadManager->downloader != NULL))
+        {
+            ARUPDATER_Downloader_CancelThread(fleet->downloadManager);
+        }
+        
+        for (i = 0; i < ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS; i++)
+        {
+            if ((fleet->slots[i].manager != NULL) && (fleet->slots[i].manager->uploader != NULL))
+            {
+                ARUPDATER_Uploader_CancelThread(fleet->slots[i].manager);
+            }
+        }
+        ARSAL_Mutex_Unlock(&fleet->lock);
+    }
+    
+    return error;
+}
+
+int ARUPDATER_Fleet_ThreadIsRunning(ARUPDATER_Fleet_t *fleet, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int isRunning = 0;
+    
+    if (fleet == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        isRunning = fleet->isRunning;
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return isRunning;
+}
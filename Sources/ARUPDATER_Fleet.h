@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Fleet.h
+ * @brief libARUpdater Fleet private header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FLEET_PRIVATE_H_
+#define _ARUPDATER_FLEET_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Fleet.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+/**
+ * @brief Device to update
+ */
+typedef struct
+{
+    ARUTILS_Manager_t *ftpManager;
+    ARUPDATER_Fleet_DeviceStatus_t status; /**< protected by the lock of the fleet */
+    int64_t uploadStartUs;
+} ARUPDATER_Fleet_Device_t;
+
+/**
+ * @brief Upload slot, a manager holding the uploader of the device being updated
+ */
+typedef struct
+{
+    struct ARUPDATER_Fleet_t *fleet;
+    ARUPDATER_Manager_t *manager;
+    int device; /**< index of the device being updated, -1 if none */
+} ARUPDATER_Fleet_Slot_t;
+
+struct ARUPDATER_Fleet_t
+{
+    char *rootFolder;
+    ARSAL_MD5_Manager_t *md5Manager;
+    int maxConcurrentUploads;
+    eARUPDATER_Manager_PlfStorage plfStorage;
+    
+    int isUpdatesChecked;
+    eARUPDATER_Downloader_Platforms appPlatform;
+    char *appVersion;
+    
+    ARUPDATER_Fleet_Device_t *devices;
+    int deviceCount;
+    int deviceCapacity;
+    int nextDevice; /**< index of the next device to upload, protected by lock */
+    
+    ARUPDATER_Manager_t *downloadManager; /**< manager of the shared download, protected by lock */
+    ARUPDATER_Fleet_Slot_t slots[ARUPDATER_FLEET_MAX_CONCURRENT_UPLOADS];
+    
+    int isRunning;
+    volatile int isCanceled;
+    
+    eARUPDATER_ERROR downloadError;
+    int64_t downloadTimeUs;
+    int64_t uploadStartUs;
+    int64_t uploadEndUs;
+    
+    ARSAL_Mutex_t lock;
+    
+    ARUPDATER_Fleet_DeviceStateCallback_t stateCallback;
+    void *stateArg;
+};
+
+#endif
@@ -0,0 +1,1168 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Ftp.c
+ * @brief libARUpdater Ftp c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#if defined(__linux__)
+#include <signal.h>
+#include <pthread.h>
+#include <sys/sendfile.h>
+#define ARUPDATER_FTP_HAS_SENDFILE
+#endif
+
+#include "ARUPDATER_Ftp.h"
+#include "ARUPDATER_Md5.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_FTP_TAG                       "ARUPDATER_Ftp"
+#define ARUPDATER_FTP_CONNECT_TIMEOUT_MS        10000
+#define ARUPDATER_FTP_IO_TIMEOUT_SEC            30
+#define ARUPDATER_FTP_CANCEL_POLL_MS            100
+#define ARUPDATER_FTP_PORT_SIZE                 8
+
+/**
+ * @brief The link is measured and the transfer adapted every ARUPDATER_FTP_SAMPLE_PERIOD_US
+ */
+#define ARUPDATER_FTP_SAMPLE_PERIOD_US          100000
+#define ARUPDATER_FTP_BLOCK_DURATION_US         10000
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL                            0
+#endif
+
+/**
+ * @brief State of an adaptive transfer
+ */
+typedef struct
+{
+    int blockSize;
+    int socketBufferSize;
+    int rttUs;
+    int adaptationCount;
+    int isZeroCopy; /**< the file goes to the data connection with sendfile */
+    int64_t sentSize;
+    int64_t sampleStartUs;
+    int64_t sampleDeliveredSize;
+} ARUPDATER_Ftp_Transfer_t;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static int64_t ARUPDATER_Ftp_NowUs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/**
+ * @brief close a connection of the session, the descriptor is cleared under the lock so that it is not shut down by ARUPDATER_Ftp_Cancel once closed
+ */
+static void ARUPDATER_Ftp_Close(ARUPDATER_Ftp_t *ftp, int *fdPtr)
+{
+    int fd = -1;
+    
+    ARSAL_Mutex_Lock(&ftp->lock);
+    fd = *fdPtr;
+    *fdPtr = -1;
+    ARSAL_Mutex_Unlock(&ftp->lock);
+    
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+static eARUPDATER_ERROR ARUPDATER_Ftp_SendAll(ARUPDATER_Ftp_t *ftp, int fd, const char *buffer, size_t size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        ssize_t sent = send(fd, buffer, size, MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            buffer += sent;
+            size -= sent;
+        }
+        else if ((sent < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            error = (ftp->isCanceled != 0) ? ARUPDATER_ERROR_UPLOADER_CANCELED : ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    return error;
+}
+
+/**
+ * @brief connect a socket in slices of ARUPDATER_FTP_CANCEL_POLL_MS, so that a cancel does not wait for the timeout
+ * @param fdPtr : the descriptor of the session which receives the socket
+ */
+static eARUPDATER_ERROR ARUPDATER_Ftp_ConnectSocket(ARUPDATER_Ftp_t *ftp, int *fdPtr, const struct sockaddr *address, socklen_t addressLength)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct timeval timeout = { ARUPDATER_FTP_IO_TIMEOUT_SEC, 0 };
+    int fd = socket(address->sa_family, SOCK_STREAM, 0);
+    int flags = 0;
+    int waitedMs = 0;
+    
+    if (fd < 0)
+    {
+        return ARUPDATER_ERROR_SYSTEM;
+    }
+    
+    ARSAL_Mutex_Lock(&ftp->lock);
+    *fdPtr = fd;
+    ARSAL_Mutex_Unlock(&ftp->lock);
+    
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    
+    if ((connect(fd, address, addressLength) != 0) && (errno != EINPROGRESS))
+    {
+        error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    while (error == ARUPDATER_OK)
+    {
+        struct pollfd pollFd = { fd, POLLOUT, 0 };
+        int socketError = 0;
+        socklen_t socketErrorLength = sizeof(socketError);
+        int result = 0;
+        
+        if (ftp->isCanceled != 0)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+        }
+        else if (waitedMs >= ARUPDATER_FTP_CONNECT_TIMEOUT_MS)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+        else if ((result = poll(&pollFd, 1, ARUPDATER_FTP_CANCEL_POLL_MS)) > 0)
+        {
+            if ((getsockopt(fd, SOL_SOCKET, SO_ERROR, &socketError, &socketErrorLength) != 0) || (socketError != 0))
+            {
+                error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+            }
+            break;
+        }
+        else if ((result < 0) && (errno != EINTR))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        waitedMs += ARUPDATER_FTP_CANCEL_POLL_MS;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        // the transfers block, bounded by the timeouts
+        fcntl(fd, F_SETFL, flags);
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        {
+            int noSigPipe = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+        }
+#endif
+    }
+    else
+    {
+        ARUPDATER_Ftp_Close(ftp, fdPtr);
+    }
+    
+    return error;
+}
+
+/**
+ * @brief read a line of the control connection, without its end of line
+ * @return 1 if a line has been read, 0 otherwise
+ */
+static int ARUPDATER_Ftp_ReadLine(ARUPDATER_Ftp_t *ftp, char *line, size_t lineSize)
+{
+    char *end = NULL;
+    
+    while ((end = memchr(ftp->received, '\n', ftp->receivedSize)) == NULL)
+    {
+        ssize_t size = 0;
+        
+        if (ftp->receivedSize >= (int)sizeof(ftp->received))
+        {
+            // a line longer than the buffer is not a reply of a ftp server
+            return 0;
+        }
+        size = recv(ftp->controlFd, ftp->received + ftp->receivedSize, sizeof(ftp->received) - ftp->receivedSize, 0);
+        if (size > 0)
+        {
+            ftp->receivedSize += size;
+        }
+        else if ((size < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    
+    {
+        size_t length = end - ftp->received;
+        size_t consumed = length + 1;
+        
+        if ((length > 0) && (ftp->received[length - 1] == '\r'))
+        {
+            length--;
+        }
+        if (length >= lineSize)
+        {
+            length = lineSize - 1;
+        }
+        memcpy(line, ftp->received, length);
+        line[length] = '\0';
+        
+        ftp->receivedSize -= consumed;
+        memmove(ftp->received, ftp->received + consumed, ftp->receivedSize);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief read a reply, the lines of a multi-line reply are skipped up to the last one
+ * @return the code of the reply, -1 if the connection is lost
+ */
+static int ARUPDATER_Ftp_ReadReply(ARUPDATER_Ftp_t *ftp)
+{
+    int code = -1;
+    
+    while (ARUPDATER_Ftp_ReadLine(ftp, ftp->reply, sizeof(ftp->reply)))
+    {
+        if ((strlen(ftp->reply) >= 4) && (ftp->reply[0] >= '1') && (ftp->reply[0] <= '5') && (ftp->reply[3] == ' '))
+        {
+            code = atoi(ftp->reply);
+            break;
+        }
+    }
+    
+    return code;
+}
+
+/**
+ * @brief send a command and read its reply
+ * @return the code of the reply, -1 if the connection is lost
+ */
+static int ARUPDATER_Ftp_Command(ARUPDATER_Ftp_t *ftp, const char *format, ...)
+{
+    char command[ARUPDATER_FTP_LINE_SIZE];
+    va_list args;
+    int length = 0;
+    
+    va_start(args, format);
+    length = vsnprintf(command, sizeof(command) - 2, format, args);
+    va_end(args);
+    
+    if ((length < 0) || (length >= (int)sizeof(command) - 2) || (ftp->controlFd < 0))
+    {
+        return -1;
+    }
+    strcat(command, "\r\n");
+    
+    if (ARUPDATER_Ftp_SendAll(ftp, ftp->controlFd, command, length + 2) != ARUPDATER_OK)
+    {
+        return -1;
+    }
+    
+    return ARUPDATER_Ftp_ReadReply(ftp);
+}
+
+/**
+ * @brief error of a failed exchange on the control connection
+ */
+static eARUPDATER_ERROR ARUPDATER_Ftp_ReplyError(ARUPDATER_Ftp_t *ftp, const char *command)
+{
+    if (ftp->isCanceled != 0)
+    {
+        return ARUPDATER_ERROR_UPLOADER_CANCELED;
+    }
+    
+    ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FTP_TAG, "%s failed: %s", command, ftp->reply);
+    return ARUPDATER_ERROR_UPLOADER_TRANSFER;
+}
+
+/**
+ * @brief open a passive data connection, on the address of the control connection
+ */
+static eARUPDATER_ERROR ARUPDATER_Ftp_OpenData(ARUPDATER_Ftp_t *ftp)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct sockaddr_storage address;
+    socklen_t addressLength = sizeof(address);
+    int port = -1;
+    char *start = NULL;
+    
+    if (getpeername(ftp->controlFd, (struct sockaddr *)&address, &addressLength) != 0)
+    {
+        error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    // 229 Entering Extended Passive Mode (|||port|), or 227 Entering Passive Mode (h1,h2,h3,h4,p1,p2)
+    if ((error == ARUPDATER_OK) && (ARUPDATER_Ftp_Command(ftp, "EPSV") == 229) && ((start = strstr(ftp->reply, "(|||")) != NULL))
+    {
+        port = atoi(start + 4);
+    }
+    else if ((error == ARUPDATER_OK) && (address.ss_family == AF_INET) && (ARUPDATER_Ftp_Command(ftp, "PASV") == 227) && ((start = strchr(ftp->reply, '(')) != NULL))
+    {
+        int h1, h2, h3, h4, p1, p2;
+        if (sscanf(start + 1, "%d,%d,%d,%d,%d,%d", &h1, &h2, &h3, &h4, &p1, &p2) == 6)
+        {
+            port = p1 * 256 + p2;
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && ((port <= 0) || (port > 65535)))
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "passive mode");
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        if (address.ss_family == AF_INET6)
+        {
+            ((struct sockaddr_in6 *)&address)->sin6_port = htons(port);
+        }
+        else
+        {
+            ((struct sockaddr_in *)&address)->sin_port = htons(port);
+        }
+        error = ARUPDATER_Ftp_ConnectSocket(ftp, &ftp->dataFd, (struct sockaddr *)&address, addressLength);
+    }
+    
+    return error;
+}
+
+static int ARUPDATER_Ftp_GetSocketBufferSize(int fd)
+{
+    int bufferSize = 0;
+    socklen_t length = sizeof(bufferSize);
+    
+    if (getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufferSize, &length) != 0)
+    {
+        bufferSize = 0;
+    }
+    return bufferSize;
+}
+
+/**
+ * @brief number of bytes written on a connection and acknowledged by the peer
+ * @details the bytes still in the send buffer are not counted, where the system tells it
+ */
+static int64_t ARUPDATER_Ftp_GetDeliveredSize(int fd, int64_t sentSize)
+{
+    int64_t deliveredSize = sentSize;
+#if defined(__linux__) && defined(TIOCOUTQ)
+    int unsentSize = 0;
+    
+    if ((ioctl(fd, TIOCOUTQ, &unsentSize) == 0) && (unsentSize > 0) && (unsentSize <= sentSize))
+    {
+        deliveredSize -= unsentSize;
+    }
+#endif
+    return deliveredSize;
+}
+
+static int ARUPDATER_Ftp_GetRttUs(int fd)
+{
+    int rttUs = 0;
+#if defined(__linux__) && defined(TCP_INFO)
+    struct tcp_info info;
+    socklen_t length = sizeof(info);
+    
+    if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &length) == 0)
+    {
+        rttUs = (int)info.tcpi_rtt;
+    }
+#endif
+    return rttUs;
+}
+
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+/**
+ * @brief send a part of the local file on the data connection without copying it in user space
+ * @details the file system or the socket may not support it: isZeroCopy is cleared then, and nothing is sent
+ */
+static eARUPDATER_ERROR ARUPDATER_Ftp_SendFile(ARUPDATER_Ftp_t *ftp, int fd, int64_t offset, size_t length, int *isZeroCopy)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    off_t fileOffset = (off_t)offset;
+    size_t sentSize = 0;
+    
+    while ((error == ARUPDATER_OK) && (*isZeroCopy != 0) && (sentSize < length))
+    {
+        ssize_t sent = sendfile(ftp->dataFd, fd, &fileOffset, length - sentSize);
+        if (sent > 0)
+        {
+            sentSize += sent;
+        }
+        else if ((sent < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else if ((sent < 0) && (sentSize == 0) && ((errno == EINVAL) || (errno == ENOSYS) || (errno == EOPNOTSUPP)))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_FTP_TAG, "sendfile not supported (%d), the file is copied", errno);
+            *isZeroCopy = 0;
+        }
+        else if (sent == 0)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FTP_TAG, "the local file can not be read at %lld", (long long)fileOffset);
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            error = (ftp->isCanceled != 0) ? ARUPDATER_ERROR_UPLOADER_CANCELED : ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    return error;
+}
+
+/**
+ * @brief sendfile has no MSG_NOSIGNAL: SIGPIPE is blocked in the calling thread during the transfer
+ */
+static void ARUPDATER_Ftp_BlockSigpipe(sigset_t *oldSet)
+{
+    sigset_t pipeSet;
+    
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSet, oldSet);
+}
+
+/**
+ * @brief discard the SIGPIPE raised by a connection closed during the transfer, then restore the signal mask of the thread
+ */
+static void ARUPDATER_Ftp_RestoreSigpipe(const sigset_t *oldSet)
+{
+    sigset_t pipeSet;
+    sigset_t pendingSet;
+    struct timespec noWait = { 0, 0 };
+    
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+    if ((sigismember(oldSet, SIGPIPE) == 0) && (sigpending(&pendingSet) == 0) && (sigismember(&pendingSet, SIGPIPE) == 1))
+    {
+        sigtimedwait(&pipeSet, NULL, &noWait);
+    }
+    pthread_sigmask(SIG_SETMASK, oldSet, NULL);
+}
+#endif
+
+/**
+ * @brief measure the link and adapt the block size and the send buffer of the data connection
+ */
+static void ARUPDATER_Ftp_Adapt(ARUPDATER_Ftp_t *ftp, ARUPDATER_Ftp_Transfer_t *transfer, int64_t nowUs)
+{
+    int64_t deliveredSize = ARUPDATER_Ftp_GetDeliveredSize(ftp->dataFd, transfer->sentSize);
+    int64_t throughput = (deliveredSize - transfer->sampleDeliveredSize) * 1000000 / (nowUs - transfer->sampleStartUs);
+    int64_t target = 0;
+    int blockSize = ARUPDATER_FTP_MIN_BLOCK_SIZE;
+    
+    transfer->sampleStartUs = nowUs;
+    transfer->sampleDeliveredSize = deliveredSize;
+    transfer->rttUs = ARUPDATER_Ftp_GetRttUs(ftp->dataFd);
+    
+    // nothing has been acknowledged, the link is stalled and tells nothing
+    if (throughput <= 0)
+    {
+        return;
+    }
+    
+    // a block takes about ARUPDATER_FTP_BLOCK_DURATION_US: few system calls on a fast link, a responsive progress and cancel on a slow one
+    target = throughput * ARUPDATER_FTP_BLOCK_DURATION_US / 1000000;
+    while ((blockSize < ARUPDATER_FTP_MAX_BLOCK_SIZE) && (blockSize * 2 <= target))
+    {
+        blockSize *= 2;
+    }
+    if (blockSize != transfer->blockSize)
+    {
+        transfer->blockSize = blockSize;
+        transfer->adaptationCount++;
+    }
+    
+    // the send buffer holds twice the bandwidth-delay product: enough to fill the link, not so much that it queues seconds of data on a congested one
+    if (transfer->rttUs > 0)
+    {
+        target = 2 * throughput * transfer->rttUs / 1000000;
+        if (target < ARUPDATER_FTP_MIN_SOCKET_BUFFER_SIZE)
+        {
+            target = ARUPDATER_FTP_MIN_SOCKET_BUFFER_SIZE;
+        }
+        else if (target > ARUPDATER_FTP_MAX_SOCKET_BUFFER_SIZE)
+        {
+            target = ARUPDATER_FTP_MAX_SOCKET_BUFFER_SIZE;
+        }
+        
+        if ((target >= 2 * (int64_t)transfer->socketBufferSize) || (2 * target <= (int64_t)transfer->socketBufferSize))
+        {
+            int bufferSize = (int)target;
+            if (setsockopt(ftp->dataFd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize)) == 0)
+            {
+                transfer->socketBufferSize = ARUPDATER_Ftp_GetSocketBufferSize(ftp->dataFd);
+                transfer->adaptationCount++;
+            }
+        }
+    }
+}
+
+/* ***************************************
+ *
+ *             function implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Ftp_t *ARUPDATER_Ftp_New(const char *const address, int port, const char *const username, const char *const password, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Ftp_t *ftp = NULL;
+    
+    if ((address == NULL) || (port <= 0) || (port > 65535))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        ftp = calloc(1, sizeof(ARUPDATER_Ftp_t));
+        if (ftp == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        ftp->controlFd = -1;
+        ftp->dataFd = -1;
+        ftp->port = port;
+        ftp->address = strdup(address);
+        ftp->username = strdup(((username != NULL) && (username[0] != '\0')) ? username : "anonymous");
+        ftp->password = strdup((password != NULL) ? password : "");
+        if ((ftp->address == NULL) || (ftp->username == NULL) || (ftp->password == NULL))
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    if ((err == ARUPDATER_OK) && (ARSAL_Mutex_Init(&ftp->lock) != 0))
+    {
+        err = ARUPDATER_ERROR_SYSTEM;
+    }
+    
+    /* delete the session if an error occurred */
+    if ((err != ARUPDATER_OK) && (ftp != NULL))
+    {
+        free(ftp->address);
+        free(ftp->username);
+        free(ftp->password);
+        free(ftp);
+        ftp = NULL;
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return ftp;
+}
+
+void ARUPDATER_Ftp_Delete(ARUPDATER_Ftp_t **ftpAddr)
+{
+    if ((ftpAddr != NULL) && (*ftpAddr != NULL))
+    {
+        ARUPDATER_Ftp_t *ftp = *ftpAddr;
+        
+        ARUPDATER_Ftp_Close(ftp, &ftp->dataFd);
+        if ((ftp->controlFd >= 0) && (ftp->isCanceled == 0))
+        {
+            ARUPDATER_Ftp_Command(ftp, "QUIT");
+        }
+        ARUPDATER_Ftp_Close(ftp, &ftp->controlFd);
+        
+        ARSAL_Mutex_Destroy(&ftp->lock);
+        free(ftp->address);
+        free(ftp->username);
+        free(ftp->password);
+        free(ftp);
+        *ftpAddr = NULL;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Connect(ARUPDATER_Ftp_t *ftp)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct addrinfo hints;
+    struct addrinfo *addresses = NULL;
+    struct addrinfo *address = NULL;
+    char port[ARUPDATER_FTP_PORT_SIZE];
+    int code = 0;
+    
+    if (ftp == NULL)
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port, sizeof(port), "%d", ftp->port);
+    
+    ftp->receivedSize = 0;
+    ftp->reply[0] = '\0';
+    
+    if (getaddrinfo(ftp->address, port, &hints, &addresses) != 0)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FTP_TAG, "%s can not be resolved", ftp->address);
+        error = ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    for (address = addresses; (error == ARUPDATER_OK) && (address != NULL); address = address->ai_next)
+    {
+        error = ARUPDATER_Ftp_ConnectSocket(ftp, &ftp->controlFd, address->ai_addr, address->ai_addrlen);
+        if (error == ARUPDATER_OK)
+        {
+            break;
+        }
+        else if ((error == ARUPDATER_ERROR_UPLOADER_TRANSFER) && (address->ai_next != NULL))
+        {
+            // try the next address of the server
+            error = ARUPDATER_OK;
+        }
+    }
+    if (addresses != NULL)
+    {
+        freeaddrinfo(addresses);
+    }
+    
+    if ((error == ARUPDATER_OK) && (ARUPDATER_Ftp_ReadReply(ftp) != 220))
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "greeting");
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        code = ARUPDATER_Ftp_Command(ftp, "USER %s", ftp->username);
+        if (code == 331)
+        {
+            code = ARUPDATER_Ftp_Command(ftp, "PASS %s", ftp->password);
+        }
+        if ((code != 230) && (code != 202))
+        {
+            error = ARUPDATER_Ftp_ReplyError(ftp, "login");
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (ARUPDATER_Ftp_Command(ftp, "TYPE I") != 200))
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "TYPE I");
+    }
+    
+    if (error != ARUPDATER_OK)
+    {
+        ARUPDATER_Ftp_Close(ftp, &ftp->controlFd);
+    }
+    
+    return error;
+}
+
+void ARUPDATER_Ftp_Cancel(ARUPDATER_Ftp_t *ftp)
+{
+    if (ftp != NULL)
+    {
+        ARSAL_Mutex_Lock(&ftp->lock);
+        ftp->isCanceled = 1;
+        if (ftp->dataFd >= 0)
+        {
+            shutdown(ftp->dataFd, SHUT_RDWR);
+        }
+        if (ftp->controlFd >= 0)
+        {
+            shutdown(ftp->controlFd, SHUT_RDWR);
+        }
+        ARSAL_Mutex_Unlock(&ftp->lock);
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Noop(ARUPDATER_Ftp_t *ftp)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if (ftp == NULL)
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    // a server which has closed an idle session replies 421 first, or nothing
+    if (ARUPDATER_Ftp_Command(ftp, "NOOP") != 200)
+    {
+        error = (ftp->isCanceled != 0) ? ARUPDATER_ERROR_UPLOADER_CANCELED : ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Size(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t *size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((ftp == NULL) || (remotePath == NULL) || (size == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    // 213 size
+    if (ARUPDATER_Ftp_Command(ftp, "SIZE %s", remotePath) == 213)
+    {
+        *size = strtoll(ftp->reply + 4, NULL, 10);
+    }
+    else
+    {
+        error = (ftp->isCanceled != 0) ? ARUPDATER_ERROR_UPLOADER_CANCELED : ARUPDATER_ERROR_UPLOADER_TRANSFER;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Rename(ARUPDATER_Ftp_t *ftp, const char *const fromPath, const char *const toPath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((ftp == NULL) || (fromPath == NULL) || (toPath == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (ARUPDATER_Ftp_Command(ftp, "RNFR %s", fromPath) != 350)
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "RNFR");
+    }
+    else if (ARUPDATER_Ftp_Command(ftp, "RNTO %s", toPath) != 250)
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "RNTO");
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Remove(ARUPDATER_Ftp_t *ftp, const char *const remotePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int code = 0;
+    
+    if ((ftp == NULL) || (remotePath == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    code = ARUPDATER_Ftp_Command(ftp, "DELE %s", remotePath);
+    if (code == 550)
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+    else if (code != 250)
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "DELE");
+    }
+    
+    return error;
+}
+
+int ARUPDATER_Ftp_HasFeature(ARUPDATER_Ftp_t *ftp, const char *const feature)
+{
+    char line[ARUPDATER_FTP_LINE_SIZE];
+    char *found = NULL;
+    size_t length = 0;
+    
+    if ((ftp == NULL) || (feature == NULL) || (ftp->controlFd < 0))
+    {
+        return 0;
+    }
+    
+    // 211-Features: then one feature per line, each after a space, up to 211 End
+    if ((ftp->hasFeatures == 0) && (ARUPDATER_Ftp_SendAll(ftp, ftp->controlFd, "FEAT\r\n", 6) == ARUPDATER_OK))
+    {
+        while (ARUPDATER_Ftp_ReadLine(ftp, line, sizeof(line)))
+        {
+            if ((strlen(line) >= 4) && (line[0] >= '1') && (line[0] <= '5') && (line[3] == ' '))
+            {
+                break;
+            }
+            if ((line[0] == ' ') && (strlen(ftp->features) + strlen(line) + 1 < sizeof(ftp->features)))
+            {
+                // the name of the feature, without its parameters
+                line[1 + strcspn(line + 1, " ")] = '\0';
+                strcat(ftp->features, line);
+                strcat(ftp->features, " ");
+            }
+        }
+        ftp->hasFeatures = 1;
+    }
+    
+    length = strlen(feature);
+    found = ftp->features;
+    while ((found = strstr(found, feature)) != NULL)
+    {
+        if ((found > ftp->features) && (found[-1] == ' ') && (found[length] == ' '))
+        {
+            return 1;
+        }
+        found += length;
+    }
+    
+    return 0;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Md5(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t offset, int64_t size, uint8_t *digest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *hex = NULL;
+    int i = 0;
+    
+    if ((ftp == NULL) || (remotePath == NULL) || (offset < 0) || (size < 0) || (digest == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    // 250 followed by the md5 in hexadecimal, some servers give the path first
+    if (ARUPDATER_Ftp_Command(ftp, "XMD5 %s %lld %lld", remotePath, (long long)offset, (long long)(offset + size)) != 250)
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "XMD5");
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        hex = strrchr(ftp->reply, ' ');
+        if ((hex == NULL) || (strlen(hex + 1) != 2 * ARUPDATER_MD5_DIGEST_SIZE))
+        {
+            error = ARUPDATER_Ftp_ReplyError(ftp, "XMD5");
+        }
+    }
+    
+    for (i = 0; (error == ARUPDATER_OK) && (i < ARUPDATER_MD5_DIGEST_SIZE); i++)
+    {
+        unsigned int byte = 0;
+        if (sscanf(hex + 1 + 2 * i, "%2x", &byte) != 1)
+        {
+            error = ARUPDATER_Ftp_ReplyError(ftp, "XMD5");
+        }
+        digest[i] = (uint8_t)byte;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Get(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t offset, uint8_t *buffer, int64_t size, int64_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int64_t received = 0;
+    int isEnd = 0;
+    int code = 0;
+    
+    if ((ftp == NULL) || (remotePath == NULL) || (offset < 0) || (buffer == NULL) || (size < 0) || (readSize == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    error = ARUPDATER_Ftp_OpenData(ftp);
+    
+    if ((error == ARUPDATER_OK) && (offset > 0) && (ARUPDATER_Ftp_Command(ftp, "REST %lld", (long long)offset) != 350))
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "REST");
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        code = ARUPDATER_Ftp_Command(ftp, "RETR %s", remotePath);
+        if ((code != 125) && (code != 150))
+        {
+            error = ARUPDATER_Ftp_ReplyError(ftp, "RETR");
+        }
+    }
+    
+    while ((error == ARUPDATER_OK) && (isEnd == 0) && (received < size))
+    {
+        ssize_t length = recv(ftp->dataFd, buffer + received, (size_t)(size - received), 0);
+        if (length > 0)
+        {
+            received += length;
+        }
+        else if (length == 0)
+        {
+            isEnd = 1;
+        }
+        else if (errno != EINTR)
+        {
+            error = (ftp->isCanceled != 0) ? ARUPDATER_ERROR_UPLOADER_CANCELED : ARUPDATER_ERROR_UPLOADER_TRANSFER;
+        }
+    }
+    
+    // a transfer stopped before the end of the file is aborted by the server, the part read is complete all the same
+    if (ftp->dataFd >= 0)
+    {
+        ARUPDATER_Ftp_Close(ftp, &ftp->dataFd);
+        if (code / 100 == 1)
+        {
+            code = ARUPDATER_Ftp_ReadReply(ftp);
+            if ((error == ARUPDATER_OK) && (isEnd != 0) && (code != 226) && (code != 250))
+            {
+                error = ARUPDATER_Ftp_ReplyError(ftp, "transfer");
+            }
+            else if ((error == ARUPDATER_OK) && (code < 0))
+            {
+                error = ARUPDATER_Ftp_ReplyError(ftp, "transfer");
+            }
+        }
+    }
+    
+    *readSize = received;
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Ftp_Put(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int fd, int64_t offset, int64_t size, int isAppend, int blockSize, int isZeroCopy, ARUPDATER_Ftp_ProgressCallback_t progressCallback, void *progressArg, ARUPDATER_Uploader_TransferStats_t *stats)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Ftp_Transfer_t transfer;
+    char *buffer = NULL;
+    int64_t startUs = 0;
+    int code = 0;
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+    sigset_t oldSignalSet;
+#endif
+    
+    if ((ftp == NULL) || (remotePath == NULL) || (fd < 0) || (offset < 0) || (size < 0) || (blockSize < 0))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    memset(&transfer, 0, sizeof(transfer));
+    transfer.blockSize = (blockSize > 0) ? blockSize : ARUPDATER_FTP_INITIAL_BLOCK_SIZE;
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+    transfer.isZeroCopy = (isZeroCopy != 0);
+#endif
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Ftp_OpenData(ftp);
+    }
+    
+    if ((error == ARUPDATER_OK) && (isAppend == 0) && (offset > 0) && (ARUPDATER_Ftp_Command(ftp, "REST %lld", (long long)offset) != 350))
+    {
+        error = ARUPDATER_Ftp_ReplyError(ftp, "REST");
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        code = ARUPDATER_Ftp_Command(ftp, "%s %s", (isAppend != 0) ? "APPE" : "STOR", remotePath);
+        if ((code != 125) && (code != 150))
+        {
+            error = ARUPDATER_Ftp_ReplyError(ftp, (isAppend != 0) ? "APPE" : "STOR");
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        startUs = ARUPDATER_Ftp_NowUs();
+        transfer.sampleStartUs = startUs;
+        
+        // a send buffer larger than the plf would take it all at once and leave nothing to measure
+        if (blockSize == 0)
+        {
+            int bufferSize = ARUPDATER_FTP_INITIAL_SOCKET_BUFFER_SIZE;
+            setsockopt(ftp->dataFd, SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+        }
+        transfer.socketBufferSize = ARUPDATER_Ftp_GetSocketBufferSize(ftp->dataFd);
+    }
+    
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+    if (transfer.isZeroCopy != 0)
+    {
+        ARUPDATER_Ftp_BlockSigpipe(&oldSignalSet);
+    }
+#endif
+    
+    while ((error == ARUPDATER_OK) && (transfer.sentSize < size))
+    {
+        int64_t nowUs = 0;
+        size_t length = transfer.blockSize;
+        ssize_t readSize = 0;
+        
+        if ((int64_t)length > size - transfer.sentSize)
+        {
+            length = (size_t)(size - transfer.sentSize);
+        }
+        
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+        // a block is still the unit of the progress and of the measures of the link
+        if (transfer.isZeroCopy != 0)
+        {
+            error = ARUPDATER_Ftp_SendFile(ftp, fd, offset + transfer.sentSize, length, &transfer.isZeroCopy);
+            readSize = (ssize_t)length;
+        }
+#endif
+        
+        // an adaptive transfer may grow its blocks up to the maximum
+        if ((error == ARUPDATER_OK) && (transfer.isZeroCopy == 0) && (buffer == NULL))
+        {
+            buffer = malloc((blockSize > 0) ? blockSize : ARUPDATER_FTP_MAX_BLOCK_SIZE);
+            if (buffer == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+            }
+        }
+        
+        if ((error == ARUPDATER_OK) && (transfer.isZeroCopy == 0))
+        {
+            readSize = pread(fd, buffer, length, offset + transfer.sentSize);
+            if (readSize <= 0)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_FTP_TAG, "the local file can not be read at %lld", (long long)(offset + transfer.sentSize));
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+            else
+            {
+                error = ARUPDATER_Ftp_SendAll(ftp, ftp->dataFd, buffer, readSize);
+            }
+        }
+        
+        if (error == ARUPDATER_OK)
+        {
+            transfer.sentSize += readSize;
+            if (progressCallback != NULL)
+            {
+                progressCallback(progressArg, ARUPDATER_Ftp_GetDeliveredSize(ftp->dataFd, transfer.sentSize));
+            }
+            
+            nowUs = ARUPDATER_Ftp_NowUs();
+            if ((blockSize == 0) && (nowUs - transfer.sampleStartUs >= ARUPDATER_FTP_SAMPLE_PERIOD_US))
+            {
+                ARUPDATER_Ftp_Adapt(ftp, &transfer, nowUs);
+            }
+        }
+    }
+    
+#ifdef ARUPDATER_FTP_HAS_SENDFILE
+    if (isZeroCopy != 0)
+    {
+        ARUPDATER_Ftp_RestoreSigpipe(&oldSignalSet);
+    }
+#endif
+    
+    if ((error == ARUPDATER_OK) && (transfer.rttUs == 0))
+    {
+        transfer.rttUs = ARUPDATER_Ftp_GetRttUs(ftp->dataFd);
+    }
+    else if ((error != ARUPDATER_OK) && (ftp->dataFd >= 0))
+    {
+        // only the acknowledged bytes are on the server
+        transfer.sentSize = ARUPDATER_Ftp_GetDeliveredSize(ftp->dataFd, transfer.sentSize);
+    }
+    
+    // the end of the file is the end of the data connection, the server acknowledges it on the control connection
+    if (ftp->dataFd >= 0)
+    {
+        ARUPDATER_Ftp_Close(ftp, &ftp->dataFd);
+        if (code / 100 == 1)
+        {
+            code = ARUPDATER_Ftp_ReadReply(ftp);
+            if ((error == ARUPDATER_OK) && (code != 226) && (code != 250))
+            {
+                error = ARUPDATER_Ftp_ReplyError(ftp, "transfer");
+            }
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (progressCallback != NULL))
+    {
+        progressCallback(progressArg, transfer.sentSize);
+    }
+    
+    if (stats != NULL)
+    {
+        memset(stats, 0, sizeof(*stats));
+        stats->isAdaptive = (blockSize == 0);
+        stats->isZeroCopy = transfer.isZeroCopy;
+        stats->blockSize = transfer.blockSize;
+        stats->socketBufferSize = transfer.socketBufferSize;
+        stats->rttUs = transfer.rttUs;
+        stats->adaptationCount = transfer.adaptationCount;
+        stats->sentSize = transfer.sentSize;
+        stats->durationUs = (startUs > 0) ? ARUPDATER_Ftp_NowUs() - startUs : 0;
+        stats->throughput = (stats->durationUs > 0) ? stats->sentSize * 1000000 / stats->durationUs : 0;
+    }
+    
+    free(buffer);
+    
+    return error;
+}
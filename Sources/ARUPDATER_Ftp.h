@@ -0,0 +1,210 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Ftp.h
+ * @brief libARUpdater Ftp private header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_FTP_PRIVATE_H_
+#define _ARUPDATER_FTP_PRIVATE_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARUpdater/ARUPDATER_Uploader.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+/**
+ * @brief Size of the blocks of an adaptive transfer
+ * @details The block size follows the throughput of the link so that a block is sent in about ARUPDATER_FTP_BLOCK_DURATION_US
+ */
+#define ARUPDATER_FTP_MIN_BLOCK_SIZE            (4 * 1024)
+#define ARUPDATER_FTP_MAX_BLOCK_SIZE            (1024 * 1024)
+#define ARUPDATER_FTP_INITIAL_BLOCK_SIZE        (16 * 1024)
+
+/**
+ * @brief Size of the send buffer of the data connection of an adaptive transfer, twice the bandwidth-delay product of the link
+ */
+#define ARUPDATER_FTP_MIN_SOCKET_BUFFER_SIZE    (64 * 1024)
+#define ARUPDATER_FTP_MAX_SOCKET_BUFFER_SIZE    (4 * 1024 * 1024)
+#define ARUPDATER_FTP_INITIAL_SOCKET_BUFFER_SIZE (256 * 1024)
+
+#define ARUPDATER_FTP_LINE_SIZE                 512
+
+/**
+ * @brief Progress callback of a transfer
+ * @param arg The pointer of the user custom argument
+ * @param sentSize The number of bytes of the transfer acknowledged by the server, where the system tells it
+ */
+typedef void (*ARUPDATER_Ftp_ProgressCallback_t) (void *arg, int64_t sentSize);
+
+/**
+ * @brief Ftp client session, passive mode only
+ */
+typedef struct
+{
+    char *address;
+    int port;
+    char *username;
+    char *password;
+    
+    int controlFd;
+    int dataFd;
+    int isCanceled;
+    ARSAL_Mutex_t lock; /**< protects the descriptors against ARUPDATER_Ftp_Cancel */
+    
+    char reply[ARUPDATER_FTP_LINE_SIZE]; /**< last line of the last reply */
+    char received[ARUPDATER_FTP_LINE_SIZE]; /**< bytes received on the control connection and not parsed yet */
+    int receivedSize;
+    
+    int hasFeatures; /**< the features have been asked to the server */
+    char features[ARUPDATER_FTP_LINE_SIZE]; /**< the commands listed by FEAT, separated by spaces */
+} ARUPDATER_Ftp_t;
+
+/**
+ * @brief Create a session, nothing is sent before ARUPDATER_Ftp_Connect
+ * @warning This function allocates memory
+ * @param[in] address : address of the ftp server
+ * @param[in] port : port of the ftp server
+ * @param[in] username : user name, anonymous if null or empty
+ * @param[in] password : password. Can be null
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise
+ * @return the session, NULL on error
+ * @see ARUPDATER_Ftp_Delete ()
+ */
+ARUPDATER_Ftp_t *ARUPDATER_Ftp_New(const char *const address, int port, const char *const username, const char *const password, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Close and delete a session
+ * @param ftpAddr : address of the pointer on the session
+ */
+void ARUPDATER_Ftp_Delete(ARUPDATER_Ftp_t **ftpAddr);
+
+/**
+ * @brief Open the control connection and log in, in binary mode
+ * @param ftp : the session
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_UPLOADER_CANCELED if the session has been canceled, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Connect(ARUPDATER_Ftp_t *ftp);
+
+/**
+ * @brief Cancel the current and the next operations of a session
+ * @details Can be called from any thread, the connections are shut down
+ * @param ftp : the session
+ */
+void ARUPDATER_Ftp_Cancel(ARUPDATER_Ftp_t *ftp);
+
+/**
+ * @brief Check that the control connection of a session is still open and in sync
+ * @param ftp : the session
+ * @return ARUPDATER_OK if the server answers, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Noop(ARUPDATER_Ftp_t *ftp);
+
+/**
+ * @brief Get the size of a remote file
+ * @param ftp : the session
+ * @param[in] remotePath : the remote file
+ * @param[out] size : the size of the file
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Size(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t *size);
+
+/**
+ * @brief Rename a remote file
+ * @param ftp : the session
+ * @param[in] fromPath : the remote file
+ * @param[in] toPath : its new path
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Rename(ARUPDATER_Ftp_t *ftp, const char *const fromPath, const char *const toPath);
+
+/**
+ * @brief Delete a remote file
+ * @param ftp : the session
+ * @param[in] remotePath : the remote file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if there is no such file, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Remove(ARUPDATER_Ftp_t *ftp, const char *const remotePath);
+
+/**
+ * @brief Tell whether the server lists a feature in its reply to FEAT
+ * @details The features are asked once per session
+ * @param ftp : the session
+ * @param[in] feature : the name of the feature, as XMD5
+ * @return 1 if the server has the feature, 0 otherwise
+ */
+int ARUPDATER_Ftp_HasFeature(ARUPDATER_Ftp_t *ftp, const char *const feature);
+
+/**
+ * @brief Get the md5 of a part of a remote file, computed by the server
+ * @warning The server must have the XMD5 feature
+ * @param ftp : the session
+ * @param[in] remotePath : the remote file
+ * @param[in] offset : offset of the part
+ * @param[in] size : size of the part
+ * @param[out] digest : buffer of ARUPDATER_MD5_DIGEST_SIZE bytes
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Md5(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t offset, int64_t size, uint8_t *digest);
+
+/**
+ * @brief Read a part of a remote file in memory
+ * @param ftp : the session
+ * @param[in] remotePath : the remote file
+ * @param[in] offset : offset of the part
+ * @param[out] buffer : buffer of size bytes
+ * @param[in] size : maximum size of the part, the transfer stops once it is read
+ * @param[out] readSize : size read, less than size at the end of the file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_UPLOADER_CANCELED if the session has been canceled, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Get(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int64_t offset, uint8_t *buffer, int64_t size, int64_t *readSize);
+
+/**
+ * @brief Send a part of a local file
+ * @details With a blockSize of 0, the throughput and the round trip time of the data connection are measured during the transfer,
+ * the block size and the send buffer of the connection follow them
+ * @param ftp : the session
+ * @param[in] remotePath : the remote file
+ * @param[in] fd : the local file
+ * @param[in] offset : offset of the part in the local file, and in the remote file when isAppend is 0
+ * @param[in] size : size of the part
+ * @param[in] isAppend : 1 to append the part to the remote file, 0 to write it at offset
+ * @param[in] blockSize : size of the blocks written on the data connection, 0 to adapt it to the link
+ * @param[in] isZeroCopy : 1 to send the file with sendfile where the system supports it, the blocks are copied through a buffer otherwise
+ * @param[in] progressCallback : callback which tells the progress of the transfer. Can be null
+ * @param[in|out] progressArg : arg given to the progressCallback
+ * @param[out] stats : the parameters and the throughput of the transfer. Can be null
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_UPLOADER_CANCELED if the session has been canceled, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Ftp_Put(ARUPDATER_Ftp_t *ftp, const char *const remotePath, int fd, int64_t offset, int64_t size, int isAppend, int blockSize, int isZeroCopy, ARUPDATER_Ftp_ProgressCallback_t progressCallback, void *progressArg, ARUPDATER_Uploader_TransferStats_t *stats);
+
+#endif
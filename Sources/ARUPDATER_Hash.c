@@ -0,0 +1,484 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Hash.c
+ * @brief libARUpdater hash c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Thread.h>
+
+#include "ARUPDATER_Hash.h"
+#include "ARUPDATER_FileIO.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_HASH_TAG                  "ARUPDATER_Hash"
+
+#define ARUPDATER_HASH_READ_BUFFER_SIZE     (1024 * 1024)
+
+/**
+ * @brief Leaves of a sha256tree hashed by one thread
+ */
+typedef struct
+{
+    ARUPDATER_FileIO_t *file;
+    int64_t fileSize;
+    int64_t firstChunk;
+    int64_t lastChunk; /**< excluded */
+    uint8_t *digests; /**< ARUPDATER_SHA256_DIGEST_SIZE bytes per chunk of the file */
+    eARUPDATER_ERROR error;
+} ARUPDATER_Hash_TreeWorker_t;
+
+static const char *const ARUPDATER_Hash_Names[ARUPDATER_HASH_MAX] =
+{
+    "md5",
+    "sha256",
+    "sha256tree",
+};
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static void *ARUPDATER_Hash_TreeWorkerRun(void *arg)
+{
+    ARUPDATER_Hash_TreeWorker_t *worker = (ARUPDATER_Hash_TreeWorker_t *)arg;
+    ARUPDATER_Sha256_Context_t context;
+    uint8_t *buffer = malloc(ARUPDATER_HASH_TREE_CHUNK_SIZE);
+    int64_t chunk = 0;
+    size_t readSize = 0;
+
+    if (buffer == NULL)
+    {
+        worker->error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    for (chunk = worker->firstChunk; (worker->error == ARUPDATER_OK) && (chunk < worker->lastChunk); chunk++)
+    {
+        int64_t offset = chunk * ARUPDATER_HASH_TREE_CHUNK_SIZE;
+        size_t size = ((worker->fileSize - offset) < ARUPDATER_HASH_TREE_CHUNK_SIZE) ? (size_t)(worker->fileSize - offset) : ARUPDATER_HASH_TREE_CHUNK_SIZE;
+
+        worker->error = ARUPDATER_FileIO_Read(worker->file, buffer, size, offset, &readSize);
+        if ((worker->error == ARUPDATER_OK) && (readSize != size))
+        {
+            // the file has been truncated
+            worker->error = ARUPDATER_ERROR_SYSTEM;
+        }
+        if (worker->error == ARUPDATER_OK)
+        {
+            ARUPDATER_Sha256_Init(&context);
+            ARUPDATER_Sha256_Update(&context, buffer, size);
+            ARUPDATER_Sha256_Final(&context, worker->digests + chunk * ARUPDATER_SHA256_DIGEST_SIZE);
+        }
+    }
+
+    free(buffer);
+
+    return NULL;
+}
+
+/**
+ * @brief Get the number of threads used to hash a number of leaves
+ */
+static int ARUPDATER_Hash_GetThreadCount(int64_t chunkCount)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCount = (cores > 0) ? (int)cores : 1;
+
+    if (threadCount > ARUPDATER_HASH_MAX_THREADS)
+    {
+        threadCount = ARUPDATER_HASH_MAX_THREADS;
+    }
+    if (threadCount > chunkCount)
+    {
+        threadCount = (chunkCount > 0) ? (int)chunkCount : 1;
+    }
+
+    return threadCount;
+}
+
+static eARUPDATER_ERROR ARUPDATER_Hash_ComputeTree(ARUPDATER_FileIO_t *file, int64_t fileSize, uint8_t *digest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Hash_TreeWorker_t workers[ARUPDATER_HASH_MAX_THREADS];
+    ARSAL_Thread_t threads[ARUPDATER_HASH_MAX_THREADS];
+    ARUPDATER_Sha256_Context_t context;
+    int64_t chunkCount = (fileSize + ARUPDATER_HASH_TREE_CHUNK_SIZE - 1) / ARUPDATER_HASH_TREE_CHUNK_SIZE;
+    int threadCount = ARUPDATER_Hash_GetThreadCount(chunkCount);
+    uint8_t *digests = NULL;
+    int i = 0;
+
+    if ((chunkCount > 0) && ((uint64_t)chunkCount > SIZE_MAX / ARUPDATER_SHA256_DIGEST_SIZE))
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if ((error == ARUPDATER_OK) && (chunkCount > 0))
+    {
+        digests = malloc((size_t)chunkCount * ARUPDATER_SHA256_DIGEST_SIZE);
+        if (digests == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        // contiguous ranges keep the reads of each thread sequential
+        for (i = 0; i < threadCount; i++)
+        {
+            workers[i].file = file;
+            workers[i].fileSize = fileSize;
+            workers[i].firstChunk = chunkCount * i / threadCount;
+            workers[i].lastChunk = chunkCount * (i + 1) / threadCount;
+            workers[i].digests = digests;
+            workers[i].error = ARUPDATER_OK;
+            threads[i] = NULL;
+        }
+
+        // the calling thread hashes the first range
+        for (i = 1; i < threadCount; i++)
+        {
+            if (ARSAL_Thread_Create(&threads[i], ARUPDATER_Hash_TreeWorkerRun, &workers[i]) != 0)
+            {
+                threads[i] = NULL;
+                ARUPDATER_Hash_TreeWorkerRun(&workers[i]);
+            }
+        }
+
+        ARUPDATER_Hash_TreeWorkerRun(&workers[0]);
+
+        for (i = 0; i < threadCount; i++)
+        {
+            if (threads[i] != NULL)
+            {
+                ARSAL_Thread_Join(threads[i], NULL);
+                ARSAL_Thread_Destroy(&threads[i]);
+            }
+            if ((error == ARUPDATER_OK) && (workers[i].error != ARUPDATER_OK))
+            {
+                error = workers[i].error;
+            }
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Sha256_Init(&context);
+        if (digests != NULL)
+        {
+            ARUPDATER_Sha256_Update(&context, digests, (size_t)chunkCount * ARUPDATER_SHA256_DIGEST_SIZE);
+        }
+        ARUPDATER_Sha256_Final(&context, digest);
+    }
+
+    free(digests);
+
+    return error;
+}
+
+static eARUPDATER_ERROR ARUPDATER_Hash_ComputeStream(eARUPDATER_HASH algorithm, ARUPDATER_FileIO_t *file, uint8_t *digest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Hash_Context_t context;
+    uint8_t *buffer = malloc(ARUPDATER_HASH_READ_BUFFER_SIZE);
+    int64_t offset = 0;
+    size_t readSize = 0;
+
+    if (buffer == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Hash_Init(&context, algorithm);
+    }
+
+    do
+    {
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_FileIO_Read(file, buffer, ARUPDATER_HASH_READ_BUFFER_SIZE, offset, &readSize);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            ARUPDATER_Hash_Update(&context, buffer, readSize);
+            offset += readSize;
+        }
+    } while ((error == ARUPDATER_OK) && (readSize > 0));
+
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Hash_Final(&context, digest);
+    }
+
+    free(buffer);
+
+    return error;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+eARUPDATER_HASH ARUPDATER_Hash_FromName(const char *const name)
+{
+    eARUPDATER_HASH algorithm = ARUPDATER_HASH_MAX;
+    int i = 0;
+
+    for (i = 0; (name != NULL) && (i < ARUPDATER_HASH_MAX); i++)
+    {
+        if (strcasecmp(name, ARUPDATER_Hash_Names[i]) == 0)
+        {
+            algorithm = (eARUPDATER_HASH)i;
+            break;
+        }
+    }
+
+    return algorithm;
+}
+
+const char *ARUPDATER_Hash_GetName(eARUPDATER_HASH algorithm)
+{
+    return ((algorithm >= 0) && (algorithm < ARUPDATER_HASH_MAX)) ? ARUPDATER_Hash_Names[algorithm] : NULL;
+}
+
+size_t ARUPDATER_Hash_GetDigestSize(eARUPDATER_HASH algorithm)
+{
+    size_t size = 0;
+
+    switch (algorithm)
+    {
+    case ARUPDATER_HASH_MD5:
+        size = ARUPDATER_MD5_DIGEST_SIZE;
+        break;
+    case ARUPDATER_HASH_SHA256:
+    case ARUPDATER_HASH_SHA256_TREE:
+        size = ARUPDATER_SHA256_DIGEST_SIZE;
+        break;
+    default:
+        break;
+    }
+
+    return size;
+}
+
+eARUPDATER_ERROR ARUPDATER_Hash_Init(ARUPDATER_Hash_Context_t *context, eARUPDATER_HASH algorithm)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((context == NULL) || (ARUPDATER_Hash_GetDigestSize(algorithm) == 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        context->algorithm = algorithm;
+        context->chunkSize = 0;
+        if (algorithm == ARUPDATER_HASH_MD5)
+        {
+            ARUPDATER_Md5_Init(&context->md5);
+        }
+        else
+        {
+            ARUPDATER_Sha256_Init(&context->sha256);
+        }
+    }
+
+    return error;
+}
+
+void ARUPDATER_Hash_Update(ARUPDATER_Hash_Context_t *context, const uint8_t *data, size_t size)
+{
+    switch (context->algorithm)
+    {
+    case ARUPDATER_HASH_MD5:
+        ARUPDATER_Md5_Update(&context->md5, data, size);
+        break;
+    case ARUPDATER_HASH_SHA256:
+        ARUPDATER_Sha256_Update(&context->sha256, data, size);
+        break;
+    case ARUPDATER_HASH_SHA256_TREE:
+        while (size > 0)
+        {
+            size_t chunkFree = ARUPDATER_HASH_TREE_CHUNK_SIZE - context->chunkSize;
+            size_t length = (size < chunkFree) ? size : chunkFree;
+            uint8_t chunkDigest[ARUPDATER_SHA256_DIGEST_SIZE];
+
+            if (context->chunkSize == 0)
+            {
+                ARUPDATER_Sha256_Init(&context->chunk);
+            }
+            ARUPDATER_Sha256_Update(&context->chunk, data, length);
+            context->chunkSize += length;
+            data += length;
+            size -= length;
+
+            if (context->chunkSize == ARUPDATER_HASH_TREE_CHUNK_SIZE)
+            {
+                ARUPDATER_Sha256_Final(&context->chunk, chunkDigest);
+                ARUPDATER_Sha256_Update(&context->sha256, chunkDigest, sizeof(chunkDigest));
+                context->chunkSize = 0;
+            }
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void ARUPDATER_Hash_Final(ARUPDATER_Hash_Context_t *context, uint8_t *digest)
+{
+    uint8_t chunkDigest[ARUPDATER_SHA256_DIGEST_SIZE];
+
+    switch (context->algorithm)
+    {
+    case ARUPDATER_HASH_MD5:
+        ARUPDATER_Md5_Final(&context->md5, digest);
+        break;
+    case ARUPDATER_HASH_SHA256_TREE:
+        if (context->chunkSize > 0)
+        {
+            ARUPDATER_Sha256_Final(&context->chunk, chunkDigest);
+            ARUPDATER_Sha256_Update(&context->sha256, chunkDigest, sizeof(chunkDigest));
+            context->chunkSize = 0;
+        }
+        ARUPDATER_Sha256_Final(&context->sha256, digest);
+        break;
+    case ARUPDATER_HASH_SHA256:
+        ARUPDATER_Sha256_Final(&context->sha256, digest);
+        break;
+    default:
+        break;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Hash_ComputeFile(eARUPDATER_HASH algorithm, const char *const filePath, uint8_t *digest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_FileIO_t *file = NULL;
+    struct stat fileStat;
+
+    if ((filePath == NULL) || (digest == NULL) || (ARUPDATER_Hash_GetDigestSize(algorithm) == 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        file = ARUPDATER_FileIO_New(filePath, ARUPDATER_FILEIO_MODE_READ, ARUPDATER_FILEIO_BACKEND_DEFAULT, &error);
+    }
+
+    if ((error == ARUPDATER_OK) && (fstat(ARUPDATER_FileIO_GetFd(file), &fileStat) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+#ifdef POSIX_FADV_SEQUENTIAL
+        posix_fadvise(ARUPDATER_FileIO_GetFd(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        if (algorithm == ARUPDATER_HASH_SHA256_TREE)
+        {
+            error = ARUPDATER_Hash_ComputeTree(file, (int64_t)fileStat.st_size, digest);
+        }
+        else
+        {
+            error = ARUPDATER_Hash_ComputeStream(algorithm, file, digest);
+        }
+    }
+
+    ARUPDATER_FileIO_Delete(&file);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Hash_CheckFile(eARUPDATER_HASH algorithm, const char *const filePath, const char *const expected)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t digest[ARUPDATER_HASH_MAX_DIGEST_SIZE];
+    char digestHex[ARUPDATER_HASH_MAX_DIGEST_SIZE * 2 + 1];
+    size_t digestSize = ARUPDATER_Hash_GetDigestSize(algorithm);
+
+    if ((expected == NULL) || (digestSize == 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Hash_ComputeFile(algorithm, filePath, digest);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Hash_ToHex(digest, digestSize, digestHex);
+        if ((strlen(expected) != digestSize * 2) || (strcasecmp(expected, digestHex) != 0))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_HASH_TAG, "%s: %s is %s, expected %s", filePath, ARUPDATER_Hash_Names[algorithm], digestHex, expected);
+            error = ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH;
+        }
+    }
+
+    return error;
+}
+
+void ARUPDATER_Hash_ToHex(const uint8_t *digest, size_t size, char *hex)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    size_t i = 0;
+
+    for (i = 0; i < size; i++)
+    {
+        hex[i * 2] = hexDigits[digest[i] >> 4];
+        hex[i * 2 + 1] = hexDigits[digest[i] & 0x0f];
+    }
+    hex[size * 2] = '\0';
+}
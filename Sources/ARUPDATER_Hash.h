@@ -0,0 +1,156 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Hash.h
+ * @brief libARUpdater hash header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_HASH_PRIVATE_H_
+#define _ARUPDATER_HASH_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+
+#include "ARUPDATER_Md5.h"
+#include "ARUPDATER_Sha256.h"
+
+/**
+ * @brief Size of the biggest digest of all the algorithms
+ */
+#define ARUPDATER_HASH_MAX_DIGEST_SIZE      ARUPDATER_SHA256_DIGEST_SIZE
+
+/**
+ * @brief Size of the leaves of the sha256tree algorithm
+ */
+#define ARUPDATER_HASH_TREE_CHUNK_SIZE      (1024 * 1024)
+
+/**
+ * @brief Maximum number of threads used to hash a file
+ */
+#define ARUPDATER_HASH_MAX_THREADS          8
+
+/**
+ * @brief Hash algorithms
+ */
+typedef enum
+{
+    ARUPDATER_HASH_MD5 = 0,             /**< "md5" : MD5, the checksum given in the update reply */
+    ARUPDATER_HASH_SHA256,              /**< "sha256" : SHA-256 of the whole file */
+    ARUPDATER_HASH_SHA256_TREE,         /**< "sha256tree" : SHA-256 of the concatenated SHA-256 of each ARUPDATER_HASH_TREE_CHUNK_SIZE chunk of the file, the last chunk may be shorter. The leaves are hashed in parallel */
+    ARUPDATER_HASH_MAX,                 /**< Unknown algorithm */
+} eARUPDATER_HASH;
+
+/**
+ * @brief Streaming hash context
+ */
+typedef struct
+{
+    eARUPDATER_HASH algorithm;
+    ARUPDATER_Md5_Context_t md5;
+    ARUPDATER_Sha256_Context_t sha256;
+    ARUPDATER_Sha256_Context_t chunk; /**< current leaf of the sha256tree algorithm */
+    size_t chunkSize; /**< bytes in the current leaf */
+} ARUPDATER_Hash_Context_t;
+
+/**
+ * @brief Get an algorithm from its name
+ * @param[in] name : the name of the algorithm, as sent by the update server
+ * @return the algorithm, ARUPDATER_HASH_MAX if the name is unknown
+ */
+eARUPDATER_HASH ARUPDATER_Hash_FromName(const char *const name);
+
+/**
+ * @brief Get the name of an algorithm
+ * @param[in] algorithm : the algorithm
+ * @return the name of the algorithm, NULL if it is unknown
+ */
+const char *ARUPDATER_Hash_GetName(eARUPDATER_HASH algorithm);
+
+/**
+ * @brief Get the digest size of an algorithm
+ * @param[in] algorithm : the algorithm
+ * @return the size of the digest in bytes, 0 if the algorithm is unknown
+ */
+size_t ARUPDATER_Hash_GetDigestSize(eARUPDATER_HASH algorithm);
+
+/**
+ * @brief Initialize a streaming hash context
+ * @param context : the context
+ * @param[in] algorithm : the algorithm
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_BAD_PARAMETER if the algorithm is unknown
+ */
+eARUPDATER_ERROR ARUPDATER_Hash_Init(ARUPDATER_Hash_Context_t *context, eARUPDATER_HASH algorithm);
+
+/**
+ * @brief Add data to a streaming hash context
+ * @param context : the context
+ * @param[in] data : the data to hash
+ * @param[in] size : the size of the data
+ */
+void ARUPDATER_Hash_Update(ARUPDATER_Hash_Context_t *context, const uint8_t *data, size_t size);
+
+/**
+ * @brief Get the digest of a streaming hash context
+ * @param context : the context
+ * @param[out] digest : buffer of ARUPDATER_Hash_GetDigestSize() bytes
+ */
+void ARUPDATER_Hash_Final(ARUPDATER_Hash_Context_t *context, uint8_t *digest);
+
+/**
+ * @brief Compute the digest of a file
+ * @details the leaves of the sha256tree algorithm are split between up to ARUPDATER_HASH_MAX_THREADS threads, one per online core
+ * @param[in] algorithm : the algorithm
+ * @param[in] filePath : the path of the file
+ * @param[out] digest : buffer of ARUPDATER_Hash_GetDigestSize() bytes
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Hash_ComputeFile(eARUPDATER_HASH algorithm, const char *const filePath, uint8_t *digest);
+
+/**
+ * @brief Check a file against an expected digest
+ * @param[in] algorithm : the algorithm
+ * @param[in] filePath : the path of the file
+ * @param[in] expected : the expected digest as an hexadecimal string
+ * @return ARUPDATER_OK if the digest matches, ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH if it does not (whatever the algorithm), a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Hash_CheckFile(eARUPDATER_HASH algorithm, const char *const filePath, const char *const expected);
+
+/**
+ * @brief Convert a digest to a lowercase hexadecimal string
+ * @param[in] digest : the digest
+ * @param[in] size : the size of the digest
+ * @param[out] hex : buffer of size * 2 + 1 bytes
+ */
+void ARUPDATER_Hash_ToHex(const uint8_t *digest, size_t size, char *hex);
+
+#endif
@@ -0,0 +1,295 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_HashCache.c
+ * @brief libARUpdater persistent hash cache c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_HashCache.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_HASH_CACHE_TAG                "ARUPDATER_HashCache"
+
+#define ARUPDATER_HASH_CACHE_TMP_SUFFIX         ".XXXXXX"
+#define ARUPDATER_HASH_CACHE_LINE_SIZE          256
+
+/**
+ * @brief Key of a cache entry
+ */
+typedef struct
+{
+    unsigned long long device;
+    unsigned long long inode;
+    long long size;
+    long long mtimeNs;
+} ARUPDATER_HashCache_Key_t;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static eARUPDATER_ERROR ARUPDATER_HashCache_GetKey(const char *const filePath, ARUPDATER_HashCache_Key_t *key)
+{
+    struct stat fileStat;
+
+    if ((filePath == NULL) || (stat(filePath, &fileStat) != 0))
+    {
+        return ARUPDATER_ERROR_SYSTEM;
+    }
+
+    key->device = (unsigned long long)fileStat.st_dev;
+    key->inode = (unsigned long long)fileStat.st_ino;
+    key->size = (long long)fileStat.st_size;
+#if defined(__APPLE__)
+    key->mtimeNs = (long long)fileStat.st_mtimespec.tv_sec * 1000000000LL + fileStat.st_mtimespec.tv_nsec;
+#else
+    key->mtimeNs = (long long)fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec;
+#endif
+
+    return ARUPDATER_OK;
+}
+
+/**
+ * @brief Parse a line of the cache file
+ * @return 1 if the line is valid, 0 otherwise
+ */
+static int ARUPDATER_HashCache_ParseLine(const char *line, ARUPDATER_HashCache_Key_t *key, char *algorithmName, char *hex)
+{
+    // <device> <inode> <size> <mtime ns> <algorithm> <hex>
+    return sscanf(line, "%llu %llu %lld %lld %15s %64s", &key->device, &key->inode, &key->size, &key->mtimeNs, algorithmName, hex) == 6;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+int ARUPDATER_HashCache_Lookup(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, char *hex)
+{
+    ARUPDATER_HashCache_Key_t fileKey;
+    ARUPDATER_HashCache_Key_t entryKey;
+    char line[ARUPDATER_HASH_CACHE_LINE_SIZE];
+    char algorithmName[16];
+    char entryHex[ARUPDATER_HASH_CACHE_HEX_SIZE];
+    const char *name = ARUPDATER_Hash_GetName(algorithm);
+    FILE *cacheFile = NULL;
+    int found = 0;
+
+    if ((cacheFilePath != NULL) && (name != NULL) && (hex != NULL) && (ARUPDATER_HashCache_GetKey(filePath, &fileKey) == ARUPDATER_OK))
+    {
+        cacheFile = fopen(cacheFilePath, "r");
+    }
+
+    // the last entry for a file is the most recent one
+    while ((cacheFile != NULL) && (fgets(line, sizeof(line), cacheFile) != NULL))
+    {
+        if (ARUPDATER_HashCache_ParseLine(line, &entryKey, algorithmName, entryHex) &&
+            (memcmp(&entryKey, &fileKey, sizeof(fileKey)) == 0) &&
+            (strcmp(algorithmName, name) == 0) &&
+            (strlen(entryHex) == ARUPDATER_Hash_GetDigestSize(algorithm) * 2))
+        {
+            strcpy(hex, entryHex);
+            found = 1;
+        }
+    }
+
+    if (cacheFile != NULL)
+    {
+        fclose(cacheFile);
+    }
+
+    return found;
+}
+
+eARUPDATER_ERROR ARUPDATER_HashCache_Store(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, const char *const hex)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_HashCache_Key_t fileKey;
+    ARUPDATER_HashCache_Key_t entryKey;
+    char (*lines)[ARUPDATER_HASH_CACHE_LINE_SIZE] = NULL;
+    char algorithmName[16];
+    char entryHex[ARUPDATER_HASH_CACHE_HEX_SIZE];
+    const char *name = ARUPDATER_Hash_GetName(algorithm);
+    char *tmpPath = NULL;
+    FILE *cacheFile = NULL;
+    int lineCount = 0;
+    int firstLine = 0;
+    int fd = -1;
+    int i = 0;
+
+    if ((cacheFilePath == NULL) || (name == NULL) || (hex == NULL) || (strlen(hex) != ARUPDATER_Hash_GetDigestSize(algorithm) * 2))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_HashCache_GetKey(filePath, &fileKey);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        lines = malloc(ARUPDATER_HASH_CACHE_MAX_ENTRIES * sizeof(*lines));
+        tmpPath = malloc(strlen(cacheFilePath) + strlen(ARUPDATER_HASH_CACHE_TMP_SUFFIX) + 1);
+        if ((lines == NULL) || (tmpPath == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    // keep the other entries, in a ring of the ARUPDATER_HASH_CACHE_MAX_ENTRIES - 1 most recent ones
+    if (error == ARUPDATER_OK)
+    {
+        cacheFile = fopen(cacheFilePath, "r");
+        while ((cacheFile != NULL) && (fgets(lines[lineCount % ARUPDATER_HASH_CACHE_MAX_ENTRIES], ARUPDATER_HASH_CACHE_LINE_SIZE, cacheFile) != NULL))
+        {
+            char *line = lines[lineCount % ARUPDATER_HASH_CACHE_MAX_ENTRIES];
+            if (ARUPDATER_HashCache_ParseLine(line, &entryKey, algorithmName, entryHex) &&
+                (line[strlen(line) - 1] == '\n') &&
+                !((entryKey.device == fileKey.device) && (entryKey.inode == fileKey.inode) && (strcmp(algorithmName, name) == 0)))
+            {
+                lineCount++;
+                if (lineCount - firstLine >= ARUPDATER_HASH_CACHE_MAX_ENTRIES)
+                {
+                    firstLine++;
+                }
+            }
+        }
+        if (cacheFile != NULL)
+        {
+            fclose(cacheFile);
+            cacheFile = NULL;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        strcpy(tmpPath, cacheFilePath);
+        strcat(tmpPath, ARUPDATER_HASH_CACHE_TMP_SUFFIX);
+        fd = mkstemp(tmpPath);
+        if (fd >= 0)
+        {
+            cacheFile = fdopen(fd, "w");
+        }
+        if (cacheFile == NULL)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+                unlink(tmpPath);
+            }
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        for (i = 0; hex[i] != '\0'; i++)
+        {
+            entryHex[i] = (char)tolower((unsigned char)hex[i]);
+        }
+        entryHex[i] = '\0';
+
+        for (i = firstLine; i < lineCount; i++)
+        {
+            fputs(lines[i % ARUPDATER_HASH_CACHE_MAX_ENTRIES], cacheFile);
+        }
+        fprintf(cacheFile, "%llu %llu %lld %lld %s %s\n", fileKey.device, fileKey.inode, fileKey.size, fileKey.mtimeNs, name, entryHex);
+
+        if ((fclose(cacheFile) != 0) || (rename(tmpPath, cacheFilePath) != 0))
+        {
+            unlink(tmpPath);
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_HASH_CACHE_TAG, "could not add %s to the hash cache: %s", (filePath != NULL) ? filePath : "(null)", ARUPDATER_Error_ToString(error));
+    }
+
+    free(lines);
+    free(tmpPath);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_HashCache_ComputeFile(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, char *hex)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t digest[ARUPDATER_HASH_MAX_DIGEST_SIZE];
+    int isCached = 0;
+
+    if (hex == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        isCached = ARUPDATER_HashCache_Lookup(cacheFilePath, algorithm, filePath, hex);
+        if (isCached)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_HASH_CACHE_TAG, "%s: %s taken from the hash cache", filePath, ARUPDATER_Hash_GetName(algorithm));
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && !isCached)
+    {
+        error = ARUPDATER_Hash_ComputeFile(algorithm, filePath, digest);
+        if (error == ARUPDATER_OK)
+        {
+            ARUPDATER_Hash_ToHex(digest, ARUPDATER_Hash_GetDigestSize(algorithm), hex);
+
+            // the digest is valid even if the cache can not be written
+            ARUPDATER_HashCache_Store(cacheFilePath, algorithm, filePath, hex);
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_HashCache.h
+ * @brief libARUpdater persistent hash cache header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_HASH_CACHE_PRIVATE_H_
+#define _ARUPDATER_HASH_CACHE_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Error.h>
+
+#include "ARUPDATER_Hash.h"
+
+/**
+ * @brief Name of the cache file, in the plf folder
+ */
+#define ARUPDATER_HASH_CACHE_FILE_NAME          "hash_cache.txt"
+
+/**
+ * @brief Maximum number of entries kept in the cache, the oldest ones are dropped first
+ */
+#define ARUPDATER_HASH_CACHE_MAX_ENTRIES        64
+
+/**
+ * @brief Size of the buffer needed to get an hexadecimal digest from the cache
+ */
+#define ARUPDATER_HASH_CACHE_HEX_SIZE           (ARUPDATER_HASH_MAX_DIGEST_SIZE * 2 + 1)
+
+/**
+ * @brief Get the digest of a file from the cache
+ * @details An entry is keyed by the device, inode, size and modification time (in ns) of the file, any change of the file invalidates it
+ * @param[in] cacheFilePath : path of the cache file
+ * @param[in] algorithm : the algorithm of the digest
+ * @param[in] filePath : path of the file
+ * @param[out] hex : buffer of ARUPDATER_HASH_CACHE_HEX_SIZE bytes
+ * @return 1 if the digest is in the cache, 0 otherwise
+ */
+int ARUPDATER_HashCache_Lookup(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, char *hex);
+
+/**
+ * @brief Add the digest of a file to the cache
+ * @details The cache file is rewritten then renamed, concurrent writers may lose an entry but never corrupt the cache
+ * @param[in] cacheFilePath : path of the cache file
+ * @param[in] algorithm : the algorithm of the digest
+ * @param[in] filePath : path of the file, it must not be modified after its digest has been verified
+ * @param[in] hex : the digest of the file as an hexadecimal string
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_HashCache_Store(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, const char *const hex);
+
+/**
+ * @brief Get the digest of a file from the cache, or compute it and add it to the cache
+ * @param[in] cacheFilePath : path of the cache file
+ * @param[in] algorithm : the algorithm of the digest
+ * @param[in] filePath : path of the file
+ * @param[out] hex : buffer of ARUPDATER_HASH_CACHE_HEX_SIZE bytes
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_HashCache_ComputeFile(const char *const cacheFilePath, eARUPDATER_HASH algorithm, const char *const filePath, char *hex);
+
+#endif
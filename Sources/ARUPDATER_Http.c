@@ -0,0 +1,459 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Http.c
+ * @brief libARUpdater Http c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <curl/curl.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Mutex.h>
+
+#include "ARUPDATER_Http.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_HTTP_TAG                      "ARUPDATER_Http"
+
+#define ARUPDATER_HTTP_CONNECT_TIMEOUT_SEC      30
+#define ARUPDATER_HTTP_LOW_SPEED_LIMIT          1
+#define ARUPDATER_HTTP_LOW_SPEED_TIME_SEC       60
+
+static pthread_once_t ARUPDATER_Http_GlobalInitOnce = PTHREAD_ONCE_INIT;
+static CURLcode ARUPDATER_Http_GlobalInitCode = CURLE_OK;
+
+struct ARUPDATER_Http_Connection_t
+{
+    CURL *curl;
+    volatile int isCanceled;
+
+    ARUPDATER_FileIO_t *file;
+    int64_t offset;
+    int64_t endOffset; /**< offset past the last byte which can be written, -1 if none */
+    eARUPDATER_ERROR writeError;
+
+    ARUPDATER_Http_ProgressCallback_t progressCallback;
+    void *progressArg;
+
+    ARUPDATER_Http_DataCallback_t dataCallback;
+    void *dataArg;
+
+    int64_t pipelineMemory; /**< 0 to write the file from the curl callback */
+    ARUPDATER_Pipeline_t *pipeline;
+    ARUPDATER_Downloader_PipelineStats_t pipelineStats; /**< stats of the last pipeline */
+    ARSAL_Mutex_t pipelineLock; /**< protects the pipeline from ARUPDATER_Http_Connection_GetPipelineStats */
+    int hasPipelineLock;
+};
+
+/* ***************************************
+ *
+ *             function implementation :
+ *
+ *****************************************/
+
+static void ARUPDATER_Http_InitCurl(void)
+{
+    ARUPDATER_Http_GlobalInitCode = curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_GlobalInit(void)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    pthread_once(&ARUPDATER_Http_GlobalInitOnce, ARUPDATER_Http_InitCurl);
+    if (ARUPDATER_Http_GlobalInitCode != CURLE_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_HTTP_TAG, "curl can not be initialized: %s", curl_easy_strerror(ARUPDATER_Http_GlobalInitCode));
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+    
+    return error;
+}
+
+static size_t ARUPDATER_Http_WriteCallback(void *ptr, size_t size, size_t nmemb, void *userData)
+{
+    ARUPDATER_Http_Connection_t *connection = (ARUPDATER_Http_Connection_t *)userData;
+    size_t length = size * nmemb;
+    size_t written = 0;
+
+    // a server ignoring the range would overwrite the rest of the file
+    if ((connection->endOffset >= 0) && ((int64_t)length > connection->endOffset - connection->offset))
+    {
+        return 0;
+    }
+
+    if ((connection->isCanceled == 0) && (connection->pipeline != NULL))
+    {
+        // the data callback is called by the writing thread of the pipeline
+        connection->writeError = ARUPDATER_Pipeline_Write(connection->pipeline, ptr, length, connection->offset);
+    }
+    else if (connection->isCanceled == 0)
+    {
+        connection->writeError = ARUPDATER_FileIO_Write(connection->file, ptr, length, connection->offset);
+        if ((connection->writeError == ARUPDATER_OK) && (connection->dataCallback != NULL))
+        {
+            connection->dataCallback(connection->dataArg, (const uint8_t *)ptr, length);
+        }
+    }
+
+    if ((connection->isCanceled == 0) && (connection->writeError == ARUPDATER_OK))
+    {
+        written = length;
+        connection->offset += length;
+    }
+
+    // returning less than length makes curl abort the transfer
+    return written;
+}
+
+static int ARUPDATER_Http_ProgressInternalCallback(void *clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    ARUPDATER_Http_Connection_t *connection = (ARUPDATER_Http_Connection_t *)clientp;
+
+    if ((connection->progressCallback != NULL) && (dlnow > 0))
+    {
+        connection->progressCallback(connection->progressArg, (int64_t)dlnow, (int64_t)dltotal);
+    }
+
+    // a non zero value aborts the transfer
+    return connection->isCanceled;
+}
+
+ARUPDATER_Http_Connection_t* ARUPDATER_Http_Connection_New(eARUPDATER_ERROR *error)
+{
+    ARUPDATER_Http_Connection_t *connection = NULL;
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+
+    connection = calloc(1, sizeof(ARUPDATER_Http_Connection_t));
+    if (connection == NULL)
+    {
+        err = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        err = ARUPDATER_Http_GlobalInit();
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        connection->endOffset = -1;
+        connection->curl = curl_easy_init();
+        if (connection->curl == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Mutex_Init(&connection->pipelineLock) != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            connection->hasPipelineLock = 1;
+        }
+    }
+
+    if (err != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_HTTP_TAG, "error: %s", ARUPDATER_Error_ToString(err));
+        ARUPDATER_Http_Connection_Delete(&connection);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return connection;
+}
+
+void ARUPDATER_Http_Connection_Delete(ARUPDATER_Http_Connection_t **connectionAddr)
+{
+    if (connectionAddr != NULL)
+    {
+        ARUPDATER_Http_Connection_t *connection = *connectionAddr;
+        if (connection != NULL)
+        {
+            if (connection->curl != NULL)
+            {
+                curl_easy_cleanup(connection->curl);
+            }
+            if (connection->hasPipelineLock)
+            {
+                ARSAL_Mutex_Destroy(&connection->pipelineLock);
+            }
+            free(connection);
+        }
+        *connectionAddr = NULL;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_Connection_Cancel(ARUPDATER_Http_Connection_t *connection)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if (connection == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        connection->isCanceled = 1;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_Connection_SetDataCallback(ARUPDATER_Http_Connection_t *connection, ARUPDATER_Http_DataCallback_t dataCallback, void *dataArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if (connection == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        connection->dataCallback = dataCallback;
+        connection->dataArg = dataArg;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_Connection_SetPipelineMemory(ARUPDATER_Http_Connection_t *connection, int64_t maxMemory)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((connection == NULL) || (maxMemory < 0) || ((maxMemory > 0) && (maxMemory < ARUPDATER_PIPELINE_MIN_MEMORY)))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else
+    {
+        connection->pipelineMemory = maxMemory;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_Connection_GetPipelineStats(ARUPDATER_Http_Connection_t *connection, ARUPDATER_Downloader_PipelineStats_t *stats)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((connection == NULL) || (stats == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&connection->pipelineLock);
+        if (connection->pipeline != NULL)
+        {
+            ARUPDATER_Pipeline_GetStats(connection->pipeline, stats);
+        }
+        else
+        {
+            *stats = connection->pipelineStats;
+        }
+        ARSAL_Mutex_Unlock(&connection->pipelineLock);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Fetch an url, or a range of it when size is not negative, and write it into file from offset
+ */
+static eARUPDATER_ERROR ARUPDATER_Http_Perform(ARUPDATER_Http_Connection_t *connection, const char *const url, ARUPDATER_FileIO_t *file, int64_t offset, int64_t size, int64_t *receivedSize, ARUPDATER_Http_ProgressCallback_t progressCallback, void *progressArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    CURLcode code = CURLE_OK;
+    char range[64];
+    eARUPDATER_ERROR flushError = ARUPDATER_OK;
+    ARUPDATER_Pipeline_t *pipeline = NULL;
+    long responseCode = 0;
+
+    connection->file = file;
+    connection->offset = offset;
+    connection->endOffset = (size >= 0) ? offset + size : -1;
+    connection->writeError = ARUPDATER_OK;
+    connection->progressCallback = progressCallback;
+    connection->progressArg = progressArg;
+
+    curl_easy_reset(connection->curl);
+    curl_easy_setopt(connection->curl, CURLOPT_URL, url);
+    curl_easy_setopt(connection->curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(connection->curl, CURLOPT_FAILONERROR, 1L);
+    curl_easy_setopt(connection->curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(connection->curl, CURLOPT_CONNECTTIMEOUT, (long)ARUPDATER_HTTP_CONNECT_TIMEOUT_SEC);
+    curl_easy_setopt(connection->curl, CURLOPT_LOW_SPEED_LIMIT, (long)ARUPDATER_HTTP_LOW_SPEED_LIMIT);
+    curl_easy_setopt(connection->curl, CURLOPT_LOW_SPEED_TIME, (long)ARUPDATER_HTTP_LOW_SPEED_TIME_SEC);
+    curl_easy_setopt(connection->curl, CURLOPT_WRITEFUNCTION, ARUPDATER_Http_WriteCallback);
+    curl_easy_setopt(connection->curl, CURLOPT_WRITEDATA, connection);
+    curl_easy_setopt(connection->curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(connection->curl, CURLOPT_XFERINFOFUNCTION, ARUPDATER_Http_ProgressInternalCallback);
+    curl_easy_setopt(connection->curl, CURLOPT_XFERINFODATA, connection);
+    if (size >= 0)
+    {
+        snprintf(range, sizeof(range), "%lld-%lld", (long long)offset, (long long)(offset + size - 1));
+        curl_easy_setopt(connection->curl, CURLOPT_RANGE, range);
+    }
+
+    // the ranges are too small to be worth a writing thread
+    if ((connection->pipelineMemory > 0) && (size < 0))
+    {
+        pipeline = ARUPDATER_Pipeline_New(file, connection->pipelineMemory, connection->dataCallback, connection->dataArg, NULL);
+        if (pipeline == NULL)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_HTTP_TAG, "no pipeline, the file is written by the network thread");
+        }
+        ARSAL_Mutex_Lock(&connection->pipelineLock);
+        connection->pipeline = pipeline;
+        ARSAL_Mutex_Unlock(&connection->pipelineLock);
+    }
+
+    if (connection->isCanceled == 0)
+    {
+        code = curl_easy_perform(connection->curl);
+    }
+    else
+    {
+        code = CURLE_ABORTED_BY_CALLBACK;
+    }
+
+    if (code != CURLE_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_HTTP_TAG, "get %s failed: %s", url, curl_easy_strerror(code));
+        if (connection->writeError == ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE)
+        {
+            error = ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE;
+        }
+        else
+        {
+            error = ARUPDATER_ERROR_DOWNLOADER_DOWNLOAD;
+        }
+    }
+
+    // the last writes may still be queued in the pipeline or gathered by the file
+    if (pipeline != NULL)
+    {
+        flushError = ARUPDATER_Pipeline_Finish(pipeline);
+        ARSAL_Mutex_Lock(&connection->pipelineLock);
+        ARUPDATER_Pipeline_GetStats(pipeline, &connection->pipelineStats);
+        connection->pipeline = NULL;
+        ARSAL_Mutex_Unlock(&connection->pipelineLock);
+        ARUPDATER_Pipeline_Delete(&pipeline);
+    }
+    if (flushError == ARUPDATER_OK)
+    {
+        flushError = ARUPDATER_FileIO_Flush(file);
+    }
+    if ((error == ARUPDATER_OK) && (flushError != ARUPDATER_OK))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_HTTP_TAG, "get %s failed: %s", url, ARUPDATER_Error_ToString(flushError));
+        error = (flushError == ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE) ? flushError : ARUPDATER_ERROR_DOWNLOADER_DOWNLOAD;
+    }
+
+    if ((error == ARUPDATER_OK) && (size >= 0))
+    {
+        curl_easy_getinfo(connection->curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        if ((responseCode != 206) || (connection->offset != connection->endOffset))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_HTTP_TAG, "get %s (%s) failed: status %ld", url, range, responseCode);
+            error = ARUPDATER_ERROR_DOWNLOADER_DOWNLOAD;
+        }
+    }
+
+    if (receivedSize != NULL)
+    {
+        *receivedSize = connection->offset - offset;
+    }
+
+    connection->file = NULL;
+    connection->endOffset = -1;
+    connection->progressCallback = NULL;
+    connection->progressArg = NULL;
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_GetToFile(ARUPDATER_Http_Connection_t *connection, const char *const url, ARUPDATER_FileIO_t *file, int64_t *receivedSize, ARUPDATER_Http_ProgressCallback_t progressCallback, void *progressArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((connection == NULL) || (url == NULL) || (file == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Http_Perform(connection, url, file, 0, -1, receivedSize, progressCallback, progressArg);
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Http_GetRangeToFile(ARUPDATER_Http_Connection_t *connection, const char *const url, ARUPDATER_FileIO_t *file, int64_t offset, int64_t size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Http_DataCallback_t dataCallback = NULL;
+
+    if ((connection == NULL) || (url == NULL) || (file == NULL) || (offset < 0) || (size <= 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        // the data callback expects the file in order
+        dataCallback = connection->dataCallback;
+        connection->dataCallback = NULL;
+        error = ARUPDATER_Http_Perform(connection, url, file, offset, size, NULL, NULL, NULL);
+        connection->dataCallback = dataCallback;
+    }
+
+    return error;
+}
@@ -0,0 +1,154 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Http.h
+ * @brief libARUpdater Http header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_HTTP_PRIVATE_H_
+#define _ARUPDATER_HTTP_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+
+#include "ARUPDATER_FileIO.h"
+#include "ARUPDATER_Pipeline.h"
+
+/**
+ * @brief Http connection used to fetch the plf files into a file
+ * @see ARUPDATER_Http_Connection_New ()
+ */
+typedef struct ARUPDATER_Http_Connection_t ARUPDATER_Http_Connection_t;
+
+/**
+ * @brief Progress callback of an http get
+ * @param arg The pointer of the user custom argument
+ * @param receivedSize The number of bytes already fetched
+ * @param totalSize The size of the file given by the server, 0 if unknown
+ */
+typedef void (*ARUPDATER_Http_ProgressCallback_t) (void* arg, int64_t receivedSize, int64_t totalSize);
+
+/**
+ * @brief Data callback of an http get, called with the data once it has been written
+ * @param arg The pointer of the user custom argument
+ * @param data The data written, following the previous one
+ * @param size The size of the data
+ */
+typedef void (*ARUPDATER_Http_DataCallback_t) (void* arg, const uint8_t *data, size_t size);
+
+/**
+ * @brief Initialize libcurl once for the process
+ * @details curl_easy_init() runs the global initialization of libcurl itself if it has not been done, which is not thread safe:
+ * it is called before the first easy handle of the library and before any of its transfer threads is created
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_SYSTEM if libcurl can not be initialized
+ */
+eARUPDATER_ERROR ARUPDATER_Http_GlobalInit(void);
+
+/**
+ * @brief Create a new http connection
+ * @warning This function allocates memory
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise. Can be null
+ * @return the new connection, NULL if an error occurred
+ * @see ARUPDATER_Http_Connection_Delete ()
+ */
+ARUPDATER_Http_Connection_t* ARUPDATER_Http_Connection_New(eARUPDATER_ERROR *error);
+
+/**
+ * @brief Delete an http connection
+ * @warning This function frees memory
+ * @param connection : address of the pointer on the connection
+ * @see ARUPDATER_Http_Connection_New ()
+ */
+void ARUPDATER_Http_Connection_Delete(ARUPDATER_Http_Connection_t **connection);
+
+/**
+ * @brief Cancel the running get of a connection
+ * @details Can be called from any thread, the get returns as soon as the transfer notices it
+ * @param connection : pointer on the connection
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Http_Connection_Cancel(ARUPDATER_Http_Connection_t *connection);
+
+/**
+ * @brief Set the callback called with the data written by ARUPDATER_Http_GetToFile
+ * @param connection : pointer on the connection
+ * @param[in] dataCallback : the callback, NULL to remove it
+ * @param[in|out] dataArg : arg given to the dataCallback
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Http_Connection_SetDataCallback(ARUPDATER_Http_Connection_t *connection, ARUPDATER_Http_DataCallback_t dataCallback, void *dataArg);
+
+/**
+ * @brief Set the memory of the pipeline between the network and the file of ARUPDATER_Http_GetToFile
+ * @details With a pipeline, the data callback is called by the writing thread of the pipeline
+ * @param connection : pointer on the connection
+ * @param[in] maxMemory : memory of the buffers of the pipeline, at least ARUPDATER_PIPELINE_MIN_MEMORY bytes, 0 to write the file from the network thread
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_BAD_PARAMETER if maxMemory is too small, the description of the error otherwise
+ * @see ARUPDATER_Pipeline_New ()
+ */
+eARUPDATER_ERROR ARUPDATER_Http_Connection_SetPipelineMemory(ARUPDATER_Http_Connection_t *connection, int64_t maxMemory);
+
+/**
+ * @brief Get the occupancy of the pipeline of the running get, or of the last one
+ * @details Can be called from any thread
+ * @param connection : pointer on the connection
+ * @param[out] stats : the occupancy of the buffers
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Http_Connection_GetPipelineStats(ARUPDATER_Http_Connection_t *connection, ARUPDATER_Downloader_PipelineStats_t *stats);
+
+/**
+ * @brief Fetch an url and write its content at the beginning of a file
+ * @param connection : pointer on the connection
+ * @param[in] url : the full url of the file (http://server/path)
+ * @param file : file opened for writing, flushed once the get is done
+ * @param[out] receivedSize : number of bytes written into file. Can be null
+ * @param[in] progressCallback : callback which tells the progress of the get. Can be null
+ * @param[in|out] progressArg : arg given to the progressCallback
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Http_GetToFile(ARUPDATER_Http_Connection_t *connection, const char *const url, ARUPDATER_FileIO_t *file, int64_t *receivedSize, ARUPDATER_Http_ProgressCallback_t progressCallback, void *progressArg);
+
+/**
+ * @brief Fetch a byte range of an url and write it at the same offset of a file
+ * @details The server must answer with a partial content, a full reply is treated as an error
+ * @param connection : pointer on the connection
+ * @param[in] url : the full url of the file (http://server/path)
+ * @param file : file opened for writing, flushed once the get is done
+ * @param[in] offset : offset of the first byte of the range
+ * @param[in] size : size of the range
+ * @return ARUPDATER_OK if the whole range has been written, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Http_GetRangeToFile(ARUPDATER_Http_Connection_t *connection, const char *const url, ARUPDATER_FileIO_t *file, int64_t offset, int64_t size);
+
+#endif /* _ARUPDATER_HTTP_PRIVATE_H_ */
@@ -36,12 +36,16 @@
  **/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <libARSAL/ARSAL_Print.h>
 
 #include <libARUpdater/ARUPDATER_Error.h>
 #include <libARUpdater/ARUPDATER_Manager.h>
 #include "ARUPDATER_Manager.h"
 #include "ARUPDATER_Utils.h"
+#include "ARUPDATER_Versions.h"
+#include "ARUPDATER_PlfPack.h"
+#include "ARUPDATER_PlfIndex.h"
 
 #define ARUPDATER_MANAGER_TAG   "ARUPDATER_Manager"
 
@@ -83,6 +87,20 @@ ARUPDATER_Manager_t* ARUPDATER_Manager_New(eARUPDATER_ERROR *error)
     {
         manager->downloader = NULL;
         manager->uploader = NULL;
+        manager->fanOut = NULL;
+        manager->plfStorage = ARUPDATER_MANAGER_PLF_STORAGE_FOLDERS;
+        manager->blacklist = ARUPDATER_Blacklist_New(&err);
+    }
+    
+    /* Seed the black list with the compiled in versions */
+    if (ARUPDATER_OK == err)
+    {
+        int nbBlackListedVersions = sizeof(blackListedVersions) / sizeof(ARUPDATER_Manager_PlfVersion);
+        int i = 0;
+        for (i = 0; (err == ARUPDATER_OK) && (i < nbBlackListedVersions); i++)
+        {
+            err = ARUPDATER_Blacklist_Add(manager->blacklist, blackListedVersions[i].product, blackListedVersions[i].version, blackListedVersions[i].edition, blackListedVersions[i].extension);
+        }
     }
     
     /* delete the Manager if an error occurred */
@@ -120,6 +138,13 @@ void ARUPDATER_Manager_Delete (ARUPDATER_Manager_t **managerPtrAddr)
             {
                 ARUPDATER_Uploader_Delete(manager);
             }
+            
+            if (manager->fanOut != NULL)
+            {
+                ARUPDATER_FanOut_Delete(manager);
+            }
+            
+            ARUPDATER_Blacklist_Delete(&manager->blacklist);
                         
             free(manager);
             *managerPtrAddr = NULL;
@@ -134,7 +159,6 @@ int ARUPDATER_Manager_PlfVersionIsUpToDate(ARUPDATER_Manager_t *manager, const c
     int sourceVersion, sourceEdition, sourceExtension;
     int retVal = 1;
     
-    char *device = NULL;
     char *productFolder = NULL;
     char *plfFilename = NULL;
     char *sourceFilePath = NULL;
@@ -145,40 +169,46 @@ int ARUPDATER_Manager_PlfVersionIsUpToDate(ARUPDATER_Manager_t *manager, const c
         err = ARUPDATER_ERROR_BAD_PARAMETER;
     }
     
-    if (err == ARUPDATER_OK)
+    // the version is given by the index of the pack
+    if ((err == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
     {
-        uint16_t productId = ARDISCOVERY_getProductID(product);
-        device = malloc(ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE);
-        snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
+        ARUPDATER_PlfPack_Entry_t entry;
+        char *packPath = ARUPDATER_Manager_GetPlfPackPath(rootFolder);
         
-        int productFolderLength = strlen(rootFolder) + strlen(ARUPDATER_MANAGER_PLF_FOLDER) + strlen(device) + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) + 1;
-        char *slash = strrchr(rootFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR[0]);
-        if ((slash != NULL) && (strcmp(slash, ARUPDATER_MANAGER_FOLDER_SEPARATOR) != 0))
+        err = (packPath != NULL) ? ARUPDATER_PlfPack_Find(packPath, ARDISCOVERY_getProductID(product), &entry) : ARUPDATER_ERROR_ALLOC;
+        if (err == ARUPDATER_OK)
         {
-            productFolderLength += 1;
+            sourceVersion = entry.version;
+            sourceEdition = entry.edition;
+            sourceExtension = entry.extension;
         }
-        productFolder = (char*) malloc(productFolderLength);
-        strcpy(productFolder, rootFolder);
-        
-        if ((slash != NULL) && (strcmp(slash, ARUPDATER_MANAGER_FOLDER_SEPARATOR) != 0))
+        free(packPath);
+    }
+    else if (err == ARUPDATER_OK)
+    {
+        productFolder = ARUPDATER_Manager_GetProductFolderPath(rootFolder, ARDISCOVERY_getProductID(product));
+        if (productFolder == NULL)
         {
-            strcat(productFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            plfFilename = NULL;
+            err = ARUPDATER_Utils_GetPlfInFolder(productFolder, &plfFilename);
         }
-        strcat(productFolder, ARUPDATER_MANAGER_PLF_FOLDER);
-        strcat(productFolder, device);
-        strcat(productFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
-        
-        plfFilename = NULL;
-        err = ARUPDATER_Utils_GetPlfInFolder(productFolder, &plfFilename);
     }
     
-    if (err == ARUPDATER_OK)
+    if ((err == ARUPDATER_OK) && (plfFilename != NULL))
     {
-        sourceFilePath = malloc(strlen(productFolder) + strlen(plfFilename) + 1);
-        strcpy(sourceFilePath, productFolder);
-        strcat(sourceFilePath, plfFilename);
-
-        err = ARUPDATER_Utils_GetPlfVersion(sourceFilePath, &sourceVersion, &sourceEdition, &sourceExtension);
+        sourceFilePath = ARUPDATER_Utils_BuildPath(productFolder, plfFilename, NULL);
+        if (sourceFilePath == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            err = ARUPDATER_Utils_GetPlfVersion(sourceFilePath, &sourceVersion, &sourceEdition, &sourceExtension);
+        }
     }
     
     if ((err == ARUPDATER_OK) && (localVersionBuffer != NULL))
@@ -234,10 +264,6 @@ int ARUPDATER_Manager_PlfVersionIsUpToDate(ARUPDATER_Manager_t *manager, const c
     {
         free(sourceFilePath);
     }
-    if (device)
-    {
-        free(device);
-    }
     if (plfFilename)
     {
         free(plfFilename);
@@ -271,3 +297,282 @@ int ARUPDATER_Manager_PlfVersionIsBlacklisted(eARDISCOVERY_PRODUCT product, int
     
     return isBlackListed;
 }
+
+int ARUPDATER_Manager_IsBlacklisted(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    int isBlackListed = 0;
+    
+    if (manager != NULL)
+    {
+        isBlackListed = ARUPDATER_Blacklist_Contains(manager->blacklist, product, version, edition, extension);
+    }
+    
+    return isBlackListed;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manager_AddBlacklistedVersion(ARUPDATER_Manager_t *manager, eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    
+    if (manager == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        err = ARUPDATER_Blacklist_Add(manager->blacklist, product, version, edition, extension);
+    }
+    
+    return err;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manager_LoadBlacklist(ARUPDATER_Manager_t *manager, const char *const filePath)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (filePath == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        err = ARUPDATER_Blacklist_LoadFile(manager->blacklist, filePath);
+    }
+    
+    if (err != ARUPDATER_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_MANAGER_TAG, "error: %s", ARUPDATER_Error_ToString (err));
+    }
+    
+    return err;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manager_SelectRetainedPlfVersion(ARUPDATER_Manager_t *manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, int version, int edition, int extension)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    
+    char *productFolder = NULL;
+    
+    if ((manager == NULL) ||
+        (rootFolder == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->downloader != NULL) && (manager->downloader->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->uploader != NULL) && (manager->uploader->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->fanOut != NULL) && (manager->fanOut->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
+    {
+        char *packPath = ARUPDATER_Manager_GetPlfPackPath(rootFolder);
+        
+        if (packPath == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else if (manager->downloader != NULL)
+        {
+            // the retention limits are the ones of the downloader, which retains the versions
+            err = ARUPDATER_PlfPack_Select(packPath, ARDISCOVERY_getProductID(product), version, edition, extension, manager->downloader->maxRetainedVersions, manager->downloader->maxRetainedBytes);
+        }
+        else
+        {
+            err = ARUPDATER_PlfPack_Select(packPath, ARDISCOVERY_getProductID(product), version, edition, extension, 0, 0);
+        }
+        free(packPath);
+    }
+    else if (err == ARUPDATER_OK)
+    {
+        productFolder = ARUPDATER_Manager_GetProductFolderPath(rootFolder, ARDISCOVERY_getProductID(product));
+        
+        // the retention limits are the ones of the downloader, which retains the versions
+        if (productFolder == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else if (manager->downloader != NULL)
+        {
+            err = ARUPDATER_Versions_Select(productFolder, version, edition, extension, manager->downloader->maxRetainedVersions, manager->downloader->maxRetainedBytes);
+        }
+        else
+        {
+            err = ARUPDATER_Versions_Select(productFolder, version, edition, extension, 0, 0);
+        }
+    }
+    
+    if (productFolder)
+    {
+        free(productFolder);
+    }
+    
+    return err;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manager_SetPlfStorage(ARUPDATER_Manager_t *manager, eARUPDATER_Manager_PlfStorage storage)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    
+    if ((manager == NULL) ||
+        (storage < 0) || (storage >= ARUPDATER_MANAGER_PLF_STORAGE_MAX))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->downloader != NULL) && (manager->downloader->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->uploader != NULL) && (manager->uploader->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->fanOut != NULL) && (manager->fanOut->isRunning != 0))
+    {
+        err = ARUPDATER_ERROR_THREAD_PROCESSING;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        manager->plfStorage = storage;
+    }
+    
+    return err;
+}
+
+int ARUPDATER_Manager_GetPlfVersions(ARUPDATER_Manager_t *manager, const char *const rootFolder, eARDISCOVERY_PRODUCT product, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int count = 0;
+    int currentCount = 0;
+    int retainedCount = 0;
+    int listedCount = 0;
+    
+    char *productFolder = NULL;
+    
+    if ((manager == NULL) ||
+        (rootFolder == NULL) ||
+        (maxCount < 0) ||
+        ((versions == NULL) && (maxCount > 0)))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((err == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
+    {
+        ARUPDATER_PlfPack_Entry_t entry;
+        char *packPath = ARUPDATER_Manager_GetPlfPackPath(rootFolder);
+        
+        err = (packPath != NULL) ? ARUPDATER_PlfPack_Find(packPath, ARDISCOVERY_getProductID(product), &entry) : ARUPDATER_ERROR_ALLOC;
+        if (err == ARUPDATER_OK)
+        {
+            count = 1;
+            if (maxCount > 0)
+            {
+                versions[0].version = entry.version;
+                versions[0].edition = entry.edition;
+                versions[0].extension = entry.extension;
+            }
+        }
+        else if (err == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND)
+        {
+            err = ARUPDATER_OK;
+        }
+        currentCount = count;
+        
+        if ((err == ARUPDATER_OK) && (packPath != NULL))
+        {
+            listedCount = (count < maxCount) ? count : maxCount;
+            err = ARUPDATER_PlfPack_GetRetainedVersions(packPath, ARDISCOVERY_getProductID(product), (versions != NULL) ? &versions[listedCount] : NULL, maxCount - listedCount, &retainedCount);
+            if (err == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND)
+            {
+                retainedCount = 0;
+                err = ARUPDATER_OK;
+            }
+        }
+        free(packPath);
+    }
+    else if (err == ARUPDATER_OK)
+    {
+        productFolder = ARUPDATER_Manager_GetProductFolderPath(rootFolder, ARDISCOVERY_getProductID(product));
+        if (productFolder == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            err = ARUPDATER_PlfIndex_GetVersions(productFolder, versions, maxCount, &count);
+        }
+        
+        // a product never downloaded has no plf
+        if (err == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND)
+        {
+            count = 0;
+            err = ARUPDATER_OK;
+        }
+        currentCount = count;
+        
+        // the previous versions kept by the downloader follow the plf files of the product folder
+        if (err == ARUPDATER_OK)
+        {
+            listedCount = (count < maxCount) ? count : maxCount;
+            err = ARUPDATER_Versions_GetVersions(productFolder, (versions != NULL) ? &versions[listedCount] : NULL, maxCount - listedCount, &retainedCount);
+        }
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        int i = 0;
+        count = currentCount + retainedCount;
+        for (i = 0; (i < count) && (i < maxCount); i++)
+        {
+            versions[i].isRetained = (i >= currentCount) ? 1 : 0;
+        }
+    }
+    
+    if (productFolder)
+    {
+        free(productFolder);
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return count;
+}
+
+char *ARUPDATER_Manager_GetPlfPackPath(const char *const rootFolder)
+{
+    size_t length = strlen(rootFolder);
+    const char *separator = ((length > 0) && (rootFolder[length - 1] == ARUPDATER_MANAGER_FOLDER_SEPARATOR[0])) ? "" : ARUPDATER_MANAGER_FOLDER_SEPARATOR;
+
+    return ARUPDATER_Utils_BuildPath(rootFolder, separator, ARUPDATER_MANAGER_PLF_FOLDER, ARUPDATER_PLF_PACK_FILE_NAME, NULL);
+}
+
+char *ARUPDATER_Manager_GetProductFolderPath(const char *const rootFolder, uint16_t productId)
+{
+    char device[ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE];
+    size_t length = strlen(rootFolder);
+    const char *separator = ((length > 0) && (rootFolder[length - 1] == ARUPDATER_MANAGER_FOLDER_SEPARATOR[0])) ? "" : ARUPDATER_MANAGER_FOLDER_SEPARATOR;
+
+    snprintf(device, sizeof(device), "%04x", productId);
+
+    return ARUPDATER_Utils_BuildPath(rootFolder, separator, ARUPDATER_MANAGER_PLF_FOLDER, device, ARUPDATER_MANAGER_FOLDER_SEPARATOR, NULL);
+}
@@ -40,6 +40,8 @@
 
 #include "ARUPDATER_Downloader.h"
 #include "ARUPDATER_Uploader.h"
+#include "ARUPDATER_FanOut.h"
+#include "ARUPDATER_Blacklist.h"
 
 #define ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE        10
 #define ARUPDATER_MANAGER_FOLDER_SEPARATOR              "/"
@@ -56,8 +58,29 @@ struct ARUPDATER_Manager_t
 {
     ARUPDATER_Downloader_t *downloader;
     ARUPDATER_Uploader_t *uploader;
+    ARUPDATER_FanOut_t *fanOut;
     
+    ARUPDATER_Blacklist_t *blacklist;
+
+    eARUPDATER_Manager_PlfStorage plfStorage;
 };
 
+/**
+ * @brief Get the path of the plf pack of a root folder
+ * @warning This function allocates memory
+ * @param[in] rootFolder : the root folder, with or without a separator at its end
+ * @return the newly-allocated path, NULL if it can not be allocated
+ */
+char *ARUPDATER_Manager_GetPlfPackPath(const char *const rootFolder);
+
+/**
+ * @brief Get the path of the folder of a product, with a separator at its end
+ * @warning This function allocates memory
+ * @param[in] rootFolder : the root folder, with or without a separator at its end
+ * @param[in] productId : the id of the product
+ * @return the newly-allocated path, NULL if it can not be allocated
+ */
+char *ARUPDATER_Manager_GetProductFolderPath(const char *const rootFolder, uint16_t productId);
+
 #endif /* _ARUPDATER_MANAGER_PRIVATE_H_ */
 
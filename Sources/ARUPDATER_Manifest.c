@@ -0,0 +1,439 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Manifest.c
+ * @brief libARUpdater chunk manifest c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_Manifest.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_MANIFEST_TAG                  "ARUPDATER_Manifest"
+
+#define ARUPDATER_MANIFEST_MAX_CHUNK_SIZE       (64 * 1024 * 1024)
+#define ARUPDATER_MANIFEST_LINE_SIZE            128
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static int ARUPDATER_Manifest_HexValue(char c)
+{
+    int value = -1;
+
+    if ((c >= '0') && (c <= '9'))
+    {
+        value = c - '0';
+    }
+    else if ((c >= 'a') && (c <= 'f'))
+    {
+        value = c - 'a' + 10;
+    }
+    else if ((c >= 'A') && (c <= 'F'))
+    {
+        value = c - 'A' + 10;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Parse a line holding an hexadecimal sha256
+ * @return 1 if the line is valid, 0 otherwise
+ */
+static int ARUPDATER_Manifest_ParseDigest(const char *line, uint8_t *digest)
+{
+    int i = 0;
+
+    for (i = 0; i < ARUPDATER_SHA256_DIGEST_SIZE; i++)
+    {
+        int high = ARUPDATER_Manifest_HexValue(line[i * 2]);
+        int low = (high >= 0) ? ARUPDATER_Manifest_HexValue(line[i * 2 + 1]) : -1;
+        if (low < 0)
+        {
+            return 0;
+        }
+        digest[i] = (uint8_t)((high << 4) | low);
+    }
+
+    line += ARUPDATER_SHA256_DIGEST_SIZE * 2;
+    return (*line == '\0') || (*line == '\n') || (*line == '\r');
+}
+
+static void ARUPDATER_Manifest_Verifier_EndChunk(ARUPDATER_Manifest_Verifier_t *verifier)
+{
+    uint8_t digest[ARUPDATER_SHA256_DIGEST_SIZE];
+
+    ARUPDATER_Sha256_Final(&verifier->context, digest);
+    if (memcmp(digest, verifier->manifest->digests + verifier->chunkIndex * ARUPDATER_SHA256_DIGEST_SIZE, ARUPDATER_SHA256_DIGEST_SIZE) != 0)
+    {
+        verifier->isBad[verifier->chunkIndex] = 1;
+    }
+
+    verifier->chunkIndex++;
+    verifier->chunkReceived = 0;
+    ARUPDATER_Sha256_Init(&verifier->context);
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Manifest_t *ARUPDATER_Manifest_New(const char *const manifestPath, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Manifest_t *manifest = NULL;
+    char line[ARUPDATER_MANIFEST_LINE_SIZE];
+    long long fileSize = 0;
+    long long chunkSize = 0;
+    int64_t chunkIndex = 0;
+    FILE *manifestFile = NULL;
+
+    if (manifestPath == NULL)
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        manifestFile = fopen(manifestPath, "r");
+        if (manifestFile == NULL)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        if ((fgets(line, sizeof(line), manifestFile) == NULL) ||
+            (sscanf(line, "%lld %lld", &fileSize, &chunkSize) != 2) ||
+            (fileSize < 0) || (chunkSize <= 0) || (chunkSize > ARUPDATER_MANIFEST_MAX_CHUNK_SIZE))
+        {
+            err = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        manifest = calloc(1, sizeof(ARUPDATER_Manifest_t));
+        if (manifest == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        manifest->fileSize = fileSize;
+        manifest->chunkSize = chunkSize;
+        manifest->chunkCount = (fileSize + chunkSize - 1) / chunkSize;
+        if ((uint64_t)manifest->chunkCount > SIZE_MAX / ARUPDATER_SHA256_DIGEST_SIZE)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if ((err == ARUPDATER_OK) && (manifest->chunkCount > 0))
+    {
+        manifest->digests = malloc((size_t)manifest->chunkCount * ARUPDATER_SHA256_DIGEST_SIZE);
+        if (manifest->digests == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    for (chunkIndex = 0; (err == ARUPDATER_OK) && (chunkIndex < manifest->chunkCount); chunkIndex++)
+    {
+        if ((fgets(line, sizeof(line), manifestFile) == NULL) ||
+            !ARUPDATER_Manifest_ParseDigest(line, manifest->digests + chunkIndex * ARUPDATER_SHA256_DIGEST_SIZE))
+        {
+            err = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+    }
+
+    if (manifestFile != NULL)
+    {
+        fclose(manifestFile);
+    }
+
+    if (err != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_MANIFEST_TAG, "cannot load the manifest: %s", ARUPDATER_Error_ToString(err));
+        ARUPDATER_Manifest_Delete(&manifest);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return manifest;
+}
+
+void ARUPDATER_Manifest_Delete(ARUPDATER_Manifest_t **manifest)
+{
+    if ((manifest != NULL) && (*manifest != NULL))
+    {
+        free((*manifest)->digests);
+        free(*manifest);
+        *manifest = NULL;
+    }
+}
+
+void ARUPDATER_Manifest_GetRoot(const ARUPDATER_Manifest_t *manifest, uint8_t *digest)
+{
+    ARUPDATER_Sha256_Context_t context;
+
+    ARUPDATER_Sha256_Init(&context);
+    if (manifest->digests != NULL)
+    {
+        ARUPDATER_Sha256_Update(&context, manifest->digests, (size_t)manifest->chunkCount * ARUPDATER_SHA256_DIGEST_SIZE);
+    }
+    ARUPDATER_Sha256_Final(&context, digest);
+}
+
+void ARUPDATER_Manifest_GetChunk(const ARUPDATER_Manifest_t *manifest, int64_t chunkIndex, int64_t *offset, size_t *size)
+{
+    int64_t chunkOffset = chunkIndex * manifest->chunkSize;
+    int64_t remaining = manifest->fileSize - chunkOffset;
+
+    *offset = chunkOffset;
+    *size = (size_t)((remaining < manifest->chunkSize) ? remaining : manifest->chunkSize);
+}
+
+int ARUPDATER_Manifest_CheckFileChunk(const ARUPDATER_Manifest_t *manifest, ARUPDATER_FileIO_t *file, int64_t chunkIndex, uint8_t *buffer)
+{
+    ARUPDATER_Sha256_Context_t context;
+    uint8_t digest[ARUPDATER_SHA256_DIGEST_SIZE];
+    int64_t offset = 0;
+    size_t size = 0;
+    size_t readSize = 0;
+
+    ARUPDATER_Manifest_GetChunk(manifest, chunkIndex, &offset, &size);
+
+    if ((ARUPDATER_FileIO_Read(file, buffer, size, offset, &readSize) != ARUPDATER_OK) || (readSize != size))
+    {
+        return 0;
+    }
+
+    ARUPDATER_Sha256_Init(&context);
+    ARUPDATER_Sha256_Update(&context, buffer, size);
+    ARUPDATER_Sha256_Final(&context, digest);
+
+    return memcmp(digest, manifest->digests + chunkIndex * ARUPDATER_SHA256_DIGEST_SIZE, ARUPDATER_SHA256_DIGEST_SIZE) == 0;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manifest_Repair(const ARUPDATER_Manifest_t *manifest, ARUPDATER_Http_Connection_t *connection, const char *const url, const char *const filePath, const uint8_t *isBad)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t *buffer = NULL;
+    uint8_t *toRepair = NULL;
+    int64_t chunkIndex = 0;
+    int64_t badCount = 0;
+    int64_t repairedCount = 0;
+    int round = 0;
+    ARUPDATER_FileIO_t *file = NULL;
+
+    if ((manifest == NULL) || (connection == NULL) || (url == NULL) || (filePath == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        buffer = malloc((size_t)manifest->chunkSize);
+        toRepair = calloc((size_t)manifest->chunkCount + 1, 1);
+        if ((buffer == NULL) || (toRepair == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        file = ARUPDATER_FileIO_New(filePath, ARUPDATER_FILEIO_MODE_UPDATE, ARUPDATER_FILEIO_BACKEND_DEFAULT, &error);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_FileIO_Truncate(file, manifest->fileSize);
+    }
+
+    for (chunkIndex = 0; (error == ARUPDATER_OK) && (chunkIndex < manifest->chunkCount); chunkIndex++)
+    {
+        if (isBad != NULL)
+        {
+            toRepair[chunkIndex] = (isBad[chunkIndex] != 0);
+        }
+        else
+        {
+            toRepair[chunkIndex] = !ARUPDATER_Manifest_CheckFileChunk(manifest, file, chunkIndex, buffer);
+        }
+        badCount += toRepair[chunkIndex];
+    }
+
+    for (round = 0; (error == ARUPDATER_OK) && (badCount > 0) && (round < ARUPDATER_MANIFEST_REPAIR_MAX_ROUNDS); round++)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_MANIFEST_TAG, "%s: fetching %lld corrupted chunks again", filePath, (long long)badCount);
+
+        for (chunkIndex = 0; (error == ARUPDATER_OK) && (chunkIndex < manifest->chunkCount); chunkIndex++)
+        {
+            if (toRepair[chunkIndex])
+            {
+                int64_t offset = 0;
+                size_t size = 0;
+
+                ARUPDATER_Manifest_GetChunk(manifest, chunkIndex, &offset, &size);
+                error = ARUPDATER_Http_GetRangeToFile(connection, url, file, offset, (int64_t)size);
+                if ((error == ARUPDATER_OK) && ARUPDATER_Manifest_CheckFileChunk(manifest, file, chunkIndex, buffer))
+                {
+                    toRepair[chunkIndex] = 0;
+                    badCount--;
+                    repairedCount++;
+                }
+            }
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (badCount > 0))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_MANIFEST_TAG, "%s: %lld chunks can not be repaired", filePath, (long long)badCount);
+        error = ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH;
+    }
+    else if (error == ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_INFO, ARUPDATER_MANIFEST_TAG, "%s: %lld chunks repaired", filePath, (long long)repairedCount);
+    }
+
+    ARUPDATER_FileIO_Delete(&file);
+    free(buffer);
+    free(toRepair);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Manifest_Verifier_Init(ARUPDATER_Manifest_Verifier_t *verifier, const ARUPDATER_Manifest_t *manifest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((verifier == NULL) || (manifest == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        verifier->manifest = manifest;
+        verifier->chunkIndex = 0;
+        verifier->chunkReceived = 0;
+        verifier->isBad = calloc((size_t)manifest->chunkCount + 1, 1);
+        if (verifier->isBad == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        ARUPDATER_Sha256_Init(&verifier->context);
+    }
+
+    return error;
+}
+
+void ARUPDATER_Manifest_Verifier_DataCallback(void *arg, const uint8_t *data, size_t size)
+{
+    ARUPDATER_Manifest_Verifier_t *verifier = (ARUPDATER_Manifest_Verifier_t *)arg;
+
+    while ((size > 0) && (verifier->chunkIndex < verifier->manifest->chunkCount))
+    {
+        int64_t offset = 0;
+        size_t chunkSize = 0;
+        size_t length = 0;
+
+        ARUPDATER_Manifest_GetChunk(verifier->manifest, verifier->chunkIndex, &offset, &chunkSize);
+        length = chunkSize - (size_t)verifier->chunkReceived;
+        if (length > size)
+        {
+            length = size;
+        }
+
+        ARUPDATER_Sha256_Update(&verifier->context, data, length);
+        verifier->chunkReceived += length;
+        data += length;
+        size -= length;
+
+        if (verifier->chunkReceived == (int64_t)chunkSize)
+        {
+            ARUPDATER_Manifest_Verifier_EndChunk(verifier);
+        }
+    }
+    // the data past the size given by the manifest is dropped by the final hash check
+}
+
+int64_t ARUPDATER_Manifest_Verifier_Finish(ARUPDATER_Manifest_Verifier_t *verifier)
+{
+    int64_t badCount = 0;
+    int64_t chunkIndex = 0;
+
+    for (chunkIndex = verifier->chunkIndex; chunkIndex < verifier->manifest->chunkCount; chunkIndex++)
+    {
+        verifier->isBad[chunkIndex] = 1;
+    }
+    verifier->chunkIndex = verifier->manifest->chunkCount;
+
+    for (chunkIndex = 0; chunkIndex < verifier->manifest->chunkCount; chunkIndex++)
+    {
+        badCount += verifier->isBad[chunkIndex];
+    }
+
+    return badCount;
+}
+
+void ARUPDATER_Manifest_Verifier_Clear(ARUPDATER_Manifest_Verifier_t *verifier)
+{
+    if (verifier != NULL)
+    {
+        free(verifier->isBad);
+        verifier->isBad = NULL;
+        verifier->manifest = NULL;
+    }
+}
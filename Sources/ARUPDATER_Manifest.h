@@ -0,0 +1,171 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Manifest.h
+ * @brief libARUpdater chunk manifest header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_MANIFEST_PRIVATE_H_
+#define _ARUPDATER_MANIFEST_PRIVATE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+
+#include "ARUPDATER_Sha256.h"
+#include "ARUPDATER_Http.h"
+
+/**
+ * @brief Maximum number of times a chunk is fetched again
+ */
+#define ARUPDATER_MANIFEST_REPAIR_MAX_ROUNDS    3
+
+/**
+ * @brief Chunk manifest of a plf file
+ * @details The manifest is a text file published by the update server:
+ * @code
+ * <file size> <chunk size>
+ * <hexadecimal sha256 of chunk 0>
+ * <hexadecimal sha256 of chunk 1>
+ * ...
+ * @endcode
+ * The last chunk may be shorter. With chunks of ARUPDATER_HASH_TREE_CHUNK_SIZE bytes, the digests are the leaves of the sha256tree hash of the file.
+ */
+typedef struct
+{
+    int64_t fileSize;
+    int64_t chunkSize;
+    int64_t chunkCount;
+    uint8_t *digests; /**< ARUPDATER_SHA256_DIGEST_SIZE bytes per chunk */
+} ARUPDATER_Manifest_t;
+
+/**
+ * @brief Verifies the chunks of a file as its data is received in order
+ * @see ARUPDATER_Manifest_Verifier_DataCallback ()
+ */
+typedef struct
+{
+    const ARUPDATER_Manifest_t *manifest;
+    ARUPDATER_Sha256_Context_t context;
+    int64_t chunkIndex; /**< chunk being received */
+    int64_t chunkReceived; /**< bytes of the chunk being received */
+    uint8_t *isBad; /**< one flag per chunk */
+} ARUPDATER_Manifest_Verifier_t;
+
+/**
+ * @brief Load a manifest file
+ * @warning This function allocates memory
+ * @param[in] manifestPath : path of the manifest file
+ * @param[out] error : ARUPDATER_OK if operation went well, ARUPDATER_ERROR_BAD_PARAMETER if the manifest is malformed, the description of the error otherwise. Can be null
+ * @return the manifest, NULL if an error occurred
+ * @see ARUPDATER_Manifest_Delete ()
+ */
+ARUPDATER_Manifest_t *ARUPDATER_Manifest_New(const char *const manifestPath, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Delete a manifest
+ * @warning This function frees memory
+ * @param manifest : address of the pointer on the manifest
+ */
+void ARUPDATER_Manifest_Delete(ARUPDATER_Manifest_t **manifest);
+
+/**
+ * @brief Get the root of the manifest, the sha256 of the concatenated chunk digests
+ * @param[in] manifest : the manifest
+ * @param[out] digest : buffer of ARUPDATER_SHA256_DIGEST_SIZE bytes
+ */
+void ARUPDATER_Manifest_GetRoot(const ARUPDATER_Manifest_t *manifest, uint8_t *digest);
+
+/**
+ * @brief Get the position of a chunk in the file
+ * @param[in] manifest : the manifest
+ * @param[in] chunkIndex : the index of the chunk
+ * @param[out] offset : offset of the chunk in the file
+ * @param[out] size : size of the chunk
+ */
+void ARUPDATER_Manifest_GetChunk(const ARUPDATER_Manifest_t *manifest, int64_t chunkIndex, int64_t *offset, size_t *size);
+
+/**
+ * @brief Check a chunk of a file against the manifest
+ * @param[in] manifest : the manifest
+ * @param file : the file, opened for reading
+ * @param[in] chunkIndex : the index of the chunk
+ * @param buffer : buffer of manifest->chunkSize bytes used to read the chunk
+ * @return 1 if the chunk is valid, 0 if it is corrupted or can not be read
+ */
+int ARUPDATER_Manifest_CheckFileChunk(const ARUPDATER_Manifest_t *manifest, ARUPDATER_FileIO_t *file, int64_t chunkIndex, uint8_t *buffer);
+
+/**
+ * @brief Fetch again the corrupted chunks of a file with http range requests
+ * @details The file is resized to the size given by the manifest. Each repaired chunk is checked again, up to ARUPDATER_MANIFEST_REPAIR_MAX_ROUNDS times
+ * @param[in] manifest : the manifest
+ * @param connection : the connection used to fetch the chunks
+ * @param[in] url : url of the file
+ * @param[in] filePath : path of the file
+ * @param[in] isBad : one flag per chunk to repair, NULL to check all the chunks of the file first
+ * @return ARUPDATER_OK if all the chunks match the manifest, ARUPDATER_ERROR_DOWNLOADER_MD5_DONT_MATCH if some could not be repaired, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Manifest_Repair(const ARUPDATER_Manifest_t *manifest, ARUPDATER_Http_Connection_t *connection, const char *const url, const char *const filePath, const uint8_t *isBad);
+
+/**
+ * @brief Initialize a verifier
+ * @warning This function allocates memory
+ * @param verifier : the verifier
+ * @param[in] manifest : the manifest, it must outlive the verifier
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ * @see ARUPDATER_Manifest_Verifier_Clear ()
+ */
+eARUPDATER_ERROR ARUPDATER_Manifest_Verifier_Init(ARUPDATER_Manifest_Verifier_t *verifier, const ARUPDATER_Manifest_t *manifest);
+
+/**
+ * @brief Give the next received data to a verifier
+ * @param arg : the verifier
+ * @param[in] data : the data, following the previous one in the file
+ * @param[in] size : the size of the data
+ */
+void ARUPDATER_Manifest_Verifier_DataCallback(void *arg, const uint8_t *data, size_t size);
+
+/**
+ * @brief End the verification
+ * @details The chunks which have not been completely received are marked as bad
+ * @param verifier : the verifier
+ * @return the number of bad chunks
+ */
+int64_t ARUPDATER_Manifest_Verifier_Finish(ARUPDATER_Manifest_Verifier_t *verifier);
+
+/**
+ * @brief Free the memory of a verifier
+ * @param verifier : the verifier
+ */
+void ARUPDATER_Manifest_Verifier_Clear(ARUPDATER_Manifest_Verifier_t *verifier);
+
+#endif
@@ -0,0 +1,234 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Md5.c
+ * @brief libARUpdater MD5 c file.
+ * @date 19/10/2026
+ **/
+
+#include <string.h>
+
+#include "ARUPDATER_Md5.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_MD5_F(x, y, z)        ((z) ^ ((x) & ((y) ^ (z))))
+#define ARUPDATER_MD5_G(x, y, z)        ((y) ^ ((z) & ((x) ^ (y))))
+#define ARUPDATER_MD5_H(x, y, z)        ((x) ^ (y) ^ (z))
+#define ARUPDATER_MD5_I(x, y, z)        ((y) ^ ((x) | ~(z)))
+
+#define ARUPDATER_MD5_STEP(f, a, b, c, d, x, t, s) \
+    (a) += f((b), (c), (d)) + (x) + (t); \
+    (a) = (((a) << (s)) | ((a) >> (32 - (s)))); \
+    (a) += (b);
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static inline uint32_t ARUPDATER_Md5_Load32(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static void ARUPDATER_Md5_Blocks(uint32_t state[4], const uint8_t *data, size_t blockCount)
+{
+    uint32_t a, b, c, d;
+    uint32_t x[16];
+    int i = 0;
+
+    while (blockCount > 0)
+    {
+        for (i = 0; i < 16; i++)
+        {
+            x[i] = ARUPDATER_Md5_Load32(data + i * 4);
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, a, b, c, d, x[0], 0xd76aa478, 7)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, d, a, b, c, x[1], 0xe8c7b756, 12)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, c, d, a, b, x[2], 0x242070db, 17)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, b, c, d, a, x[3], 0xc1bdceee, 22)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, a, b, c, d, x[4], 0xf57c0faf, 7)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, d, a, b, c, x[5], 0x4787c62a, 12)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, c, d, a, b, x[6], 0xa8304613, 17)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, b, c, d, a, x[7], 0xfd469501, 22)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, a, b, c, d, x[8], 0x698098d8, 7)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, d, a, b, c, x[9], 0x8b44f7af, 12)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, c, d, a, b, x[10], 0xffff5bb1, 17)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, b, c, d, a, x[11], 0x895cd7be, 22)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, a, b, c, d, x[12], 0x6b901122, 7)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, d, a, b, c, x[13], 0xfd987193, 12)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, c, d, a, b, x[14], 0xa679438e, 17)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_F, b, c, d, a, x[15], 0x49b40821, 22)
+
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, a, b, c, d, x[1], 0xf61e2562, 5)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, d, a, b, c, x[6], 0xc040b340, 9)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, c, d, a, b, x[11], 0x265e5a51, 14)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, b, c, d, a, x[0], 0xe9b6c7aa, 20)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, a, b, c, d, x[5], 0xd62f105d, 5)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, d, a, b, c, x[10], 0x02441453, 9)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, c, d, a, b, x[15], 0xd8a1e681, 14)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, b, c, d, a, x[4], 0xe7d3fbc8, 20)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, a, b, c, d, x[9], 0x21e1cde6, 5)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, d, a, b, c, x[14], 0xc33707d6, 9)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, c, d, a, b, x[3], 0xf4d50d87, 14)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, b, c, d, a, x[8], 0x455a14ed, 20)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, a, b, c, d, x[13], 0xa9e3e905, 5)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, d, a, b, c, x[2], 0xfcefa3f8, 9)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, c, d, a, b, x[7], 0x676f02d9, 14)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_G, b, c, d, a, x[12], 0x8d2a4c8a, 20)
+
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, a, b, c, d, x[5], 0xfffa3942, 4)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, d, a, b, c, x[8], 0x8771f681, 11)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, c, d, a, b, x[11], 0x6d9d6122, 16)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, b, c, d, a, x[14], 0xfde5380c, 23)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, a, b, c, d, x[1], 0xa4beea44, 4)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, d, a, b, c, x[4], 0x4bdecfa9, 11)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, c, d, a, b, x[7], 0xf6bb4b60, 16)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, b, c, d, a, x[10], 0xbebfbc70, 23)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, a, b, c, d, x[13], 0x289b7ec6, 4)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, d, a, b, c, x[0], 0xeaa127fa, 11)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, c, d, a, b, x[3], 0xd4ef3085, 16)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, b, c, d, a, x[6], 0x04881d05, 23)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, a, b, c, d, x[9], 0xd9d4d039, 4)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, d, a, b, c, x[12], 0xe6db99e5, 11)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, c, d, a, b, x[15], 0x1fa27cf8, 16)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_H, b, c, d, a, x[2], 0xc4ac5665, 23)
+
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, a, b, c, d, x[0], 0xf4292244, 6)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, d, a, b, c, x[7], 0x432aff97, 10)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, c, d, a, b, x[14], 0xab9423a7, 15)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, b, c, d, a, x[5], 0xfc93a039, 21)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, a, b, c, d, x[12], 0x655b59c3, 6)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, d, a, b, c, x[3], 0x8f0ccc92, 10)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, c, d, a, b, x[10], 0xffeff47d, 15)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, b, c, d, a, x[1], 0x85845dd1, 21)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, a, b, c, d, x[8], 0x6fa87e4f, 6)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, d, a, b, c, x[15], 0xfe2ce6e0, 10)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, c, d, a, b, x[6], 0xa3014314, 15)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, b, c, d, a, x[13], 0x4e0811a1, 21)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, a, b, c, d, x[4], 0xf7537e82, 6)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, d, a, b, c, x[11], 0xbd3af235, 10)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, c, d, a, b, x[2], 0x2ad7d2bb, 15)
+        ARUPDATER_MD5_STEP(ARUPDATER_MD5_I, b, c, d, a, x[9], 0xeb86d391, 21)
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+
+        data += ARUPDATER_MD5_BLOCK_SIZE;
+        blockCount--;
+    }
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+void ARUPDATER_Md5_Init(ARUPDATER_Md5_Context_t *context)
+{
+    context->state[0] = 0x67452301;
+    context->state[1] = 0xefcdab89;
+    context->state[2] = 0x98badcfe;
+    context->state[3] = 0x10325476;
+    context->length = 0;
+}
+
+void ARUPDATER_Md5_Update(ARUPDATER_Md5_Context_t *context, const uint8_t *data, size_t size)
+{
+    size_t used = (size_t)(context->length % ARUPDATER_MD5_BLOCK_SIZE);
+
+    context->length += size;
+
+    if (used > 0)
+    {
+        size_t free = ARUPDATER_MD5_BLOCK_SIZE - used;
+        if (size < free)
+        {
+            memcpy(context->buffer + used, data, size);
+            return;
+        }
+
+        memcpy(context->buffer + used, data, free);
+        ARUPDATER_Md5_Blocks(context->state, context->buffer, 1);
+        data += free;
+        size -= free;
+    }
+
+    if (size >= ARUPDATER_MD5_BLOCK_SIZE)
+    {
+        ARUPDATER_Md5_Blocks(context->state, data, size / ARUPDATER_MD5_BLOCK_SIZE);
+        data += size & ~(size_t)(ARUPDATER_MD5_BLOCK_SIZE - 1);
+        size &= ARUPDATER_MD5_BLOCK_SIZE - 1;
+    }
+
+    memcpy(context->buffer, data, size);
+}
+
+void ARUPDATER_Md5_Final(ARUPDATER_Md5_Context_t *context, uint8_t *digest)
+{
+    uint64_t bitLength = context->length * 8;
+    size_t used = (size_t)(context->length % ARUPDATER_MD5_BLOCK_SIZE);
+    int i = 0;
+
+    context->buffer[used++] = 0x80;
+    if (used > ARUPDATER_MD5_BLOCK_SIZE - 8)
+    {
+        memset(context->buffer + used, 0, ARUPDATER_MD5_BLOCK_SIZE - used);
+        ARUPDATER_Md5_Blocks(context->state, context->buffer, 1);
+        used = 0;
+    }
+    memset(context->buffer + used, 0, ARUPDATER_MD5_BLOCK_SIZE - 8 - used);
+
+    for (i = 0; i < 8; i++)
+    {
+        context->buffer[ARUPDATER_MD5_BLOCK_SIZE - 8 + i] = (uint8_t)(bitLength >> (8 * i));
+    }
+    ARUPDATER_Md5_Blocks(context->state, context->buffer, 1);
+
+    for (i = 0; i < 16; i++)
+    {
+        digest[i] = (uint8_t)(context->state[i / 4] >> (8 * (i % 4)));
+    }
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Md5.h
+ * @brief libARUpdater MD5 header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_MD5_PRIVATE_H_
+#define _ARUPDATER_MD5_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARUPDATER_MD5_DIGEST_SIZE       16
+#define ARUPDATER_MD5_BLOCK_SIZE        64
+
+/**
+ * @brief MD5 context (RFC 1321)
+ */
+typedef struct
+{
+    uint32_t state[4];
+    uint64_t length;
+    uint8_t buffer[ARUPDATER_MD5_BLOCK_SIZE];
+} ARUPDATER_Md5_Context_t;
+
+/**
+ * @brief Initialize an MD5 context
+ * @param context : the context
+ */
+void ARUPDATER_Md5_Init(ARUPDATER_Md5_Context_t *context);
+
+/**
+ * @brief Add data to an MD5 context
+ * @param context : the context
+ * @param[in] data : the data to hash
+ * @param[in] size : the size of the data
+ */
+void ARUPDATER_Md5_Update(ARUPDATER_Md5_Context_t *context, const uint8_t *data, size_t size);
+
+/**
+ * @brief Get the digest of an MD5 context
+ * @param context : the context, it must be initialized again before being reused
+ * @param[out] digest : buffer of ARUPDATER_MD5_DIGEST_SIZE bytes
+ */
+void ARUPDATER_Md5_Final(ARUPDATER_Md5_Context_t *context, uint8_t *digest);
+
+#endif
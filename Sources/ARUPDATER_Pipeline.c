@@ -0,0 +1,403 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Pipeline.c
+ * @brief libARUpdater pipeline c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdlib.h>
+#include <string.h>
+#include <libARSAL/ARSAL_Print.h>
+#include <libARSAL/ARSAL_Sem.h>
+#include <libARSAL/ARSAL_Thread.h>
+
+#include "ARUPDATER_Pipeline.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_PIPELINE_TAG                  "ARUPDATER_Pipeline"
+
+#define ARUPDATER_PIPELINE_ALIGNMENT            4096
+#define ARUPDATER_PIPELINE_MIN_BUFFERS          2
+
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+    int64_t offset;
+} ARUPDATER_Pipeline_Buffer_t;
+
+struct ARUPDATER_Pipeline_t
+{
+    ARUPDATER_FileIO_t *file;
+    ARUPDATER_Pipeline_DataCallback_t dataCallback;
+    void *dataArg;
+
+    ARUPDATER_Pipeline_Buffer_t *buffers;
+    int bufferCount;
+    size_t bufferSize;
+
+    unsigned head; /**< next buffer to write, only written by the writing thread */
+    unsigned tail; /**< next buffer to fill, only written by the receiving thread */
+    int hasBuffer; /**< the receiving thread is filling the buffer at tail */
+    ARSAL_Sem_t filledSem;
+    ARSAL_Sem_t freeSem;
+    int hasSems;
+    int isFinished;
+
+    ARSAL_Thread_t writerThread;
+    eARUPDATER_ERROR writerError;
+
+    int maxOccupancy;
+    int64_t occupancySum;
+    int64_t occupancyCount;
+    int64_t networkWaitCount;
+    int64_t writerWaitCount;
+};
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static void ARUPDATER_Pipeline_SemWait(ARSAL_Sem_t *sem, int64_t *waitCount)
+{
+    if (ARSAL_Sem_Trywait(sem) != 0)
+    {
+        __atomic_add_fetch(waitCount, 1, __ATOMIC_RELAXED);
+        while (ARSAL_Sem_Wait(sem) != 0)
+        {
+            // interrupted by a signal
+        }
+    }
+}
+
+static void *ARUPDATER_Pipeline_WriterRun(void *arg)
+{
+    ARUPDATER_Pipeline_t *pipeline = (ARUPDATER_Pipeline_t *)arg;
+    int isDone = 0;
+
+    while (isDone == 0)
+    {
+        ARUPDATER_Pipeline_SemWait(&pipeline->filledSem, &pipeline->writerWaitCount);
+
+        // woken up with an empty ring once the last buffer has been written
+        if (pipeline->head == __atomic_load_n(&pipeline->tail, __ATOMIC_ACQUIRE))
+        {
+            isDone = __atomic_load_n(&pipeline->isFinished, __ATOMIC_ACQUIRE);
+        }
+        else
+        {
+            ARUPDATER_Pipeline_Buffer_t *buffer = &pipeline->buffers[pipeline->head % pipeline->bufferCount];
+
+            // after an error, the buffers are only released so that the receiving thread never waits forever
+            if (__atomic_load_n(&pipeline->writerError, __ATOMIC_RELAXED) == ARUPDATER_OK)
+            {
+                eARUPDATER_ERROR error = ARUPDATER_OK;
+
+                if (pipeline->dataCallback != NULL)
+                {
+                    pipeline->dataCallback(pipeline->dataArg, buffer->data, buffer->size);
+                }
+                error = ARUPDATER_FileIO_Write(pipeline->file, buffer->data, buffer->size, buffer->offset);
+                __atomic_store_n(&pipeline->writerError, error, __ATOMIC_RELAXED);
+            }
+
+            __atomic_store_n(&pipeline->head, pipeline->head + 1, __ATOMIC_RELEASE);
+            ARSAL_Sem_Post(&pipeline->freeSem);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Hand the buffer being filled to the writing thread
+ */
+static void ARUPDATER_Pipeline_Publish(ARUPDATER_Pipeline_t *pipeline)
+{
+    unsigned tail = pipeline->tail + 1;
+    int occupancy = (int)(tail - __atomic_load_n(&pipeline->head, __ATOMIC_ACQUIRE));
+
+    __atomic_store_n(&pipeline->tail, tail, __ATOMIC_RELEASE);
+    pipeline->hasBuffer = 0;
+    ARSAL_Sem_Post(&pipeline->filledSem);
+
+    if (occupancy > __atomic_load_n(&pipeline->maxOccupancy, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&pipeline->maxOccupancy, occupancy, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&pipeline->occupancySum, occupancy, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&pipeline->occupancyCount, 1, __ATOMIC_RELAXED);
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+ARUPDATER_Pipeline_t *ARUPDATER_Pipeline_New(ARUPDATER_FileIO_t *file, int64_t maxMemory, ARUPDATER_Pipeline_DataCallback_t dataCallback, void *dataArg, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Pipeline_t *pipeline = NULL;
+    int i = 0;
+
+    // the memory is a cap, the buffers are not made larger than it allows
+    if ((file == NULL) || (maxMemory < ARUPDATER_PIPELINE_MIN_MEMORY))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        pipeline = calloc(1, sizeof(ARUPDATER_Pipeline_t));
+        if (pipeline == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        pipeline->file = file;
+        pipeline->dataCallback = dataCallback;
+        pipeline->dataArg = dataArg;
+
+        // smaller buffers when the memory does not hold two full ones
+        pipeline->bufferSize = ARUPDATER_PIPELINE_BUFFER_SIZE;
+        if (maxMemory < (int64_t)ARUPDATER_PIPELINE_MIN_BUFFERS * ARUPDATER_PIPELINE_BUFFER_SIZE)
+        {
+            pipeline->bufferSize = (size_t)(maxMemory / ARUPDATER_PIPELINE_MIN_BUFFERS) & ~(size_t)(ARUPDATER_PIPELINE_ALIGNMENT - 1);
+        }
+        pipeline->bufferCount = (int)(maxMemory / (int64_t)pipeline->bufferSize);
+
+        pipeline->buffers = calloc((size_t)pipeline->bufferCount, sizeof(ARUPDATER_Pipeline_Buffer_t));
+        if (pipeline->buffers == NULL)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    for (i = 0; (err == ARUPDATER_OK) && (i < pipeline->bufferCount); i++)
+    {
+        void *data = NULL;
+        if (posix_memalign(&data, ARUPDATER_PIPELINE_ALIGNMENT, pipeline->bufferSize) != 0)
+        {
+            err = ARUPDATER_ERROR_ALLOC;
+        }
+        pipeline->buffers[i].data = (uint8_t *)data;
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Sem_Init(&pipeline->filledSem, 0, 0) != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+        else if (ARSAL_Sem_Init(&pipeline->freeSem, 0, pipeline->bufferCount) != 0)
+        {
+            ARSAL_Sem_Destroy(&pipeline->filledSem);
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            pipeline->hasSems = 1;
+        }
+    }
+
+    if (err == ARUPDATER_OK)
+    {
+        if (ARSAL_Thread_Create(&pipeline->writerThread, ARUPDATER_Pipeline_WriterRun, pipeline) != 0)
+        {
+            pipeline->writerThread = NULL;
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (err != ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_PIPELINE_TAG, "error: %s", ARUPDATER_Error_ToString(err));
+        ARUPDATER_Pipeline_Delete(&pipeline);
+    }
+
+    if (error != NULL)
+    {
+        *error = err;
+    }
+
+    return pipeline;
+}
+
+void ARUPDATER_Pipeline_Delete(ARUPDATER_Pipeline_t **pipelineAddr)
+{
+    if (pipelineAddr != NULL)
+    {
+        ARUPDATER_Pipeline_t *pipeline = *pipelineAddr;
+        if (pipeline != NULL)
+        {
+            int i = 0;
+
+            if (pipeline->writerThread != NULL)
+            {
+                ARUPDATER_Pipeline_Finish(pipeline);
+            }
+            if (pipeline->hasSems)
+            {
+                ARSAL_Sem_Destroy(&pipeline->filledSem);
+                ARSAL_Sem_Destroy(&pipeline->freeSem);
+            }
+            for (i = 0; (pipeline->buffers != NULL) && (i < pipeline->bufferCount); i++)
+            {
+                free(pipeline->buffers[i].data);
+            }
+            free(pipeline->buffers);
+            free(pipeline);
+        }
+        *pipelineAddr = NULL;
+    }
+}
+
+eARUPDATER_ERROR ARUPDATER_Pipeline_Write(ARUPDATER_Pipeline_t *pipeline, const uint8_t *data, size_t size, int64_t offset)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if ((pipeline == NULL) || ((data == NULL) && (size > 0)) || (pipeline->writerThread == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        ARUPDATER_Pipeline_Buffer_t *buffer = &pipeline->buffers[pipeline->tail % pipeline->bufferCount];
+
+        // once the writing thread has failed, the data would be lost
+        error = __atomic_load_n(&pipeline->writerError, __ATOMIC_RELAXED);
+        if (error != ARUPDATER_OK)
+        {
+            break;
+        }
+
+        if (pipeline->hasBuffer == 0)
+        {
+            ARUPDATER_Pipeline_SemWait(&pipeline->freeSem, &pipeline->networkWaitCount);
+            buffer->size = 0;
+            buffer->offset = offset;
+            pipeline->hasBuffer = 1;
+        }
+        else if (offset != buffer->offset + (int64_t)buffer->size)
+        {
+            ARUPDATER_Pipeline_Publish(pipeline);
+        }
+        else
+        {
+            size_t copySize = pipeline->bufferSize - buffer->size;
+            if (copySize > size)
+            {
+                copySize = size;
+            }
+            memcpy(buffer->data + buffer->size, data, copySize);
+            buffer->size += copySize;
+            data += copySize;
+            size -= copySize;
+            offset += copySize;
+
+            if (buffer->size == pipeline->bufferSize)
+            {
+                ARUPDATER_Pipeline_Publish(pipeline);
+            }
+        }
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Pipeline_Finish(ARUPDATER_Pipeline_t *pipeline)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    if (pipeline == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (pipeline->writerThread != NULL))
+    {
+        if (pipeline->hasBuffer)
+        {
+            if (pipeline->buffers[pipeline->tail % pipeline->bufferCount].size > 0)
+            {
+                ARUPDATER_Pipeline_Publish(pipeline);
+            }
+            else
+            {
+                // give back the free buffer taken
+                pipeline->hasBuffer = 0;
+                ARSAL_Sem_Post(&pipeline->freeSem);
+            }
+        }
+
+        __atomic_store_n(&pipeline->isFinished, 1, __ATOMIC_RELEASE);
+        ARSAL_Sem_Post(&pipeline->filledSem);
+
+        ARSAL_Thread_Join(pipeline->writerThread, NULL);
+        ARSAL_Thread_Destroy(&pipeline->writerThread);
+        pipeline->writerThread = NULL;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = pipeline->writerError;
+    }
+
+    return error;
+}
+
+void ARUPDATER_Pipeline_GetStats(ARUPDATER_Pipeline_t *pipeline, ARUPDATER_Downloader_PipelineStats_t *stats)
+{
+    if ((pipeline != NULL) && (stats != NULL))
+    {
+        int64_t occupancyCount = __atomic_load_n(&pipeline->occupancyCount, __ATOMIC_RELAXED);
+
+        stats->bufferCount = pipeline->bufferCount;
+        stats->bufferSize = (int64_t)pipeline->bufferSize;
+        stats->occupancy = (int)(__atomic_load_n(&pipeline->tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&pipeline->head, __ATOMIC_ACQUIRE));
+        stats->maxOccupancy = __atomic_load_n(&pipeline->maxOccupancy, __ATOMIC_RELAXED);
+        stats->averageOccupancy = (occupancyCount > 0) ? (float)__atomic_load_n(&pipeline->occupancySum, __ATOMIC_RELAXED) / (float)occupancyCount : 0.f;
+        stats->networkWaitCount = __atomic_load_n(&pipeline->networkWaitCount, __ATOMIC_RELAXED);
+        stats->writerWaitCount = __atomic_load_n(&pipeline->writerWaitCount, __ATOMIC_RELAXED);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Pipeline.h
+ * @brief libARUpdater pipeline header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_PIPELINE_PRIVATE_H_
+#define _ARUPDATER_PIPELINE_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARUpdater/ARUPDATER_Downloader.h>
+
+#include "ARUPDATER_FileIO.h"
+
+/**
+ * @brief Size of the buffers of a pipeline, when the memory allows at least two of them
+ */
+#define ARUPDATER_PIPELINE_BUFFER_SIZE          ARUPDATER_FILEIO_BLOCK_SIZE
+
+/**
+ * @brief Smallest size of the buffers of a pipeline
+ */
+#define ARUPDATER_PIPELINE_MIN_BUFFER_SIZE      (16 * 1024)
+
+/**
+ * @brief Smallest memory of a pipeline, two buffers of ARUPDATER_PIPELINE_MIN_BUFFER_SIZE bytes
+ */
+#define ARUPDATER_PIPELINE_MIN_MEMORY           (2 * ARUPDATER_PIPELINE_MIN_BUFFER_SIZE)
+
+/**
+ * @brief Ring of buffers between a thread receiving data and a thread writing it into a file
+ * @details The receiving thread fills the buffers in order, the writing thread gives each buffer to the data callback then writes it. The ring indexes are shared without lock, the threads only sleep when the ring is full or empty
+ * @see ARUPDATER_Pipeline_New ()
+ */
+typedef struct ARUPDATER_Pipeline_t ARUPDATER_Pipeline_t;
+
+/**
+ * @brief Data callback of a pipeline, called by the writing thread just before the data is written
+ * @param arg The pointer of the user custom argument
+ * @param data The data, following the previous one
+ * @param size The size of the data
+ */
+typedef void (*ARUPDATER_Pipeline_DataCallback_t) (void* arg, const uint8_t *data, size_t size);
+
+/**
+ * @brief Create a pipeline and start its writing thread
+ * @warning This function allocates memory
+ * @param file : the file written by the pipeline, it must not be used until ARUPDATER_Pipeline_Finish () returns
+ * @param[in] maxMemory : memory of all the buffers, at least ARUPDATER_PIPELINE_MIN_MEMORY bytes
+ * @param[in] dataCallback : callback called with the data by the writing thread. Can be null
+ * @param[in|out] dataArg : arg given to the dataCallback
+ * @param[out] error : ARUPDATER_OK if operation went well, ARUPDATER_ERROR_BAD_PARAMETER if maxMemory is lower than ARUPDATER_PIPELINE_MIN_MEMORY, the description of the error otherwise. Can be null
+ * @return the new pipeline, NULL if an error occurred
+ * @see ARUPDATER_Pipeline_Delete ()
+ */
+ARUPDATER_Pipeline_t *ARUPDATER_Pipeline_New(ARUPDATER_FileIO_t *file, int64_t maxMemory, ARUPDATER_Pipeline_DataCallback_t dataCallback, void *dataArg, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Stop the writing thread if needed and delete a pipeline
+ * @warning This function frees memory
+ * @param pipelineAddr : address of the pointer on the pipeline
+ * @see ARUPDATER_Pipeline_New ()
+ */
+void ARUPDATER_Pipeline_Delete(ARUPDATER_Pipeline_t **pipelineAddr);
+
+/**
+ * @brief Queue data to be written, from the receiving thread
+ * @details Waits for a free buffer when the ring is full
+ * @param pipeline : pointer on the pipeline
+ * @param[in] data : the data
+ * @param[in] size : size of the data
+ * @param[in] offset : position of the data in the file
+ * @return ARUPDATER_OK if operation went well, the first error of the writing thread otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Pipeline_Write(ARUPDATER_Pipeline_t *pipeline, const uint8_t *data, size_t size, int64_t offset);
+
+/**
+ * @brief Queue the last buffer and wait until all the data is written
+ * @param pipeline : pointer on the pipeline
+ * @return ARUPDATER_OK if all the data has been written, the first error of the writing thread otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Pipeline_Finish(ARUPDATER_Pipeline_t *pipeline);
+
+/**
+ * @brief Get the occupancy of the buffers of a pipeline, can be called from any thread
+ * @param pipeline : pointer on the pipeline
+ * @param[out] stats : the occupancy of the buffers
+ */
+void ARUPDATER_Pipeline_GetStats(ARUPDATER_Pipeline_t *pipeline, ARUPDATER_Downloader_PipelineStats_t *stats);
+
+#endif /* _ARUPDATER_PIPELINE_PRIVATE_H_ */
@@ -38,12 +38,21 @@
  */
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "ARUPDATER_Plf.h"
 
 eARUPDATER_ERROR ARUPDATER_Plf_GetHeader(const char *plf_filename, plf_phdr_t *header)
+{
+    return ARUPDATER_Plf_GetHeaderAt(AT_FDCWD, plf_filename, header);
+}
+
+eARUPDATER_ERROR ARUPDATER_Plf_GetHeaderAt(int dirFd, const char *plf_filename, plf_phdr_t *header)
 {
     eARUPDATER_ERROR error =  ARUPDATER_OK;
-    if (header == NULL)
+    if ((header == NULL) || (plf_filename == NULL))
     {
         error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
@@ -51,14 +60,19 @@ eARUPDATER_ERROR ARUPDATER_Plf_GetHeader(const char *plf_filename, plf_phdr_t *h
     if (error == ARUPDATER_OK)
     {
         plf_phdr_t h;
-        FILE *f = fopen(plf_filename, "rb");
-        if(f != NULL)
+        int fd = openat(dirFd, plf_filename, O_RDONLY | O_CLOEXEC);
+        if(fd >= 0)
         {
-            if(fread(&h, 1, sizeof(plf_phdr_t), f) == sizeof(plf_phdr_t))
+            if(pread(fd, &h, sizeof(plf_phdr_t), 0) == sizeof(plf_phdr_t))
             {
                 memcpy(header, &h, sizeof(plf_phdr_t));
+                error = ARUPDATER_Plf_CheckHeader(header, 0);
             }
-            fclose(f);
+            else
+            {
+                error = ARUPDATER_ERROR_PLF_BAD_HEADER;
+            }
+            close(fd);
         }
         else
         {
@@ -68,3 +82,179 @@ eARUPDATER_ERROR ARUPDATER_Plf_GetHeader(const char *plf_filename, plf_phdr_t *h
 	
 	return error;
 }
+
+eARUPDATER_ERROR ARUPDATER_Plf_CheckHeader(const plf_phdr_t *header, size_t fileSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    if (header == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((error == ARUPDATER_OK) &&
+        ((header->p_magic != PLF_HEADER_MAGIC) ||
+         (header->p_phdrsize < sizeof(plf_phdr_t)) ||
+         (header->p_shdrsize < sizeof(plf_shdr_t))))
+    {
+        error = ARUPDATER_ERROR_PLF_BAD_HEADER;
+    }
+    
+    // a truncated file
+    if ((error == ARUPDATER_OK) && (fileSize != 0) &&
+        ((header->p_phdrsize > fileSize) || (header->p_size > fileSize)))
+    {
+        error = ARUPDATER_ERROR_PLF_BAD_HEADER;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Plf_Open(const char *plf_filename, plf_file_t *plf)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct stat statbuf;
+    int fd = -1;
+    
+    if ((plf_filename == NULL) || (plf == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        memset(plf, 0, sizeof(plf_file_t));
+        fd = open(plf_filename, O_RDONLY);
+        if (fd < 0)
+        {
+            error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (fstat(fd, &statbuf) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+    
+    if ((error == ARUPDATER_OK) && (statbuf.st_size < (off_t)sizeof(plf_phdr_t)))
+    {
+        error = ARUPDATER_ERROR_PLF_BAD_HEADER;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        plf->mapSize = (size_t)statbuf.st_size;
+        plf->map = mmap(NULL, plf->mapSize, PROT_READ, MAP_SHARED, fd, 0);
+        if (plf->map == MAP_FAILED)
+        {
+            plf->map = NULL;
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
+    // the mapping stays valid once the file is closed
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        plf->data = (const uint8_t *)plf->map;
+        plf->header = (const plf_phdr_t *)plf->map;
+        error = ARUPDATER_Plf_CheckHeader(plf->header, plf->mapSize);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        // the sections are read once, from the beginning to the end
+        madvise(plf->map, plf->mapSize, MADV_SEQUENTIAL);
+        plf->size = (plf->header->p_size != 0) ? plf->header->p_size : plf->mapSize;
+    }
+    
+    if ((error != ARUPDATER_OK) && (plf != NULL))
+    {
+        ARUPDATER_Plf_Close(plf);
+    }
+    
+    return error;
+}
+
+void ARUPDATER_Plf_Close(plf_file_t *plf)
+{
+    if ((plf != NULL) && (plf->map != NULL))
+    {
+        munmap(plf->map, plf->mapSize);
+        memset(plf, 0, sizeof(plf_file_t));
+    }
+}
+
+void ARUPDATER_Plf_SectionIterator_Init(plf_section_iterator_t *iterator, const plf_file_t *plf)
+{
+    if (iterator != NULL)
+    {
+        iterator->plf = plf;
+        iterator->offset = ((plf != NULL) && (plf->header != NULL)) ? plf->header->p_phdrsize : 0;
+    }
+}
+
+int ARUPDATER_Plf_SectionIterator_Next(plf_section_iterator_t *iterator, plf_section_t *section, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    int hasSection = 0;
+    const plf_file_t *plf = NULL;
+    const plf_shdr_t *sectionHeader = NULL;
+    size_t payloadOffset = 0;
+    
+    if ((iterator == NULL) || (iterator->plf == NULL) || (iterator->plf->header == NULL) || (section == NULL))
+    {
+        err = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if (err == ARUPDATER_OK)
+    {
+        plf = iterator->plf;
+        if (iterator->offset < plf->size)
+        {
+            hasSection = 1;
+        }
+    }
+    
+    // the section header and its payload must be in the file
+    if ((err == ARUPDATER_OK) && (hasSection != 0))
+    {
+        if ((plf->size - iterator->offset) < plf->header->p_shdrsize)
+        {
+            err = ARUPDATER_ERROR_PLF_BAD_SECTION;
+        }
+        else
+        {
+            sectionHeader = (const plf_shdr_t *)(plf->data + iterator->offset);
+            payloadOffset = iterator->offset + plf->header->p_shdrsize;
+            if ((plf->size - payloadOffset) < sectionHeader->s_size)
+            {
+                err = ARUPDATER_ERROR_PLF_BAD_SECTION;
+            }
+        }
+    }
+    
+    if ((err == ARUPDATER_OK) && (hasSection != 0))
+    {
+        section->header = sectionHeader;
+        section->payload = plf->data + payloadOffset;
+        section->payloadSize = sectionHeader->s_size;
+        section->offset = iterator->offset;
+        
+        iterator->offset = (payloadOffset + sectionHeader->s_size + (PLF_SECTION_ALIGNMENT - 1)) & ~(size_t)(PLF_SECTION_ALIGNMENT - 1);
+    }
+    else
+    {
+        hasSection = 0;
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return hasSection;
+}
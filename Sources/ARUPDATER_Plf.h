@@ -43,6 +43,8 @@
 #define PLF_CURRENT_VERSION  10
 #define PLF_HEADER_MAGIC     0x21464c50 //!< PLF magic number
 
+#include <stddef.h>
+#include <stdint.h>
 #include <libARUpdater/ARUPDATER_Error.h>
 
 typedef unsigned int   Plf_Word;        //!< Unsigned 32 bits integer
@@ -67,11 +69,94 @@ typedef struct {
 	Plf_Word    p_size;                   //!< File size in bytes
 } plf_phdr_t;
 
+//! PLF section header, followed by the section payload. Sections are 4 bytes aligned
+typedef struct {
+	Plf_Word    s_type;                   //!< Section type
+	Plf_Word    s_size;                   //!< Payload size in bytes
+	Plf_Word    s_crc32;                  //!< CRC32 of the payload
+	Plf_Word    s_loadAddr;               //!< Load address
+	Plf_Word    s_uncomprSize;            //!< Uncompressed size, 0 if the payload is not compressed
+} plf_shdr_t;
+
+#define PLF_SECTION_ALIGNMENT 4
+
+//! PLF file mapped in memory
+typedef struct {
+	const plf_phdr_t *header;            //!< File header, pointing into the mapping
+	const uint8_t    *data;              //!< Beginning of the file
+	size_t            size;              //!< Size of the file, bounded by p_size
+	void             *map;               //!< The mapping
+	size_t            mapSize;           //!< Size of the mapping
+} plf_file_t;
+
+//! Section of a mapped PLF file, no data is copied
+typedef struct {
+	const plf_shdr_t *header;            //!< Section header, pointing into the mapping
+	const uint8_t    *payload;           //!< Section payload, pointing into the mapping
+	size_t            payloadSize;       //!< Size of the payload
+	size_t            offset;            //!< Offset of the section header in the file
+} plf_section_t;
+
+//! Iterator over the sections of a mapped PLF file
+typedef struct {
+	const plf_file_t *plf;
+	size_t            offset;            //!< Offset of the next section header
+} plf_section_iterator_t;
+
 /**
  * @brief read the header of a plf file
  * @param[in] plf_filepath : path of the plf file to read
  * @param[out] header : a struct representing the header of the file
- * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_BAD_HEADER if the file is not a plf, a description of the error otherwise
  */
 eARUPDATER_ERROR ARUPDATER_Plf_GetHeader(const char *plf_filename, plf_phdr_t *header);
+
+/**
+ * @brief read the header of a plf file of an opened folder
+ * @param[in] dirFd : descriptor of the folder, AT_FDCWD for the current folder
+ * @param[in] plf_filename : name of the plf file in the folder
+ * @param[out] header : a struct representing the header of the file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_BAD_HEADER if the file is not a plf, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Plf_GetHeaderAt(int dirFd, const char *plf_filename, plf_phdr_t *header);
+
+/**
+ * @brief check that a header describes a plf file
+ * @param[in] header : the header to check
+ * @param[in] fileSize : the size of the file, 0 if unknown
+ * @return ARUPDATER_OK if the header is valid, ARUPDATER_ERROR_PLF_BAD_HEADER otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Plf_CheckHeader(const plf_phdr_t *header, size_t fileSize);
+
+/**
+ * @brief map a plf file in memory and check its header
+ * @param[in] plf_filename : path of the plf file to map
+ * @param[out] plf : the mapped file
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ * @see ARUPDATER_Plf_Close ()
+ */
+eARUPDATER_ERROR ARUPDATER_Plf_Open(const char *plf_filename, plf_file_t *plf);
+
+/**
+ * @brief unmap a plf file, all the views given by the file become invalid
+ * @param plf : the mapped file
+ * @see ARUPDATER_Plf_Open ()
+ */
+void ARUPDATER_Plf_Close(plf_file_t *plf);
+
+/**
+ * @brief start an iteration over the sections of a mapped plf file
+ * @param[out] iterator : the iterator to initialize
+ * @param[in] plf : the mapped file
+ */
+void ARUPDATER_Plf_SectionIterator_Init(plf_section_iterator_t *iterator, const plf_file_t *plf);
+
+/**
+ * @brief get the next section of a mapped plf file
+ * @param iterator : the iterator
+ * @param[out] section : the next section
+ * @param[out] error : ARUPDATER_OK at the end of the sections, ARUPDATER_ERROR_PLF_BAD_SECTION if a section goes past the end of the file. Can be null
+ * @return 1 if a section has been given, 0 at the end of the sections or on error
+ */
+int ARUPDATER_Plf_SectionIterator_Next(plf_section_iterator_t *iterator, plf_section_t *section, eARUPDATER_ERROR *error);
 #endif // _PLF_H_
@@ -0,0 +1,467 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfIndex.c
+ * @brief libARUpdater index of the plf files of a folder c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_PlfIndex.h"
+#include "ARUPDATER_Utils.h"
+#include "ARUPDATER_Manager.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_PLF_INDEX_TAG                 "ARUPDATER_PlfIndex"
+
+/**
+ * @brief Delay during which a folder modified before its scan may be modified again with the same modification time
+ * @details 2 seconds covers the FAT filesystems of the SD cards
+ */
+#define ARUPDATER_PLF_INDEX_RACY_DELAY          2
+
+typedef struct
+{
+    char *fileName;
+    int isValid; /**< 0 if the header of the file can not be read */
+    ARUPDATER_Manager_PlfVersion_t version;
+    off_t size; /**< size of the file when its header was read */
+    time_t modificationTime;
+} ARUPDATER_PlfIndex_Plf_t;
+
+typedef struct
+{
+    int isUsed;
+    dev_t device;
+    ino_t inode;
+    time_t modificationTime;
+    int isRacy; /**< the folder was modified too close to its scan, its modification time can not be trusted */
+    ARUPDATER_PlfIndex_Plf_t *plfs;
+    int plfCount;
+    uint64_t lastUse;
+} ARUPDATER_PlfIndex_Folder_t;
+
+static pthread_mutex_t ARUPDATER_PlfIndex_Lock = PTHREAD_MUTEX_INITIALIZER;
+static ARUPDATER_PlfIndex_Folder_t ARUPDATER_PlfIndex_Folders[ARUPDATER_PLF_INDEX_MAX_FOLDERS];
+static uint64_t ARUPDATER_PlfIndex_UseCount = 0;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static void ARUPDATER_PlfIndex_ClearFolder(ARUPDATER_PlfIndex_Folder_t *folder)
+{
+    int i = 0;
+
+    for (i = 0; i < folder->plfCount; i++)
+    {
+        free(folder->plfs[i].fileName);
+    }
+    free(folder->plfs);
+    memset(folder, 0, sizeof(*folder));
+}
+
+/**
+ * @brief newest first, then by name so that the order does not depend on the filesystem
+ */
+static int ARUPDATER_PlfIndex_Compare(const void *a, const void *b)
+{
+    const ARUPDATER_PlfIndex_Plf_t *plfA = (const ARUPDATER_PlfIndex_Plf_t *)a;
+    const ARUPDATER_PlfIndex_Plf_t *plfB = (const ARUPDATER_PlfIndex_Plf_t *)b;
+
+    if (plfA->isValid != plfB->isValid)
+    {
+        return plfB->isValid - plfA->isValid;
+    }
+    if (plfA->version.version != plfB->version.version)
+    {
+        return (plfA->version.version > plfB->version.version) ? -1 : 1;
+    }
+    if (plfA->version.edition != plfB->version.edition)
+    {
+        return (plfA->version.edition > plfB->version.edition) ? -1 : 1;
+    }
+    if (plfA->version.extension != plfB->version.extension)
+    {
+        return (plfA->version.extension > plfB->version.extension) ? -1 : 1;
+    }
+    return strcmp(plfA->fileName, plfB->fileName);
+}
+
+/**
+ * @brief list an opened folder and read the headers of its plf files
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfIndex_Scan(ARUPDATER_PlfIndex_Folder_t *indexFolder, int dirFd)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    int capacity = 0;
+    int listFd = -1;
+
+    // the listing owns its descriptor, dirFd stays opened for the headers
+    listFd = openat(dirFd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (listFd >= 0)
+    {
+        dir = fdopendir(listFd);
+    }
+    if (dir == NULL)
+    {
+        if (listFd >= 0)
+        {
+            close(listFd);
+        }
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+
+    while ((error == ARUPDATER_OK) && ((entry = readdir(dir)) != NULL))
+    {
+        char *extension = strrchr(entry->d_name, ARUPDATER_MANAGER_PLF_EXTENSION[0]);
+        ARUPDATER_PlfIndex_Plf_t *plf = NULL;
+
+        if ((extension == NULL) || (strcmp(extension, ARUPDATER_MANAGER_PLF_EXTENSION) != 0))
+        {
+            continue;
+        }
+
+        if (indexFolder->plfCount == capacity)
+        {
+            int newCapacity = (capacity == 0) ? 4 : 2 * capacity;
+            ARUPDATER_PlfIndex_Plf_t *plfs = realloc(indexFolder->plfs, newCapacity * sizeof(ARUPDATER_PlfIndex_Plf_t));
+            if (plfs == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+                break;
+            }
+            indexFolder->plfs = plfs;
+            capacity = newCapacity;
+        }
+
+        plf = &indexFolder->plfs[indexFolder->plfCount];
+        memset(plf, 0, sizeof(*plf));
+        plf->fileName = strdup(entry->d_name);
+        if (plf->fileName == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            struct stat statbuf;
+
+            if (fstatat(dirFd, entry->d_name, &statbuf, 0) == 0)
+            {
+                plf->size = statbuf.st_size;
+                plf->modificationTime = statbuf.st_mtime;
+            }
+            plf->isValid = (ARUPDATER_Utils_GetPlfVersionAt(dirFd, entry->d_name, &plf->version.version, &plf->version.edition, &plf->version.extension) == ARUPDATER_OK);
+            indexFolder->plfCount++;
+        }
+    }
+
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+
+    if ((error == ARUPDATER_OK) && (indexFolder->plfCount > 1))
+    {
+        qsort(indexFolder->plfs, indexFolder->plfCount, sizeof(ARUPDATER_PlfIndex_Plf_t), ARUPDATER_PlfIndex_Compare);
+    }
+
+    return error;
+}
+
+/**
+ * @brief check that the newest plf of an index is still the file whose header was read
+ * @details a plf rewritten in place does not change the modification time of its folder
+ */
+static int ARUPDATER_PlfIndex_IsNewestUnchanged(ARUPDATER_PlfIndex_Folder_t *indexFolder, int dirFd)
+{
+    struct stat statbuf;
+
+    if (indexFolder->plfCount == 0)
+    {
+        return 1;
+    }
+
+    return ((fstatat(dirFd, indexFolder->plfs[0].fileName, &statbuf, 0) == 0) &&
+            (statbuf.st_size == indexFolder->plfs[0].size) && (statbuf.st_mtime == indexFolder->plfs[0].modificationTime));
+}
+
+/**
+ * @brief get the up to date index of an opened folder, to be called with the lock held
+ * @return the index of the folder, NULL if the folder can not be listed
+ */
+static ARUPDATER_PlfIndex_Folder_t *ARUPDATER_PlfIndex_Get(int dirFd, eARUPDATER_ERROR *error)
+{
+    ARUPDATER_PlfIndex_Folder_t *indexFolder = NULL;
+    ARUPDATER_PlfIndex_Folder_t *oldest = &ARUPDATER_PlfIndex_Folders[0];
+    struct stat statbuf;
+    int i = 0;
+
+    if (fstat(dirFd, &statbuf) != 0)
+    {
+        *error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+        return NULL;
+    }
+
+    for (i = 0; (i < ARUPDATER_PLF_INDEX_MAX_FOLDERS) && (indexFolder == NULL); i++)
+    {
+        ARUPDATER_PlfIndex_Folder_t *current = &ARUPDATER_PlfIndex_Folders[i];
+        if ((current->isUsed) && (current->device == statbuf.st_dev) && (current->inode == statbuf.st_ino))
+        {
+            indexFolder = current;
+        }
+        else if (current->lastUse < oldest->lastUse)
+        {
+            oldest = current;
+        }
+    }
+
+    if ((indexFolder != NULL) && (indexFolder->isRacy == 0) && (indexFolder->modificationTime == statbuf.st_mtime) &&
+        (ARUPDATER_PlfIndex_IsNewestUnchanged(indexFolder, dirFd)))
+    {
+        indexFolder->lastUse = ++ARUPDATER_PlfIndex_UseCount;
+        *error = ARUPDATER_OK;
+        return indexFolder;
+    }
+
+    // scan into the slot of the folder, or the least recently used one
+    if (indexFolder == NULL)
+    {
+        indexFolder = oldest;
+    }
+    ARUPDATER_PlfIndex_ClearFolder(indexFolder);
+
+    *error = ARUPDATER_PlfIndex_Scan(indexFolder, dirFd);
+    if (*error != ARUPDATER_OK)
+    {
+        ARUPDATER_PlfIndex_ClearFolder(indexFolder);
+        return NULL;
+    }
+
+    indexFolder->isUsed = 1;
+    indexFolder->device = statbuf.st_dev;
+    indexFolder->inode = statbuf.st_ino;
+    indexFolder->modificationTime = statbuf.st_mtime;
+    indexFolder->isRacy = (statbuf.st_mtime >= time(NULL) - ARUPDATER_PLF_INDEX_RACY_DELAY);
+    indexFolder->lastUse = ++ARUPDATER_PlfIndex_UseCount;
+
+    return indexFolder;
+}
+
+/**
+ * @brief open a folder given by its path
+ */
+static int ARUPDATER_PlfIndex_OpenFolder(const char *const folder)
+{
+    return open(folder, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewest(const char *const folder, char **plfFileName)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int dirFd = -1;
+
+    if ((folder == NULL) || (plfFileName == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    *plfFileName = NULL;
+
+    dirFd = ARUPDATER_PlfIndex_OpenFolder(folder);
+    if (dirFd < 0)
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+    else
+    {
+        error = ARUPDATER_PlfIndex_GetNewestAt(dirFd, plfFileName);
+        close(dirFd);
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewestAt(int dirFd, char **plfFileName)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfIndex_Folder_t *indexFolder = NULL;
+
+    if ((dirFd < 0) || (plfFileName == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    *plfFileName = NULL;
+
+    pthread_mutex_lock(&ARUPDATER_PlfIndex_Lock);
+
+    indexFolder = ARUPDATER_PlfIndex_Get(dirFd, &error);
+    if ((error == ARUPDATER_OK) && (indexFolder->plfCount == 0))
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        *plfFileName = strdup(indexFolder->plfs[0].fileName);
+        if (*plfFileName == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    pthread_mutex_unlock(&ARUPDATER_PlfIndex_Lock);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewestVersionAt(int dirFd, ARUPDATER_Manager_PlfVersion_t *version)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfIndex_Folder_t *indexFolder = NULL;
+
+    if ((dirFd < 0) || (version == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    pthread_mutex_lock(&ARUPDATER_PlfIndex_Lock);
+
+    indexFolder = ARUPDATER_PlfIndex_Get(dirFd, &error);
+    if ((error == ARUPDATER_OK) && (indexFolder->plfCount == 0))
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+    else if ((error == ARUPDATER_OK) && (indexFolder->plfs[0].isValid == 0))
+    {
+        // the valid plf files are sorted first
+        error = ARUPDATER_ERROR_PLF_BAD_HEADER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        *version = indexFolder->plfs[0].version;
+    }
+
+    pthread_mutex_unlock(&ARUPDATER_PlfIndex_Lock);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetVersions(const char *const folder, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfIndex_Folder_t *indexFolder = NULL;
+    int dirFd = -1;
+    int i = 0;
+
+    if ((folder == NULL) || (count == NULL) || (maxCount < 0) || ((versions == NULL) && (maxCount > 0)))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    *count = 0;
+
+    dirFd = ARUPDATER_PlfIndex_OpenFolder(folder);
+    if (dirFd < 0)
+    {
+        return ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+
+    pthread_mutex_lock(&ARUPDATER_PlfIndex_Lock);
+
+    indexFolder = ARUPDATER_PlfIndex_Get(dirFd, &error);
+
+    // the valid plf files are sorted first
+    for (i = 0; (error == ARUPDATER_OK) && (i < indexFolder->plfCount) && (indexFolder->plfs[i].isValid); i++)
+    {
+        if (i < maxCount)
+        {
+            versions[i] = indexFolder->plfs[i].version;
+        }
+        (*count)++;
+    }
+
+    pthread_mutex_unlock(&ARUPDATER_PlfIndex_Lock);
+
+    close(dirFd);
+
+    return error;
+}
+
+void ARUPDATER_PlfIndex_Invalidate(const char *const folder)
+{
+    struct stat statbuf;
+    int i = 0;
+
+    if ((folder == NULL) || (stat(folder, &statbuf) != 0))
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&ARUPDATER_PlfIndex_Lock);
+
+    for (i = 0; i < ARUPDATER_PLF_INDEX_MAX_FOLDERS; i++)
+    {
+        if ((ARUPDATER_PlfIndex_Folders[i].isUsed) && (ARUPDATER_PlfIndex_Folders[i].device == statbuf.st_dev) &&
+            (ARUPDATER_PlfIndex_Folders[i].inode == statbuf.st_ino))
+        {
+            ARUPDATER_PlfIndex_ClearFolder(&ARUPDATER_PlfIndex_Folders[i]);
+        }
+    }
+
+    pthread_mutex_unlock(&ARUPDATER_PlfIndex_Lock);
+}
@@ -0,0 +1,94 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfIndex.h
+ * @brief libARUpdater index of the plf files of a folder header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_PLF_INDEX_PRIVATE_H_
+#define _ARUPDATER_PLF_INDEX_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARUpdater/ARUPDATER_Manager.h>
+
+/**
+ * @brief Number of folders kept in the index, known by their device and inode
+ */
+#define ARUPDATER_PLF_INDEX_MAX_FOLDERS                 16
+
+/**
+ * @brief Get the newest plf of a folder
+ * @details The plf files are sorted by version, edition and extension, then by name. The files with an unreadable header come last.
+ * The folder is listed and the headers are read only when the modification time of the folder, or the size or the modification time of its newest plf, changes.
+ * @param[in] folder : the folder
+ * @param[out] plfFileName : the newly-allocated name of the plf file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the folder holds no plf, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewest(const char *const folder, char **plfFileName);
+
+/**
+ * @brief Get the newest plf of an opened folder
+ * @see ARUPDATER_PlfIndex_GetNewest ()
+ * @param[in] dirFd : descriptor of the folder
+ * @param[out] plfFileName : the newly-allocated name of the plf file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the folder holds no plf, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewestAt(int dirFd, char **plfFileName);
+
+/**
+ * @brief Get the version of the newest plf of an opened folder
+ * @details The version comes from the index, no header is read while the folder is unchanged
+ * @param[in] dirFd : descriptor of the folder
+ * @param[out] version : the version of the newest plf
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the folder holds no plf, ARUPDATER_ERROR_PLF_BAD_HEADER if no header can be read, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetNewestVersionAt(int dirFd, ARUPDATER_Manager_PlfVersion_t *version);
+
+/**
+ * @brief Get the versions of the plf files of a folder, the newest first
+ * @details The files with an unreadable header are not listed
+ * @param[in] folder : the folder
+ * @param[out] versions : the versions. Can be null if maxCount is 0
+ * @param[in] maxCount : the size of versions
+ * @param[out] count : the number of plf files in the folder, which may be greater than maxCount
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfIndex_GetVersions(const char *const folder, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count);
+
+/**
+ * @brief Drop a folder from the index
+ * @details Needed only when a plf file other than the newest one is rewritten in place, the other changes of the folder are seen from its modification time and from the one of its newest plf
+ * @param[in] folder : the folder
+ */
+void ARUPDATER_PlfIndex_Invalidate(const char *const folder);
+
+#endif
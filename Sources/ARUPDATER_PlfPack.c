@@ -0,0 +1,853 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfPack.c
+ * @brief libARUpdater packed plf storage c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_PlfPack.h"
+#include "ARUPDATER_Utils.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_PLF_PACK_TAG                  "ARUPDATER_PlfPack"
+
+#define ARUPDATER_PLF_PACK_MAGIC                "ARUPPACK"
+#define ARUPDATER_PLF_PACK_FORMAT_VERSION       1
+#define ARUPDATER_PLF_PACK_ALIGNMENT            4096
+#define ARUPDATER_PLF_PACK_TMP_SUFFIX           ".tmp"
+#define ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE     (1024 * 1024)
+
+/**
+ * @brief Header of the index, followed by the entries
+ */
+typedef struct
+{
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t entryCapacity;
+    uint32_t entryCount; /**< the entries past the count are not written yet, incrementing it commits an entry */
+    uint32_t reserved;
+    uint64_t dataEnd;
+    uint8_t padding[96];
+} ARUPDATER_PlfPack_Header_t;
+
+#define ARUPDATER_PLF_PACK_ENTRY_CAPACITY       ((ARUPDATER_PLF_PACK_INDEX_SIZE - sizeof(ARUPDATER_PlfPack_Header_t)) / sizeof(ARUPDATER_PlfPack_Entry_t))
+
+/**
+ * @brief An opened and locked pack, with its index mapped
+ */
+typedef struct
+{
+    int fd;
+    int isWritable;
+    int64_t fileSize;
+    ARUPDATER_PlfPack_Header_t *header;
+    ARUPDATER_PlfPack_Entry_t *entries;
+} ARUPDATER_PlfPack_t;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static uint64_t ARUPDATER_PlfPack_Align(uint64_t offset)
+{
+    return (offset + ARUPDATER_PLF_PACK_ALIGNMENT - 1) & ~((uint64_t)ARUPDATER_PLF_PACK_ALIGNMENT - 1);
+}
+
+/**
+ * @brief map the index of an opened pack, a writable empty pack is initialized
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfPack_Map(ARUPDATER_PlfPack_t *pack)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int isNew = 0;
+    void *index = MAP_FAILED;
+
+    if ((pack->isWritable) && (pack->fileSize == 0))
+    {
+        if (ftruncate(pack->fd, ARUPDATER_PLF_PACK_INDEX_SIZE) != 0)
+        {
+            error = (errno == ENOSPC) ? ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE : ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            pack->fileSize = ARUPDATER_PLF_PACK_INDEX_SIZE;
+            isNew = 1;
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (pack->fileSize < ARUPDATER_PLF_PACK_INDEX_SIZE))
+    {
+        error = ARUPDATER_ERROR_PLF_BAD_PACK;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        index = mmap(NULL, ARUPDATER_PLF_PACK_INDEX_SIZE, PROT_READ | (pack->isWritable ? PROT_WRITE : 0), MAP_SHARED, pack->fd, 0);
+        if (index == MAP_FAILED)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        pack->header = (ARUPDATER_PlfPack_Header_t *)index;
+        pack->entries = (ARUPDATER_PlfPack_Entry_t *)((uint8_t *)index + sizeof(ARUPDATER_PlfPack_Header_t));
+
+        if (isNew)
+        {
+            memcpy(pack->header->magic, ARUPDATER_PLF_PACK_MAGIC, sizeof(pack->header->magic));
+            pack->header->formatVersion = ARUPDATER_PLF_PACK_FORMAT_VERSION;
+            pack->header->entryCapacity = ARUPDATER_PLF_PACK_ENTRY_CAPACITY;
+            pack->header->entryCount = 0;
+            pack->header->dataEnd = ARUPDATER_PLF_PACK_INDEX_SIZE;
+        }
+
+        // the entries are checked against the data end when they are used
+        if ((memcmp(pack->header->magic, ARUPDATER_PLF_PACK_MAGIC, sizeof(pack->header->magic)) != 0) ||
+            (pack->header->formatVersion != ARUPDATER_PLF_PACK_FORMAT_VERSION) ||
+            (pack->header->entryCapacity != ARUPDATER_PLF_PACK_ENTRY_CAPACITY) ||
+            (pack->header->entryCount > pack->header->entryCapacity) ||
+            (pack->header->dataEnd < ARUPDATER_PLF_PACK_INDEX_SIZE) ||
+            (pack->header->dataEnd > (uint64_t)pack->fileSize))
+        {
+            error = ARUPDATER_ERROR_PLF_BAD_PACK;
+        }
+    }
+
+    if ((error != ARUPDATER_OK) && (index != MAP_FAILED))
+    {
+        munmap(index, ARUPDATER_PLF_PACK_INDEX_SIZE);
+        pack->header = NULL;
+        pack->entries = NULL;
+    }
+
+    return error;
+}
+
+/**
+ * @brief open and lock a pack, shared for reading, exclusive for writing
+ * @details the pack is always closable, even when the opening fails
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfPack_Open(ARUPDATER_PlfPack_t *pack, const char *const packPath, int isWritable, int isCreated)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct stat fdStat;
+    struct stat pathStat;
+    int isLocked = 0;
+
+    memset(pack, 0, sizeof(*pack));
+    pack->fd = -1;
+    pack->isWritable = isWritable;
+
+    while ((error == ARUPDATER_OK) && (isLocked == 0))
+    {
+        pack->fd = open(packPath, (isWritable ? O_RDWR : O_RDONLY) | (isCreated ? O_CREAT : 0), S_IRUSR | S_IWUSR);
+        if (pack->fd < 0)
+        {
+            error = (errno == ENOENT) ? ARUPDATER_ERROR_PLF_FILE_NOT_FOUND : ARUPDATER_ERROR_SYSTEM;
+        }
+
+        while ((error == ARUPDATER_OK) && (flock(pack->fd, isWritable ? LOCK_EX : LOCK_SH) != 0))
+        {
+            if (errno != EINTR)
+            {
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+        }
+
+        if ((error == ARUPDATER_OK) && (fstat(pack->fd, &fdStat) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+
+        // a compaction may have replaced the pack while waiting for the lock, the new one is opened
+        if ((error == ARUPDATER_OK) && (stat(packPath, &pathStat) == 0) && (pathStat.st_dev == fdStat.st_dev) && (pathStat.st_ino == fdStat.st_ino))
+        {
+            pack->fileSize = fdStat.st_size;
+            isLocked = 1;
+        }
+        else if (pack->fd >= 0)
+        {
+            close(pack->fd);
+            pack->fd = -1;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_Map(pack);
+    }
+
+    if ((error != ARUPDATER_OK) && (pack->fd >= 0))
+    {
+        close(pack->fd);
+        pack->fd = -1;
+    }
+
+    return error;
+}
+
+/**
+ * @brief write the index to the disk
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfPack_Sync(ARUPDATER_PlfPack_t *pack)
+{
+    return (msync(pack->header, ARUPDATER_PLF_PACK_INDEX_SIZE, MS_SYNC) == 0) ? ARUPDATER_OK : ARUPDATER_ERROR_SYSTEM;
+}
+
+/**
+ * @brief unmap the index and unlock the pack
+ */
+static void ARUPDATER_PlfPack_Close(ARUPDATER_PlfPack_t *pack)
+{
+    if (pack->header != NULL)
+    {
+        munmap(pack->header, ARUPDATER_PLF_PACK_INDEX_SIZE);
+        pack->header = NULL;
+        pack->entries = NULL;
+    }
+    if (pack->fd >= 0)
+    {
+        close(pack->fd);
+        pack->fd = -1;
+    }
+}
+
+/**
+ * @brief get the newest committed entry of a product in the given state
+ * @return the index of the entry, -1 if there is none
+ */
+static int ARUPDATER_PlfPack_FindEntry(ARUPDATER_PlfPack_t *pack, uint16_t productId, eARUPDATER_PLF_PACK_STATE state)
+{
+    int i = 0;
+
+    for (i = (int)pack->header->entryCount - 1; i >= 0; i--)
+    {
+        ARUPDATER_PlfPack_Entry_t *entry = &pack->entries[i];
+        if ((entry->productId == productId) && (entry->state == state) &&
+            (entry->offset >= ARUPDATER_PLF_PACK_INDEX_SIZE) && (entry->size <= pack->header->dataEnd) && (entry->offset <= pack->header->dataEnd - entry->size))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief copy a range between two files
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfPack_CopyRange(int srcFd, uint64_t srcOffset, int dstFd, uint64_t dstOffset, uint64_t size, uint8_t *buffer)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint64_t copied = 0;
+
+    while ((error == ARUPDATER_OK) && (copied < size))
+    {
+        size_t length = ((size - copied) < ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE) ? (size_t)(size - copied) : ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE;
+        ssize_t readSize = pread(srcFd, buffer, length, srcOffset + copied);
+        ssize_t writtenSize = 0;
+
+        if (readSize == 0)
+        {
+            // the source is shorter than expected
+            error = ARUPDATER_ERROR_PLF_BAD_PACK;
+        }
+        else if (readSize < 0)
+        {
+            if (errno != EINTR)
+            {
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+            continue;
+        }
+
+        while ((error == ARUPDATER_OK) && (writtenSize < readSize))
+        {
+            ssize_t ret = pwrite(dstFd, buffer + writtenSize, readSize - writtenSize, dstOffset + copied + writtenSize);
+            if (ret >= 0)
+            {
+                writtenSize += ret;
+            }
+            else if (errno != EINTR)
+            {
+                error = (errno == ENOSPC) ? ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE : ARUPDATER_ERROR_SYSTEM;
+            }
+        }
+
+        copied += writtenSize;
+    }
+
+    return error;
+}
+
+/**
+ * @brief rewrite a locked pack with its live entries and put it in place of the previous one
+ * @details on success, the pack is the new one, still locked
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfPack_CompactLocked(ARUPDATER_PlfPack_t *pack, const char *const packPath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t newPack;
+    char *tmpPath = NULL;
+    uint8_t *buffer = NULL;
+    uint32_t i = 0;
+
+    memset(&newPack, 0, sizeof(newPack));
+    newPack.fd = -1;
+    newPack.isWritable = 1;
+
+    tmpPath = malloc(strlen(packPath) + strlen(ARUPDATER_PLF_PACK_TMP_SUFFIX) + 1);
+    buffer = malloc(ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE);
+    if ((tmpPath == NULL) || (buffer == NULL))
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    // the new pack is locked before being visible, the writers waiting on the previous one will reopen it
+    if (error == ARUPDATER_OK)
+    {
+        strcpy(tmpPath, packPath);
+        strcat(tmpPath, ARUPDATER_PLF_PACK_TMP_SUFFIX);
+
+        newPack.fd = open(tmpPath, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if ((newPack.fd < 0) || (flock(newPack.fd, LOCK_EX) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_Map(&newPack);
+    }
+
+    for (i = 0; (error == ARUPDATER_OK) && (i < pack->header->entryCount); i++)
+    {
+        ARUPDATER_PlfPack_Entry_t *entry = &pack->entries[i];
+        if (entry->state != ARUPDATER_PLF_PACK_STATE_DELETED)
+        {
+            uint64_t offset = ARUPDATER_PlfPack_Align(newPack.header->dataEnd);
+
+            error = ARUPDATER_PlfPack_CopyRange(pack->fd, entry->offset, newPack.fd, offset, entry->size, buffer);
+            if (error == ARUPDATER_OK)
+            {
+                newPack.entries[newPack.header->entryCount] = *entry;
+                newPack.entries[newPack.header->entryCount].offset = offset;
+                newPack.header->entryCount++;
+                newPack.header->dataEnd = offset + entry->size;
+            }
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (fdatasync(newPack.fd) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_Sync(&newPack);
+    }
+
+    if ((error == ARUPDATER_OK) && (rename(tmpPath, packPath) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_PLF_PACK_TAG, "%s compacted from %lld to %lld bytes", packPath, (long long)pack->header->dataEnd, (long long)newPack.header->dataEnd);
+        ARUPDATER_PlfPack_Close(pack);
+        *pack = newPack;
+    }
+    else
+    {
+        ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_PLF_PACK_TAG, "compaction of %s failed: %s", packPath, ARUPDATER_Error_ToString(error));
+        if (newPack.fd >= 0)
+        {
+            unlink(tmpPath);
+        }
+        ARUPDATER_PlfPack_Close(&newPack);
+    }
+
+    free(tmpPath);
+    free(buffer);
+
+    return error;
+}
+
+/**
+ * @brief tell whether an entry holds a newer version than another one
+ */
+static int ARUPDATER_PlfPack_IsNewer(const ARUPDATER_PlfPack_Entry_t *entryA, const ARUPDATER_PlfPack_Entry_t *entryB)
+{
+    if (entryA->version != entryB->version)
+    {
+        return (entryA->version > entryB->version);
+    }
+    if (entryA->edition != entryB->edition)
+    {
+        return (entryA->edition > entryB->edition);
+    }
+    return (entryA->extension > entryB->extension);
+}
+
+/**
+ * @brief get the retained entries of a product, the newest version first as in the versions folders
+ * @param[out] indexes : ARUPDATER_PLF_PACK_ENTRY_CAPACITY indexes of entries
+ * @return the number of retained entries
+ */
+static int ARUPDATER_PlfPack_GetRetained(ARUPDATER_PlfPack_t *pack, uint16_t productId, int *indexes)
+{
+    int count = 0;
+    int i = 0;
+    int j = 0;
+
+    // the last added entry first among the same versions
+    for (i = (int)pack->header->entryCount - 1; i >= 0; i--)
+    {
+        if ((pack->entries[i].productId == productId) && (pack->entries[i].state == ARUPDATER_PLF_PACK_STATE_RETAINED))
+        {
+            for (j = count; (j > 0) && ARUPDATER_PlfPack_IsNewer(&pack->entries[i], &pack->entries[indexes[j - 1]]); j--)
+            {
+                indexes[j] = indexes[j - 1];
+            }
+            indexes[j] = i;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief apply the retention limits to the previous versions of a product
+ * @details the oldest versions are deleted first, as ARUPDATER_Versions_Retain () does
+ */
+static void ARUPDATER_PlfPack_Prune(ARUPDATER_PlfPack_t *pack, uint16_t productId, int maxVersions, int64_t maxBytes)
+{
+    int indexes[ARUPDATER_PLF_PACK_ENTRY_CAPACITY];
+    int count = ARUPDATER_PlfPack_GetRetained(pack, productId, indexes);
+    int keptVersions = 0;
+    int64_t keptBytes = 0;
+    int i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        ARUPDATER_PlfPack_Entry_t *entry = &pack->entries[indexes[i]];
+        if ((keptVersions >= maxVersions) || ((maxBytes > 0) && (keptBytes + (int64_t)entry->size > maxBytes)))
+        {
+            entry->state = ARUPDATER_PLF_PACK_STATE_DELETED;
+        }
+        else
+        {
+            keptVersions++;
+            keptBytes += entry->size;
+        }
+    }
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_Find(const char *const packPath, uint16_t productId, ARUPDATER_PlfPack_Entry_t *entry)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+    int index = -1;
+
+    if ((packPath == NULL) || (entry == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARUPDATER_PlfPack_Open(&pack, packPath, 0, 0);
+
+    if (error == ARUPDATER_OK)
+    {
+        index = ARUPDATER_PlfPack_FindEntry(&pack, productId, ARUPDATER_PLF_PACK_STATE_CURRENT);
+        if (index < 0)
+        {
+            error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+        }
+        else
+        {
+            *entry = pack.entries[index];
+        }
+    }
+
+    ARUPDATER_PlfPack_Close(&pack);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_GetRetainedVersions(const char *const packPath, uint16_t productId, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+    int indexes[ARUPDATER_PLF_PACK_ENTRY_CAPACITY];
+    int retainedCount = 0;
+    int i = 0;
+
+    if ((packPath == NULL) || (count == NULL) || (maxCount < 0) || ((versions == NULL) && (maxCount > 0)))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARUPDATER_PlfPack_Open(&pack, packPath, 0, 0);
+
+    if (error == ARUPDATER_OK)
+    {
+        retainedCount = ARUPDATER_PlfPack_GetRetained(&pack, productId, indexes);
+        for (i = 0; (i < retainedCount) && (i < maxCount); i++)
+        {
+            versions[i].version = pack.entries[indexes[i]].version;
+            versions[i].edition = pack.entries[indexes[i]].edition;
+            versions[i].extension = pack.entries[indexes[i]].extension;
+        }
+        *count = retainedCount;
+    }
+
+    ARUPDATER_PlfPack_Close(&pack);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_Extract(const char *const packPath, uint16_t productId, const char *const filePath, ARUPDATER_PlfPack_Entry_t *entry)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+    uint8_t *buffer = NULL;
+    int index = -1;
+    int fd = -1;
+
+    if ((packPath == NULL) || (filePath == NULL))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    // the pack stays locked during the copy, a compaction can not move the data
+    error = ARUPDATER_PlfPack_Open(&pack, packPath, 0, 0);
+
+    if (error == ARUPDATER_OK)
+    {
+        index = ARUPDATER_PlfPack_FindEntry(&pack, productId, ARUPDATER_PLF_PACK_STATE_CURRENT);
+        if (index < 0)
+        {
+            error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        buffer = malloc(ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE);
+        if (buffer == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_CopyRange(pack.fd, pack.entries[index].offset, fd, 0, pack.entries[index].size, buffer);
+        if (close(fd) != 0)
+        {
+            error = (error == ARUPDATER_OK) ? ARUPDATER_ERROR_SYSTEM : error;
+        }
+        if (error != ARUPDATER_OK)
+        {
+            unlink(filePath);
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (entry != NULL))
+    {
+        *entry = pack.entries[index];
+    }
+
+    ARUPDATER_PlfPack_Close(&pack);
+    free(buffer);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_Add(const char *const packPath, uint16_t productId, const char *const filePath, const char *const fileName, const char *const md5, int maxVersions, int64_t maxBytes)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+    ARUPDATER_PlfPack_Entry_t newEntry;
+    struct stat statbuf;
+    uint8_t *buffer = NULL;
+    int version = 0, edition = 0, extension = 0;
+    int srcFd = -1;
+    int isOpened = 0;
+    int i = 0;
+
+    if ((packPath == NULL) || (filePath == NULL) || (fileName == NULL) || (md5 == NULL) ||
+        (strlen(fileName) >= ARUPDATER_PLF_PACK_FILE_NAME_SIZE) || (strlen(md5) >= ARUPDATER_PLF_PACK_MD5_SIZE) || (maxVersions < 0) || (maxBytes < 0))
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    // the version is read once here, then given by the index
+    error = ARUPDATER_Utils_GetPlfVersion(filePath, &version, &edition, &extension);
+
+    if (error == ARUPDATER_OK)
+    {
+        srcFd = open(filePath, O_RDONLY);
+        if ((srcFd < 0) || (fstat(srcFd, &statbuf) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        buffer = malloc(ARUPDATER_PLF_PACK_COPY_BUFFER_SIZE);
+        if (buffer == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_Open(&pack, packPath, 1, 1);
+        isOpened = 1;
+    }
+
+    // the plf files of a corrupted pack can not be trusted anymore, it is replaced
+    if (error == ARUPDATER_ERROR_PLF_BAD_PACK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_PLF_PACK_TAG, "replacing the corrupted pack %s", packPath);
+        unlink(packPath);
+        error = ARUPDATER_PlfPack_Open(&pack, packPath, 1, 1);
+    }
+
+    // make room in the index
+    if ((error == ARUPDATER_OK) && (pack.header->entryCount == pack.header->entryCapacity))
+    {
+        error = ARUPDATER_PlfPack_CompactLocked(&pack, packPath);
+        if ((error == ARUPDATER_OK) && (pack.header->entryCount == pack.header->entryCapacity))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_PLF_PACK_TAG, "the index of %s is full", packPath);
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    // append the data after the committed ones, a previous interrupted append is overwritten
+    if (error == ARUPDATER_OK)
+    {
+        memset(&newEntry, 0, sizeof(newEntry));
+        newEntry.productId = productId;
+        newEntry.state = ARUPDATER_PLF_PACK_STATE_CURRENT;
+        newEntry.version = version;
+        newEntry.edition = edition;
+        newEntry.extension = extension;
+        newEntry.offset = ARUPDATER_PlfPack_Align(pack.header->dataEnd);
+        newEntry.size = statbuf.st_size;
+        strcpy(newEntry.md5, md5);
+        strcpy(newEntry.fileName, fileName);
+
+        error = ARUPDATER_PlfPack_CopyRange(srcFd, 0, pack.fd, newEntry.offset, newEntry.size, buffer);
+    }
+
+    if ((error == ARUPDATER_OK) && (fdatasync(pack.fd) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    // commit the entry, the newest current entry of a product wins if the previous one is not retained yet
+    if (error == ARUPDATER_OK)
+    {
+        pack.entries[pack.header->entryCount] = newEntry;
+        pack.header->dataEnd = newEntry.offset + newEntry.size;
+        pack.header->entryCount++;
+        error = ARUPDATER_PlfPack_Sync(&pack);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        for (i = 0; i < (int)pack.header->entryCount - 1; i++)
+        {
+            if ((pack.entries[i].productId == productId) && (pack.entries[i].state == ARUPDATER_PLF_PACK_STATE_CURRENT))
+            {
+                pack.entries[i].state = ARUPDATER_PLF_PACK_STATE_RETAINED;
+            }
+        }
+        ARUPDATER_PlfPack_Prune(&pack, productId, maxVersions, maxBytes);
+        error = ARUPDATER_PlfPack_Sync(&pack);
+    }
+
+    // compact once most of the pack is deleted data, the plf is already added if it fails
+    if (error == ARUPDATER_OK)
+    {
+        uint64_t liveBytes = 0;
+        for (i = 0; i < (int)pack.header->entryCount; i++)
+        {
+            if (pack.entries[i].state != ARUPDATER_PLF_PACK_STATE_DELETED)
+            {
+                liveBytes += ARUPDATER_PlfPack_Align(pack.entries[i].size);
+            }
+        }
+        if (pack.header->dataEnd - ARUPDATER_PLF_PACK_INDEX_SIZE > 2 * liveBytes)
+        {
+            ARUPDATER_PlfPack_CompactLocked(&pack, packPath);
+        }
+    }
+
+    if (isOpened)
+    {
+        ARUPDATER_PlfPack_Close(&pack);
+    }
+    if (srcFd >= 0)
+    {
+        close(srcFd);
+    }
+    free(buffer);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_Select(const char *const packPath, uint16_t productId, int version, int edition, int extension, int maxVersions, int64_t maxBytes)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+    int index = -1;
+    int i = 0;
+
+    if (packPath == NULL)
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARUPDATER_PlfPack_Open(&pack, packPath, 1, 0);
+
+    if (error == ARUPDATER_OK)
+    {
+        for (i = (int)pack.header->entryCount - 1; (i >= 0) && (index < 0); i--)
+        {
+            ARUPDATER_PlfPack_Entry_t *entry = &pack.entries[i];
+            if ((entry->productId == productId) && (entry->state == ARUPDATER_PLF_PACK_STATE_RETAINED) &&
+                (entry->version == version) && (entry->edition == edition) && (entry->extension == extension))
+            {
+                index = i;
+            }
+        }
+        if (index < 0)
+        {
+            error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+        }
+    }
+
+    // until the current plf is retained, the newest of the two current entries stays the current plf
+    if (error == ARUPDATER_OK)
+    {
+        pack.entries[index].state = ARUPDATER_PLF_PACK_STATE_CURRENT;
+        error = ARUPDATER_PlfPack_Sync(&pack);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        for (i = 0; i < (int)pack.header->entryCount; i++)
+        {
+            if ((i != index) && (pack.entries[i].productId == productId) && (pack.entries[i].state == ARUPDATER_PLF_PACK_STATE_CURRENT))
+            {
+                pack.entries[i].state = ARUPDATER_PLF_PACK_STATE_RETAINED;
+            }
+        }
+        // as ARUPDATER_Versions_Select (), the retained versions are only pruned when a limit is given
+        if (maxVersions > 0)
+        {
+            ARUPDATER_PlfPack_Prune(&pack, productId, maxVersions, maxBytes);
+        }
+        error = ARUPDATER_PlfPack_Sync(&pack);
+    }
+
+    ARUPDATER_PlfPack_Close(&pack);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfPack_Compact(const char *const packPath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_PlfPack_t pack;
+
+    if (packPath == NULL)
+    {
+        return ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    error = ARUPDATER_PlfPack_Open(&pack, packPath, 1, 0);
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfPack_CompactLocked(&pack, packPath);
+    }
+
+    ARUPDATER_PlfPack_Close(&pack);
+
+    return error;
+}
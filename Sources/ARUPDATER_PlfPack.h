@@ -0,0 +1,152 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfPack.h
+ * @brief libARUpdater packed plf storage header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_PLF_PACK_PRIVATE_H_
+#define _ARUPDATER_PLF_PACK_PRIVATE_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARUpdater/ARUPDATER_Manager.h>
+
+/**
+ * @brief Name of the pack file in the plf folder
+ */
+#define ARUPDATER_PLF_PACK_FILE_NAME                    "plf.pack"
+
+/**
+ * @brief Size of the index at the beginning of the pack, the plf files are stored after it
+ */
+#define ARUPDATER_PLF_PACK_INDEX_SIZE                   (64 * 1024)
+
+#define ARUPDATER_PLF_PACK_MD5_SIZE                     33
+#define ARUPDATER_PLF_PACK_FILE_NAME_SIZE               63
+
+/**
+ * @brief State of an entry of the pack
+ */
+typedef enum
+{
+    ARUPDATER_PLF_PACK_STATE_DELETED = 0,   /**< the data of the entry is freed by the next compaction */
+    ARUPDATER_PLF_PACK_STATE_CURRENT,       /**< the plf of the product */
+    ARUPDATER_PLF_PACK_STATE_RETAINED,      /**< a previous plf of the product kept for rollback */
+} eARUPDATER_PLF_PACK_STATE;
+
+/**
+ * @brief Entry of the index of the pack
+ * @details The layout is fixed (128 bytes, host byte order), the index is read by mapping it
+ */
+typedef struct
+{
+    uint16_t productId;
+    uint16_t state;
+    int32_t version;
+    int32_t edition;
+    int32_t extension;
+    uint64_t offset;
+    uint64_t size;
+    char md5[ARUPDATER_PLF_PACK_MD5_SIZE];
+    char fileName[ARUPDATER_PLF_PACK_FILE_NAME_SIZE];
+} ARUPDATER_PlfPack_Entry_t;
+
+/**
+ * @brief Get the current plf of a product from the index of the pack
+ * @details Only the index is mapped, nothing is read from the plf folder
+ * @param[in] packPath : the pack file
+ * @param[in] productId : the id of the product
+ * @param[out] entry : the entry of the current plf
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the product has no plf in the pack, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_Find(const char *const packPath, uint16_t productId, ARUPDATER_PlfPack_Entry_t *entry);
+
+/**
+ * @brief Get the versions of a product retained in the pack, the newest first
+ * @details Only the index is mapped, nothing is read from the plf folder
+ * @param[in] packPath : the pack file
+ * @param[in] productId : the id of the product
+ * @param[out] versions : the retained versions. Can be null if maxCount is 0
+ * @param[in] maxCount : the size of versions
+ * @param[out] count : the number of retained versions, which may be greater than maxCount
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_GetRetainedVersions(const char *const packPath, uint16_t productId, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count);
+
+/**
+ * @brief Copy the current plf of a product out of the pack
+ * @param[in] packPath : the pack file
+ * @param[in] productId : the id of the product
+ * @param[in] filePath : the file to create
+ * @param[out] entry : the entry of the extracted plf. Can be null
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the product has no plf in the pack, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_Extract(const char *const packPath, uint16_t productId, const char *const filePath, ARUPDATER_PlfPack_Entry_t *entry);
+
+/**
+ * @brief Append a plf to the pack and make it the current plf of its product
+ * @details The previous plf of the product is retained (or deleted) as ARUPDATER_Versions_Retain () does for the product folders. The pack is compacted once most of it is deleted data
+ * @param[in] packPath : the pack file, created if it does not exist
+ * @param[in] productId : the id of the product
+ * @param[in] filePath : the verified plf file to add
+ * @param[in] fileName : the name of the plf file, given back by the index
+ * @param[in] md5 : the md5 of the plf file as an hexadecimal string
+ * @param[in] maxVersions : the number of previous versions to keep, 0 to delete the previous plf
+ * @param[in] maxBytes : the maximum size of the kept versions, 0 for no limit
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_Add(const char *const packPath, uint16_t productId, const char *const filePath, const char *const fileName, const char *const md5, int maxVersions, int64_t maxBytes);
+
+/**
+ * @brief Make a retained version the current plf of its product
+ * @details The current plf is retained in exchange, then the oldest retained versions are deleted until the retention limits are met, as ARUPDATER_Versions_Select () does for the product folders
+ * @param[in] packPath : the pack file
+ * @param[in] productId : the id of the product
+ * @param[in] version : the version of the retained plf
+ * @param[in] edition : the edition of the retained plf
+ * @param[in] extension : the extension of the retained plf
+ * @param[in] maxVersions : the number of versions to keep once the current plf is retained, 0 to keep them all
+ * @param[in] maxBytes : the maximum size of the kept versions, 0 for no limit
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the version is not retained, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_Select(const char *const packPath, uint16_t productId, int version, int edition, int extension, int maxVersions, int64_t maxBytes);
+
+/**
+ * @brief Rewrite the pack without its deleted entries
+ * @details The compacted pack replaces the previous one atomically, the readers which opened it before keep reading the previous one
+ * @param[in] packPath : the pack file
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfPack_Compact(const char *const packPath);
+
+#endif
@@ -0,0 +1,356 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfStore.c
+ * @brief libARUpdater content-addressed plf store c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#if defined(__linux__)
+#include <linux/fs.h>
+#endif
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_PlfStore.h"
+#include "ARUPDATER_Hash.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_PLF_STORE_TAG                 "ARUPDATER_PlfStore"
+
+#define ARUPDATER_PLF_STORE_MD5_LENGTH          32
+#define ARUPDATER_PLF_STORE_TMP_SUFFIX          ".XXXXXX"
+#define ARUPDATER_PLF_STORE_COPY_BUFFER_SIZE    (64 * 1024)
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+/**
+ * @brief get the path of a plf in the store
+ * @details the md5 comes from the server, it must be a plain hexadecimal string to be used as a file name
+ * @return the newly-allocated path, NULL if the md5 is not valid
+ */
+static char *ARUPDATER_PlfStore_GetPath(const char *const storeFolder, const char *const md5, const char *const suffix)
+{
+    char *path = NULL;
+    int length = 0;
+    int i = 0;
+
+    if ((storeFolder == NULL) || (md5 == NULL) || (strlen(md5) != ARUPDATER_PLF_STORE_MD5_LENGTH))
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < ARUPDATER_PLF_STORE_MD5_LENGTH; i++)
+    {
+        char c = md5[i];
+        if (!(((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'f')) || ((c >= 'A') && (c <= 'F'))))
+        {
+            return NULL;
+        }
+    }
+
+    length = strlen(storeFolder) + 1 + ARUPDATER_PLF_STORE_MD5_LENGTH + strlen(ARUPDATER_PLF_STORE_FILE_EXTENSION) + strlen(suffix) + 1;
+    path = malloc(length);
+    if (path != NULL)
+    {
+        snprintf(path, length, "%s/%s%s%s", storeFolder, md5, ARUPDATER_PLF_STORE_FILE_EXTENSION, suffix);
+    }
+
+    return path;
+}
+
+/**
+ * @brief copy a file into an opened destination, sharing its blocks when the filesystem can do it
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfStore_CopyToFd(const char *const srcPath, int dstFd)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *buffer = NULL;
+    int srcFd = -1;
+    ssize_t readSize = 0;
+
+    srcFd = open(srcPath, O_RDONLY);
+    if (srcFd < 0)
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+#if defined(FICLONE)
+    // reflink on btrfs, xfs...
+    if ((error == ARUPDATER_OK) && (ioctl(dstFd, FICLONE, srcFd) == 0))
+    {
+        close(srcFd);
+        return ARUPDATER_OK;
+    }
+#endif
+
+    if (error == ARUPDATER_OK)
+    {
+        buffer = malloc(ARUPDATER_PLF_STORE_COPY_BUFFER_SIZE);
+        if (buffer == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    while ((error == ARUPDATER_OK) && ((readSize = read(srcFd, buffer, ARUPDATER_PLF_STORE_COPY_BUFFER_SIZE)) != 0))
+    {
+        ssize_t writtenSize = 0;
+
+        if (readSize < 0)
+        {
+            if (errno != EINTR)
+            {
+                error = ARUPDATER_ERROR_SYSTEM;
+            }
+            continue;
+        }
+
+        while ((error == ARUPDATER_OK) && (writtenSize < readSize))
+        {
+            ssize_t ret = write(dstFd, buffer + writtenSize, readSize - writtenSize);
+            if (ret >= 0)
+            {
+                writtenSize += ret;
+            }
+            else if (errno != EINTR)
+            {
+                error = (errno == ENOSPC) ? ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE : ARUPDATER_ERROR_SYSTEM;
+            }
+        }
+    }
+
+    if (buffer != NULL)
+    {
+        free(buffer);
+    }
+    if (srcFd >= 0)
+    {
+        close(srcFd);
+    }
+
+    return error;
+}
+
+/**
+ * @brief link a file, falling back on a clone or a copy when a hardlink can not be made (other filesystem, no hardlink support)
+ */
+static eARUPDATER_ERROR ARUPDATER_PlfStore_LinkOrCopy(const char *const srcPath, const char *const dstPath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int dstFd = -1;
+
+    if (link(srcPath, dstPath) == 0)
+    {
+        return ARUPDATER_OK;
+    }
+
+    if (errno == EEXIST)
+    {
+        return ARUPDATER_ERROR_SYSTEM;
+    }
+
+    dstFd = open(dstPath, O_WRONLY | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (dstFd < 0)
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfStore_CopyToFd(srcPath, dstFd);
+        close(dstFd);
+
+        if (error != ARUPDATER_OK)
+        {
+            unlink(dstPath);
+        }
+    }
+
+    return error;
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+int ARUPDATER_PlfStore_Exists(const char *const storeFolder, const char *const md5)
+{
+    struct stat statbuf;
+    int exists = 0;
+    char *storePath = ARUPDATER_PlfStore_GetPath(storeFolder, md5, "");
+
+    if ((storePath != NULL) && (stat(storePath, &statbuf) == 0) && S_ISREG(statbuf.st_mode))
+    {
+        exists = 1;
+    }
+
+    free(storePath);
+    return exists;
+}
+
+int ARUPDATER_PlfStore_Contains(const char *const storeFolder, const char *const md5)
+{
+    int contains = 0;
+    char *storePath = NULL;
+
+    if (ARUPDATER_PlfStore_Exists(storeFolder, md5))
+    {
+        storePath = ARUPDATER_PlfStore_GetPath(storeFolder, md5, "");
+    }
+
+    if (storePath != NULL)
+    {
+        if (ARUPDATER_Hash_CheckFile(ARUPDATER_HASH_MD5, storePath, md5) == ARUPDATER_OK)
+        {
+            contains = 1;
+        }
+        else
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_PLF_STORE_TAG, "removing corrupted entry %s", storePath);
+            unlink(storePath);
+        }
+
+        free(storePath);
+    }
+
+    return contains;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfStore_Insert(const char *const storeFolder, const char *const md5, const char *const filePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *storePath = NULL;
+    char *tmpPath = NULL;
+    int tmpFd = -1;
+
+    if (filePath == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        storePath = ARUPDATER_PlfStore_GetPath(storeFolder, md5, "");
+        tmpPath = ARUPDATER_PlfStore_GetPath(storeFolder, md5, ARUPDATER_PLF_STORE_TMP_SUFFIX);
+        if ((storePath == NULL) || (tmpPath == NULL))
+        {
+            error = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        mkdir(storeFolder, S_IRWXU);
+
+        // another manager sharing the store may have inserted it in the meantime
+        if ((link(filePath, storePath) == 0) || (errno == EEXIST))
+        {
+            free(storePath);
+            free(tmpPath);
+            return ARUPDATER_OK;
+        }
+
+        // can not link, copy into a temporary file then publish it atomically
+        tmpFd = mkstemp(tmpPath);
+        if (tmpFd < 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfStore_CopyToFd(filePath, tmpFd);
+        close(tmpFd);
+
+        if ((error == ARUPDATER_OK) && (rename(tmpPath, storePath) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+
+        if (error != ARUPDATER_OK)
+        {
+            unlink(tmpPath);
+        }
+    }
+
+    free(storePath);
+    free(tmpPath);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_PlfStore_LinkTo(const char *const storeFolder, const char *const md5, const char *const filePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *storePath = NULL;
+
+    if (filePath == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        storePath = ARUPDATER_PlfStore_GetPath(storeFolder, md5, "");
+        if (storePath == NULL)
+        {
+            error = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfStore_LinkOrCopy(storePath, filePath);
+    }
+
+    free(storePath);
+
+    return error;
+}
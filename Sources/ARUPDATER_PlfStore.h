@@ -0,0 +1,84 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfStore.h
+ * @brief libARUpdater content-addressed plf store header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_PLF_STORE_PRIVATE_H_
+#define _ARUPDATER_PLF_STORE_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Error.h>
+
+/**
+ * @brief Extension of the files of the store, named <md5>.plf
+ */
+#define ARUPDATER_PLF_STORE_FILE_EXTENSION              ".plf"
+
+/**
+ * @brief Tell whether a verified plf with the given md5 is in the store
+ * @details The file is checked against its md5 before being trusted, a corrupted entry is removed from the store
+ * @param[in] storeFolder : the folder of the store
+ * @param[in] md5 : the expected md5 as an hexadecimal string
+ * @return 1 if the plf is in the store, 0 otherwise
+ */
+int ARUPDATER_PlfStore_Contains(const char *const storeFolder, const char *const md5);
+
+/**
+ * @brief Tell whether a file with the given md5 is in the store, without checking its content
+ * @param[in] storeFolder : the folder of the store
+ * @param[in] md5 : the expected md5 as an hexadecimal string
+ * @return 1 if a file is in the store, 0 otherwise
+ */
+int ARUPDATER_PlfStore_Exists(const char *const storeFolder, const char *const md5);
+
+/**
+ * @brief Add a verified plf file to the store
+ * @details The file is hardlinked into the store, or cloned/copied if the store is on another filesystem. Adding a plf already stored is not an error
+ * @param[in] storeFolder : the folder of the store
+ * @param[in] md5 : the md5 of the file as an hexadecimal string
+ * @param[in] filePath : the plf file to add
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfStore_Insert(const char *const storeFolder, const char *const md5, const char *const filePath);
+
+/**
+ * @brief Make a stored plf available at a given path
+ * @details The path is a hardlink on the stored file, or a clone/copy of it if the store is on another filesystem. The path must not exist
+ * @param[in] storeFolder : the folder of the store
+ * @param[in] md5 : the md5 of the stored file as an hexadecimal string
+ * @param[in] filePath : the path to create
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfStore_LinkTo(const char *const storeFolder, const char *const md5, const char *const filePath);
+
+#endif
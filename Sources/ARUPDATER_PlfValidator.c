@@ -0,0 +1,101 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfValidator.c
+ * @brief libARUpdater plf validator c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdlib.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_PlfValidator.h"
+#include "ARUPDATER_Plf.h"
+#include "ARUPDATER_Crc32.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_PLF_VALIDATOR_TAG             "ARUPDATER_PlfValidator"
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+eARUPDATER_ERROR ARUPDATER_PlfValidator_Check(const char *const plfFilePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    plf_file_t plf;
+    plf_section_iterator_t iterator;
+    plf_section_t section;
+    int sectionCount = 0;
+
+    if (plfFilePath == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    // magic, header sizes and p_size are checked when opening
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Plf_Open(plfFilePath, &plf);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Plf_SectionIterator_Init(&iterator, &plf);
+        while ((error == ARUPDATER_OK) && ARUPDATER_Plf_SectionIterator_Next(&iterator, &section, &error))
+        {
+            sectionCount++;
+
+            // the crc of a compressed section is the one of the uncompressed data, it is checked by the device
+            if ((section.header->s_uncomprSize == 0) && (section.header->s_crc32 != 0) &&
+                (ARUPDATER_Crc32_Update(0, section.payload, section.payloadSize) != section.header->s_crc32))
+            {
+                ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_PLF_VALIDATOR_TAG, "%s: bad crc for the section at %zu", plfFilePath, section.offset);
+                error = ARUPDATER_ERROR_PLF_BAD_CRC;
+            }
+        }
+
+        ARUPDATER_Plf_Close(&plf);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_PLF_VALIDATOR_TAG, "%s: %d sections checked", plfFilePath, sectionCount);
+    }
+
+    return error;
+}
@@ -0,0 +1,50 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_PlfValidator.h
+ * @brief libARUpdater plf validator header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_PLF_VALIDATOR_PRIVATE_H_
+#define _ARUPDATER_PLF_VALIDATOR_PRIVATE_H_
+
+#include <libARUpdater/ARUPDATER_Error.h>
+
+/**
+ * @brief check the integrity of a plf file
+ * @details Checks the header (magic number, header sizes, p_size against the file size), that every section is in the file and the CRC32 of the uncompressed sections
+ * @param[in] plfFilePath : path of the plf file
+ * @return ARUPDATER_OK if the file is valid, ARUPDATER_ERROR_PLF_BAD_HEADER, ARUPDATER_ERROR_PLF_BAD_SECTION or ARUPDATER_ERROR_PLF_BAD_CRC if it is corrupted, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_PlfValidator_Check(const char *const plfFilePath);
+
+#endif
@@ -0,0 +1,300 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Sha256.c
+ * @brief libARUpdater SHA-256 c file.
+ * @date 19/10/2026
+ **/
+
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "ARUPDATER_Sha256.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ARUPDATER_SHA256_X86_SHA_NI
+#endif
+
+#define ARUPDATER_SHA256_ROTR(x, n)     (((x) >> (n)) | ((x) << (32 - (n))))
+#define ARUPDATER_SHA256_CH(x, y, z)    ((z) ^ ((x) & ((y) ^ (z))))
+#define ARUPDATER_SHA256_MAJ(x, y, z)   (((x) & (y)) | ((z) & ((x) | (y))))
+#define ARUPDATER_SHA256_S0(x)          (ARUPDATER_SHA256_ROTR((x), 2) ^ ARUPDATER_SHA256_ROTR((x), 13) ^ ARUPDATER_SHA256_ROTR((x), 22))
+#define ARUPDATER_SHA256_S1(x)          (ARUPDATER_SHA256_ROTR((x), 6) ^ ARUPDATER_SHA256_ROTR((x), 11) ^ ARUPDATER_SHA256_ROTR((x), 25))
+#define ARUPDATER_SHA256_G0(x)          (ARUPDATER_SHA256_ROTR((x), 7) ^ ARUPDATER_SHA256_ROTR((x), 18) ^ ((x) >> 3))
+#define ARUPDATER_SHA256_G1(x)          (ARUPDATER_SHA256_ROTR((x), 17) ^ ARUPDATER_SHA256_ROTR((x), 19) ^ ((x) >> 10))
+
+typedef void (*ARUPDATER_Sha256_BlocksFunction_t)(uint32_t state[8], const uint8_t *data, size_t blockCount);
+
+static const uint32_t ARUPDATER_Sha256_K[64] __attribute__((aligned(16))) =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static void ARUPDATER_Sha256_BlocksGeneric(uint32_t state[8], const uint8_t *data, size_t blockCount)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h, t1, t2;
+    int i = 0;
+
+    while (blockCount > 0)
+    {
+        for (i = 0; i < 16; i++)
+        {
+            w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[i * 4 + 1] << 16) | ((uint32_t)data[i * 4 + 2] << 8) | (uint32_t)data[i * 4 + 3];
+        }
+        for (i = 16; i < 64; i++)
+        {
+            w[i] = ARUPDATER_SHA256_G1(w[i - 2]) + w[i - 7] + ARUPDATER_SHA256_G0(w[i - 15]) + w[i - 16];
+        }
+
+        a = state[0];
+        b = state[1];
+        c = state[2];
+        d = state[3];
+        e = state[4];
+        f = state[5];
+        g = state[6];
+        h = state[7];
+
+        for (i = 0; i < 64; i++)
+        {
+            t1 = h + ARUPDATER_SHA256_S1(e) + ARUPDATER_SHA256_CH(e, f, g) + ARUPDATER_Sha256_K[i] + w[i];
+            t2 = ARUPDATER_SHA256_S0(a) + ARUPDATER_SHA256_MAJ(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+
+        data += ARUPDATER_SHA256_BLOCK_SIZE;
+        blockCount--;
+    }
+}
+
+#ifdef ARUPDATER_SHA256_X86_SHA_NI
+__attribute__((target("sha,ssse3,sse4.1")))
+static void ARUPDATER_Sha256_BlocksShaNi(uint32_t state[8], const uint8_t *data, size_t blockCount)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abefSave, cdghSave, msg, tmp;
+    __m128i w[4];
+    int group = 0;
+
+    /* the sha256rnds2 instruction works on the ABEF / CDGH word layout */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)&state[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (blockCount > 0)
+    {
+        abefSave = state0;
+        cdghSave = state1;
+
+        for (group = 0; group < 16; group++)
+        {
+            __m128i *current = &w[group & 3];
+
+            if (group < 4)
+            {
+                *current = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + group * 16)), byteSwap);
+            }
+
+            msg = _mm_add_epi32(*current, _mm_load_si128((const __m128i *)&ARUPDATER_Sha256_K[group * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+
+            if ((group >= 3) && (group <= 14))
+            {
+                __m128i *next = &w[(group + 1) & 3];
+                tmp = _mm_alignr_epi8(*current, w[(group - 1) & 3], 4);
+                *next = _mm_sha256msg2_epu32(_mm_add_epi32(*next, tmp), *current);
+            }
+
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+            if ((group >= 1) && (group <= 12))
+            {
+                w[(group - 1) & 3] = _mm_sha256msg1_epu32(w[(group - 1) & 3], *current);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+
+        data += ARUPDATER_SHA256_BLOCK_SIZE;
+        blockCount--;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+#endif
+
+static ARUPDATER_Sha256_BlocksFunction_t ARUPDATER_Sha256_Blocks = ARUPDATER_Sha256_BlocksGeneric;
+static const char *ARUPDATER_Sha256_ImplementationName = "generic";
+static pthread_once_t ARUPDATER_Sha256_Once = PTHREAD_ONCE_INIT;
+
+static void ARUPDATER_Sha256_SelectImplementation()
+{
+#ifdef ARUPDATER_SHA256_X86_SHA_NI
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1"))
+    {
+        ARUPDATER_Sha256_Blocks = ARUPDATER_Sha256_BlocksShaNi;
+        ARUPDATER_Sha256_ImplementationName = "sha-ni";
+    }
+#endif
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+void ARUPDATER_Sha256_Init(ARUPDATER_Sha256_Context_t *context)
+{
+    pthread_once(&ARUPDATER_Sha256_Once, ARUPDATER_Sha256_SelectImplementation);
+
+    context->state[0] = 0x6a09e667;
+    context->state[1] = 0xbb67ae85;
+    context->state[2] = 0x3c6ef372;
+    context->state[3] = 0xa54ff53a;
+    context->state[4] = 0x510e527f;
+    context->state[5] = 0x9b05688c;
+    context->state[6] = 0x1f83d9ab;
+    context->state[7] = 0x5be0cd19;
+    context->length = 0;
+}
+
+void ARUPDATER_Sha256_Update(ARUPDATER_Sha256_Context_t *context, const uint8_t *data, size_t size)
+{
+    size_t used = (size_t)(context->length % ARUPDATER_SHA256_BLOCK_SIZE);
+
+    context->length += size;
+
+    if (used > 0)
+    {
+        size_t free = ARUPDATER_SHA256_BLOCK_SIZE - used;
+        if (size < free)
+        {
+            memcpy(context->buffer + used, data, size);
+            return;
+        }
+
+        memcpy(context->buffer + used, data, free);
+        ARUPDATER_Sha256_Blocks(context->state, context->buffer, 1);
+        data += free;
+        size -= free;
+    }
+
+    if (size >= ARUPDATER_SHA256_BLOCK_SIZE)
+    {
+        ARUPDATER_Sha256_Blocks(context->state, data, size / ARUPDATER_SHA256_BLOCK_SIZE);
+        data += size & ~(size_t)(ARUPDATER_SHA256_BLOCK_SIZE - 1);
+        size &= ARUPDATER_SHA256_BLOCK_SIZE - 1;
+    }
+
+    memcpy(context->buffer, data, size);
+}
+
+void ARUPDATER_Sha256_Final(ARUPDATER_Sha256_Context_t *context, uint8_t *digest)
+{
+    uint64_t bitLength = context->length * 8;
+    size_t used = (size_t)(context->length % ARUPDATER_SHA256_BLOCK_SIZE);
+    int i = 0;
+
+    context->buffer[used++] = 0x80;
+    if (used > ARUPDATER_SHA256_BLOCK_SIZE - 8)
+    {
+        memset(context->buffer + used, 0, ARUPDATER_SHA256_BLOCK_SIZE - used);
+        ARUPDATER_Sha256_Blocks(context->state, context->buffer, 1);
+        used = 0;
+    }
+    memset(context->buffer + used, 0, ARUPDATER_SHA256_BLOCK_SIZE - 8 - used);
+
+    for (i = 0; i < 8; i++)
+    {
+        context->buffer[ARUPDATER_SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bitLength >> (8 * i));
+    }
+    ARUPDATER_Sha256_Blocks(context->state, context->buffer, 1);
+
+    for (i = 0; i < 32; i++)
+    {
+        digest[i] = (uint8_t)(context->state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+}
+
+const char *ARUPDATER_Sha256_GetImplementationName()
+{
+    pthread_once(&ARUPDATER_Sha256_Once, ARUPDATER_Sha256_SelectImplementation);
+    return ARUPDATER_Sha256_ImplementationName;
+}
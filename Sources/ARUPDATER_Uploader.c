@@ -37,13 +37,26 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
 #include <libARSAL/ARSAL_Print.h>
 #include <libARUtils/ARUtils.h>
 #include <libARSAL/ARSAL_Error.h>
+#include <libARSAL/ARSAL_Thread.h>
 #include "ARUPDATER_Manager.h"
 
 #include "ARUPDATER_Uploader.h"
 #include "ARUPDATER_Utils.h"
+#include "ARUPDATER_PlfValidator.h"
+#include "ARUPDATER_Hash.h"
+#include "ARUPDATER_HashCache.h"
+#include "ARUPDATER_PlfPack.h"
+#include "ARUPDATER_PlfIndex.h"
+#include "ARUPDATER_Dir.h"
 
 /* ***************************************
  *
@@ -51,10 +64,10 @@
  *
  *****************************************/
 #define ARUPDATER_UPLOADER_TAG                   "ARUPDATER_Uploader"
-#define ARUPDATER_UPLOADER_REMOTE_FOLDER         "/"
-#define ARUPDATER_UPLOADER_MD5_FILENAME          "md5_check.md5"
-#define ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX  ".tmp"
-#define ARUPDATER_UPLOADER_CHUNK_SIZE            32
+#define ARUPDATER_UPLOADER_EXTRACTED_FILE_FORMAT "extracted_plf_%d_%p.tmp"
+#define ARUPDATER_UPLOADER_LOCAL_FILE_NAME_SIZE  64
+#define ARUPDATER_UPLOADER_LOCAL_MD5_FORMAT      "md5_check_%d_%p.md5"
+#define ARUPDATER_UPLOADER_LOCAL_TAIL_FORMAT     "remote_tail_%d_%p.tmp"
 /* ***************************************
  *
  *             function implementation :
@@ -118,7 +131,30 @@ eARUPDATER_ERROR ARUPDATER_Uploader_New(ARUPDATER_Manager_t* manager, const char
         uploader->isRunning = 0;
         uploader->isCanceled = 0;
         uploader->isUploadThreadRunning = 0;
-        uploader->isDownloadMd5ThreadRunning = 0;
+        uploader->isUsingFtpManager = 0;
+        
+        uploader->hasDeviceVersion = 0;
+        memset(&uploader->deviceVersion, 0, sizeof(uploader->deviceVersion));
+        
+        uploader->ftpAddress = NULL;
+        uploader->ftpPort = 0;
+        uploader->ftpUsername = NULL;
+        uploader->ftpPassword = NULL;
+        uploader->blockSize = 0;
+        uploader->isZeroCopy = 1;
+        uploader->streamCount = 1;
+        memset(uploader->ftp, 0, sizeof(uploader->ftp));
+        memset(uploader->streams, 0, sizeof(uploader->streams));
+        uploader->activeStreamCount = 0;
+        memset(uploader->idleSessions, 0, sizeof(uploader->idleSessions));
+        uploader->idleSessionCount = 0;
+        uploader->sessionIdleTimeoutMs = ARUPDATER_UPLOADER_DEFAULT_SESSION_IDLE_TIMEOUT_MS;
+        uploader->plfSize = 0;
+        uploader->partialSize = 0;
+        uploader->resumeSize = 0;
+        memset(&uploader->transferStats, 0, sizeof(uploader->transferStats));
+        uploader->verificationSize = ARUPDATER_UPLOADER_DEFAULT_VERIFICATION_SIZE;
+        uploader->verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
         
         uploader->uploadError = ARDATATRANSFER_OK;
                 
@@ -127,6 +163,8 @@ eARUPDATER_ERROR ARUPDATER_Uploader_New(ARUPDATER_Manager_t* manager, const char
         
         uploader->progressCallback = progressCallback;
         uploader->completionCallback = completionCallback;
+
+        uploader->dir = ARUPDATER_Dir_New(uploader->rootFolder, &err);
     }
     
     // create the data transfer manager
@@ -150,6 +188,16 @@ eARUPDATER_ERROR ARUPDATER_Uploader_New(ARUPDATER_Manager_t* manager, const char
         }
     }
     
+    if (err == ARUPDATER_OK)
+    {
+        int resultSys = ARSAL_Mutex_Init(&manager->uploader->progressLock);
+        
+        if (resultSys != 0)
+        {
+            err = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
     /* delete the uploader if an error occurred */
     if (err != ARUPDATER_OK)
     {
@@ -182,8 +230,14 @@ eARUPDATER_ERROR ARUPDATER_Uploader_Delete(ARUPDATER_Manager_t *manager)
             }
             else
             {
+                ARUPDATER_Uploader_EvictIdleSessions(manager, 1);
                 ARSAL_Mutex_Destroy(&manager->uploader->uploadLock);
+                ARSAL_Mutex_Destroy(&manager->uploader->progressLock);
+                ARUPDATER_Dir_Delete(&manager->uploader->dir);
                 free(manager->uploader->rootFolder);
+                free(manager->uploader->ftpAddress);
+                free(manager->uploader->ftpUsername);
+                free(manager->uploader->ftpPassword);
                 
                 ARDATATRANSFER_Manager_Delete(&manager->uploader->dataTransferManager);
                 
@@ -196,338 +250,239 @@ eARUPDATER_ERROR ARUPDATER_Uploader_Delete(ARUPDATER_Manager_t *manager)
     return error;
 }
 
-void* ARUPDATER_Uploader_ThreadRun(void *managerArg)
+eARUPDATER_ERROR ARUPDATER_Uploader_SetDeviceVersion(ARUPDATER_Manager_t *manager, int version, int edition, int extension)
 {
     eARUPDATER_ERROR error = ARUPDATER_OK;
- 
-    ARUPDATER_Manager_t *manager = NULL;
-    if (managerArg != NULL)
-    {
-        manager = (ARUPDATER_Manager_t*)managerArg;
-    }
-    else
-    {
-        error = ARUPDATER_ERROR_BAD_PARAMETER;
-    }
     
-    if ((manager != NULL) && (manager->uploader != NULL))
+    if (manager == NULL)
     {
-        manager->uploader->isRunning = 1;
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    
-    eARDATATRANSFER_ERROR dataTransferError = ARDATATRANSFER_OK;
-
-    char *sourceFileFolder = NULL;
-    char *sourceFilePath = NULL;
-    char *tmpDestFilePath = NULL;
-    char *finalDestFilePath = NULL;
-    char *device = NULL;
-    char *fileName = NULL;
-    char *md5Txt = NULL;
-    char *md5RemotePath = NULL;
-    char *md5LocalPath = NULL;
-    
-    uint16_t productId = ARDISCOVERY_getProductID(manager->uploader->product);
-    device = malloc(ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE);
-    snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
-    
-    sourceFileFolder = malloc(strlen(manager->uploader->rootFolder) + strlen(ARUPDATER_MANAGER_PLF_FOLDER) + strlen(device) + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) + 1);
-    strcpy(sourceFileFolder, manager->uploader->rootFolder);
-    strcat(sourceFileFolder, ARUPDATER_MANAGER_PLF_FOLDER);
-    strcat(sourceFileFolder, device);
-    strcat(sourceFileFolder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
-    
-    fileName = NULL;
-    error = ARUPDATER_Utils_GetPlfInFolder(sourceFileFolder, &fileName);
-    
-    if (error == ARUPDATER_OK)
+    else if (manager->uploader == NULL)
     {
-        tmpDestFilePath = malloc(strlen(ARUPDATER_UPLOADER_REMOTE_FOLDER) + strlen(fileName) + strlen(ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX) + 1);
-        strcpy(tmpDestFilePath, ARUPDATER_UPLOADER_REMOTE_FOLDER);
-        strcat(tmpDestFilePath, fileName);
-        strcat(tmpDestFilePath, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX);
-        
-        finalDestFilePath = malloc(strlen(ARUPDATER_UPLOADER_REMOTE_FOLDER) + strlen(fileName) + 1);
-        strcpy(finalDestFilePath, ARUPDATER_UPLOADER_REMOTE_FOLDER);
-        strcat(finalDestFilePath, fileName);
-        
-        sourceFilePath = malloc(strlen(sourceFileFolder) + strlen(fileName) + 1);
-        strcpy(sourceFilePath, sourceFileFolder);
-        strcat(sourceFilePath, fileName);
-        
-        md5LocalPath = malloc(strlen(sourceFileFolder) + strlen(ARUPDATER_UPLOADER_MD5_FILENAME) + 1);
-        strcpy(md5LocalPath, sourceFileFolder);
-        strcat(md5LocalPath, ARUPDATER_UPLOADER_MD5_FILENAME);
-        
-        md5RemotePath = malloc(strlen(ARUPDATER_UPLOADER_REMOTE_FOLDER) + strlen(ARUPDATER_UPLOADER_MD5_FILENAME) + 1);
-        strcpy(md5RemotePath, ARUPDATER_UPLOADER_REMOTE_FOLDER);
-        strcat(md5RemotePath, ARUPDATER_UPLOADER_MD5_FILENAME);
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
     
-    // get md5 of the plf file to upload
     if (error == ARUPDATER_OK)
     {
-        uint8_t *md5 = malloc(ARSAL_MD5_LENGTH);
-        eARSAL_ERROR arsalError = ARSAL_MD5_Manager_Compute(manager->uploader->md5Manager, sourceFilePath, md5, ARSAL_MD5_LENGTH);
-        if (ARSAL_OK == arsalError)
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isRunning != 0)
         {
-            // get md5 in text
-            md5Txt = malloc(ARSAL_MD5_LENGTH * 2 + 1);
-            int i = 0;
-            for (i = 0; i < ARSAL_MD5_LENGTH; i++)
-            {
-                snprintf(&md5Txt[i * 2], 3, "%02x", md5[i]);
-            }
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
         }
         else
         {
-            error = ARUPDATER_ERROR_UPLOADER_ARSAL_ERROR;
+            manager->uploader->deviceVersion.version = version;
+            manager->uploader->deviceVersion.edition = edition;
+            manager->uploader->deviceVersion.extension = extension;
+            manager->uploader->hasDeviceVersion = 1;
         }
-        free(md5);
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     }
     
-    // by default, do not resume an upload
-    eARDATATRANSFER_UPLOADER_RESUME resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
-    
-    // read distant plf md5
-    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-    if (ARUPDATER_OK == error)
-    {
-        dataTransferError = ARDATATRANSFER_Downloader_New(manager->uploader->dataTransferManager, manager->uploader->ftpManager, md5RemotePath, md5LocalPath, NULL, NULL, ARUPDATER_Uploader_CompletionCallback, manager, ARDATATRANSFER_DOWNLOADER_RESUME_FALSE);
-        if (ARDATATRANSFER_OK != dataTransferError)
-        {
-            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-        }
-    }
-    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SetFtpTarget(ARUPDATER_Manager_t *manager, const char *const address, int port, const char *const username, const char *const password)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *ftpAddress = NULL;
+    char *ftpUsername = NULL;
+    char *ftpPassword = NULL;
     
-    if ((ARUPDATER_OK == error) && (manager->uploader->isCanceled == 0))
+    if ((manager == NULL) || (address == NULL) || (port <= 0))
     {
-        manager->uploader->isDownloadMd5ThreadRunning = 1;
-        ARDATATRANSFER_Downloader_ThreadRun(manager->uploader->dataTransferManager);
-        manager->uploader->isDownloadMd5ThreadRunning = 0;
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    
-    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-    if (ARUPDATER_OK == error)
+    else if (manager->uploader == NULL)
     {
-        dataTransferError = ARDATATRANSFER_Downloader_Delete(manager->uploader->dataTransferManager);
-        if (ARDATATRANSFER_OK != dataTransferError)
-        {
-            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-        }
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
-    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     
-    // check if an upload was in progress
-    if (ARUPDATER_OK == error)
+    if (error == ARUPDATER_OK)
     {
-        // an upload should be resumed if and only if the md5 file is present and the md5 in file match with the plf file md5
-        FILE *md5File = fopen(md5LocalPath, "rb");
-        if (md5File != NULL)
+        ftpAddress = strdup(address);
+        ftpUsername = strdup((username != NULL) ? username : "");
+        ftpPassword = strdup((password != NULL) ? password : "");
+        if ((ftpAddress == NULL) || (ftpUsername == NULL) || (ftpPassword == NULL))
         {
-            int size = 0;
-            char line[ARUPDATER_UPLOADER_CHUNK_SIZE];
-            int allocatedSize = 1;
-            char *uploadedMD5 = malloc(allocatedSize);
-            strcpy(uploadedMD5, "");
-            while ((size = fread(line, 1, ARUPDATER_UPLOADER_CHUNK_SIZE, md5File)) != 0)
-            {
-                allocatedSize += size;
-                uploadedMD5 = realloc(uploadedMD5, allocatedSize + 1);
-                strncat(uploadedMD5, line, size);
-                uploadedMD5[allocatedSize] = '\0';
-            }
-            fclose(md5File);
-            md5File = NULL;
-            
-            // md5s match, so we can resume the upload
-            if (strcmp(md5Txt, uploadedMD5) == 0)
-            {
-                resumeMode = ARDATATRANSFER_UPLOADER_RESUME_TRUE;
-            } // ELSE md5s don't match, so keep the default value of resumeMode (=> begin a new upload)
-            
-            free(uploadedMD5);
-            uploadedMD5 = NULL;
-            
-            // delete the md5LocalPath file
-            unlink(md5LocalPath);
+            error = ARUPDATER_ERROR_ALLOC;
         }
     }
     
-    // store in md5LocalPath the md5 of the file that will be uploaded if the upload is a new one
-    if ((ARUPDATER_OK == error) && (resumeMode == ARDATATRANSFER_UPLOADER_RESUME_FALSE))
+    if (error == ARUPDATER_OK)
     {
-        FILE *md5File = fopen(md5LocalPath, "wb");
-        if (md5File != NULL && md5Txt != NULL)
-        {
-            fprintf(md5File, "%s", md5Txt);
-            fclose(md5File);
-        }
-        else
-        {
-            error = ARUPDATER_ERROR_UPLOADER;
-        }
-        
-        // create an uploader to upload the md5 file
         ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-        if (ARUPDATER_OK == error)
-        {
-            dataTransferError = ARDATATRANSFER_Uploader_New(manager->uploader->dataTransferManager, manager->uploader->ftpManager, md5RemotePath, md5LocalPath, NULL, NULL, ARUPDATER_Uploader_CompletionCallback, manager, ARDATATRANSFER_UPLOADER_RESUME_FALSE);
-            if (ARDATATRANSFER_OK != dataTransferError)
-            {
-                error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-            }
-        }
-        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
-        
-        
-        if ((ARUPDATER_OK == error) && (manager->uploader->isCanceled == 0))
+        if (manager->uploader->isRunning != 0)
         {
-            manager->uploader->isUploadThreadRunning = 1;
-            ARDATATRANSFER_Uploader_ThreadRun(manager->uploader->dataTransferManager);
-            manager->uploader->isUploadThreadRunning = 0;
-            if (manager->uploader->uploadError != ARDATATRANSFER_OK)
-            {
-                error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-            }
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
         }
-        
-        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-        if (ARUPDATER_OK == error)
+        else
         {
-            dataTransferError = ARDATATRANSFER_Uploader_Delete(manager->uploader->dataTransferManager);
-            if (ARDATATRANSFER_OK != dataTransferError)
-            {
-                error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-            }
+            free(manager->uploader->ftpAddress);
+            free(manager->uploader->ftpUsername);
+            free(manager->uploader->ftpPassword);
+            manager->uploader->ftpAddress = ftpAddress;
+            manager->uploader->ftpPort = port;
+            manager->uploader->ftpUsername = ftpUsername;
+            manager->uploader->ftpPassword = ftpPassword;
+            ftpAddress = NULL;
+            ftpUsername = NULL;
+            ftpPassword = NULL;
         }
         ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
-        
-        if (ARUPDATER_OK == error)
-        {
-            unlink(md5LocalPath);
-        }
     }
     
-    if (md5Txt != NULL)
-    {
-        free(md5Txt);
-        md5Txt = NULL;
-    }
+    free(ftpAddress);
+    free(ftpUsername);
+    free(ftpPassword);
     
-    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-    // create a new uploader
-    if (ARUPDATER_OK == error)
+    // the idle sessions are logged in on the previous target
+    if (error == ARUPDATER_OK)
     {
-        dataTransferError = ARDATATRANSFER_Uploader_New(manager->uploader->dataTransferManager, manager->uploader->ftpManager, tmpDestFilePath, sourceFilePath, ARUPDATER_Uploader_ProgressCallback, manager, ARUPDATER_Uploader_CompletionCallback, manager, resumeMode);
-        if (ARDATATRANSFER_OK != dataTransferError)
-        {
-            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-        }
+        ARUPDATER_Uploader_EvictIdleSessions(manager, 1);
     }
-    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SetBlockSize(ARUPDATER_Manager_t *manager, int blockSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
     
-    if ((ARUPDATER_OK == error) && (manager->uploader->isCanceled == 0))
+    if ((manager == NULL) || (blockSize < 0))
     {
-        manager->uploader->isUploadThreadRunning = 1;
-        ARDATATRANSFER_Uploader_ThreadRun(manager->uploader->dataTransferManager);
-        manager->uploader->isUploadThreadRunning = 0;
-        if (manager->uploader->uploadError != ARDATATRANSFER_OK)
-        {
-            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
-        }
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    
-    // rename the plf file if the operation went well
-    if ((ARUPDATER_OK == error) && (manager->uploader->isCanceled == 0))
+    else if (manager->uploader == NULL)
     {
-        ARDATATRANSFER_Uploader_Rename(manager->uploader->dataTransferManager, tmpDestFilePath, finalDestFilePath);
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
     
-    
-    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-    if (ARUPDATER_OK == error)
+    if (error == ARUPDATER_OK)
     {
-        dataTransferError = ARDATATRANSFER_Uploader_Delete(manager->uploader->dataTransferManager);
-        if (ARDATATRANSFER_OK != dataTransferError)
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isRunning != 0)
         {
-            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
         }
+        else
+        {
+            manager->uploader->blockSize = blockSize;
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     }
-    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     
-    if (error != ARUPDATER_OK)
-    {
-        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "error: %s", ARUPDATER_Error_ToString (error));
-    }
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SetZeroCopy(ARUPDATER_Manager_t *manager, int isZeroCopy)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
     
-    if (sourceFileFolder != NULL)
-    {
-        free(sourceFileFolder);
-    }
-    if (md5LocalPath != NULL)
+    if (manager == NULL)
     {
-        free(md5LocalPath);
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    if (md5RemotePath != NULL)
+    else if (manager->uploader == NULL)
     {
-        free(md5RemotePath);
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
-    if (sourceFilePath != NULL)
+    
+    if (error == ARUPDATER_OK)
     {
-        free(sourceFilePath);
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isRunning != 0)
+        {
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
+        }
+        else
+        {
+            manager->uploader->isZeroCopy = (isZeroCopy != 0);
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     }
-    if (device != NULL)
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SetStreamCount(ARUPDATER_Manager_t *manager, int streamCount)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (streamCount < 1) || (streamCount > ARUPDATER_UPLOADER_MAX_STREAMS))
     {
-        free(device);
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    if (fileName != NULL)
+    else if (manager->uploader == NULL)
     {
-        free(fileName);
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
-    if (tmpDestFilePath != NULL)
+    
+    if (error == ARUPDATER_OK)
     {
-        free(tmpDestFilePath);
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isRunning != 0)
+        {
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
+        }
+        else
+        {
+            manager->uploader->streamCount = streamCount;
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
     }
-    if (finalDestFilePath != NULL)
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SetSessionIdleTimeout(ARUPDATER_Manager_t *manager, int timeoutMs)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (timeoutMs < 0))
     {
-        free(finalDestFilePath);
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    
-    if ((manager != NULL) && (manager->uploader != NULL))
+    else if (manager->uploader == NULL)
     {
-        manager->uploader->isRunning = 0;
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
     
-    if (manager->uploader->completionCallback != NULL)
+    if (error == ARUPDATER_OK)
     {
-        manager->uploader->completionCallback(manager->uploader->completionArg, error);
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        manager->uploader->sessionIdleTimeoutMs = timeoutMs;
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+        
+        ARUPDATER_Uploader_EvictIdleSessions(manager, (timeoutMs == 0));
     }
     
-    return (void*)error;
+    return error;
 }
 
-void ARUPDATER_Uploader_ProgressCallback(void* arg, float percent)
+eARUPDATER_ERROR ARUPDATER_Uploader_CloseIdleSessions(ARUPDATER_Manager_t *manager)
 {
-    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)arg;
-    if (manager->uploader->progressCallback != NULL)
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if (manager == NULL)
     {
-        manager->uploader->progressCallback(manager->uploader->progressArg, percent);
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-}
-
-void ARUPDATER_Uploader_CompletionCallback(void* arg, eARDATATRANSFER_ERROR error)
-{
-    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)arg;
-    if (manager->uploader != NULL)
+    else if (manager->uploader == NULL)
     {
-        manager->uploader->uploadError = error;
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Uploader_EvictIdleSessions(manager, 0);
     }
+    
+    return error;
 }
 
-eARUPDATER_ERROR ARUPDATER_Uploader_CancelThread(ARUPDATER_Manager_t *manager)
+eARUPDATER_ERROR ARUPDATER_Uploader_SetVerificationSize(ARUPDATER_Manager_t *manager, int64_t verificationSize)
 {
     eARUPDATER_ERROR error = ARUPDATER_OK;
     
@@ -535,29 +490,1486 @@ eARUPDATER_ERROR ARUPDATER_Uploader_CancelThread(ARUPDATER_Manager_t *manager)
     {
         error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
-    
-    if ((error == ARUPDATER_OK) && (manager->uploader == NULL))
+    else if (manager->uploader == NULL)
     {
         error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
     }
     
     if (error == ARUPDATER_OK)
     {
-        manager->uploader->isCanceled = 1;
-        
         ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
-        if (manager->uploader->isDownloadMd5ThreadRunning == 1)
+        if (manager->uploader->isRunning != 0)
         {
-            ARDATATRANSFER_Downloader_CancelThread(manager->uploader->dataTransferManager);
+            error = ARUPDATER_ERROR_THREAD_PROCESSING;
         }
-        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
-        
+        else
+        {
+            manager->uploader->verificationSize = verificationSize;
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_GetVerification(ARUPDATER_Manager_t *manager, eARUPDATER_UPLOADER_VERIFICATION *verification)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (verification == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (manager->uploader == NULL)
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        *verification = manager->uploader->verification;
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_GetTransferStats(ARUPDATER_Manager_t *manager, ARUPDATER_Uploader_TransferStats_t *stats)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((manager == NULL) || (stats == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    else if (manager->uploader == NULL)
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        *stats = manager->uploader->transferStats;
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    }
+    
+    return error;
+}
+
+void* ARUPDATER_Uploader_ThreadRun(void *managerArg)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+ 
+    ARUPDATER_Manager_t *manager = NULL;
+    if (managerArg != NULL)
+    {
+        manager = (ARUPDATER_Manager_t*)managerArg;
+    }
+    else
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((manager != NULL) && (manager->uploader != NULL))
+    {
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        manager->uploader->isRunning = 1;
+        manager->uploader->verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    }
+    
+    eARDATATRANSFER_ERROR dataTransferError = ARDATATRANSFER_OK;
+    eARUPDATER_UPLOADER_VERIFICATION verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
+    int isDataTransferUploaderCreated = 0;
+
+    char *sourceFileFolder = NULL;
+    char *sourceFilePath = NULL;
+    char *tmpDestFilePath = NULL;
+    char *finalDestFilePath = NULL;
+    char device[ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE];
+    int productFd = -1;
+    char *fileName = NULL;
+    char *md5Txt = NULL;
+    char *md5RemotePath = NULL;
+    char *md5LocalPath = NULL;
+    char *packPath = NULL;
+    char extractedFileName[ARUPDATER_UPLOADER_LOCAL_FILE_NAME_SIZE];
+    char md5LocalFileName[ARUPDATER_UPLOADER_LOCAL_FILE_NAME_SIZE];
+    ARUPDATER_PlfPack_Entry_t packEntry;
+    
+    uint16_t productId = ARDISCOVERY_getProductID(manager->uploader->product);
+    snprintf(device, ARUPDATER_MANAGER_DEVICE_STRING_MAX_SIZE, "%04x", productId);
+    
+    // the plf validator, the hash cache and ARDataTransfer still take paths
+    sourceFileFolder = ARUPDATER_Manager_GetProductFolderPath(manager->uploader->rootFolder, productId);
+    if (sourceFileFolder == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    
+    // the product folder receives the extracted plf of a pack
+    if (error == ARUPDATER_OK)
+    {
+        productFd = ARUPDATER_Dir_OpenProductFolder(manager->uploader->dir, productId, (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK), &error);
+        if (error != ARUPDATER_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "the folder of %s can not be opened", device);
+        }
+    }
+
+    fileName = NULL;
+    if ((error == ARUPDATER_OK) && (manager->plfStorage == ARUPDATER_MANAGER_PLF_STORAGE_PACK))
+    {
+        packPath = ARUPDATER_Manager_GetPlfPackPath(manager->uploader->rootFolder);
+        if (packPath == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    // nothing is extracted, hashed nor sent when the device already runs the local plf
+    if ((error == ARUPDATER_OK) && (manager->uploader->hasDeviceVersion != 0))
+    {
+        if (ARUPDATER_Uploader_DeviceIsUpToDate(manager, productFd, packPath, &error) != 0)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ALREADY_UP_TO_DATE;
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (packPath != NULL))
+    {
+        // the plf is sent from a temporary file of the product folder, extracted under the lock of the pack
+        // its name is unique, several uploaders of a fleet may send the plf of the same product at once
+        snprintf(extractedFileName, sizeof(extractedFileName), ARUPDATER_UPLOADER_EXTRACTED_FILE_FORMAT, (int)getpid(), (void *)manager->uploader);
+        sourceFilePath = ARUPDATER_Utils_BuildPath(sourceFileFolder, extractedFileName, NULL);
+        if (sourceFilePath == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        else
+        {
+            error = ARUPDATER_PlfPack_Extract(packPath, productId, sourceFilePath, &packEntry);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            fileName = strdup(packEntry.fileName);
+            if (fileName == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+            }
+        }
+    }
+    else if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Utils_GetPlfInFolderAt(productFd, &fileName);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        tmpDestFilePath = ARUPDATER_Utils_BuildPath(ARUPDATER_UPLOADER_REMOTE_FOLDER, fileName, ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX, NULL);
+        finalDestFilePath = ARUPDATER_Utils_BuildPath(ARUPDATER_UPLOADER_REMOTE_FOLDER, fileName, NULL);
+        
+        if (sourceFilePath == NULL)
+        {
+            sourceFilePath = ARUPDATER_Utils_BuildPath(sourceFileFolder, fileName, NULL);
+        }
+        
+        // the local md5 file is not shared with the other uploaders of the product
+        snprintf(md5LocalFileName, sizeof(md5LocalFileName), ARUPDATER_UPLOADER_LOCAL_MD5_FORMAT, (int)getpid(), (void *)manager->uploader);
+        md5LocalPath = ARUPDATER_Utils_BuildPath(sourceFileFolder, md5LocalFileName, NULL);
+        md5RemotePath = ARUPDATER_Utils_BuildPath(ARUPDATER_UPLOADER_REMOTE_FOLDER, ARUPDATER_UPLOADER_MD5_FILENAME, NULL);
+        
+        if ((tmpDestFilePath == NULL) || (finalDestFilePath == NULL) || (sourceFilePath == NULL) || (md5LocalPath == NULL) || (md5RemotePath == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    
+    // do not send a corrupted plf over the slow link
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_PlfValidator_Check(sourceFilePath);
+    }
+    
+    // get md5 of the plf file to upload, the pack gives the one checked by the downloader
+    if ((error == ARUPDATER_OK) && (packPath != NULL))
+    {
+        md5Txt = strdup(packEntry.md5);
+        if (md5Txt == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+    else if (error == ARUPDATER_OK)
+    {
+        // the downloader and the previous uploads keep the md5 of the plf files in the hash cache
+        char *hashCachePath = ARUPDATER_Utils_BuildPath(manager->uploader->rootFolder, ARUPDATER_MANAGER_PLF_FOLDER, ARUPDATER_HASH_CACHE_FILE_NAME, NULL);
+        md5Txt = malloc(ARUPDATER_HASH_CACHE_HEX_SIZE);
+        if ((hashCachePath != NULL) && (md5Txt != NULL))
+        {
+            error = ARUPDATER_HashCache_ComputeFile(hashCachePath, ARUPDATER_HASH_MD5, sourceFilePath, md5Txt);
+        }
+        else
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        free(hashCachePath);
+    }
+    
+    // by default, do not resume an upload
+    eARDATATRANSFER_UPLOADER_RESUME resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
+    
+    // the ftp client of the library negotiates the resume on the session which sends the plf
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress != NULL) && (manager->uploader->isCanceled == 0))
+    {
+        error = ARUPDATER_Uploader_NegotiateResumeOnSession(manager, productFd, md5LocalPath, md5RemotePath, tmpDestFilePath, md5Txt, &resumeMode);
+    }
+    
+    // negotiate the resume on the ftp connection of the manager, the plf uploader is the only transfer object
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress == NULL) && (manager->uploader->isCanceled == 0))
+    {
+        manager->uploader->isUsingFtpManager = 1;
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    if ((ARUPDATER_OK == error) && (manager->uploader->isUsingFtpManager == 1))
+    {
+        error = ARUPDATER_Uploader_NegotiateResume(manager, productFd, md5LocalPath, md5RemotePath, tmpDestFilePath, md5Txt, &resumeMode);
+    }
+    
+    // ARDataTransfer resumes from the end of the partial plf, which has to match
+    if ((ARUPDATER_OK == error) && (manager->uploader->isUsingFtpManager == 1) && (resumeMode == ARDATATRANSFER_UPLOADER_RESUME_TRUE))
+    {
+        error = ARUPDATER_Uploader_VerifyPartialPlfWithArutils(manager, productFd, sourceFileFolder, sourceFilePath, tmpDestFilePath, &resumeMode);
+    }
+    
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    manager->uploader->isUsingFtpManager = 0;
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    // the ftp client of the library sends, checks and renames the plf itself
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress != NULL) && (manager->uploader->isCanceled == 0))
+    {
+        error = ARUPDATER_Uploader_SendPlf(manager, sourceFilePath, tmpDestFilePath, finalDestFilePath, md5RemotePath, md5Txt, resumeMode);
+    }
+    
+    // the session of the negotiation is still open if the plf has not been sent
+    if (manager->uploader->ftp[0] != NULL)
+    {
+        ARUPDATER_Uploader_CloseSession(manager, 0, error);
+    }
+    
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    // create a new uploader
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress == NULL))
+    {
+        dataTransferError = ARDATATRANSFER_Uploader_New(manager->uploader->dataTransferManager, manager->uploader->ftpManager, tmpDestFilePath, sourceFilePath, ARUPDATER_Uploader_ProgressCallback, manager, ARUPDATER_Uploader_CompletionCallback, manager, resumeMode);
+        if (ARDATATRANSFER_OK != dataTransferError)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
+        }
+        else
+        {
+            isDataTransferUploaderCreated = 1;
+        }
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress == NULL) && (manager->uploader->isCanceled == 0))
+    {
+        manager->uploader->isUploadThreadRunning = 1;
+        ARDATATRANSFER_Uploader_ThreadRun(manager->uploader->dataTransferManager);
+        manager->uploader->isUploadThreadRunning = 0;
+        if (manager->uploader->uploadError != ARDATATRANSFER_OK)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
+        }
+    }
+    
+    // check the plf on the device before it gets its final name, on the ftp connection of the manager
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress == NULL) && (manager->uploader->isCanceled == 0) && (manager->uploader->verificationSize >= 0))
+    {
+        manager->uploader->isUsingFtpManager = 1;
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    if ((ARUPDATER_OK == error) && (manager->uploader->isUsingFtpManager == 1))
+    {
+        error = ARUPDATER_Uploader_VerifyPlfWithArutils(manager, productFd, sourceFileFolder, sourceFilePath, tmpDestFilePath, &verification);
+        if ((ARUPDATER_OK == error) && (verification == ARUPDATER_UPLOADER_VERIFICATION_MISMATCH))
+        {
+            // the next upload sends the plf again from its beginning
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "the plf sent does not match the plf on %s, it is removed", device);
+            ARUTILS_Manager_Ftp_Delete(manager->uploader->ftpManager, tmpDestFilePath);
+            error = ARUPDATER_ERROR_UPLOADER_VERIFICATION_FAILED;
+        }
+    }
+    
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    manager->uploader->isUsingFtpManager = 0;
+    if (manager->uploader->ftpAddress == NULL)
+    {
+        manager->uploader->verification = verification;
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    // rename the plf file if the operation went well
+    if ((ARUPDATER_OK == error) && (manager->uploader->ftpAddress == NULL) && (manager->uploader->isCanceled == 0))
+    {
+        dataTransferError = ARDATATRANSFER_Uploader_Rename(manager->uploader->dataTransferManager, tmpDestFilePath, finalDestFilePath);
+        if (ARDATATRANSFER_OK != dataTransferError)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "the plf can not be renamed on %s: %d", device, dataTransferError);
+            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
+        }
+    }
+    
+    // the uploader of ARDataTransfer is deleted after a failure too, so that the next upload can create its own
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    if (isDataTransferUploaderCreated == 1)
+    {
+        dataTransferError = ARDATATRANSFER_Uploader_Delete(manager->uploader->dataTransferManager);
+        if ((ARUPDATER_OK == error) && (ARDATATRANSFER_OK != dataTransferError))
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ARDATATRANSFER_ERROR;
+        }
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    if (error == ARUPDATER_ERROR_UPLOADER_ALREADY_UP_TO_DATE)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_INFO, ARUPDATER_UPLOADER_TAG, "%s already runs the version of the plf, nothing uploaded", device);
+    }
+    else if (error != ARUPDATER_OK)
+    {
+        ARSAL_PRINT (ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "error: %s", ARUPDATER_Error_ToString (error));
+    }
+    
+    if (sourceFileFolder != NULL)
+    {
+        free(sourceFileFolder);
+    }
+    if (md5Txt != NULL)
+    {
+        free(md5Txt);
+    }
+    if (md5LocalPath != NULL)
+    {
+        free(md5LocalPath);
+    }
+    if (md5RemotePath != NULL)
+    {
+        free(md5RemotePath);
+    }
+    if (sourceFilePath != NULL)
+    {
+        if (packPath != NULL)
+        {
+            unlinkat(productFd, extractedFileName, 0);
+        }
+        free(sourceFilePath);
+    }
+    if (packPath != NULL)
+    {
+        free(packPath);
+    }
+    if (productFd >= 0)
+    {
+        close(productFd);
+    }
+    if (fileName != NULL)
+    {
+        free(fileName);
+    }
+    if (tmpDestFilePath != NULL)
+    {
+        free(tmpDestFilePath);
+    }
+    if (finalDestFilePath != NULL)
+    {
+        free(finalDestFilePath);
+    }
+    
+    if ((manager != NULL) && (manager->uploader != NULL))
+    {
+        // the version of the device only applies to this upload, the next one may be to another device
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        manager->uploader->hasDeviceVersion = 0;
+        manager->uploader->isRunning = 0;
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    }
+    
+    if (manager->uploader->completionCallback != NULL)
+    {
+        manager->uploader->completionCallback(manager->uploader->completionArg, error);
+    }
+    
+    return (void*)error;
+}
+
+void ARUPDATER_Uploader_ProgressCallback(void* arg, float percent)
+{
+    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)arg;
+    if (manager->uploader->progressCallback != NULL)
+    {
+        manager->uploader->progressCallback(manager->uploader->progressArg, percent);
+    }
+}
+
+void ARUPDATER_Uploader_CompletionCallback(void* arg, eARDATATRANSFER_ERROR error)
+{
+    ARUPDATER_Manager_t *manager = (ARUPDATER_Manager_t *)arg;
+    if (manager->uploader != NULL)
+    {
+        manager->uploader->uploadError = error;
+    }
+}
+
+void ARUPDATER_Uploader_StreamProgressCallback(void* arg, int64_t sentSize)
+{
+    ARUPDATER_Uploader_Stream_t *stream = (ARUPDATER_Uploader_Stream_t *)arg;
+    ARUPDATER_Uploader_t *uploader = stream->manager->uploader;
+    int64_t uploadedSize = 0;
+    int i = 0;
+    
+    // the streams report one after the other, the progress is the one of the whole plf
+    ARSAL_Mutex_Lock(&uploader->progressLock);
+    stream->sentSize = sentSize;
+    uploadedSize = uploader->resumeSize;
+    for (i = 0; i < uploader->activeStreamCount; i++)
+    {
+        uploadedSize += uploader->streams[i].sentSize;
+    }
+    if ((uploader->progressCallback != NULL) && (uploader->plfSize > 0))
+    {
+        uploader->progressCallback(uploader->progressArg, (float)uploadedSize * 100.f / (float)uploader->plfSize);
+    }
+    ARSAL_Mutex_Unlock(&uploader->progressLock);
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_OpenSession(ARUPDATER_Manager_t *manager, int index)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Ftp_t *ftp = NULL;
+    int isIdle = 0;
+    
+    // the negotiation of the resume leaves the first session open
+    if (manager->uploader->ftp[index] != NULL)
+    {
+        return ARUPDATER_OK;
+    }
+    
+    ARUPDATER_Uploader_EvictIdleSessions(manager, 0);
+    
+    ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+    if (manager->uploader->idleSessionCount > 0)
+    {
+        manager->uploader->idleSessionCount--;
+        ftp = manager->uploader->idleSessions[manager->uploader->idleSessionCount].ftp;
+        manager->uploader->idleSessions[manager->uploader->idleSessionCount].ftp = NULL;
+        isIdle = 1;
+    }
+    ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+    
+    if (ftp == NULL)
+    {
+        ftp = ARUPDATER_Ftp_New(manager->uploader->ftpAddress, manager->uploader->ftpPort, manager->uploader->ftpUsername, manager->uploader->ftpPassword, &error);
+    }
+    
+    // the session is canceled by ARUPDATER_Uploader_CancelThread from now on
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isCanceled != 0)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+        }
+        else
+        {
+            manager->uploader->ftp[index] = ftp;
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+        
+        if (error != ARUPDATER_OK)
+        {
+            ARUPDATER_Ftp_Delete(&ftp);
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (isIdle == 1))
+    {
+        // the server may have closed the session while it was idle, the next idle session or a new one is used then
+        error = ARUPDATER_Ftp_Noop(ftp);
+        if (error == ARUPDATER_ERROR_UPLOADER_TRANSFER)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_UPLOADER_TAG, "an idle session has been closed by the device");
+            ARUPDATER_Uploader_CloseSession(manager, index, error);
+            error = ARUPDATER_Uploader_OpenSession(manager, index);
+        }
+    }
+    else if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Ftp_Connect(ftp);
+    }
+    
+    return error;
+}
+
+void ARUPDATER_Uploader_CloseSession(ARUPDATER_Manager_t *manager, int index, eARUPDATER_ERROR lastError)
+{
+    ARUPDATER_Uploader_t *uploader = manager->uploader;
+    ARUPDATER_Ftp_t *ftp = NULL;
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    ARSAL_Mutex_Lock(&uploader->uploadLock);
+    ftp = uploader->ftp[index];
+    uploader->ftp[index] = NULL;
+    
+    // a failed transfer may leave a reply or a data connection behind, a canceled session is shut down
+    if ((ftp != NULL) && (lastError != ARUPDATER_ERROR_UPLOADER_TRANSFER) && (lastError != ARUPDATER_ERROR_UPLOADER_CANCELED) && (ftp->controlFd >= 0) && (ftp->isCanceled == 0) &&
+        (uploader->isCanceled == 0) && (uploader->sessionIdleTimeoutMs > 0) && (uploader->idleSessionCount < ARUPDATER_UPLOADER_MAX_STREAMS))
+    {
+        uploader->idleSessions[uploader->idleSessionCount].ftp = ftp;
+        uploader->idleSessions[uploader->idleSessionCount].idleSinceUs = (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+        uploader->idleSessionCount++;
+        ftp = NULL;
+    }
+    ARSAL_Mutex_Unlock(&uploader->uploadLock);
+    
+    ARUPDATER_Ftp_Delete(&ftp);
+}
+
+void ARUPDATER_Uploader_EvictIdleSessions(ARUPDATER_Manager_t *manager, int isAll)
+{
+    ARUPDATER_Uploader_t *uploader = manager->uploader;
+    ARUPDATER_Ftp_t *evicted[ARUPDATER_UPLOADER_MAX_STREAMS];
+    int evictedCount = 0;
+    struct timespec now;
+    int64_t oldestUs = 0;
+    int i = 0;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    // the sessions are closed out of the lock, QUIT waits for the server
+    ARSAL_Mutex_Lock(&uploader->uploadLock);
+    oldestUs = (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000 - (int64_t)uploader->sessionIdleTimeoutMs * 1000;
+    while ((evictedCount < uploader->idleSessionCount) && ((isAll == 1) || (uploader->idleSessions[evictedCount].idleSinceUs <= oldestUs)))
+    {
+        evicted[evictedCount] = uploader->idleSessions[evictedCount].ftp;
+        evictedCount++;
+    }
+    uploader->idleSessionCount -= evictedCount;
+    memmove(&uploader->idleSessions[0], &uploader->idleSessions[evictedCount], uploader->idleSessionCount * sizeof(uploader->idleSessions[0]));
+    ARSAL_Mutex_Unlock(&uploader->uploadLock);
+    
+    for (i = 0; i < evictedCount; i++)
+    {
+        ARUPDATER_Ftp_Delete(&evicted[i]);
+    }
+}
+
+void* ARUPDATER_Uploader_StreamRun(void *streamArg)
+{
+    ARUPDATER_Uploader_Stream_t *stream = (ARUPDATER_Uploader_Stream_t *)streamArg;
+    ARUPDATER_Manager_t *manager = stream->manager;
+    int isOwningSession = (manager->uploader->ftp[stream->index] == NULL);
+    
+    stream->error = ARUPDATER_OK;
+    if (isOwningSession)
+    {
+        stream->error = ARUPDATER_Uploader_OpenSession(manager, stream->index);
+    }
+    
+    if (stream->error == ARUPDATER_OK)
+    {
+        stream->error = ARUPDATER_Ftp_Put(manager->uploader->ftp[stream->index], stream->remotePath, stream->fd, stream->offset, stream->size, stream->isAppend, manager->uploader->blockSize, manager->uploader->isZeroCopy, ARUPDATER_Uploader_StreamProgressCallback, stream, &stream->stats);
+    }
+    
+    if (isOwningSession)
+    {
+        ARUPDATER_Uploader_CloseSession(manager, stream->index, stream->error);
+    }
+    
+    return NULL;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SendStreams(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, int streamCount)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Uploader_t *uploader = manager->uploader;
+    ARSAL_Thread_t threads[ARUPDATER_UPLOADER_MAX_STREAMS];
+    int isThreadCreated[ARUPDATER_UPLOADER_MAX_STREAMS];
+    int64_t remainingSize = uploader->plfSize - uploader->resumeSize;
+    int64_t rangeSize = (remainingSize + streamCount - 1) / streamCount;
+    int i = 0;
+    
+    rangeSize = (rangeSize + ARUPDATER_UPLOADER_STREAM_ALIGNMENT - 1) / ARUPDATER_UPLOADER_STREAM_ALIGNMENT * ARUPDATER_UPLOADER_STREAM_ALIGNMENT;
+    
+    ARSAL_Mutex_Lock(&uploader->progressLock);
+    for (i = 0; i < streamCount; i++)
+    {
+        ARUPDATER_Uploader_Stream_t *stream = &uploader->streams[i];
+        
+        memset(stream, 0, sizeof(*stream));
+        stream->manager = manager;
+        stream->index = i;
+        stream->fd = fd;
+        stream->remotePath = tmpDestFilePath;
+        stream->offset = uploader->resumeSize + i * rangeSize;
+        stream->size = (stream->offset + rangeSize <= uploader->plfSize) ? rangeSize : uploader->plfSize - stream->offset;
+        if (stream->size < 0)
+        {
+            stream->size = 0;
+        }
+        // a single stream goes on from the end of the partial plf, as ARDataTransfer does; the ranges, and the end of a partial plf which does not match, are written at their offset
+        stream->isAppend = ((streamCount == 1) && (stream->offset > 0) && (stream->offset == uploader->partialSize));
+        isThreadCreated[i] = 0;
+    }
+    uploader->activeStreamCount = streamCount;
+    ARSAL_Mutex_Unlock(&uploader->progressLock);
+    
+    // the first range is sent on the session already opened, by the calling thread
+    for (i = 1; i < streamCount; i++)
+    {
+        if (ARSAL_Thread_Create(&threads[i], ARUPDATER_Uploader_StreamRun, &uploader->streams[i]) == 0)
+        {
+            isThreadCreated[i] = 1;
+        }
+        else
+        {
+            uploader->streams[i].error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
+    ARUPDATER_Uploader_StreamRun(&uploader->streams[0]);
+    
+    for (i = 1; i < streamCount; i++)
+    {
+        if (isThreadCreated[i])
+        {
+            ARSAL_Thread_Join(threads[i], NULL);
+            ARSAL_Thread_Destroy(&threads[i]);
+        }
+    }
+    
+    for (i = 0; (i < streamCount) && (error == ARUPDATER_OK); i++)
+    {
+        error = uploader->streams[i].error;
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_SendPlf(ARUPDATER_Manager_t *manager, const char *const sourceFilePath, const char *const tmpDestFilePath, const char *const finalDestFilePath, const char *const md5RemotePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME resumeMode)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Uploader_t *uploader = manager->uploader;
+    eARUPDATER_UPLOADER_VERIFICATION verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
+    ARUPDATER_Uploader_TransferStats_t stats;
+    ARUPDATER_Uploader_TransferStats_t headStats;
+    struct stat statbuf;
+    struct timespec start;
+    struct timespec end;
+    int streamCount = uploader->streamCount;
+    int fd = -1;
+    int i = 0;
+    
+    memset(&stats, 0, sizeof(stats));
+    memset(&headStats, 0, sizeof(headStats));
+    uploader->plfSize = 0;
+    uploader->partialSize = 0;
+    uploader->resumeSize = 0;
+    uploader->activeStreamCount = 0;
+    
+    fd = open(sourceFilePath, O_RDONLY | O_CLOEXEC);
+    if ((fd < 0) || (fstat(fd, &statbuf) != 0))
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+    else
+    {
+        uploader->plfSize = statbuf.st_size;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Uploader_OpenSession(manager, 0);
+    }
+    
+    // the partial plf belongs to the plf according to the md5 negotiation, its end may have been torn by the interruption
+    if ((error == ARUPDATER_OK) && (resumeMode == ARDATATRANSFER_UPLOADER_RESUME_TRUE))
+    {
+        int64_t partialSize = 0;
+        if ((ARUPDATER_Ftp_Size(uploader->ftp[0], tmpDestFilePath, &partialSize) == ARUPDATER_OK) && (partialSize > 0) && (partialSize <= uploader->plfSize))
+        {
+            uploader->partialSize = partialSize;
+            error = ARUPDATER_Uploader_VerifyPartialPlf(manager, fd, tmpDestFilePath, partialSize, &uploader->resumeSize);
+        }
+    }
+    
+    // a stream sends at least ARUPDATER_UPLOADER_MIN_STREAM_SIZE
+    while ((streamCount > 1) && (uploader->plfSize - uploader->resumeSize < (int64_t)streamCount * ARUPDATER_UPLOADER_MIN_STREAM_SIZE))
+    {
+        streamCount--;
+    }
+    
+    // the ranges leave holes in the partial plf until they are all sent, its size does not tell what can be resumed
+    if ((error == ARUPDATER_OK) && (streamCount > 1))
+    {
+        eARUPDATER_ERROR removeError = ARUPDATER_Ftp_Remove(uploader->ftp[0], md5RemotePath);
+        if ((removeError != ARUPDATER_OK) && (removeError != ARUPDATER_ERROR_PLF_FILE_NOT_FOUND))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_UPLOADER_TAG, "the md5 file can not be removed, the plf is sent on one stream");
+            streamCount = 1;
+        }
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    // a server truncates a file stored from its beginning: the first block is sent alone, before the ranges
+    if ((error == ARUPDATER_OK) && (streamCount > 1) && (uploader->resumeSize == 0))
+    {
+        ARSAL_Mutex_Lock(&uploader->progressLock);
+        memset(&uploader->streams[0], 0, sizeof(uploader->streams[0]));
+        uploader->streams[0].manager = manager;
+        uploader->activeStreamCount = 1;
+        ARSAL_Mutex_Unlock(&uploader->progressLock);
+        
+        error = ARUPDATER_Ftp_Put(uploader->ftp[0], tmpDestFilePath, fd, 0, ARUPDATER_UPLOADER_STREAM_ALIGNMENT, 0, uploader->blockSize, uploader->isZeroCopy, ARUPDATER_Uploader_StreamProgressCallback, &uploader->streams[0], &headStats);
+        
+        ARSAL_Mutex_Lock(&uploader->progressLock);
+        uploader->resumeSize = ARUPDATER_UPLOADER_STREAM_ALIGNMENT;
+        uploader->activeStreamCount = 0;
+        ARSAL_Mutex_Unlock(&uploader->progressLock);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Uploader_SendStreams(manager, fd, tmpDestFilePath, streamCount);
+    }
+    
+    if (uploader->activeStreamCount > 0)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        
+        stats = uploader->streams[0].stats;
+        stats.streamCount = uploader->activeStreamCount;
+        stats.sentSize = headStats.sentSize;
+        stats.adaptationCount = headStats.adaptationCount;
+        if (headStats.sentSize > 0)
+        {
+            stats.isZeroCopy &= headStats.isZeroCopy;
+        }
+        for (i = 0; i < uploader->activeStreamCount; i++)
+        {
+            stats.sentSize += uploader->streams[i].stats.sentSize;
+            stats.adaptationCount += uploader->streams[i].stats.adaptationCount;
+            stats.isZeroCopy &= uploader->streams[i].stats.isZeroCopy;
+        }
+        stats.durationUs = (int64_t)(end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+        stats.throughput = (stats.durationUs > 0) ? stats.sentSize * 1000000 / stats.durationUs : 0;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_PRINT(ARSAL_PRINT_INFO, ARUPDATER_UPLOADER_TAG, "%lld bytes sent on %d streams in %lld ms, %lld bytes/s, blocks of %d bytes, send buffer of %d bytes, rtt %d us, %s",
+                    (long long)stats.sentSize, stats.streamCount, (long long)(stats.durationUs / 1000), (long long)stats.throughput, stats.blockSize, stats.socketBufferSize, stats.rttUs,
+                    (stats.isZeroCopy != 0) ? "zero copy" : "copied");
+    }
+    
+    // a plf which does not match is removed, the next upload sends it again from its beginning
+    if ((error == ARUPDATER_OK) && (uploader->verificationSize >= 0))
+    {
+        error = ARUPDATER_Uploader_VerifyPlf(manager, fd, tmpDestFilePath, md5Txt, &verification);
+        if ((error == ARUPDATER_OK) && (verification == ARUPDATER_UPLOADER_VERIFICATION_MISMATCH))
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "the plf sent does not match the plf on the device, it is removed");
+            ARUPDATER_Ftp_Remove(uploader->ftp[0], tmpDestFilePath);
+            error = ARUPDATER_ERROR_UPLOADER_VERIFICATION_FAILED;
+        }
+    }
+    
+    // the rename is the commit of the upload, once every range is on the device and checked
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Ftp_Rename(uploader->ftp[0], tmpDestFilePath, finalDestFilePath);
+    }
+    
+    ARSAL_Mutex_Lock(&uploader->uploadLock);
+    uploader->transferStats = stats;
+    uploader->verification = verification;
+    ARSAL_Mutex_Unlock(&uploader->uploadLock);
+    
+    ARUPDATER_Uploader_CloseSession(manager, 0, error);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    
+    return error;
+}
+
+int ARUPDATER_Uploader_DeviceIsUpToDate(ARUPDATER_Manager_t *manager, int productFd, const char *const packPath, eARUPDATER_ERROR *error)
+{
+    eARUPDATER_ERROR err = ARUPDATER_OK;
+    ARUPDATER_Manager_PlfVersion_t localVersion;
+    ARUPDATER_Manager_PlfVersion_t *deviceVersion = &manager->uploader->deviceVersion;
+    int retVal = 0;
+    
+    // the pack gives the version from its mapped index, the product folder from the plf index
+    if (packPath != NULL)
+    {
+        ARUPDATER_PlfPack_Entry_t entry;
+        
+        err = ARUPDATER_PlfPack_Find(packPath, ARDISCOVERY_getProductID(manager->uploader->product), &entry);
+        if (err == ARUPDATER_OK)
+        {
+            localVersion.version = entry.version;
+            localVersion.edition = entry.edition;
+            localVersion.extension = entry.extension;
+        }
+    }
+    else
+    {
+        err = ARUPDATER_PlfIndex_GetNewestVersionAt(productFd, &localVersion);
+    }
+    
+    // an older local plf is a rollback chosen with ARUPDATER_Manager_SelectRetainedPlfVersion(), it is sent
+    if (err == ARUPDATER_OK)
+    {
+        retVal = ((localVersion.version == deviceVersion->version) && (localVersion.edition == deviceVersion->edition) && (localVersion.extension == deviceVersion->extension));
+    }
+    
+    if (error != NULL)
+    {
+        *error = err;
+    }
+    
+    return retVal;
+}
+
+int64_t ARUPDATER_Uploader_GetTailOffset(int64_t size, int chunkCount)
+{
+    int64_t offset = 0;
+    
+    // the chunk at the end of the file may be incomplete
+    if (size > 0)
+    {
+        offset = ((size - 1) / ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE - (chunkCount - 1)) * ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+    }
+    
+    return (offset > 0) ? offset : 0;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_HashRange(int fd, int64_t offset, int64_t size, uint8_t *digest)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Hash_Context_t context;
+    uint8_t *buffer = malloc(ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE);
+    
+    if (buffer == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Hash_Init(&context, ARUPDATER_HASH_MD5);
+    }
+    
+    while ((error == ARUPDATER_OK) && (size > 0))
+    {
+        size_t length = (size < ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE) ? (size_t)size : ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+        ssize_t readSize = pread(fd, buffer, length, offset);
+        if (readSize <= 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            ARUPDATER_Hash_Update(&context, buffer, readSize);
+            offset += readSize;
+            size -= readSize;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ARUPDATER_Hash_Final(&context, digest);
+    }
+    
+    free(buffer);
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_CheckChunks(int fd, int64_t offset, const uint8_t *remoteData, int64_t size, int64_t *verifiedSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t localDigest[ARUPDATER_MD5_DIGEST_SIZE];
+    uint8_t remoteDigest[ARUPDATER_MD5_DIGEST_SIZE];
+    ARUPDATER_Hash_Context_t context;
+    int64_t checkedSize = 0;
+    int isMatching = 1;
+    
+    *verifiedSize = 0;
+    
+    while ((error == ARUPDATER_OK) && (isMatching == 1) && (checkedSize < size))
+    {
+        int64_t length = (size - checkedSize < ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE) ? size - checkedSize : ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+        
+        error = ARUPDATER_Uploader_HashRange(fd, offset + checkedSize, length, localDigest);
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Hash_Init(&context, ARUPDATER_HASH_MD5);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            ARUPDATER_Hash_Update(&context, remoteData + checkedSize, (size_t)length);
+            ARUPDATER_Hash_Final(&context, remoteDigest);
+            
+            isMatching = (memcmp(localDigest, remoteDigest, sizeof(localDigest)) == 0);
+            if (isMatching)
+            {
+                checkedSize += length;
+                *verifiedSize = checkedSize;
+            }
+        }
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPartialPlf(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, int64_t partialSize, int64_t *resumeSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Ftp_t *ftp = manager->uploader->ftp[0];
+    uint8_t localDigest[ARUPDATER_MD5_DIGEST_SIZE];
+    uint8_t remoteDigest[ARUPDATER_MD5_DIGEST_SIZE];
+    int64_t checkOffset = ARUPDATER_Uploader_GetTailOffset(partialSize, ARUPDATER_UPLOADER_RESUME_CHECKED_CHUNKS);
+    int64_t verifiedSize = 0;
+    int isChecked = 0;
+    
+    // the server hashes the checked part at once, then chunk by chunk only if it does not match
+    if (ARUPDATER_Ftp_HasFeature(ftp, "XMD5"))
+    {
+        error = ARUPDATER_Ftp_Md5(ftp, tmpDestFilePath, checkOffset, partialSize - checkOffset, remoteDigest);
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_HashRange(fd, checkOffset, partialSize - checkOffset, localDigest);
+        }
+        if ((error == ARUPDATER_OK) && (memcmp(localDigest, remoteDigest, sizeof(localDigest)) == 0))
+        {
+            verifiedSize = partialSize - checkOffset;
+        }
+        
+        while ((error == ARUPDATER_OK) && (verifiedSize < partialSize - checkOffset))
+        {
+            int64_t offset = checkOffset + verifiedSize;
+            int64_t length = (partialSize - offset < ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE) ? partialSize - offset : ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+            
+            error = ARUPDATER_Ftp_Md5(ftp, tmpDestFilePath, offset, length, remoteDigest);
+            if (error == ARUPDATER_OK)
+            {
+                error = ARUPDATER_Uploader_HashRange(fd, offset, length, localDigest);
+            }
+            if ((error == ARUPDATER_OK) && (memcmp(localDigest, remoteDigest, sizeof(localDigest)) != 0))
+            {
+                break;
+            }
+            if (error == ARUPDATER_OK)
+            {
+                verifiedSize += length;
+            }
+        }
+        
+        // the part is read if the server fails to hash it
+        isChecked = (error == ARUPDATER_OK);
+        if (error != ARUPDATER_ERROR_UPLOADER_CANCELED)
+        {
+            error = ARUPDATER_OK;
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (isChecked == 0))
+    {
+        int64_t size = partialSize - checkOffset;
+        int64_t readSize = 0;
+        uint8_t *remoteData = malloc((size_t)size);
+        
+        if (remoteData == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Ftp_Get(ftp, tmpDestFilePath, checkOffset, remoteData, size, &readSize);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_CheckChunks(fd, checkOffset, remoteData, readSize, &verifiedSize);
+        }
+        free(remoteData);
+    }
+    
+    // the upload does not depend on the check, a partial plf which can not be checked is sent again
+    if ((error != ARUPDATER_OK) && (error != ARUPDATER_ERROR_UPLOADER_CANCELED))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_UPLOADER_TAG, "the end of the partial plf can not be checked (%s), it is sent again", ARUPDATER_Error_ToString(error));
+        verifiedSize = 0;
+        error = ARUPDATER_OK;
+    }
+    
+    // the chunks before the checked ones are only trusted if the first checked chunk matches
+    *resumeSize = (verifiedSize > 0) ? checkOffset + verifiedSize : 0;
+    
+    if ((error == ARUPDATER_OK) && (*resumeSize < partialSize))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_UPLOADER_TAG, "the partial plf only matches the plf up to %lld bytes of %lld, the upload goes on from there", (long long)*resumeSize, (long long)partialSize);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_ReadTailWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const remotePath, int64_t offset, uint8_t *buffer, int64_t size, int64_t *readSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARUTILS_ERROR utilsError = ARUTILS_OK;
+    char tailFileName[ARUPDATER_UPLOADER_LOCAL_FILE_NAME_SIZE];
+    char *tailFilePath = NULL;
+    int tailFd = -1;
+    
+    *readSize = 0;
+    
+    // the local file is not shared with the other uploaders of the product
+    snprintf(tailFileName, sizeof(tailFileName), ARUPDATER_UPLOADER_LOCAL_TAIL_FORMAT, (int)getpid(), (void *)manager->uploader);
+    tailFilePath = malloc(strlen(productFolder) + strlen(tailFileName) + 1);
+    if (tailFilePath == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    else
+    {
+        strcpy(tailFilePath, productFolder);
+        strcat(tailFilePath, tailFileName);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        tailFd = openat(productFd, tailFileName, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if ((tailFd < 0) || (ftruncate(tailFd, offset) != 0))
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        utilsError = ARUTILS_Manager_Ftp_Get(manager->uploader->ftpManager, remotePath, tailFilePath, NULL, NULL, FTP_RESUME_TRUE);
+        if (utilsError != ARUTILS_OK)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "end of %s not read: %d", remotePath, utilsError);
+            error = ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR;
+        }
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        ssize_t tailSize = pread(tailFd, buffer, (size_t)size, offset);
+        if (tailSize < 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            *readSize = tailSize;
+        }
+    }
+    
+    if (tailFd >= 0)
+    {
+        close(tailFd);
+        unlinkat(productFd, tailFileName, 0);
+    }
+    free(tailFilePath);
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPartialPlfWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const sourceFilePath, const char *const tmpDestFilePath, eARDATATRANSFER_UPLOADER_RESUME *resumeMode)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t *remoteData = NULL;
+    double partialSize = 0;
+    int64_t checkOffset = 0;
+    int64_t size = 0;
+    int64_t readSize = 0;
+    int64_t verifiedSize = 0;
+    int fd = -1;
+    
+    if ((ARUTILS_Manager_Ftp_Size(manager->uploader->ftpManager, tmpDestFilePath, &partialSize) != ARUTILS_OK) || (partialSize <= 0))
+    {
+        *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
+        return ARUPDATER_OK;
+    }
+    checkOffset = ARUPDATER_Uploader_GetTailOffset((int64_t)partialSize, ARUPDATER_UPLOADER_RESUME_CHECKED_CHUNKS);
+    size = (int64_t)partialSize - checkOffset;
+    
+    remoteData = malloc((size_t)size);
+    if (remoteData == NULL)
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Uploader_ReadTailWithArutils(manager, productFd, productFolder, tmpDestFilePath, checkOffset, remoteData, size, &readSize);
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        fd = open(sourceFilePath, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            error = ARUPDATER_Uploader_CheckChunks(fd, checkOffset, remoteData, readSize, &verifiedSize);
+        }
+    }
+    
+    // ARDataTransfer can only append to the partial plf, the plf is sent again unless all the checked chunks match
+    if ((error != ARUPDATER_OK) || (verifiedSize < size))
+    {
+        ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_UPLOADER_TAG, "the end of the partial plf does not match the plf, it is sent again");
+        *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
+    }
+    
+    // the upload does not depend on the check
+    if ((error != ARUPDATER_OK) && (manager->uploader->isCanceled == 0))
+    {
+        error = ARUPDATER_OK;
+    }
+    
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    free(remoteData);
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPlf(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, const char *const md5Txt, eARUPDATER_UPLOADER_VERIFICATION *verification)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Uploader_t *uploader = manager->uploader;
+    ARUPDATER_Ftp_t *ftp = uploader->ftp[0];
+    int64_t plfSize = uploader->plfSize;
+    int64_t remoteSize = -1;
+    
+    *verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
+    
+    // a truncated or a longer plf is found without any transfer
+    error = ARUPDATER_Ftp_Size(ftp, tmpDestFilePath, &remoteSize);
+    if (error == ARUPDATER_OK)
+    {
+        *verification = (remoteSize == plfSize) ? ARUPDATER_UPLOADER_VERIFICATION_SIZE : ARUPDATER_UPLOADER_VERIFICATION_MISMATCH;
+    }
+    
+    // the server hashes the whole plf, nothing is read back
+    if ((error == ARUPDATER_OK) && (*verification == ARUPDATER_UPLOADER_VERIFICATION_SIZE) && (uploader->verificationSize > 0) && (ARUPDATER_Ftp_HasFeature(ftp, "XMD5")))
+    {
+        uint8_t digest[ARUPDATER_MD5_DIGEST_SIZE];
+        char digestTxt[2 * ARUPDATER_MD5_DIGEST_SIZE + 1];
+        
+        if (ARUPDATER_Ftp_Md5(ftp, tmpDestFilePath, 0, plfSize, digest) == ARUPDATER_OK)
+        {
+            ARUPDATER_Hash_ToHex(digest, sizeof(digest), digestTxt);
+            *verification = (strcasecmp(digestTxt, md5Txt) == 0) ? ARUPDATER_UPLOADER_VERIFICATION_FULL : ARUPDATER_UPLOADER_VERIFICATION_MISMATCH;
+        }
+        else if (ftp->isCanceled != 0)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+        }
+    }
+    
+    // chunks spread over the plf are read back: the first and the last ones, the others at regular intervals
+    if ((error == ARUPDATER_OK) && (*verification == ARUPDATER_UPLOADER_VERIFICATION_SIZE) && (uploader->verificationSize > 0) && (plfSize > 0))
+    {
+        int64_t chunkCount = (plfSize + ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE - 1) / ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+        int64_t sampleSize = (uploader->verificationSize < ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE) ? uploader->verificationSize : ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+        int64_t sampleCount = uploader->verificationSize / sampleSize;
+        uint8_t *remoteData = malloc((size_t)sampleSize);
+        int64_t i = 0;
+        
+        if (sampleCount > chunkCount)
+        {
+            sampleCount = chunkCount;
+        }
+        if (remoteData == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        
+        for (i = 0; (error == ARUPDATER_OK) && (*verification != ARUPDATER_UPLOADER_VERIFICATION_MISMATCH) && (i < sampleCount); i++)
+        {
+            int64_t chunk = (sampleCount > 1) ? i * (chunkCount - 1) / (sampleCount - 1) : chunkCount - 1;
+            int64_t offset = chunk * ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE;
+            int64_t size = (plfSize - offset < sampleSize) ? plfSize - offset : sampleSize;
+            int64_t readSize = 0;
+            int64_t verifiedSize = 0;
+            
+            error = ARUPDATER_Ftp_Get(ftp, tmpDestFilePath, offset, remoteData, size, &readSize);
+            if (error == ARUPDATER_OK)
+            {
+                error = ARUPDATER_Uploader_CheckChunks(fd, offset, remoteData, readSize, &verifiedSize);
+            }
+            if ((error == ARUPDATER_OK) && ((readSize != size) || (verifiedSize != size)))
+            {
+                *verification = ARUPDATER_UPLOADER_VERIFICATION_MISMATCH;
+            }
+        }
+        
+        if ((error == ARUPDATER_OK) && (*verification != ARUPDATER_UPLOADER_VERIFICATION_MISMATCH))
+        {
+            *verification = ARUPDATER_UPLOADER_VERIFICATION_SAMPLED;
+        }
+        free(remoteData);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPlfWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const sourceFilePath, const char *const tmpDestFilePath, eARUPDATER_UPLOADER_VERIFICATION *verification)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    uint8_t *remoteData = NULL;
+    struct stat statbuf;
+    double remoteSize = 0;
+    int64_t offset = 0;
+    int64_t size = 0;
+    int64_t readSize = 0;
+    int64_t verifiedSize = 0;
+    int fd = -1;
+    
+    *verification = ARUPDATER_UPLOADER_VERIFICATION_NONE;
+    
+    fd = open(sourceFilePath, O_RDONLY | O_CLOEXEC);
+    if ((fd < 0) || (fstat(fd, &statbuf) != 0))
+    {
+        error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+    }
+    
+    // a truncated or a longer plf is found without any transfer
+    if ((error == ARUPDATER_OK) && (ARUTILS_Manager_Ftp_Size(manager->uploader->ftpManager, tmpDestFilePath, &remoteSize) != ARUTILS_OK))
+    {
+        error = ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR;
+    }
+    if (error == ARUPDATER_OK)
+    {
+        *verification = ((int64_t)remoteSize == (int64_t)statbuf.st_size) ? ARUPDATER_UPLOADER_VERIFICATION_SIZE : ARUPDATER_UPLOADER_VERIFICATION_MISMATCH;
+    }
+    
+    // ARUtils can only read the end of a file without reading it all
+    if ((error == ARUPDATER_OK) && (*verification == ARUPDATER_UPLOADER_VERIFICATION_SIZE) && (manager->uploader->verificationSize > 0) && (statbuf.st_size > 0))
+    {
+        int chunkCount = (int)((manager->uploader->verificationSize + ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE - 1) / ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE);
+        
+        offset = ARUPDATER_Uploader_GetTailOffset(statbuf.st_size, chunkCount);
+        size = statbuf.st_size - offset;
+        remoteData = malloc((size_t)size);
+        if (remoteData == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+        
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_ReadTailWithArutils(manager, productFd, productFolder, tmpDestFilePath, offset, remoteData, size, &readSize);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_CheckChunks(fd, offset, remoteData, readSize, &verifiedSize);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            *verification = ((readSize == size) && (verifiedSize == size)) ? ARUPDATER_UPLOADER_VERIFICATION_SAMPLED : ARUPDATER_UPLOADER_VERIFICATION_MISMATCH;
+        }
+    }
+    
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    free(remoteData);
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_NegotiateResume(ARUPDATER_Manager_t *manager, int productFd, const char *const md5LocalPath, const char *const md5RemotePath, const char *const tmpDestFilePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME *resumeMode)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARUTILS_ERROR utilsError = ARUTILS_OK;
+    uint8_t *uploadedMD5 = NULL;
+    uint32_t uploadedMD5Size = 0;
+    double partialSize = 0;
+    const char *md5LocalFileName = strrchr(md5LocalPath, ARUPDATER_MANAGER_FOLDER_SEPARATOR[0]) + 1;
+    
+    *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
+    
+    // an upload should be resumed if and only if a part of the plf has been sent and the remote md5 matches the plf file md5
+    // the size is asked first: without partial plf, the md5 is not read
+    if ((ARUTILS_Manager_Ftp_Size(manager->uploader->ftpManager, tmpDestFilePath, &partialSize) == ARUTILS_OK) && (partialSize > 0))
+    {
+        utilsError = ARUTILS_Manager_Ftp_Get_WithBuffer(manager->uploader->ftpManager, md5RemotePath, &uploadedMD5, &uploadedMD5Size, NULL, NULL);
+        if ((utilsError == ARUTILS_OK) && (uploadedMD5 != NULL) && (uploadedMD5Size == strlen(md5Txt)) && (memcmp(uploadedMD5, md5Txt, uploadedMD5Size) == 0))
+        {
+            *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_TRUE;
+        }
+    }
+    free(uploadedMD5);
+    
+    // a new upload first leaves the md5 of the plf on the product
+    if ((*resumeMode == ARDATATRANSFER_UPLOADER_RESUME_FALSE) && (manager->uploader->isCanceled == 0))
+    {
+        int md5Fd = openat(productFd, md5LocalFileName, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if ((md5Fd < 0) || (write(md5Fd, md5Txt, strlen(md5Txt)) != (ssize_t)strlen(md5Txt)))
+        {
+            error = ARUPDATER_ERROR_UPLOADER;
+        }
+        if (md5Fd >= 0)
+        {
+            close(md5Fd);
+        }
+        
+        if (error == ARUPDATER_OK)
+        {
+            utilsError = ARUTILS_Manager_Ftp_Put(manager->uploader->ftpManager, md5RemotePath, md5LocalPath, NULL, NULL, FTP_RESUME_FALSE);
+            if (utilsError != ARUTILS_OK)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "md5 not sent: %d", utilsError);
+                error = ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR;
+            }
+        }
+        
+        unlinkat(productFd, md5LocalFileName, 0);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_NegotiateResumeOnSession(ARUPDATER_Manager_t *manager, int productFd, const char *const md5LocalPath, const char *const md5RemotePath, const char *const tmpDestFilePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME *resumeMode)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Ftp_t *ftp = NULL;
+    uint8_t uploadedMD5[ARUPDATER_FTP_LINE_SIZE];
+    int64_t uploadedMD5Size = 0;
+    int64_t partialSize = 0;
+    int64_t md5Size = strlen(md5Txt);
+    const char *md5LocalFileName = strrchr(md5LocalPath, ARUPDATER_MANAGER_FOLDER_SEPARATOR[0]) + 1;
+    
+    *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_FALSE;
+    
+    error = ARUPDATER_Uploader_OpenSession(manager, 0);
+    ftp = manager->uploader->ftp[0];
+    
+    // same rule as ARUPDATER_Uploader_NegotiateResume: a partial plf, and the md5 of the plf on the device
+    if ((error == ARUPDATER_OK) && (ARUPDATER_Ftp_Size(ftp, tmpDestFilePath, &partialSize) == ARUPDATER_OK) && (partialSize > 0))
+    {
+        // one more byte tells a longer md5 file apart
+        if ((ARUPDATER_Ftp_Get(ftp, md5RemotePath, 0, uploadedMD5, md5Size + 1, &uploadedMD5Size) == ARUPDATER_OK) && (uploadedMD5Size == md5Size) && (memcmp(uploadedMD5, md5Txt, md5Size) == 0))
+        {
+            *resumeMode = ARDATATRANSFER_UPLOADER_RESUME_TRUE;
+        }
+    }
+    
+    if ((error == ARUPDATER_OK) && (ftp->isCanceled != 0))
+    {
+        error = ARUPDATER_ERROR_UPLOADER_CANCELED;
+    }
+    
+    // a new upload first leaves the md5 of the plf on the product
+    if ((error == ARUPDATER_OK) && (*resumeMode == ARDATATRANSFER_UPLOADER_RESUME_FALSE))
+    {
+        int md5Fd = openat(productFd, md5LocalFileName, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        if ((md5Fd < 0) || (write(md5Fd, md5Txt, md5Size) != (ssize_t)md5Size))
+        {
+            error = ARUPDATER_ERROR_UPLOADER;
+        }
+        
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Ftp_Put(ftp, md5RemotePath, md5Fd, 0, md5Size, 0, ARUPDATER_FTP_MIN_BLOCK_SIZE, 0, NULL, NULL, NULL);
+            if (error != ARUPDATER_OK)
+            {
+                ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UPLOADER_TAG, "md5 not sent: %s", ARUPDATER_Error_ToString(error));
+            }
+        }
+        
+        if (md5Fd >= 0)
+        {
+            close(md5Fd);
+        }
+        unlinkat(productFd, md5LocalFileName, 0);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Uploader_CancelThread(ARUPDATER_Manager_t *manager)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int i = 0;
+    
+    if (manager == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+    
+    if ((error == ARUPDATER_OK) && (manager->uploader == NULL))
+    {
+        error = ARUPDATER_ERROR_MANAGER_NOT_INITIALIZED;
+    }
+    
+    if (error == ARUPDATER_OK)
+    {
+        manager->uploader->isCanceled = 1;
+        
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        if (manager->uploader->isUsingFtpManager == 1)
+        {
+            ARUTILS_Manager_Ftp_Connection_Cancel(manager->uploader->ftpManager);
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+        
         ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
         if (manager->uploader->isUploadThreadRunning == 1)
         {
             ARDATATRANSFER_Uploader_CancelThread(manager->uploader->dataTransferManager);
         }
         ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+        
+        ARSAL_Mutex_Lock(&manager->uploader->uploadLock);
+        for (i = 0; i < ARUPDATER_UPLOADER_MAX_STREAMS; i++)
+        {
+            if (manager->uploader->ftp[i] != NULL)
+            {
+                ARUPDATER_Ftp_Cancel(manager->uploader->ftp[i]);
+            }
+        }
+        ARSAL_Mutex_Unlock(&manager->uploader->uploadLock);
+        
+        // a canceled uploader does not upload anymore
+        ARUPDATER_Uploader_EvictIdleSessions(manager, 1);
 
     }
     
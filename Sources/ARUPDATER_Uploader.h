@@ -42,17 +42,83 @@
 #include <libARDataTransfer/ARDATATRANSFER_Uploader.h>
 #include <libARDataTransfer/ARDATATRANSFER_Downloader.h>
 #include <libARSAL/ARSAL_Mutex.h>
+#include "ARUPDATER_Dir.h"
+#include "ARUPDATER_Ftp.h"
+
+/* the ranges of a multi-stream upload start on this boundary, the first block of a new plf is sent alone */
+#define ARUPDATER_UPLOADER_STREAM_ALIGNMENT      (64 * 1024)
+#define ARUPDATER_UPLOADER_MIN_STREAM_SIZE       (1024 * 1024)
+
+/* a resumed upload first checks the last chunks of the partial plf, it goes on from the end of the last chunk which matches the plf */
+#define ARUPDATER_UPLOADER_RESUME_CHUNK_SIZE     ARUPDATER_UPLOADER_STREAM_ALIGNMENT
+#define ARUPDATER_UPLOADER_RESUME_CHECKED_CHUNKS 4
+
+/* the fan-out uploader uses the same remote files, so that each resumes the uploads of the other */
+#define ARUPDATER_UPLOADER_REMOTE_FOLDER         "/"
+#define ARUPDATER_UPLOADER_MD5_FILENAME          "md5_check.md5"
+#define ARUPDATER_UPLOADER_UPLOADED_FILE_SUFFIX  ".tmp"
+
+/**
+ * @brief Data connection sending a range of the plf
+ */
+typedef struct
+{
+    ARUPDATER_Manager_t *manager;
+    int index; /**< index of the session of the stream in the uploader */
+    int fd;
+    const char *remotePath;
+    int64_t offset;
+    int64_t size;
+    int isAppend;
+    int64_t sentSize; /**< protected by the progressLock of the uploader */
+    eARUPDATER_ERROR error;
+    ARUPDATER_Uploader_TransferStats_t stats;
+} ARUPDATER_Uploader_Stream_t;
+
+/**
+ * @brief Logged in ftp session kept between two uploads
+ */
+typedef struct
+{
+    ARUPDATER_Ftp_t *ftp;
+    int64_t idleSinceUs; /**< monotonic time of the end of its last upload */
+} ARUPDATER_Uploader_IdleSession_t;
 
 struct ARUPDATER_Uploader_t
 {
     char *rootFolder;
+    ARUPDATER_Dir_t *dir; /**< the folders of rootFolder, opened once */
     eARDISCOVERY_PRODUCT product;
     ARUTILS_Manager_t *ftpManager;
     
     int isRunning;
     int isCanceled;
     int isUploadThreadRunning;
-    int isDownloadMd5ThreadRunning;
+    int isUsingFtpManager; /**< the resume is negotiated or the plf is checked on the ftp connection of ftpManager */
+    
+    int hasDeviceVersion; /**< the plf is uploaded only if it is not deviceVersion, cleared at the end of each upload */
+    ARUPDATER_Manager_PlfVersion_t deviceVersion;
+    
+    char *ftpAddress; /**< the plf is sent by the ftp client of the library when set */
+    int ftpPort;
+    char *ftpUsername;
+    char *ftpPassword;
+    int blockSize; /**< size of the blocks of the ftp client, 0 to adapt it to the link */
+    int isZeroCopy; /**< the ftp client sends the plf with sendfile where the system supports it */
+    int streamCount; /**< number of data connections of the ftp client */
+    ARUPDATER_Ftp_t *ftp[ARUPDATER_UPLOADER_MAX_STREAMS]; /**< sessions of the plf transfer, protected by uploadLock */
+    ARUPDATER_Uploader_Stream_t streams[ARUPDATER_UPLOADER_MAX_STREAMS];
+    int activeStreamCount;
+    ARUPDATER_Uploader_IdleSession_t idleSessions[ARUPDATER_UPLOADER_MAX_STREAMS]; /**< sessions left by the previous uploads, the last one is the most recent, protected by uploadLock */
+    int idleSessionCount;
+    int sessionIdleTimeoutMs; /**< 0 to close the sessions after each upload */
+    ARSAL_Mutex_t progressLock; /**< serializes the progress of the streams */
+    int64_t plfSize;
+    int64_t partialSize; /**< size of the partial plf on the device before the transfer */
+    int64_t resumeSize; /**< part of the plf on the device before the streams, checked against the plf */
+    ARUPDATER_Uploader_TransferStats_t transferStats;
+    int64_t verificationSize; /**< bytes of the plf read back from the device to check it */
+    eARUPDATER_UPLOADER_VERIFICATION verification; /**< protected by uploadLock */
     
     ARSAL_MD5_Manager_t *md5Manager;
     
@@ -71,5 +137,192 @@ struct ARUPDATER_Uploader_t
 
 void ARUPDATER_Uploader_ProgressCallback(void* arg, float percent);
 void ARUPDATER_Uploader_CompletionCallback(void* arg, eARDATATRANSFER_ERROR error);
+void ARUPDATER_Uploader_StreamProgressCallback(void* arg, int64_t sentSize);
+
+/**
+ * @brief Send the plf with the ftp client of the library, then rename it to its final name
+ * @param manager : pointer on the manager
+ * @param[in] sourceFilePath : path of the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] finalDestFilePath : remote path of the plf
+ * @param[in] md5RemotePath : remote path of the md5 file, removed during a multi-stream upload
+ * @param[in] md5Txt : md5 of the plf
+ * @param[in] resumeMode : ARDATATRANSFER_UPLOADER_RESUME_TRUE to go on from the end of the partial plf which matches the plf
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SendPlf(ARUPDATER_Manager_t *manager, const char *const sourceFilePath, const char *const tmpDestFilePath, const char *const finalDestFilePath, const char *const md5RemotePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME resumeMode);
+
+/**
+ * @brief Get a logged in ftp session for a stream, it can be canceled by ARUPDATER_Uploader_CancelThread from then on
+ * @details An idle session of a previous upload which still answers is used first, a new session is opened otherwise.
+ * Nothing is done if the session is already open
+ * @param manager : pointer on the manager
+ * @param[in] index : index of the session
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_OpenSession(ARUPDATER_Manager_t *manager, int index);
+
+/**
+ * @brief Release the ftp session of a stream, it is kept for the next upload if its connection is in a known state
+ * @param manager : pointer on the manager
+ * @param[in] index : index of the session
+ * @param[in] lastError : result of the last operation on the session
+ */
+void ARUPDATER_Uploader_CloseSession(ARUPDATER_Manager_t *manager, int index, eARUPDATER_ERROR lastError);
+
+/**
+ * @brief Close the idle sessions
+ * @param manager : pointer on the manager
+ * @param[in] isAll : 1 to close them all, 0 to close the ones idle for longer than the timeout
+ */
+void ARUPDATER_Uploader_EvictIdleSessions(ARUPDATER_Manager_t *manager, int isAll);
+
+/**
+ * @brief Send the range of a stream on its session
+ * @param streamArg : thread data of type ARUPDATER_Uploader_Stream_t*, its session is opened if needed
+ * @return NULL
+ */
+void* ARUPDATER_Uploader_StreamRun(void *streamArg);
+
+/**
+ * @brief Send the plf from the resume size on several data connections, the ranges of the streams follow each other
+ * @param manager : pointer on the manager, the session 0 is opened
+ * @param[in] fd : the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] streamCount : number of streams
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_SendStreams(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, int streamCount);
+
+/**
+ * @brief Tell whether the device already runs the local plf of the product, from the indexes only
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder
+ * @param[in] packPath : the pack file, null if the plf files are stored in the product folders
+ * @param[out] error : ARUPDATER_OK if operation went well, the description of the error otherwise
+ * @return 1 if the device runs the version of the local plf
+ */
+int ARUPDATER_Uploader_DeviceIsUpToDate(ARUPDATER_Manager_t *manager, int productFd, const char *const packPath, eARUPDATER_ERROR *error);
+
+/**
+ * @brief Get the offset of the last chunks of a file
+ * @param[in] size : size of the file
+ * @param[in] chunkCount : number of chunks, the last one may be incomplete
+ * @return the offset, on a chunk boundary
+ */
+int64_t ARUPDATER_Uploader_GetTailOffset(int64_t size, int chunkCount);
+
+/**
+ * @brief Compute the md5 of a part of the plf
+ * @param[in] fd : the plf
+ * @param[in] offset : offset of the part
+ * @param[in] size : size of the part
+ * @param[out] digest : buffer of ARUPDATER_MD5_DIGEST_SIZE bytes
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_HashRange(int fd, int64_t offset, int64_t size, uint8_t *digest);
+
+/**
+ * @brief Compare the chunks of a part of the partial plf read from the device with the chunks of the plf
+ * @param[in] fd : the plf
+ * @param[in] offset : offset of the part, on a chunk boundary
+ * @param[in] remoteData : the part read from the device
+ * @param[in] size : size of the part
+ * @param[out] verifiedSize : size of the chunks which match, from the offset
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_CheckChunks(int fd, int64_t offset, const uint8_t *remoteData, int64_t size, int64_t *verifiedSize);
+
+/**
+ * @brief Check the end of the partial plf on the session 0, with the md5 computed by the server if it has XMD5, by reading it otherwise
+ * @param manager : pointer on the manager, the session 0 is opened
+ * @param[in] fd : the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] partialSize : size of the partial plf
+ * @param[out] resumeSize : end of the last chunk which matches the plf, 0 if none of the checked chunks does or if the partial plf can not be checked
+ * @return ARUPDATER_OK, ARUPDATER_ERROR_UPLOADER_CANCELED if the session has been canceled
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPartialPlf(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, int64_t partialSize, int64_t *resumeSize);
+
+/**
+ * @brief Read the end of a remote file on the ftp connection of the uploader
+ * @details ARUtils resumes a download from the size of the local file: the end of the file is read in a sparse file of the product folder
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder
+ * @param[in] productFolder : path of the product folder, with a separator at its end
+ * @param[in] remotePath : the remote file
+ * @param[in] offset : offset of the end of the file
+ * @param[out] buffer : buffer of size bytes
+ * @param[in] size : size of the end of the file
+ * @param[out] readSize : size read
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_ReadTailWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const remotePath, int64_t offset, uint8_t *buffer, int64_t size, int64_t *readSize);
+
+/**
+ * @brief Check the plf sent by the ftp client of the library on the session 0, before it is renamed
+ * @details The size of the partial plf is checked, then its md5 if the server has XMD5, chunks spread over it otherwise
+ * @param manager : pointer on the manager, the session 0 is opened
+ * @param[in] fd : the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] md5Txt : md5 of the plf
+ * @param[out] verification : the check made, ARUPDATER_UPLOADER_VERIFICATION_MISMATCH if the partial plf does not match
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPlf(ARUPDATER_Manager_t *manager, int fd, const char *const tmpDestFilePath, const char *const md5Txt, eARUPDATER_UPLOADER_VERIFICATION *verification);
+
+/**
+ * @brief Check the plf sent by ARDataTransfer on the ftp connection of the uploader, before it is renamed
+ * @details The size of the partial plf is checked, then its end
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder
+ * @param[in] productFolder : path of the product folder, with a separator at its end
+ * @param[in] sourceFilePath : path of the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[out] verification : the check made, ARUPDATER_UPLOADER_VERIFICATION_MISMATCH if the partial plf does not match
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPlfWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const sourceFilePath, const char *const tmpDestFilePath, eARUPDATER_UPLOADER_VERIFICATION *verification);
+
+/**
+ * @brief Check the end of the partial plf on the ftp connection of the uploader, before ARDataTransfer appends to it
+ * @details ARDataTransfer can only go on from the end of the partial plf: it is sent again if its end does not match
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder
+ * @param[in] productFolder : path of the product folder, with a separator at its end
+ * @param[in] sourceFilePath : path of the plf
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in|out] resumeMode : set to ARDATATRANSFER_UPLOADER_RESUME_FALSE if the partial plf does not match
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_VerifyPartialPlfWithArutils(ARUPDATER_Manager_t *manager, int productFd, const char *const productFolder, const char *const sourceFilePath, const char *const tmpDestFilePath, eARDATATRANSFER_UPLOADER_RESUME *resumeMode);
+
+/**
+ * @brief Decide whether the upload of a plf can be resumed, on the ftp connection of the uploader
+ * @details The size of the partial plf is asked, then only if there is one its md5 is read in memory. A new upload sends its md5 on the same connection
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder, where the md5 file to send is written
+ * @param[in] md5LocalPath : path of the md5 file to send, in the product folder
+ * @param[in] md5RemotePath : remote path of the md5 file
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] md5Txt : md5 of the plf to upload
+ * @param[out] resumeMode : ARDATATRANSFER_UPLOADER_RESUME_TRUE if the upload can be resumed
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_NegotiateResume(ARUPDATER_Manager_t *manager, int productFd, const char *const md5LocalPath, const char *const md5RemotePath, const char *const tmpDestFilePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME *resumeMode);
+
+/**
+ * @brief Negotiate the resume as ARUPDATER_Uploader_NegotiateResume() does, on the first session of the ftp client of the library
+ * @details The session stays open for ARUPDATER_Uploader_SendPlf()
+ * @param manager : pointer on the manager
+ * @param[in] productFd : descriptor of the product folder, where the md5 file to send is written
+ * @param[in] md5LocalPath : path of the md5 file to send, in the product folder
+ * @param[in] md5RemotePath : remote path of the md5 file
+ * @param[in] tmpDestFilePath : remote path of the partial plf
+ * @param[in] md5Txt : md5 of the plf to upload
+ * @param[out] resumeMode : ARDATATRANSFER_UPLOADER_RESUME_TRUE if the upload can be resumed
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Uploader_NegotiateResumeOnSession(ARUPDATER_Manager_t *manager, int productFd, const char *const md5LocalPath, const char *const md5RemotePath, const char *const tmpDestFilePath, const char *const md5Txt, eARDATATRANSFER_UPLOADER_RESUME *resumeMode);
 
 #endif
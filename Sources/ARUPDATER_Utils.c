@@ -35,31 +35,47 @@
  * @author djavan.bertrand@parrot.com
  **/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // fallocate
+#endif
+
 #ifndef WIN32
 #include <sys/types.h>
 #endif
 
 #include <stdlib.h>
 #include <stdio.h>
-#include <dirent.h>
+#include <stdarg.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/statvfs.h>
+#include <libARSAL/ARSAL_Print.h>
 
 #include "ARUPDATER_Utils.h"
 #include "ARUPDATER_Plf.h"
 #include "ARUPDATER_Manager.h"
+#include "ARUPDATER_PlfIndex.h"
+
+#define ARUPDATER_UTILS_TAG     "ARUPDATER_Utils"
 
 eARUPDATER_ERROR ARUPDATER_Utils_GetPlfVersion(const char *const plfFilePath, int *version, int *edition, int *extension)
+{
+    return ARUPDATER_Utils_GetPlfVersionAt(AT_FDCWD, plfFilePath, version, edition, extension);
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_GetPlfVersionAt(int dirFd, const char *const plfFileName, int *version, int *edition, int *extension)
 {
     eARUPDATER_ERROR error = ARUPDATER_OK;
     
     plf_phdr_t header;
     
-    if ((plfFilePath != NULL)   &&
+    if ((plfFileName != NULL)   &&
         (version != NULL)       &&
         (edition != NULL)       &&
         (extension != NULL))
     {
-        error = ARUPDATER_Plf_GetHeader(plfFilePath, &header);
+        error = ARUPDATER_Plf_GetHeaderAt(dirFd, plfFileName, &header);
     }
     else
     {
@@ -85,42 +101,191 @@ eARUPDATER_ERROR ARUPDATER_Utils_GetPlfInFolder(const char *const plfFolder, cha
         error = ARUPDATER_ERROR_BAD_PARAMETER;
     }
 
-    *plfFileName = NULL;
+    // the newest plf, whatever the order of the entries of the folder
+    if (ARUPDATER_OK == error)
+    {
+        error = ARUPDATER_PlfIndex_GetNewest(plfFolder, plfFileName);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_GetPlfInFolderAt(int dirFd, char **plfFileName)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    
+    if ((dirFd < 0) || (plfFileName == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
     if (ARUPDATER_OK == error)
     {
-        DIR *dir = opendir(plfFolder);
-        
-        struct dirent *entry = NULL;
-        int found = 0;
-        if (dir)
+        error = ARUPDATER_PlfIndex_GetNewestAt(dirFd, plfFileName);
+    }
+    
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_ParseSize(const char *const sizeStr, int64_t *size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *endPtr = NULL;
+    long long value = 0;
+
+    if ((sizeStr == NULL) || (size == NULL) || (sizeStr[0] < '0') || (sizeStr[0] > '9'))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (ARUPDATER_OK == error)
+    {
+        errno = 0;
+        value = strtoll(sizeStr, &endPtr, 10);
+        if ((errno == ERANGE) || (endPtr == sizeStr) || (*endPtr != '\0') || (value < 0) || (value > INT64_MAX))
         {
-            while((found == 0) && (entry = readdir(dir)))
+            error = ARUPDATER_ERROR_BAD_PARAMETER;
+        }
+    }
+
+    if (ARUPDATER_OK == error)
+    {
+        *size = (int64_t)value;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_ParseVersion(const char *const versionStr, int *version, int *edition, int *extension)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int consumed = 0;
+
+    if ((versionStr == NULL) || (version == NULL) || (edition == NULL) || (extension == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((ARUPDATER_OK == error) &&
+        ((sscanf(versionStr, "%d.%d.%d%n", version, edition, extension, &consumed) != 3) ||
+         (versionStr[consumed] != '\0') ||
+         (*version < 0) || (*edition < 0) || (*extension < 0)))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_CheckFreeSpace(const char *const folder, int64_t requiredSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    struct statvfs fsStat;
+
+    if ((folder == NULL) || (requiredSize < 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((ARUPDATER_OK == error) && (statvfs(folder, &fsStat) != 0))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (ARUPDATER_OK == error)
+    {
+        uint64_t freeSize = (uint64_t)fsStat.f_bavail * (uint64_t)fsStat.f_frsize;
+        if ((uint64_t)requiredSize > freeSize)
+        {
+            ARSAL_PRINT(ARSAL_PRINT_ERROR, ARUPDATER_UTILS_TAG, "%lld bytes required but only %llu bytes available in %s", (long long)requiredSize, (unsigned long long)freeSize, folder);
+            error = ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE;
+        }
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Utils_PreallocateFile(int fd, int64_t size)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int resultSys = 0;
+
+    if ((fd < 0) || (size < 0))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((ARUPDATER_OK == error) && (size > 0))
+    {
+#if defined(__linux__)
+        do
+        {
+            resultSys = fallocate(fd, 0, 0, (off_t)size);
+        } while ((resultSys != 0) && (errno == EINTR));
+#elif defined(F_PREALLOCATE)
+        fstore_t store = {F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, (off_t)size, 0};
+        resultSys = fcntl(fd, F_PREALLOCATE, &store);
+        if (resultSys == -1)
+        {
+            // no contiguous room, let the filesystem spread the blocks
+            store.fst_flags = F_ALLOCATEALL;
+            resultSys = fcntl(fd, F_PREALLOCATE, &store);
+        }
+#else
+        resultSys = -1;
+        errno = EOPNOTSUPP;
+#endif
+        if (resultSys != 0)
+        {
+            if (errno == ENOSPC)
+            {
+                error = ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE;
+            }
+            else
             {
-                char *filename = entry->d_name;
-                char *extension = strrchr(filename, ARUPDATER_MANAGER_PLF_EXTENSION[0]);
-                if ((extension != NULL) && (strcmp(extension, ARUPDATER_MANAGER_PLF_EXTENSION) == 0))
-                {
-                    int plfFileNameLength = strlen(filename) + 1;
-                    *plfFileName = malloc(plfFileNameLength);
-                    if (*plfFileName == NULL)
-                    {
-                        error = ARUPDATER_ERROR_ALLOC;
-                    }
-                    else
-                    {
-                        strcpy(*plfFileName, filename);
-                    }
-                    found = 1;
-                }
+                // preallocation is only an optimization
+                ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_UTILS_TAG, "preallocation not available: %s", strerror(errno));
             }
-            closedir(dir);
         }
-        
-        if (found == 0)
+    }
+
+    return error;
+}
+
+char *ARUPDATER_Utils_BuildPath(const char *const first, ...)
+{
+    va_list args;
+    const char *part = NULL;
+    char *path = NULL;
+    size_t length = 0;
+
+    if (first == NULL)
+    {
+        return NULL;
+    }
+
+    // measure the parts, then copy them
+    va_start(args, first);
+    for (part = first; part != NULL; part = va_arg(args, const char *))
+    {
+        length += strlen(part);
+    }
+    va_end(args);
+
+    path = malloc(length + 1);
+    if (path != NULL)
+    {
+        length = 0;
+        va_start(args, first);
+        for (part = first; part != NULL; part = va_arg(args, const char *))
         {
-            error = ARUPDATER_ERROR_PLF_FILE_NOT_FOUND;
+            size_t partLength = strlen(part);
+            memcpy(path + length, part, partLength);
+            length += partLength;
         }
+        va_end(args);
+        path[length] = '\0';
     }
-    
-    return error;
+
+    return path;
 }
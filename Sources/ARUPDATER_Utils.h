@@ -38,6 +38,7 @@
 #ifndef _ARUPDATER_UTILS_PRIVATE_H_
 #define _ARUPDATER_UTILS_PRIVATE_H_
 
+#include <stdint.h>
 #include <libARUpdater/ARUPDATER_Error.h>
 
 /**
@@ -50,6 +51,17 @@
  */
 eARUPDATER_ERROR ARUPDATER_Utils_GetPlfVersion(const char *const plfFilePath, int *version, int *edition, int *extension);
 
+/**
+ * @brief get the version of a plf file of an opened folder
+ * @param[in] dirFd : descriptor of the folder
+ * @param[in] plfFileName : name of the plf file in the folder
+ * @param[out] version : pointer on the version to be returned
+ * @param[out] edition : pointer on the edition to be returned
+ * @param[out] extension : pointer on the extension to be returned
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_GetPlfVersionAt(int dirFd, const char *const plfFileName, int *version, int *edition, int *extension);
+
 /**
  * @brief get the plf path of the first plf file found in a given folder
  * @param[in] plfFolder : the folder to look for the plf file
@@ -58,4 +70,55 @@ eARUPDATER_ERROR ARUPDATER_Utils_GetPlfVersion(const char *const plfFilePath, in
  */
 eARUPDATER_ERROR ARUPDATER_Utils_GetPlfInFolder(const char *const plfFolder, char **plfFileName);
 
+/**
+ * @brief get the name of the newest plf file of an opened folder
+ * @param[in] dirFd : descriptor of the folder to look for the plf file
+ * @param[out] plfFileName : Pointer to a pointer to the newly-allocated name of the plf file.
+ * @return ARUPDATER_OK if operation went well, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_GetPlfInFolderAt(int dirFd, char **plfFileName);
+
+/**
+ * @brief parse a size in bytes given as a decimal string
+ * @param[in] sizeStr : the string to parse
+ * @param[out] size : pointer on the size to be returned
+ * @return ARUPDATER_OK if the string is a positive decimal number which fits on 64 bits, ARUPDATER_ERROR_BAD_PARAMETER otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_ParseSize(const char *const sizeStr, int64_t *size);
+
+/**
+ * @brief parse a plf version given as a string
+ * @param[in] versionStr : the string to parse (pattern : X.Y.Z where X, Y, Z are positive integers)
+ * @param[out] version : pointer on the version to be returned
+ * @param[out] edition : pointer on the edition to be returned
+ * @param[out] extension : pointer on the extension to be returned
+ * @return ARUPDATER_OK if the string matches the pattern, ARUPDATER_ERROR_BAD_PARAMETER otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_ParseVersion(const char *const versionStr, int *version, int *edition, int *extension);
+
+/**
+ * @brief check that the filesystem of a given folder has enough free space
+ * @param[in] folder : a folder of the filesystem to check
+ * @param[in] requiredSize : the number of bytes that will be written
+ * @return ARUPDATER_OK if there is enough free space, ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE if not, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_CheckFreeSpace(const char *const folder, int64_t requiredSize);
+
+/**
+ * @brief reserve the blocks of a file up to a given size
+ * @details The blocks are reserved in one go to avoid fragmentation while writing. Filesystems which do not support it are silently ignored.
+ * @param[in] fd : file descriptor of the file opened for writing
+ * @param[in] size : the final size of the file
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_DOWNLOADER_NOT_ENOUGH_SPACE if the disk is full, a description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Utils_PreallocateFile(int fd, int64_t size);
+
+/**
+ * @brief build a path from its parts, for the functions which still need a path instead of a folder descriptor
+ * @warning This function allocates memory
+ * @param[in] first : the first part of the path, followed by the other parts and a NULL
+ * @return the newly-allocated path, NULL if it can not be allocated
+ */
+char *ARUPDATER_Utils_BuildPath(const char *const first, ...);
+
 #endif
@@ -0,0 +1,505 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Versions.c
+ * @brief libARUpdater retained plf versions c file.
+ * @date 19/10/2026
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <libARSAL/ARSAL_Print.h>
+
+#include "ARUPDATER_Versions.h"
+#include "ARUPDATER_Utils.h"
+#include "ARUPDATER_Manager.h"
+
+/* ***************************************
+ *
+ *             define :
+ *
+ *****************************************/
+#define ARUPDATER_VERSIONS_TAG                  "ARUPDATER_Versions"
+
+#define ARUPDATER_VERSIONS_NAME_MAX_SIZE        40
+
+typedef struct
+{
+    int version;
+    int edition;
+    int extension;
+    int64_t size;
+} ARUPDATER_Versions_Entry_t;
+
+/* ***************************************
+ *
+ *             private functions :
+ *
+ *****************************************/
+
+static char *ARUPDATER_Versions_GetFolder(const char *const productFolder, const char *const name)
+{
+    int length = strlen(productFolder) + strlen(ARUPDATER_VERSIONS_FOLDER) + ((name != NULL) ? strlen(name) + strlen(ARUPDATER_MANAGER_FOLDER_SEPARATOR) : 0) + 1;
+    char *folder = malloc(length);
+
+    if (folder != NULL)
+    {
+        strcpy(folder, productFolder);
+        strcat(folder, ARUPDATER_VERSIONS_FOLDER);
+        if (name != NULL)
+        {
+            strcat(folder, name);
+            strcat(folder, ARUPDATER_MANAGER_FOLDER_SEPARATOR);
+        }
+    }
+
+    return folder;
+}
+
+static char *ARUPDATER_Versions_GetVersionFolder(const char *const productFolder, int version, int edition, int extension)
+{
+    char name[ARUPDATER_VERSIONS_NAME_MAX_SIZE];
+    snprintf(name, sizeof(name), "%d.%d.%d", version, edition, extension);
+    return ARUPDATER_Versions_GetFolder(productFolder, name);
+}
+
+static char *ARUPDATER_Versions_GetPath(const char *const folder, const char *const fileName)
+{
+    char *path = malloc(strlen(folder) + strlen(fileName) + 1);
+    if (path != NULL)
+    {
+        strcpy(path, folder);
+        strcat(path, fileName);
+    }
+    return path;
+}
+
+/**
+ * @brief delete a version folder and its content
+ */
+static void ARUPDATER_Versions_RemoveFolder(const char *const folder)
+{
+    DIR *dir = opendir(folder);
+    struct dirent *entry = NULL;
+
+    if (dir != NULL)
+    {
+        while ((entry = readdir(dir)) != NULL)
+        {
+            if ((strcmp(entry->d_name, ".") != 0) && (strcmp(entry->d_name, "..") != 0))
+            {
+                char *path = ARUPDATER_Versions_GetPath(folder, entry->d_name);
+                if (path != NULL)
+                {
+                    unlink(path);
+                    free(path);
+                }
+            }
+        }
+        closedir(dir);
+    }
+
+    rmdir(folder);
+}
+
+/**
+ * @brief move a plf of the product folder in the folder of its version
+ */
+static eARUPDATER_ERROR ARUPDATER_Versions_MoveIn(const char *const productFolder, const char *const plfFileName)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int version = 0, edition = 0, extension = 0;
+    char *plfFilePath = ARUPDATER_Versions_GetPath(productFolder, plfFileName);
+    char *versionsFolder = ARUPDATER_Versions_GetFolder(productFolder, NULL);
+    char *versionFolder = NULL;
+    char *retainedFilePath = NULL;
+
+    if ((plfFilePath == NULL) || (versionsFolder == NULL))
+    {
+        error = ARUPDATER_ERROR_ALLOC;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Utils_GetPlfVersion(plfFilePath, &version, &edition, &extension);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        versionFolder = ARUPDATER_Versions_GetVersionFolder(productFolder, version, edition, extension);
+        retainedFilePath = (versionFolder != NULL) ? ARUPDATER_Versions_GetPath(versionFolder, plfFileName) : NULL;
+        if (retainedFilePath == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        // the same version may already be retained, keep only the last one
+        mkdir(versionsFolder, S_IRWXU);
+        ARUPDATER_Versions_RemoveFolder(versionFolder);
+
+        if ((mkdir(versionFolder, S_IRWXU) != 0) || (rename(plfFilePath, retainedFilePath) != 0))
+        {
+            rmdir(versionFolder);
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+    }
+
+    free(plfFilePath);
+    free(versionsFolder);
+    free(versionFolder);
+    free(retainedFilePath);
+
+    return error;
+}
+
+static int ARUPDATER_Versions_CompareNewestFirst(const void *a, const void *b)
+{
+    const ARUPDATER_Versions_Entry_t *entryA = (const ARUPDATER_Versions_Entry_t *)a;
+    const ARUPDATER_Versions_Entry_t *entryB = (const ARUPDATER_Versions_Entry_t *)b;
+
+    if (entryA->version != entryB->version)
+    {
+        return (entryA->version > entryB->version) ? -1 : 1;
+    }
+    if (entryA->edition != entryB->edition)
+    {
+        return (entryA->edition > entryB->edition) ? -1 : 1;
+    }
+    if (entryA->extension != entryB->extension)
+    {
+        return (entryA->extension > entryB->extension) ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief remove the oldest retained versions until the retention limits are met
+ */
+static void ARUPDATER_Versions_Prune(const char *const productFolder, int maxVersions, int64_t maxBytes)
+{
+    ARUPDATER_Versions_Entry_t *entries = NULL;
+    int entryCount = 0;
+    int entryCapacity = 0;
+    char *versionsFolder = ARUPDATER_Versions_GetFolder(productFolder, NULL);
+    DIR *dir = (versionsFolder != NULL) ? opendir(versionsFolder) : NULL;
+    struct dirent *dirEntry = NULL;
+
+    while ((dir != NULL) && ((dirEntry = readdir(dir)) != NULL))
+    {
+        ARUPDATER_Versions_Entry_t entry;
+        char *versionFolder = NULL;
+        char *plfFileName = NULL;
+        struct stat statbuf;
+
+        if (sscanf(dirEntry->d_name, "%d.%d.%d", &entry.version, &entry.edition, &entry.extension) != 3)
+        {
+            continue;
+        }
+
+        entry.size = 0;
+        versionFolder = ARUPDATER_Versions_GetFolder(productFolder, dirEntry->d_name);
+        if ((versionFolder != NULL) && (ARUPDATER_Utils_GetPlfInFolder(versionFolder, &plfFileName) == ARUPDATER_OK))
+        {
+            char *plfFilePath = ARUPDATER_Versions_GetPath(versionFolder, plfFileName);
+            if ((plfFilePath != NULL) && (stat(plfFilePath, &statbuf) == 0))
+            {
+                entry.size = statbuf.st_size;
+            }
+            free(plfFilePath);
+        }
+        free(plfFileName);
+        free(versionFolder);
+
+        if (entryCount == entryCapacity)
+        {
+            int newCapacity = (entryCapacity == 0) ? 8 : entryCapacity * 2;
+            ARUPDATER_Versions_Entry_t *newEntries = realloc(entries, newCapacity * sizeof(ARUPDATER_Versions_Entry_t));
+            if (newEntries == NULL)
+            {
+                break;
+            }
+            entries = newEntries;
+            entryCapacity = newCapacity;
+        }
+        entries[entryCount++] = entry;
+    }
+
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+
+    if (entryCount > 0)
+    {
+        int64_t keptBytes = 0;
+        int i = 0;
+
+        qsort(entries, entryCount, sizeof(ARUPDATER_Versions_Entry_t), ARUPDATER_Versions_CompareNewestFirst);
+
+        for (i = 0; i < entryCount; i++)
+        {
+            keptBytes += entries[i].size;
+            if ((i >= maxVersions) || ((maxBytes > 0) && (keptBytes > maxBytes)))
+            {
+                char *versionFolder = ARUPDATER_Versions_GetVersionFolder(productFolder, entries[i].version, entries[i].edition, entries[i].extension);
+                if (versionFolder != NULL)
+                {
+                    ARSAL_PRINT(ARSAL_PRINT_DEBUG, ARUPDATER_VERSIONS_TAG, "removing retained version %s", versionFolder);
+                    ARUPDATER_Versions_RemoveFolder(versionFolder);
+                    free(versionFolder);
+                }
+                keptBytes -= entries[i].size;
+            }
+        }
+    }
+
+    free(entries);
+    free(versionsFolder);
+}
+
+/* ***************************************
+ *
+ *             Implementation :
+ *
+ *****************************************/
+
+eARUPDATER_ERROR ARUPDATER_Versions_Retain(const char *const productFolder, const char *const plfFileName, int maxVersions, int64_t maxBytes)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    int isRetained = 0;
+
+    if ((productFolder == NULL) || (plfFileName == NULL))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if ((error == ARUPDATER_OK) && (maxVersions > 0))
+    {
+        eARUPDATER_ERROR retainError = ARUPDATER_Versions_MoveIn(productFolder, plfFileName);
+        if (retainError == ARUPDATER_OK)
+        {
+            isRetained = 1;
+        }
+        else
+        {
+            ARSAL_PRINT(ARSAL_PRINT_WARNING, ARUPDATER_VERSIONS_TAG, "could not retain %s: %s", plfFileName, ARUPDATER_Error_ToString(retainError));
+        }
+        ARUPDATER_Versions_Prune(productFolder, maxVersions, maxBytes);
+    }
+
+    // not retained, delete it so that the product folder only holds the new plf
+    if ((error == ARUPDATER_OK) && (isRetained == 0))
+    {
+        char *plfFilePath = ARUPDATER_Versions_GetPath(productFolder, plfFileName);
+        if (plfFilePath != NULL)
+        {
+            unlink(plfFilePath);
+            free(plfFilePath);
+        }
+    }
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Versions_Select(const char *const productFolder, int version, int edition, int extension, int maxVersions, int64_t maxBytes)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    char *versionFolder = NULL;
+    char *retainedFileName = NULL;
+    char *retainedFilePath = NULL;
+    char *selectedFilePath = NULL;
+    char *currentFileName = NULL;
+    int currentVersion = 0, currentEdition = 0, currentExtension = 0;
+    int isAlreadySelected = 0;
+
+    if (productFolder == NULL)
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        versionFolder = ARUPDATER_Versions_GetVersionFolder(productFolder, version, edition, extension);
+        if (versionFolder == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Utils_GetPlfInFolder(versionFolder, &retainedFileName);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        retainedFilePath = ARUPDATER_Versions_GetPath(versionFolder, retainedFileName);
+        selectedFilePath = ARUPDATER_Versions_GetPath(productFolder, retainedFileName);
+        if ((retainedFilePath == NULL) || (selectedFilePath == NULL))
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    // retain the current plf in exchange
+    if ((error == ARUPDATER_OK) && (ARUPDATER_Utils_GetPlfInFolder(productFolder, &currentFileName) == ARUPDATER_OK))
+    {
+        char *currentFilePath = ARUPDATER_Versions_GetPath(productFolder, currentFileName);
+        if ((currentFilePath != NULL) && (ARUPDATER_Utils_GetPlfVersion(currentFilePath, &currentVersion, &currentEdition, &currentExtension) == ARUPDATER_OK) &&
+            (currentVersion == version) && (currentEdition == edition) && (currentExtension == extension))
+        {
+            // already the current one, drop the duplicate
+            ARUPDATER_Versions_RemoveFolder(versionFolder);
+            isAlreadySelected = 1;
+        }
+        free(currentFilePath);
+
+        if (isAlreadySelected == 0)
+        {
+            error = ARUPDATER_Versions_MoveIn(productFolder, currentFileName);
+        }
+    }
+
+    if ((error == ARUPDATER_OK) && (isAlreadySelected == 0))
+    {
+        if (rename(retainedFilePath, selectedFilePath) != 0)
+        {
+            error = ARUPDATER_ERROR_SYSTEM;
+        }
+        else
+        {
+            rmdir(versionFolder);
+        }
+    }
+
+    // the selected version has left the versions folder, it can not be pruned
+    if ((error == ARUPDATER_OK) && (isAlreadySelected == 0) && (maxVersions > 0))
+    {
+        ARUPDATER_Versions_Prune(productFolder, maxVersions, maxBytes);
+    }
+
+    free(versionFolder);
+    free(retainedFileName);
+    free(retainedFilePath);
+    free(selectedFilePath);
+    free(currentFileName);
+
+    return error;
+}
+
+eARUPDATER_ERROR ARUPDATER_Versions_GetVersions(const char *const productFolder, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Versions_Entry_t *entries = NULL;
+    int entryCount = 0;
+    int entryCapacity = 0;
+    char *versionsFolder = NULL;
+    DIR *dir = NULL;
+    struct dirent *dirEntry = NULL;
+    int i = 0;
+
+    if ((productFolder == NULL) || (count == NULL) || (maxCount < 0) || ((versions == NULL) && (maxCount > 0)))
+    {
+        error = ARUPDATER_ERROR_BAD_PARAMETER;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        versionsFolder = ARUPDATER_Versions_GetFolder(productFolder, NULL);
+        if (versionsFolder == NULL)
+        {
+            error = ARUPDATER_ERROR_ALLOC;
+        }
+    }
+
+    // a product without retained version has no versions folder
+    if (error == ARUPDATER_OK)
+    {
+        dir = opendir(versionsFolder);
+    }
+
+    while ((error == ARUPDATER_OK) && (dir != NULL) && ((dirEntry = readdir(dir)) != NULL))
+    {
+        ARUPDATER_Versions_Entry_t entry;
+
+        if (sscanf(dirEntry->d_name, "%d.%d.%d", &entry.version, &entry.edition, &entry.extension) != 3)
+        {
+            continue;
+        }
+        entry.size = 0;
+
+        if (entryCount == entryCapacity)
+        {
+            int newCapacity = (entryCapacity == 0) ? 8 : entryCapacity * 2;
+            ARUPDATER_Versions_Entry_t *newEntries = realloc(entries, newCapacity * sizeof(ARUPDATER_Versions_Entry_t));
+            if (newEntries == NULL)
+            {
+                error = ARUPDATER_ERROR_ALLOC;
+                break;
+            }
+            entries = newEntries;
+            entryCapacity = newCapacity;
+        }
+        entries[entryCount++] = entry;
+    }
+
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        if (entryCount > 0)
+        {
+            qsort(entries, entryCount, sizeof(ARUPDATER_Versions_Entry_t), ARUPDATER_Versions_CompareNewestFirst);
+        }
+        for (i = 0; (i < entryCount) && (i < maxCount); i++)
+        {
+            versions[i].version = entries[i].version;
+            versions[i].edition = entries[i].edition;
+            versions[i].extension = entries[i].extension;
+        }
+        *count = entryCount;
+    }
+
+    free(entries);
+    free(versionsFolder);
+
+    return error;
+}
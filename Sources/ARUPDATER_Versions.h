@@ -0,0 +1,83 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ARUPDATER_Versions.h
+ * @brief libARUpdater retained plf versions header file.
+ * @date 19/10/2026
+ **/
+
+#ifndef _ARUPDATER_VERSIONS_PRIVATE_H_
+#define _ARUPDATER_VERSIONS_PRIVATE_H_
+
+#include <stdint.h>
+#include <libARUpdater/ARUPDATER_Error.h>
+#include <libARUpdater/ARUPDATER_Manager.h>
+
+/**
+ * @brief Folder of a product folder where the previous plf files are kept, one sub folder per version (<version>.<edition>.<extension>/)
+ */
+#define ARUPDATER_VERSIONS_FOLDER                       "versions/"
+
+/**
+ * @brief Move the current plf of a product folder into its versions folder instead of deleting it
+ * @details The oldest retained versions are then removed until the retention limits are met
+ * @param[in] productFolder : the product folder, ending with a separator
+ * @param[in] plfFileName : the name of the current plf file in the product folder
+ * @param[in] maxVersions : the number of versions to keep, 0 to delete the plf file
+ * @param[in] maxBytes : the maximum size of the kept versions, 0 for no limit
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Versions_Retain(const char *const productFolder, const char *const plfFileName, int maxVersions, int64_t maxBytes);
+
+/**
+ * @brief Make a retained version the current plf of a product folder
+ * @details The current plf is retained in exchange, nothing is copied, then the oldest retained versions are removed until the retention limits are met
+ * @param[in] productFolder : the product folder, ending with a separator
+ * @param[in] version : the version of the retained plf
+ * @param[in] edition : the edition of the retained plf
+ * @param[in] extension : the extension of the retained plf
+ * @param[in] maxVersions : the number of versions to keep once the current plf is retained, 0 to keep them all
+ * @param[in] maxBytes : the maximum size of the kept versions, 0 for no limit
+ * @return ARUPDATER_OK if operation went well, ARUPDATER_ERROR_PLF_FILE_NOT_FOUND if the version is not retained, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Versions_Select(const char *const productFolder, int version, int edition, int extension, int maxVersions, int64_t maxBytes);
+
+/**
+ * @brief Get the versions retained in a product folder, the newest first
+ * @param[in] productFolder : the product folder, ending with a separator
+ * @param[out] versions : the retained versions. Can be null if maxCount is 0
+ * @param[in] maxCount : the size of versions
+ * @param[out] count : the number of retained versions, which may be greater than maxCount
+ * @return ARUPDATER_OK if operation went well, the description of the error otherwise
+ */
+eARUPDATER_ERROR ARUPDATER_Versions_GetVersions(const char *const productFolder, ARUPDATER_Manager_PlfVersion_t *versions, int maxCount, int *count);
+
+#endif
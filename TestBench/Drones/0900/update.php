@@ -20,6 +20,7 @@ define ("ERROR_MAGIC", 9);
 define ("ERROR_PARSING_VERSIONS", 10);
 
 define ("TOKEN", "|");
+define ("TREE_CHUNK_SIZE", 1048576);
 
 define ("DEBUG", FALSE);
 //define ("DEBUG", TRUE);
@@ -242,6 +243,51 @@ function isUpToDate($remote_version, $local_version, &$error)
 	return $isUpToDate;
 }
 
+// sha256 of the concatenated sha256 of each TREE_CHUNK_SIZE chunk ("sha256tree" in libARUpdater)
+function getTreeHash($file)
+{
+    $digests = '';
+    $file_handle = fopen($file, "rb");
+
+    while (!feof($file_handle))
+    {
+        $chunk = fread($file_handle, TREE_CHUNK_SIZE);
+        if (strlen($chunk) > 0)
+        {
+            $digests = $digests . hash('sha256', $chunk, TRUE);
+        }
+    }
+    fclose($file_handle);
+
+    return hash('sha256', $digests);
+}
+
+// "<size> <chunk size>" then the sha256 of each chunk, one per line
+function sendManifest()
+{
+    $error = ERROR_OK;
+    $file = GetFileName('./', '.plf', $error);
+
+    if ($error == ERROR_OK)
+    {
+        $file_handle = fopen($file, "rb");
+        echo filesize($file) . ' ' . TREE_CHUNK_SIZE . "\n";
+        while (!feof($file_handle))
+        {
+            $chunk = fread($file_handle, TREE_CHUNK_SIZE);
+            if (strlen($chunk) > 0)
+            {
+                echo hash('sha256', $chunk) . "\n";
+            }
+        }
+        fclose($file_handle);
+    }
+    else
+    {
+        header("HTTP/1.0 404 Not Found");
+    }
+}
+
 function getUrlPath($file)
 {
     $url = 'http' . (isset($_SERVER['HTTPS']) ? 's' : '');
@@ -322,6 +368,12 @@ function main()
 	
     logIfDebug('Debug mode with verbose info: <br />');
 	
+	if (isset($_GET["manifest"]))
+	{
+		sendManifest();
+		return;
+	}
+	
 	if ( !isset($_GET["product"]) || !isset($_GET["serialNo"]) || !isset($_GET["version"]) /*|| !isset($_GET["platform"]) || !isset($_GET["appVersion"])*/)
 	{
 		$error = ERROR_BAD_REQUEST;
@@ -418,7 +470,9 @@ function main()
 	{
 		$url = getUrlPath($file);
 		$md5 = md5_file($file);
-		sendErrorResponse(ERROR_SHOULD_UPDATE, $url . TOKEN . $md5 . TOKEN . $size . TOKEN . $localVersion);
+		$hash = 'sha256tree:' . getTreeHash($file);
+		$manifestUrl = getUrlPath('update.php?manifest=1');
+		sendErrorResponse(ERROR_SHOULD_UPDATE, $url . TOKEN . $md5 . TOKEN . $size . TOKEN . $localVersion . TOKEN . 'hash=' . $hash . TOKEN . 'manifest=' . $manifestUrl);
 	}   
 	else
 	{
@@ -0,0 +1,158 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file blacklistTest.c
+ * @brief libARUpdater TestBench checks of the plf blacklist and of its list and file loaders
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Blacklist.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define BLACKLISTTEST_FILE_PATH         "/tmp/blacklistTest.txt"
+#define BLACKLISTTEST_GROWTH_COUNT      1000
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void blacklistTest_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+/**
+ * @brief write a blacklist file, %1$04x and %2$04x being replaced by the ids of the products
+ */
+static void blacklistTest_writeFile(const char *format, eARDISCOVERY_PRODUCT product, eARDISCOVERY_PRODUCT otherProduct)
+{
+    FILE *file = fopen(BLACKLISTTEST_FILE_PATH, "wb");
+
+    if (file != NULL)
+    {
+        fprintf(file, format, ARDISCOVERY_getProductID(product), ARDISCOVERY_getProductID(otherProduct));
+        fclose(file);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    eARDISCOVERY_PRODUCT product = ARDISCOVERY_PRODUCT_ARDRONE;
+    eARDISCOVERY_PRODUCT otherProduct = ARDISCOVERY_PRODUCT_MINIDRONE;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Blacklist_t *blacklist = NULL;
+    int isValid = 0;
+    int i = 0;
+
+    // single versions
+    blacklist = ARUPDATER_Blacklist_New(&error);
+    blacklistTest_check((blacklist != NULL) && (error == ARUPDATER_OK), "blacklist created");
+    blacklistTest_check(!ARUPDATER_Blacklist_Contains(blacklist, product, 0, 0, 0), "empty blacklist contains nothing");
+    blacklistTest_check((ARUPDATER_Blacklist_Add(blacklist, product, 3, 1, 0) == ARUPDATER_OK) && (ARUPDATER_Blacklist_Add(blacklist, product, 3, 1, 0) == ARUPDATER_OK), "version added twice");
+    blacklistTest_check(ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 0), "added version found");
+    blacklistTest_check(!ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 1) && !ARUPDATER_Blacklist_Contains(blacklist, product, 3, 0, 1) && !ARUPDATER_Blacklist_Contains(blacklist, product, 1, 3, 0), "close versions not found");
+    blacklistTest_check(!ARUPDATER_Blacklist_Contains(blacklist, otherProduct, 3, 1, 0), "version of another product not found");
+    blacklistTest_check((ARUPDATER_Blacklist_Add(blacklist, product, -1, 0, 0) == ARUPDATER_ERROR_BAD_PARAMETER) && (ARUPDATER_Blacklist_Add(blacklist, product, 0x10000, 0, 0) == ARUPDATER_ERROR_BAD_PARAMETER), "out of range version refused");
+    blacklistTest_check(!ARUPDATER_Blacklist_Contains(blacklist, product, -1, 0, 0), "out of range version not found");
+
+    // the table grows past its initial capacity
+    isValid = 1;
+    for (i = 0; (i < BLACKLISTTEST_GROWTH_COUNT) && isValid; i++)
+    {
+        isValid = (ARUPDATER_Blacklist_Add(blacklist, otherProduct, i, i % 7, i % 3) == ARUPDATER_OK);
+    }
+    for (i = 0; (i < BLACKLISTTEST_GROWTH_COUNT) && isValid; i++)
+    {
+        isValid = ARUPDATER_Blacklist_Contains(blacklist, otherProduct, i, i % 7, i % 3) && !ARUPDATER_Blacklist_Contains(blacklist, otherProduct, i, (i % 7) + 1, i % 3);
+    }
+    blacklistTest_check(isValid && ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 0), "versions found after the growth");
+    ARUPDATER_Blacklist_Delete(&blacklist);
+    blacklistTest_check((blacklist == NULL), "blacklist deleted");
+
+    // version lists
+    blacklist = ARUPDATER_Blacklist_New(NULL);
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, "1.2.3,4.5.6") == ARUPDATER_OK) && ARUPDATER_Blacklist_Contains(blacklist, product, 1, 2, 3) && ARUPDATER_Blacklist_Contains(blacklist, product, 4, 5, 6), "version list loaded");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, ",,7.0.0,") == ARUPDATER_OK) && ARUPDATER_Blacklist_Contains(blacklist, product, 7, 0, 0), "empty list items skipped");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, "") == ARUPDATER_OK), "empty version list");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, "8.0.0,8.1,8.2.0") == ARUPDATER_ERROR_BAD_PARAMETER) && ARUPDATER_Blacklist_Contains(blacklist, product, 8, 0, 0) && !ARUPDATER_Blacklist_Contains(blacklist, product, 8, 2, 0), "truncated version stops the list");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, "9.0.0x") == ARUPDATER_ERROR_BAD_PARAMETER) && !ARUPDATER_Blacklist_Contains(blacklist, product, 9, 0, 0), "version with trailing garbage refused");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, "-9.0.0") == ARUPDATER_ERROR_BAD_PARAMETER), "negative version refused");
+    blacklistTest_check((ARUPDATER_Blacklist_AddVersionList(blacklist, product, NULL) == ARUPDATER_ERROR_BAD_PARAMETER), "null version list refused");
+    ARUPDATER_Blacklist_Delete(&blacklist);
+
+    // files
+    blacklist = ARUPDATER_Blacklist_New(NULL);
+    blacklistTest_writeFile("# comment %1$04x 9.9.9\n\n%1$04x 3.1.0,3.1.1\r\n%2$04x 2.0.0\nffff 5.0.0\n%2$04x\n", product, otherProduct);
+    blacklistTest_check((ARUPDATER_Blacklist_LoadFile(blacklist, BLACKLISTTEST_FILE_PATH) == ARUPDATER_OK), "blacklist file loaded");
+    blacklistTest_check(ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 0) && ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 1) && ARUPDATER_Blacklist_Contains(blacklist, otherProduct, 2, 0, 0), "versions of the file found");
+    blacklistTest_check(!ARUPDATER_Blacklist_Contains(blacklist, product, 9, 9, 9) && !ARUPDATER_Blacklist_Contains(blacklist, otherProduct, 3, 1, 0), "comments and other products ignored");
+    ARUPDATER_Blacklist_Delete(&blacklist);
+
+    blacklist = ARUPDATER_Blacklist_New(NULL);
+    blacklistTest_writeFile("%1$04x 3.1.0\n%2$04x 2.0\n%1$04x 4.0.0\n", product, otherProduct);
+    blacklistTest_check((ARUPDATER_Blacklist_LoadFile(blacklist, BLACKLISTTEST_FILE_PATH) == ARUPDATER_ERROR_BAD_PARAMETER), "file with a corrupted version refused");
+    blacklistTest_check(ARUPDATER_Blacklist_Contains(blacklist, product, 3, 1, 0), "lines before the corrupted one kept");
+    ARUPDATER_Blacklist_Delete(&blacklist);
+
+    blacklist = ARUPDATER_Blacklist_New(NULL);
+    blacklistTest_writeFile("%2$04x 1.0.0\n%1$04x 3.1.0,3.2.0", product, otherProduct);
+    blacklistTest_check((ARUPDATER_Blacklist_LoadFile(blacklist, BLACKLISTTEST_FILE_PATH) == ARUPDATER_OK) && ARUPDATER_Blacklist_Contains(blacklist, product, 3, 2, 0), "last line without line end loaded");
+    unlink(BLACKLISTTEST_FILE_PATH);
+    blacklistTest_check((ARUPDATER_Blacklist_LoadFile(blacklist, BLACKLISTTEST_FILE_PATH) == ARUPDATER_ERROR_SYSTEM), "missing file");
+    ARUPDATER_Blacklist_Delete(&blacklist);
+
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
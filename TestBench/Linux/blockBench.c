@@ -0,0 +1,247 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file blockBench.c
+ * @brief libARUpdater TestBench throughput of the plf upload with fixed and adaptive block sizes and several streams, against a local ftp server with a shaped link
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARSAL/ARSAL.h>
+#include <libARUtils/ARUtils.h>
+#include "ftpServer.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define BLOCKBENCH_FOLDER               "/tmp/blockBench/"
+#define BLOCKBENCH_ROOT_FOLDER          BLOCKBENCH_FOLDER "root/"
+#define BLOCKBENCH_DEVICE_FOLDER        BLOCKBENCH_FOLDER "device/"
+#define BLOCKBENCH_PRODUCT              ARDISCOVERY_PRODUCT_MINIDRONE
+#define BLOCKBENCH_UPLOADED_SUFFIX      ".tmp"
+#define BLOCKBENCH_PATH_SIZE            512
+
+/**
+ * @brief How the plf is sent
+ */
+typedef struct
+{
+    const char *name;
+    int isFtpClient;    /**< 0 to send through ARDataTransfer */
+    int blockSize;      /**< 0 to adapt it to the link */
+    int streamCount;
+} BLOCKBENCH_Mode_t;
+
+static const BLOCKBENCH_Mode_t blockBenchModes[] =
+{
+    { "ARDataTransfer",    0, 0,           1 },
+    { "fixed 16 KB",       1, 16 * 1024,   1 },
+    { "fixed 1 MB",        1, 1024 * 1024, 1 },
+    { "adaptive",          1, 0,           1 },
+    { "adaptive x2",       1, 0,           2 },
+    { "adaptive x4",       1, 0,           4 },
+};
+
+static const int64_t blockBenchDefaultRates[] = { 0, 8 * 1024 * 1024, 1024 * 1024, 256 * 1024 };
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int64_t blockBench_nowUs(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void blockBench_run(const BLOCKBENCH_Mode_t *mode, ARUTILS_Manager_t *ftpManager, ARSAL_MD5_Manager_t *md5Manager, int port, const char *plfPath, const char *plfName, int64_t plfSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Manager_t *manager = NULL;
+    ARUPDATER_Uploader_TransferStats_t stats;
+    char command[BLOCKBENCH_PATH_SIZE * 2];
+    int64_t startUs = 0;
+    int64_t durationUs = 0;
+    int isVerified = 0;
+
+    memset(&stats, 0, sizeof(stats));
+
+    // an empty device, nothing is resumed
+    if (system("rm -f " BLOCKBENCH_DEVICE_FOLDER "*") != 0)
+    {
+        return;
+    }
+
+    manager = ARUPDATER_Manager_New(&error);
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Uploader_New(manager, BLOCKBENCH_ROOT_FOLDER, ftpManager, md5Manager, BLOCKBENCH_PRODUCT, NULL, NULL, NULL, NULL);
+    }
+    if ((error == ARUPDATER_OK) && (mode->isFtpClient))
+    {
+        error = ARUPDATER_Uploader_SetFtpTarget(manager, "127.0.0.1", port, "", "");
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_SetBlockSize(manager, mode->blockSize);
+        }
+        if (error == ARUPDATER_OK)
+        {
+            error = ARUPDATER_Uploader_SetStreamCount(manager, mode->streamCount);
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        startUs = blockBench_nowUs();
+        error = (eARUPDATER_ERROR)(intptr_t)ARUPDATER_Uploader_ThreadRun(manager);
+        durationUs = blockBench_nowUs() - startUs;
+        ARUPDATER_Uploader_GetTransferStats(manager, &stats);
+        ARUPDATER_Uploader_Delete(manager);
+    }
+    ARUPDATER_Manager_Delete(&manager);
+
+    snprintf(command, sizeof(command), "cmp -s %s " BLOCKBENCH_DEVICE_FOLDER "%s", plfPath, plfName);
+    isVerified = ((error == ARUPDATER_OK) && (system(command) == 0));
+
+    printf("  %-16s %8.2f s %8.2f MB/s   block %8d   send buffer %8d   rtt %6d us   adaptations %3d   %s\n",
+           mode->name, durationUs / 1000000.0, (durationUs > 0) ? plfSize / (durationUs / 1000000.0) / (1024 * 1024) : 0.0,
+           stats.blockSize, stats.socketBufferSize, stats.rttUs, stats.adaptationCount,
+           (isVerified) ? "verified" : ARUPDATER_Error_ToString(error));
+}
+
+int main(int argc, char *argv[])
+{
+    const char *plfPath = (argc > 1) ? argv[1] : NULL;
+    const char *plfName = NULL;
+    char productFolder[BLOCKBENCH_PATH_SIZE];
+    char command[BLOCKBENCH_PATH_SIZE * 3];
+    struct stat statbuf;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARSAL_ERROR arsalError = ARSAL_OK;
+    eARUTILS_ERROR ftpError = ARUTILS_OK;
+    ARSAL_MD5_Manager_t *md5Manager = NULL;
+    ARUTILS_Manager_t *ftpManager = NULL;
+    FTPSERVER_t *server = NULL;
+    int rateCount = (argc > 2) ? argc - 2 : (int)(sizeof(blockBenchDefaultRates) / sizeof(blockBenchDefaultRates[0]));
+    int i = 0;
+    int j = 0;
+
+    if ((plfPath == NULL) || (stat(plfPath, &statbuf) != 0))
+    {
+        fprintf(stderr, "usage: %s <plf file> [link rate in KB/s, 0 for none]...\n", argv[0]);
+        return 1;
+    }
+    plfName = strrchr(plfPath, '/');
+    plfName = (plfName != NULL) ? plfName + 1 : plfPath;
+
+    // the plf to upload in the product folder
+    snprintf(productFolder, sizeof(productFolder), BLOCKBENCH_ROOT_FOLDER "plfFolder/%04x/", ARDISCOVERY_getProductID(BLOCKBENCH_PRODUCT));
+    snprintf(command, sizeof(command), "rm -rf " BLOCKBENCH_FOLDER " && mkdir -p %s " BLOCKBENCH_DEVICE_FOLDER " && cp %s %s", productFolder, plfPath, productFolder);
+    if (system(command) != 0)
+    {
+        return 1;
+    }
+
+    server = FTPSERVER_New(BLOCKBENCH_DEVICE_FOLDER, 0, BLOCKBENCH_UPLOADED_SUFFIX);
+    md5Manager = ARSAL_MD5_Manager_New(&arsalError);
+    ftpManager = ARUTILS_Manager_New(&ftpError);
+    if ((server == NULL) || (arsalError != ARSAL_OK) || (ftpError != ARUTILS_OK))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_MD5_Manager_Init(md5Manager);
+        if (ARUTILS_Manager_InitWifiFtp(ftpManager, "127.0.0.1", FTPSERVER_GetPort(server), "", "") != ARUTILS_OK)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        printf("%s (%lld bytes) uploaded to a local ftp server\n", plfName, (long long)statbuf.st_size);
+
+        for (i = 0; i < rateCount; i++)
+        {
+            int64_t rate = (argc > 2) ? strtoll(argv[i + 2], NULL, 10) * 1024 : blockBenchDefaultRates[i];
+
+            // the server does not read a connection faster than the rate, as the window of a slow radio link
+            FTPSERVER_SetMaxRate(server, rate);
+            if (rate > 0)
+            {
+                printf("link of %lld KB/s\n", (long long)(rate / 1024));
+            }
+            else
+            {
+                printf("unshaped link\n");
+            }
+
+            for (j = 0; j < (int)(sizeof(blockBenchModes) / sizeof(blockBenchModes[0])); j++)
+            {
+                blockBench_run(&blockBenchModes[j], ftpManager, md5Manager, FTPSERVER_GetPort(server), plfPath, plfName, statbuf.st_size);
+            }
+        }
+    }
+    else
+    {
+        fprintf(stderr, "error: %s\n", ARUPDATER_Error_ToString(error));
+    }
+
+    if (ftpManager != NULL)
+    {
+        ARUTILS_Manager_CloseWifiFtp(ftpManager);
+        ARUTILS_Manager_Delete(&ftpManager);
+    }
+    ARSAL_MD5_Manager_Delete(&md5Manager);
+    FTPSERVER_Delete(&server);
+
+    return (error == ARUPDATER_OK) ? 0 : 1;
+}
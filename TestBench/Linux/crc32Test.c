@@ -0,0 +1,186 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file crc32Test.c
+ * @brief libARUpdater TestBench checks of the CRC32 against fixed vectors and a bitwise reference
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "ARUPDATER_Crc32.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define CRC32TEST_BUFFER_SIZE           4096
+#define CRC32TEST_LARGE_SIZE            (1024 * 1024 + 13)
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void crc32Test_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+/**
+ * @brief bit by bit CRC32, the reference of the accelerated paths
+ */
+static uint32_t crc32Test_reference(uint32_t crc, const uint8_t *data, size_t size)
+{
+    size_t i = 0;
+    int bit = 0;
+
+    crc = ~crc;
+    for (i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+
+    return ~crc;
+}
+
+static uint32_t crc32Test_string(const char *string)
+{
+    return ARUPDATER_Crc32_Update(0, (const uint8_t *)string, strlen(string));
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t buffer[CRC32TEST_BUFFER_SIZE + 16];
+    uint8_t *large = NULL;
+    uint32_t expected = 0;
+    uint32_t crc = 0;
+    size_t offset = 0;
+    size_t size = 0;
+    size_t split = 0;
+    int isValid = 0;
+
+    // fixed vectors
+    crc32Test_check((ARUPDATER_Crc32_Update(0, NULL, 0) == 0), "empty buffer");
+    crc32Test_check((crc32Test_string("a") == 0xe8b7be43), "\"a\"");
+    crc32Test_check((crc32Test_string("123456789") == 0xcbf43926), "\"123456789\"");
+    crc32Test_check((crc32Test_string("The quick brown fox jumps over the lazy dog") == 0x414fa339), "quick brown fox");
+    memset(buffer, 0, 32);
+    crc32Test_check((ARUPDATER_Crc32_Update(0, buffer, 32) == 0x190a55ad), "32 zero bytes");
+    memset(buffer, 0xff, 32);
+    crc32Test_check((ARUPDATER_Crc32_Update(0, buffer, 32) == 0xff6cab0b), "32 0xff bytes");
+
+    // every size and alignment around the word and folding blocks
+    for (size = 0; size < sizeof(buffer); size++)
+    {
+        buffer[size] = (uint8_t)(size * 31 + 7);
+    }
+    isValid = 1;
+    for (offset = 0; offset < 16; offset++)
+    {
+        for (size = 0; size <= 300; size++)
+        {
+            isValid = isValid && (ARUPDATER_Crc32_Update(0, buffer + offset, size) == crc32Test_reference(0, buffer + offset, size));
+        }
+    }
+    crc32Test_check(isValid, "sizes and alignments match the reference");
+    crc32Test_check((ARUPDATER_Crc32_Update(0, buffer, CRC32TEST_BUFFER_SIZE) == crc32Test_reference(0, buffer, CRC32TEST_BUFFER_SIZE)), "4096 bytes match the reference");
+
+    // split updates give the CRC of the whole buffer
+    expected = ARUPDATER_Crc32_Update(0, buffer, 1000);
+    isValid = 1;
+    for (split = 0; split <= 1000; split++)
+    {
+        crc = ARUPDATER_Crc32_Update(0, buffer, split);
+        isValid = isValid && (ARUPDATER_Crc32_Update(crc, buffer + split, 1000 - split) == expected);
+    }
+    crc32Test_check(isValid, "split at every offset");
+    crc = 0;
+    for (offset = 0; offset < 1000; offset++)
+    {
+        crc = ARUPDATER_Crc32_Update(crc, buffer + offset, 1);
+    }
+    crc32Test_check((crc == expected), "byte by byte");
+    crc = ARUPDATER_Crc32_Update(0, (const uint8_t *)"12345", 5);
+    crc32Test_check((ARUPDATER_Crc32_Update(crc, (const uint8_t *)"6789", 4) == 0xcbf43926), "\"12345\" then \"6789\"");
+
+    // corrupt and truncated data
+    isValid = 1;
+    for (offset = 0; offset < 1000; offset += 37)
+    {
+        buffer[offset] ^= 0x10;
+        isValid = isValid && (ARUPDATER_Crc32_Update(0, buffer, 1000) != expected);
+        buffer[offset] ^= 0x10;
+    }
+    crc32Test_check(isValid, "flipped bit detected");
+    crc32Test_check((ARUPDATER_Crc32_Update(0, buffer, 999) != expected) && (ARUPDATER_Crc32_Update(0, buffer + 1, 999) != expected), "truncated data detected");
+    crc32Test_check((ARUPDATER_Crc32_Update(0, buffer, 1000) == expected), "data restored");
+
+    // a large unaligned buffer, as a plf section
+    large = malloc(CRC32TEST_LARGE_SIZE + 1);
+    if (large != NULL)
+    {
+        for (size = 0; size <= CRC32TEST_LARGE_SIZE; size++)
+        {
+            large[size] = (uint8_t)((size >> 8) ^ (size * 13));
+        }
+        crc32Test_check((ARUPDATER_Crc32_Update(0, large + 1, CRC32TEST_LARGE_SIZE) == crc32Test_reference(0, large + 1, CRC32TEST_LARGE_SIZE)), "large buffer matches the reference");
+        free(large);
+    }
+    else
+    {
+        crc32Test_check(0, "large buffer allocated");
+    }
+
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file fileIOBench.c
+ * @brief libARUpdater TestBench file io backends on a storage
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_FileIO.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define FILEIOBENCH_DEFAULT_FOLDER      "/tmp/"
+#define FILEIOBENCH_DEFAULT_SIZE_MB     64
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+int main(int argc, char *argv[])
+{
+    const char *folder = (argc > 1) ? argv[1] : FILEIOBENCH_DEFAULT_FOLDER;
+    int64_t sizeMB = (argc > 2) ? atoi(argv[2]) : FILEIOBENCH_DEFAULT_SIZE_MB;
+    int backend = 0;
+
+    if ((sizeMB <= 0) || (folder[0] == '\0') || (folder[strlen(folder) - 1] != '/'))
+    {
+        fprintf(stderr, "usage: %s [folder ended by /] [size in MB]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%lld MB written in 16 KB pieces and synced, then read in %d KB blocks, in %s\n", (long long)sizeMB, ARUPDATER_FILEIO_BLOCK_SIZE / 1024, folder);
+
+    for (backend = ARUPDATER_FILEIO_BACKEND_PWRITE; backend < ARUPDATER_FILEIO_BACKEND_MAX; backend++)
+    {
+        int64_t writeTimeUs = 0;
+        int64_t readTimeUs = 0;
+        eARUPDATER_ERROR error = ARUPDATER_OK;
+
+        if (ARUPDATER_FileIO_IsAvailable(backend) == 0)
+        {
+            printf("%-10s not available\n", ARUPDATER_FileIO_GetBackendName(backend));
+            continue;
+        }
+
+        error = ARUPDATER_FileIO_Benchmark(folder, backend, sizeMB * 1024 * 1024, &writeTimeUs, &readTimeUs);
+        if (error != ARUPDATER_OK)
+        {
+            printf("%-10s failed: %s\n", ARUPDATER_FileIO_GetBackendName(backend), ARUPDATER_Error_ToString(error));
+            continue;
+        }
+
+        printf("%-10s write %8.1f MB/s   read %8.1f MB/s\n", ARUPDATER_FileIO_GetBackendName(backend), sizeMB * 1e6 / writeTimeUs, sizeMB * 1e6 / readTimeUs);
+    }
+
+    printf("selected for the downloads: %s\n", ARUPDATER_FileIO_GetBackendName(ARUPDATER_FileIO_SelectBackend(folder)));
+
+    return 0;
+}
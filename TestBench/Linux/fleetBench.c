@@ -0,0 +1,256 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file fleetBench.c
+ * @brief libARUpdater TestBench update of a fleet of fake products, served by local ftp servers
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include <libARUpdater/ARUPDATER_Fleet.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARSAL/ARSAL.h>
+#include <libARUtils/ARUtils.h>
+#include "ftpServer.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define FLEETBENCH_FOLDER               "/tmp/fleetBench/"
+#define FLEETBENCH_ROOT_FOLDER          FLEETBENCH_FOLDER "root/"
+#define FLEETBENCH_DEVICE_FOLDER        FLEETBENCH_FOLDER "device%03d/"
+#define FLEETBENCH_UPLOADED_SUFFIX      ".tmp"
+#define FLEETBENCH_DEFAULT_DEVICES      128
+#define FLEETBENCH_DEFAULT_RATE_KB      0
+#define FLEETBENCH_PATH_SIZE            512
+
+/* the devices are split between these products */
+static const eARDISCOVERY_PRODUCT fleetBench_products[] = { ARDISCOVERY_PRODUCT_MINIDRONE, ARDISCOVERY_PRODUCT_JS };
+#define FLEETBENCH_PRODUCT_COUNT        (int)(sizeof(fleetBench_products) / sizeof(fleetBench_products[0]))
+
+static const int fleetBench_concurrentUploads[] = { 1, 8, 32, 64 };
+#define FLEETBENCH_RUN_COUNT            (int)(sizeof(fleetBench_concurrentUploads) / sizeof(fleetBench_concurrentUploads[0]))
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int fleetBench_system(const char *format, const char *arg)
+{
+    char command[FLEETBENCH_PATH_SIZE * 2];
+
+    snprintf(command, sizeof(command), format, arg);
+    return (system(command) == 0);
+}
+
+/**
+ * @brief Count the devices holding a renamed plf of the expected size
+ */
+static int fleetBench_countUpdated(int deviceCount, const char *plfName, long long plfSize)
+{
+    char path[FLEETBENCH_PATH_SIZE];
+    struct stat statbuf;
+    int count = 0;
+    int i = 0;
+
+    for (i = 0; i < deviceCount; i++)
+    {
+        snprintf(path, sizeof(path), FLEETBENCH_DEVICE_FOLDER "%s", i, plfName);
+        if ((stat(path, &statbuf) == 0) && ((long long)statbuf.st_size == plfSize))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+static void fleetBench_run(int maxConcurrentUploads, int deviceCount, ARUTILS_Manager_t **ftpManagers, ARSAL_MD5_Manager_t *md5Manager, const char *plfName, long long plfSize)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Fleet_t *fleet = NULL;
+    ARUPDATER_Fleet_Summary_t summary;
+    ARUPDATER_Fleet_DeviceStatus_t status;
+    int64_t maxUploadTimeUs = 0;
+    int64_t totalUploadTimeUs = 0;
+    int i = 0;
+
+    // every device starts without any plf
+    fleetBench_system("rm -f %sdevice*/*", FLEETBENCH_FOLDER);
+
+    fleet = ARUPDATER_Fleet_New(FLEETBENCH_ROOT_FOLDER, md5Manager, maxConcurrentUploads, NULL, NULL, &error);
+    for (i = 0; (error == ARUPDATER_OK) && (i < deviceCount); i++)
+    {
+        ARUPDATER_Fleet_AddDevice(fleet, ftpManagers[i], fleetBench_products[i % FLEETBENCH_PRODUCT_COUNT], &error);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = (eARUPDATER_ERROR)(intptr_t)ARUPDATER_Fleet_ThreadRun(fleet);
+        ARUPDATER_Fleet_GetSummary(fleet, &summary);
+
+        for (i = 0; i < deviceCount; i++)
+        {
+            ARUPDATER_Fleet_GetDeviceStatus(fleet, i, &status);
+            totalUploadTimeUs += status.uploadTimeUs;
+            if (status.uploadTimeUs > maxUploadTimeUs)
+            {
+                maxUploadTimeUs = status.uploadTimeUs;
+            }
+        }
+
+        printf("%3d concurrent uploads  %8.2f s  %7.1f MB/s   done %3d  failed %3d  canceled %3d  verified %3d   device upload avg %6.2f s max %6.2f s   %s\n",
+               maxConcurrentUploads, summary.uploadTimeUs / 1e6,
+               (summary.uploadTimeUs > 0) ? (double)plfSize * summary.stateCount[ARUPDATER_FLEET_DEVICE_STATE_DONE] / summary.uploadTimeUs : 0.,
+               summary.stateCount[ARUPDATER_FLEET_DEVICE_STATE_DONE], summary.stateCount[ARUPDATER_FLEET_DEVICE_STATE_FAILED], summary.stateCount[ARUPDATER_FLEET_DEVICE_STATE_CANCELED],
+               fleetBench_countUpdated(deviceCount, plfName, plfSize),
+               totalUploadTimeUs / 1e6 / deviceCount, maxUploadTimeUs / 1e6, ARUPDATER_Error_ToString(error));
+    }
+    else
+    {
+        fprintf(stderr, "error: %s\n", ARUPDATER_Error_ToString(error));
+    }
+
+    ARUPDATER_Fleet_Delete(&fleet);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *plfPath = (argc > 1) ? argv[1] : NULL;
+    int deviceCount = (argc > 2) ? atoi(argv[2]) : FLEETBENCH_DEFAULT_DEVICES;
+    int rateKB = (argc > 3) ? atoi(argv[3]) : FLEETBENCH_DEFAULT_RATE_KB;
+    const char *plfName = NULL;
+    char path[FLEETBENCH_PATH_SIZE];
+    struct stat statbuf;
+    int ok = 1;
+    int i = 0;
+    eARSAL_ERROR arsalError = ARSAL_OK;
+    eARUTILS_ERROR ftpError = ARUTILS_OK;
+    ARSAL_MD5_Manager_t *md5Manager = NULL;
+    FTPSERVER_t **servers = NULL;
+    ARUTILS_Manager_t **ftpManagers = NULL;
+
+    if ((plfPath == NULL) || (stat(plfPath, &statbuf) != 0) || (deviceCount < 1))
+    {
+        fprintf(stderr, "usage: %s <plf file> [device count (%d)] [rate of a device in KB/s, 0 for no limit (%d)]\n", argv[0], FLEETBENCH_DEFAULT_DEVICES, FLEETBENCH_DEFAULT_RATE_KB);
+        return 1;
+    }
+    plfName = strrchr(plfPath, '/');
+    plfName = (plfName != NULL) ? plfName + 1 : plfPath;
+
+    // the plf of each product in its folder
+    ok = fleetBench_system("rm -rf %s", FLEETBENCH_FOLDER);
+    for (i = 0; ok && (i < FLEETBENCH_PRODUCT_COUNT); i++)
+    {
+        snprintf(path, sizeof(path), FLEETBENCH_ROOT_FOLDER "plfFolder/%04x/", ARDISCOVERY_getProductID(fleetBench_products[i]));
+        if (fleetBench_system("mkdir -p %s", path))
+        {
+            char command[FLEETBENCH_PATH_SIZE * 2];
+            snprintf(command, sizeof(command), "cp '%s' '%s'", plfPath, path);
+            ok = (system(command) == 0);
+        }
+        else
+        {
+            ok = 0;
+        }
+    }
+
+    // one ftp server and one ftp manager per fake device
+    servers = calloc(deviceCount, sizeof(FTPSERVER_t *));
+    ftpManagers = calloc(deviceCount, sizeof(ARUTILS_Manager_t *));
+    md5Manager = ARSAL_MD5_Manager_New(&arsalError);
+    ok = ok && (servers != NULL) && (ftpManagers != NULL) && (arsalError == ARSAL_OK);
+    if (ok)
+    {
+        ARSAL_MD5_Manager_Init(md5Manager);
+    }
+    for (i = 0; ok && (i < deviceCount); i++)
+    {
+        snprintf(path, sizeof(path), FLEETBENCH_DEVICE_FOLDER, i);
+        ok = fleetBench_system("mkdir -p %s", path);
+        servers[i] = ok ? FTPSERVER_New(path, 0, FLEETBENCH_UPLOADED_SUFFIX) : NULL;
+        ftpManagers[i] = (servers[i] != NULL) ? ARUTILS_Manager_New(&ftpError) : NULL;
+        ok = (ftpManagers[i] != NULL) && (ftpError == ARUTILS_OK) &&
+             (ARUTILS_Manager_InitWifiFtp(ftpManagers[i], "127.0.0.1", FTPSERVER_GetPort(servers[i]), "", "") == ARUTILS_OK);
+        if (servers[i] != NULL)
+        {
+            FTPSERVER_SetMaxRate(servers[i], (int64_t)rateKB * 1024);
+        }
+    }
+
+    if (ok)
+    {
+        printf("%s (%lld bytes) uploaded to %d local devices of %d products, %s\n", plfName, (long long)statbuf.st_size, deviceCount, FLEETBENCH_PRODUCT_COUNT, (rateKB > 0) ? "rate limited" : "no rate limit");
+        for (i = 0; i < FLEETBENCH_RUN_COUNT; i++)
+        {
+            if ((i == 0) || (fleetBench_concurrentUploads[i - 1] < deviceCount))
+            {
+                fleetBench_run(fleetBench_concurrentUploads[i], deviceCount, ftpManagers, md5Manager, plfName, (long long)statbuf.st_size);
+            }
+        }
+    }
+    else
+    {
+        fprintf(stderr, "the fleet can not be set up\n");
+    }
+
+    for (i = 0; i < deviceCount; i++)
+    {
+        if ((ftpManagers != NULL) && (ftpManagers[i] != NULL))
+        {
+            ARUTILS_Manager_CloseWifiFtp(ftpManagers[i]);
+            ARUTILS_Manager_Delete(&ftpManagers[i]);
+        }
+        if (servers != NULL)
+        {
+            FTPSERVER_Delete(&servers[i]);
+        }
+    }
+    free(ftpManagers);
+    free(servers);
+    ARSAL_MD5_Manager_Delete(&md5Manager);
+
+    return ok ? 0 : 1;
+}
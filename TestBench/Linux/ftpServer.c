@@ -0,0 +1,697 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ftpServer.c
+ * @brief libARUpdater TestBench minimal local ftp server
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "ftpServer.h"
+#include "ARUPDATER_Hash.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define FTPSERVER_LINE_SIZE             1024
+#define FTPSERVER_PATH_SIZE             1024
+#define FTPSERVER_LOCAL_PATH_SIZE       (2 * FTPSERVER_PATH_SIZE)
+#define FTPSERVER_BUFFER_SIZE           (64 * 1024)
+
+struct FTPSERVER_t
+{
+    char rootFolder[FTPSERVER_PATH_SIZE];
+    char payloadSuffix[64];
+    int listenFd;
+    int port;
+    int isStopped;
+    int64_t maxRate; /**< bytes per second stored by a connection, 0 for no limit */
+    int hasDigest; /**< XMD5 is listed by FEAT and answered */
+    pthread_t acceptThread;
+    pthread_mutex_t lock;
+    struct timespec statsStart;
+    FTPSERVER_Stats_t stats;
+};
+
+typedef struct
+{
+    FTPSERVER_t *server;
+    int controlFd;
+    int passiveFd;
+    int64_t restOffset;
+    char renameFrom[FTPSERVER_LOCAL_PATH_SIZE];
+} FTPSERVER_Session_t;
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int64_t FTPSERVER_ElapsedUs(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000000LL + (now.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void FTPSERVER_Reply(FTPSERVER_Session_t *session, const char *reply)
+{
+    size_t length = strlen(reply);
+    if (send(session->controlFd, reply, length, MSG_NOSIGNAL) != (ssize_t)length)
+    {
+        // the client is gone, the next read ends the session
+    }
+}
+
+static int FTPSERVER_ReadLine(int fd, char *line, size_t size)
+{
+    size_t length = 0;
+    char c = 0;
+
+    while (read(fd, &c, 1) == 1)
+    {
+        if (c == '\n')
+        {
+            if ((length > 0) && (line[length - 1] == '\r'))
+            {
+                length--;
+            }
+            line[length] = '\0';
+            return 1;
+        }
+        if (length < size - 1)
+        {
+            line[length++] = c;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief map a path of the client in the served folder, ".." is refused
+ */
+static int FTPSERVER_LocalPath(FTPSERVER_Session_t *session, const char *path, char *localPath)
+{
+    if ((path == NULL) || (strstr(path, "..") != NULL))
+    {
+        return 0;
+    }
+    while (path[0] == '/')
+    {
+        path++;
+    }
+    snprintf(localPath, FTPSERVER_LOCAL_PATH_SIZE, "%s/%s", session->server->rootFolder, path);
+    return 1;
+}
+
+static int FTPSERVER_OpenPassive(FTPSERVER_Session_t *session)
+{
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+
+    if (session->passiveFd >= 0)
+    {
+        close(session->passiveFd);
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    session->passiveFd = socket(AF_INET, SOCK_STREAM, 0);
+    if ((session->passiveFd < 0) ||
+        (bind(session->passiveFd, (struct sockaddr *)&address, sizeof(address)) != 0) ||
+        (listen(session->passiveFd, 1) != 0) ||
+        (getsockname(session->passiveFd, (struct sockaddr *)&address, &addressLength) != 0))
+    {
+        return -1;
+    }
+
+    return ntohs(address.sin_port);
+}
+
+static int FTPSERVER_AcceptData(FTPSERVER_Session_t *session)
+{
+    int dataFd = -1;
+
+    if (session->passiveFd >= 0)
+    {
+        dataFd = accept(session->passiveFd, NULL, NULL);
+        close(session->passiveFd);
+        session->passiveFd = -1;
+    }
+
+    if (dataFd >= 0)
+    {
+        pthread_mutex_lock(&session->server->lock);
+        session->server->stats.dataConnections++;
+        pthread_mutex_unlock(&session->server->lock);
+    }
+
+    return dataFd;
+}
+
+static void FTPSERVER_Retrieve(FTPSERVER_Session_t *session, const char *localPath)
+{
+    char *buffer = NULL;
+    int fd = open(localPath, O_RDONLY);
+    int dataFd = -1;
+    int isAborted = 0;
+    ssize_t size = 0;
+
+    if (fd < 0)
+    {
+        FTPSERVER_Reply(session, "550 No such file\r\n");
+        return;
+    }
+
+    FTPSERVER_Reply(session, "150 Opening data connection\r\n");
+    dataFd = FTPSERVER_AcceptData(session);
+    buffer = malloc(FTPSERVER_BUFFER_SIZE);
+    lseek(fd, session->restOffset, SEEK_SET);
+    while ((dataFd >= 0) && (buffer != NULL) && ((size = read(fd, buffer, FTPSERVER_BUFFER_SIZE)) > 0))
+    {
+        // a client which reads only a part of the file closes the connection before its end
+        if (send(dataFd, buffer, size, MSG_NOSIGNAL) != size)
+        {
+            isAborted = 1;
+            break;
+        }
+    }
+    free(buffer);
+    close(fd);
+    if (dataFd >= 0)
+    {
+        close(dataFd);
+    }
+    FTPSERVER_Reply(session, (dataFd < 0) ? "425 No data connection\r\n" : ((isAborted) ? "426 Transfer aborted\r\n" : "226 Transfer complete\r\n"));
+}
+
+/**
+ * @brief reply the md5 of the part of a file from start to end, to its end if end is negative
+ */
+static void FTPSERVER_Digest(FTPSERVER_Session_t *session, const char *localPath, int64_t start, int64_t end)
+{
+    ARUPDATER_Hash_Context_t context;
+    uint8_t digest[ARUPDATER_MD5_DIGEST_SIZE];
+    char hex[2 * ARUPDATER_MD5_DIGEST_SIZE + 1];
+    char reply[FTPSERVER_LINE_SIZE];
+    char *buffer = malloc(FTPSERVER_BUFFER_SIZE);
+    int fd = open(localPath, O_RDONLY);
+    ssize_t size = 0;
+
+    if ((fd < 0) || (buffer == NULL) || (ARUPDATER_Hash_Init(&context, ARUPDATER_HASH_MD5) != ARUPDATER_OK))
+    {
+        FTPSERVER_Reply(session, "550 No such file\r\n");
+    }
+    else
+    {
+        while (((end < 0) || (start < end)) && ((size = pread(fd, buffer, ((end < 0) || (end - start > FTPSERVER_BUFFER_SIZE)) ? FTPSERVER_BUFFER_SIZE : (size_t)(end - start), start)) > 0))
+        {
+            ARUPDATER_Hash_Update(&context, (uint8_t *)buffer, size);
+            start += size;
+        }
+        ARUPDATER_Hash_Final(&context, digest);
+        ARUPDATER_Hash_ToHex(digest, sizeof(digest), hex);
+        snprintf(reply, sizeof(reply), "250 %s\r\n", hex);
+        FTPSERVER_Reply(session, reply);
+    }
+
+    free(buffer);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+static void FTPSERVER_Store(FTPSERVER_Session_t *session, const char *localPath, int isAppend)
+{
+    FTPSERVER_t *server = session->server;
+    size_t suffixLength = strlen(server->payloadSuffix);
+    size_t pathLength = strlen(localPath);
+    int isPayload = ((suffixLength > 0) && (pathLength >= suffixLength) && (strcmp(localPath + pathLength - suffixLength, server->payloadSuffix) == 0));
+    int flags = O_WRONLY | O_CREAT | ((isAppend) ? O_APPEND : ((session->restOffset > 0) ? 0 : O_TRUNC));
+    char *buffer = NULL;
+    int fd = open(localPath, flags, 0644);
+    int dataFd = -1;
+    ssize_t size = 0;
+    struct timespec start;
+    int64_t storedSize = 0;
+    int64_t aheadUs = 0;
+
+    if (fd < 0)
+    {
+        FTPSERVER_Reply(session, "553 Can not create file\r\n");
+        return;
+    }
+
+    FTPSERVER_Reply(session, "150 Opening data connection\r\n");
+    dataFd = FTPSERVER_AcceptData(session);
+    buffer = malloc(FTPSERVER_BUFFER_SIZE);
+    if (isAppend == 0)
+    {
+        lseek(fd, session->restOffset, SEEK_SET);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while ((dataFd >= 0) && (buffer != NULL) && ((size = read(dataFd, buffer, FTPSERVER_BUFFER_SIZE)) > 0))
+    {
+        if (isPayload)
+        {
+            pthread_mutex_lock(&server->lock);
+            if (server->stats.firstPayloadByteUs < 0)
+            {
+                server->stats.firstPayloadByteUs = FTPSERVER_ElapsedUs(&server->statsStart);
+            }
+            server->stats.payloadBytes += size;
+            pthread_mutex_unlock(&server->lock);
+        }
+        if (write(fd, buffer, size) != size)
+        {
+            break;
+        }
+
+        // a slow link is emulated by not reading faster than its rate, the tcp window fills up on the client side
+        storedSize += size;
+        if (server->maxRate > 0)
+        {
+            aheadUs = storedSize * 1000000 / server->maxRate - FTPSERVER_ElapsedUs(&start);
+            if (aheadUs > 0)
+            {
+                usleep((useconds_t)aheadUs);
+            }
+        }
+    }
+    free(buffer);
+    close(fd);
+    if (dataFd >= 0)
+    {
+        close(dataFd);
+    }
+    FTPSERVER_Reply(session, (dataFd >= 0) ? "226 Transfer complete\r\n" : "425 No data connection\r\n");
+}
+
+static void FTPSERVER_List(FTPSERVER_Session_t *session, const char *localPath)
+{
+    DIR *dir = opendir(localPath);
+    struct dirent *entry = NULL;
+    int dataFd = -1;
+
+    if (dir == NULL)
+    {
+        FTPSERVER_Reply(session, "550 No such folder\r\n");
+        return;
+    }
+
+    FTPSERVER_Reply(session, "150 Here comes the listing\r\n");
+    dataFd = FTPSERVER_AcceptData(session);
+    while ((dataFd >= 0) && ((entry = readdir(dir)) != NULL))
+    {
+        char line[FTPSERVER_LINE_SIZE];
+        int length = 0;
+        if (entry->d_name[0] == '.')
+        {
+            continue;
+        }
+        length = snprintf(line, sizeof(line), "%s\r\n", entry->d_name);
+        if (send(dataFd, line, length, MSG_NOSIGNAL) != length)
+        {
+            break;
+        }
+    }
+    closedir(dir);
+    if (dataFd >= 0)
+    {
+        close(dataFd);
+    }
+    FTPSERVER_Reply(session, (dataFd >= 0) ? "226 Transfer complete\r\n" : "425 No data connection\r\n");
+}
+
+static void *FTPSERVER_Session(void *arg)
+{
+    FTPSERVER_Session_t *session = (FTPSERVER_Session_t *)arg;
+    char line[FTPSERVER_LINE_SIZE];
+    char localPath[FTPSERVER_LOCAL_PATH_SIZE];
+    char reply[FTPSERVER_LINE_SIZE + 64];
+
+    FTPSERVER_Reply(session, "220 ftpServer ready\r\n");
+
+    while (FTPSERVER_ReadLine(session->controlFd, line, sizeof(line)))
+    {
+        char *argument = strchr(line, ' ');
+        struct stat statbuf;
+        int64_t restOffset = session->restOffset;
+
+        if (argument != NULL)
+        {
+            *argument++ = '\0';
+        }
+        session->restOffset = 0;
+
+        pthread_mutex_lock(&session->server->lock);
+        session->server->stats.commands++;
+        pthread_mutex_unlock(&session->server->lock);
+
+        if (strcasecmp(line, "USER") == 0)
+        {
+            FTPSERVER_Reply(session, "331 Any password\r\n");
+        }
+        else if (strcasecmp(line, "PASS") == 0)
+        {
+            FTPSERVER_Reply(session, "230 Logged in\r\n");
+        }
+        else if (strcasecmp(line, "PWD") == 0)
+        {
+            FTPSERVER_Reply(session, "257 \"/\"\r\n");
+        }
+        else if ((strcasecmp(line, "CWD") == 0) || (strcasecmp(line, "TYPE") == 0) || (strcasecmp(line, "NOOP") == 0) || (strcasecmp(line, "OPTS") == 0))
+        {
+            FTPSERVER_Reply(session, "200 OK\r\n");
+        }
+        else if (strcasecmp(line, "SYST") == 0)
+        {
+            FTPSERVER_Reply(session, "215 UNIX Type: L8\r\n");
+        }
+        else if (strcasecmp(line, "FEAT") == 0)
+        {
+            FTPSERVER_Reply(session, "211-Features:\r\n EPSV\r\n PASV\r\n SIZE\r\n MDTM\r\n REST STREAM\r\n");
+            FTPSERVER_Reply(session, (session->server->hasDigest) ? " XMD5\r\n211 End\r\n" : "211 End\r\n");
+        }
+        else if ((strcasecmp(line, "XMD5") == 0) && (session->server->hasDigest))
+        {
+            char path[FTPSERVER_PATH_SIZE];
+            long long start = 0;
+            long long end = -1;
+
+            if ((argument != NULL) && (sscanf(argument, "%1023s %lld %lld", path, &start, &end) >= 1) && FTPSERVER_LocalPath(session, path, localPath))
+            {
+                FTPSERVER_Digest(session, localPath, start, end);
+            }
+            else
+            {
+                FTPSERVER_Reply(session, "501 Bad arguments\r\n");
+            }
+        }
+        else if (strcasecmp(line, "EPSV") == 0)
+        {
+            int port = FTPSERVER_OpenPassive(session);
+            snprintf(reply, sizeof(reply), "229 Entering Extended Passive Mode (|||%d|)\r\n", port);
+            FTPSERVER_Reply(session, (port > 0) ? reply : "425 Can not open data connection\r\n");
+        }
+        else if (strcasecmp(line, "PASV") == 0)
+        {
+            int port = FTPSERVER_OpenPassive(session);
+            snprintf(reply, sizeof(reply), "227 Entering Passive Mode (127,0,0,1,%d,%d)\r\n", port >> 8, port & 0xff);
+            FTPSERVER_Reply(session, (port > 0) ? reply : "425 Can not open data connection\r\n");
+        }
+        else if ((strcasecmp(line, "SIZE") == 0) || (strcasecmp(line, "MDTM") == 0))
+        {
+            if (FTPSERVER_LocalPath(session, argument, localPath) && (stat(localPath, &statbuf) == 0) && S_ISREG(statbuf.st_mode))
+            {
+                if (strcasecmp(line, "SIZE") == 0)
+                {
+                    snprintf(reply, sizeof(reply), "213 %lld\r\n", (long long)statbuf.st_size);
+                }
+                else
+                {
+                    struct tm tm;
+                    gmtime_r(&statbuf.st_mtime, &tm);
+                    strftime(reply, sizeof(reply), "213 %Y%m%d%H%M%S\r\n", &tm);
+                }
+                FTPSERVER_Reply(session, reply);
+            }
+            else
+            {
+                FTPSERVER_Reply(session, "550 No such file\r\n");
+            }
+        }
+        else if (strcasecmp(line, "REST") == 0)
+        {
+            session->restOffset = (argument != NULL) ? strtoll(argument, NULL, 10) : 0;
+            FTPSERVER_Reply(session, "350 Restarting\r\n");
+        }
+        else if (strcasecmp(line, "RETR") == 0)
+        {
+            session->restOffset = restOffset;
+            if (FTPSERVER_LocalPath(session, argument, localPath))
+            {
+                FTPSERVER_Retrieve(session, localPath);
+            }
+            else
+            {
+                FTPSERVER_Reply(session, "550 Bad path\r\n");
+            }
+            session->restOffset = 0;
+        }
+        else if ((strcasecmp(line, "STOR") == 0) || (strcasecmp(line, "APPE") == 0))
+        {
+            session->restOffset = restOffset;
+            if (FTPSERVER_LocalPath(session, argument, localPath))
+            {
+                FTPSERVER_Store(session, localPath, (strcasecmp(line, "APPE") == 0));
+            }
+            else
+            {
+                FTPSERVER_Reply(session, "553 Bad path\r\n");
+            }
+            session->restOffset = 0;
+        }
+        else if ((strcasecmp(line, "LIST") == 0) || (strcasecmp(line, "NLST") == 0))
+        {
+            FTPSERVER_LocalPath(session, ((argument != NULL) && (argument[0] != '-')) ? argument : "/", localPath);
+            FTPSERVER_List(session, localPath);
+        }
+        else if (strcasecmp(line, "DELE") == 0)
+        {
+            int isDeleted = (FTPSERVER_LocalPath(session, argument, localPath) && (unlink(localPath) == 0));
+            FTPSERVER_Reply(session, (isDeleted) ? "250 Deleted\r\n" : "550 No such file\r\n");
+        }
+        else if (strcasecmp(line, "MKD") == 0)
+        {
+            int isCreated = (FTPSERVER_LocalPath(session, argument, localPath) && (mkdir(localPath, 0755) == 0));
+            FTPSERVER_Reply(session, (isCreated) ? "257 Created\r\n" : "550 Can not create\r\n");
+        }
+        else if (strcasecmp(line, "RNFR") == 0)
+        {
+            int isFound = (FTPSERVER_LocalPath(session, argument, session->renameFrom) && (access(session->renameFrom, F_OK) == 0));
+            FTPSERVER_Reply(session, (isFound) ? "350 Ready for RNTO\r\n" : "550 No such file\r\n");
+        }
+        else if (strcasecmp(line, "RNTO") == 0)
+        {
+            int isRenamed = (FTPSERVER_LocalPath(session, argument, localPath) && (rename(session->renameFrom, localPath) == 0));
+            FTPSERVER_Reply(session, (isRenamed) ? "250 Renamed\r\n" : "550 Can not rename\r\n");
+        }
+        else if (strcasecmp(line, "QUIT") == 0)
+        {
+            FTPSERVER_Reply(session, "221 Bye\r\n");
+            break;
+        }
+        else
+        {
+            FTPSERVER_Reply(session, "502 Not implemented\r\n");
+        }
+    }
+
+    if (session->passiveFd >= 0)
+    {
+        close(session->passiveFd);
+    }
+    close(session->controlFd);
+    free(session);
+
+    return NULL;
+}
+
+static void *FTPSERVER_Accept(void *arg)
+{
+    FTPSERVER_t *server = (FTPSERVER_t *)arg;
+
+    while (server->isStopped == 0)
+    {
+        int controlFd = accept(server->listenFd, NULL, NULL);
+        FTPSERVER_Session_t *session = NULL;
+        pthread_t thread;
+        int noDelay = 1;
+
+        if (controlFd < 0)
+        {
+            continue;
+        }
+        if (server->isStopped)
+        {
+            close(controlFd);
+            break;
+        }
+
+        // the replies are small, they are not to be delayed
+        setsockopt(controlFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        session = calloc(1, sizeof(FTPSERVER_Session_t));
+        if (session == NULL)
+        {
+            close(controlFd);
+            continue;
+        }
+        session->server = server;
+        session->controlFd = controlFd;
+        session->passiveFd = -1;
+
+        pthread_mutex_lock(&server->lock);
+        server->stats.controlConnections++;
+        pthread_mutex_unlock(&server->lock);
+
+        if (pthread_create(&thread, NULL, FTPSERVER_Session, session) == 0)
+        {
+            pthread_detach(thread);
+        }
+        else
+        {
+            close(controlFd);
+            free(session);
+        }
+    }
+
+    return NULL;
+}
+
+FTPSERVER_t *FTPSERVER_New(const char *rootFolder, int port, const char *payloadSuffix)
+{
+    FTPSERVER_t *server = calloc(1, sizeof(FTPSERVER_t));
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+    int reuse = 1;
+
+    if (server == NULL)
+    {
+        return NULL;
+    }
+
+    snprintf(server->rootFolder, sizeof(server->rootFolder), "%s", rootFolder);
+    snprintf(server->payloadSuffix, sizeof(server->payloadSuffix), "%s", (payloadSuffix != NULL) ? payloadSuffix : "");
+    pthread_mutex_init(&server->lock, NULL);
+    FTPSERVER_ResetStats(server);
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    server->listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if ((server->listenFd < 0) ||
+        (setsockopt(server->listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0) ||
+        (bind(server->listenFd, (struct sockaddr *)&address, sizeof(address)) != 0) ||
+        (listen(server->listenFd, 16) != 0) ||
+        (getsockname(server->listenFd, (struct sockaddr *)&address, &addressLength) != 0) ||
+        (pthread_create(&server->acceptThread, NULL, FTPSERVER_Accept, server) != 0))
+    {
+        fprintf(stderr, "ftpServer: can not listen: %s\n", strerror(errno));
+        if (server->listenFd >= 0)
+        {
+            close(server->listenFd);
+        }
+        pthread_mutex_destroy(&server->lock);
+        free(server);
+        return NULL;
+    }
+    server->port = ntohs(address.sin_port);
+
+    return server;
+}
+
+void FTPSERVER_Delete(FTPSERVER_t **serverAddr)
+{
+    if ((serverAddr != NULL) && (*serverAddr != NULL))
+    {
+        FTPSERVER_t *server = *serverAddr;
+
+        // shutting the listening socket down wakes the accepting thread up
+        server->isStopped = 1;
+        shutdown(server->listenFd, SHUT_RDWR);
+        pthread_join(server->acceptThread, NULL);
+        close(server->listenFd);
+        pthread_mutex_destroy(&server->lock);
+        free(server);
+
+        *serverAddr = NULL;
+    }
+}
+
+int FTPSERVER_GetPort(FTPSERVER_t *server)
+{
+    return (server != NULL) ? server->port : -1;
+}
+
+void FTPSERVER_SetMaxRate(FTPSERVER_t *server, int64_t bytesPerSecond)
+{
+    server->maxRate = bytesPerSecond;
+}
+
+void FTPSERVER_SetDigest(FTPSERVER_t *server, int hasDigest)
+{
+    server->hasDigest = hasDigest;
+}
+
+void FTPSERVER_ResetStats(FTPSERVER_t *server)
+{
+    pthread_mutex_lock(&server->lock);
+    memset(&server->stats, 0, sizeof(server->stats));
+    server->stats.firstPayloadByteUs = -1;
+    clock_gettime(CLOCK_MONOTONIC, &server->statsStart);
+    pthread_mutex_unlock(&server->lock);
+}
+
+void FTPSERVER_GetStats(FTPSERVER_t *server, FTPSERVER_Stats_t *stats)
+{
+    pthread_mutex_lock(&server->lock);
+    *stats = server->stats;
+    pthread_mutex_unlock(&server->lock);
+}
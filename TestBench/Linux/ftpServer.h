@@ -0,0 +1,100 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file ftpServer.h
+ * @brief libARUpdater TestBench minimal local ftp server
+ * @date 19/10/2026
+ */
+
+#ifndef _FTPSERVER_H_
+#define _FTPSERVER_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Minimal ftp server of a local folder, passive mode only, one thread per connection
+ */
+typedef struct FTPSERVER_t FTPSERVER_t;
+
+/**
+ * @brief What the clients did since the last reset
+ */
+typedef struct
+{
+    int controlConnections;         /**< number of control connections accepted */
+    int dataConnections;            /**< number of data connections accepted */
+    int commands;                   /**< number of commands received */
+    int64_t firstPayloadByteUs;     /**< time of the first byte stored in a file with the payload suffix, -1 if none */
+    int64_t payloadBytes;           /**< number of bytes stored in the files with the payload suffix */
+} FTPSERVER_Stats_t;
+
+/**
+ * @brief Serve a folder on the loopback
+ * @param[in] rootFolder : the served folder
+ * @param[in] port : the port of the control connections, 0 for any
+ * @param[in] payloadSuffix : suffix of the files whose first stored byte is timed
+ * @return the server, NULL on error
+ */
+FTPSERVER_t *FTPSERVER_New(const char *rootFolder, int port, const char *payloadSuffix);
+
+/**
+ * @brief Stop the server
+ */
+void FTPSERVER_Delete(FTPSERVER_t **serverAddr);
+
+/**
+ * @brief Get the port of the control connections
+ */
+int FTPSERVER_GetPort(FTPSERVER_t *server);
+
+/**
+ * @brief Limit the rate of the files stored by each connection, to emulate the link of a product
+ * @param[in] bytesPerSecond : maximum rate, 0 for no limit
+ */
+void FTPSERVER_SetMaxRate(FTPSERVER_t *server, int64_t bytesPerSecond);
+
+/**
+ * @brief Answer XMD5 and list it in the features, as the servers which hash the files themselves
+ * @param[in] hasDigest : 1 to answer XMD5, 0 otherwise
+ */
+void FTPSERVER_SetDigest(FTPSERVER_t *server, int hasDigest);
+
+/**
+ * @brief Clear the statistics, the times are given from this call
+ */
+void FTPSERVER_ResetStats(FTPSERVER_t *server);
+
+/**
+ * @brief Get the statistics since the last reset
+ */
+void FTPSERVER_GetStats(FTPSERVER_t *server, FTPSERVER_Stats_t *stats);
+
+#endif
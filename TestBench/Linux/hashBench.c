@@ -0,0 +1,133 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file hashBench.c
+ * @brief libARUpdater TestBench hash throughput
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Hash.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define HASHBENCH_DEFAULT_SIZE_MB       64
+#define HASHBENCH_FILE_PATH             "/tmp/hashBench.bin"
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static double hashBench_now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t sizeMB = (argc > 1) ? (size_t)atoi(argv[1]) : HASHBENCH_DEFAULT_SIZE_MB;
+    size_t size = sizeMB * 1024 * 1024;
+    uint8_t *buffer = malloc(size);
+    uint8_t digest[ARUPDATER_HASH_MAX_DIGEST_SIZE];
+    char digestHex[ARUPDATER_HASH_MAX_DIGEST_SIZE * 2 + 1];
+    FILE *file = NULL;
+    size_t i = 0;
+    int algorithm = 0;
+
+    if ((sizeMB == 0) || (buffer == NULL))
+    {
+        fprintf(stderr, "usage: %s [size in MB]\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        buffer[i] = (uint8_t)(i * 2654435761u >> 13);
+    }
+
+    file = fopen(HASHBENCH_FILE_PATH, "wb");
+    if ((file == NULL) || (fwrite(buffer, 1, size, file) != size))
+    {
+        fprintf(stderr, "cannot write %s\n", HASHBENCH_FILE_PATH);
+        return 1;
+    }
+    fclose(file);
+
+    printf("%zu MB, %ld cores, sha256 kernel: %s\n", sizeMB, sysconf(_SC_NPROCESSORS_ONLN), ARUPDATER_Sha256_GetImplementationName());
+
+    for (algorithm = 0; algorithm < ARUPDATER_HASH_MAX; algorithm++)
+    {
+        ARUPDATER_Hash_Context_t context;
+        double start, memoryTime, fileTime;
+
+        // one thread, from memory
+        start = hashBench_now();
+        ARUPDATER_Hash_Init(&context, algorithm);
+        ARUPDATER_Hash_Update(&context, buffer, size);
+        ARUPDATER_Hash_Final(&context, digest);
+        memoryTime = hashBench_now() - start;
+
+        // from the (cached) file, the tree leaves are hashed on all cores
+        start = hashBench_now();
+        if (ARUPDATER_Hash_ComputeFile(algorithm, HASHBENCH_FILE_PATH, digest) != ARUPDATER_OK)
+        {
+            fprintf(stderr, "cannot hash %s\n", HASHBENCH_FILE_PATH);
+            return 1;
+        }
+        fileTime = hashBench_now() - start;
+
+        ARUPDATER_Hash_ToHex(digest, ARUPDATER_Hash_GetDigestSize(algorithm), digestHex);
+        printf("%-12s memory %8.1f MB/s   file %8.1f MB/s   %s\n", ARUPDATER_Hash_GetName(algorithm), sizeMB / memoryTime, sizeMB / fileTime, digestHex);
+    }
+
+    unlink(HASHBENCH_FILE_PATH);
+    free(buffer);
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file hashCacheTest.c
+ * @brief libARUpdater TestBench checks of the hash cache lookups, of its ring of entries and of its handling of the corrupt cache files
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_HashCache.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define HASHCACHETEST_FOLDER            "/tmp/hashCacheTest"
+#define HASHCACHETEST_CACHE_PATH        HASHCACHETEST_FOLDER "/" ARUPDATER_HASH_CACHE_FILE_NAME
+#define HASHCACHETEST_FILE_PATH         HASHCACHETEST_FOLDER "/abc.plf"
+
+#define HASHCACHETEST_MD5_ABC           "900150983cd24fb0d6963f7d28e17f72"
+#define HASHCACHETEST_SHA256_ABC        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+#define HASHCACHETEST_MD5_OTHER         "0123456789abcdef0123456789abcdef"
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void hashCacheTest_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+static void hashCacheTest_writeFile(const char *path, const char *content)
+{
+    FILE *file = fopen(path, "w");
+
+    if (file != NULL)
+    {
+        fputs(content, file);
+        fclose(file);
+    }
+}
+
+static void hashCacheTest_appendCache(const char *content)
+{
+    FILE *file = fopen(HASHCACHETEST_CACHE_PATH, "a");
+
+    if (file != NULL)
+    {
+        fputs(content, file);
+        fclose(file);
+    }
+}
+
+/**
+ * @brief set the modification time of a file to a fixed value
+ */
+static void hashCacheTest_setTime(const char *path, time_t modificationTime)
+{
+    struct timespec times[2];
+
+    times[0].tv_sec = modificationTime;
+    times[0].tv_nsec = 0;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, path, times, 0);
+}
+
+/**
+ * @brief write the key of the test file into a line of the cache, followed by the given end
+ */
+static void hashCacheTest_keyLine(char *line, size_t size, const char *end)
+{
+    struct stat fileStat;
+
+    stat(HASHCACHETEST_FILE_PATH, &fileStat);
+    snprintf(line, size, "%llu %llu %lld %lld %s", (unsigned long long)fileStat.st_dev, (unsigned long long)fileStat.st_ino,
+             (long long)fileStat.st_size, (long long)fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec, end);
+}
+
+static int hashCacheTest_countLines(void)
+{
+    char line[512];
+    int count = 0;
+    FILE *file = fopen(HASHCACHETEST_CACHE_PATH, "r");
+
+    while ((file != NULL) && (fgets(line, sizeof(line), file) != NULL))
+    {
+        count++;
+    }
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return count;
+}
+
+/**
+ * @brief check the digest found in the cache for a file, NULL if it must not be found
+ */
+static int hashCacheTest_isCached(eARUPDATER_HASH algorithm, const char *path, const char *expected)
+{
+    char hex[ARUPDATER_HASH_CACHE_HEX_SIZE];
+    int found = ARUPDATER_HashCache_Lookup(HASHCACHETEST_CACHE_PATH, algorithm, path, hex);
+
+    return (expected == NULL) ? (found == 0) : (found && (strcmp(hex, expected) == 0));
+}
+
+int main(int argc, char *argv[])
+{
+    char hex[ARUPDATER_HASH_CACHE_HEX_SIZE];
+    char path[256];
+    char line[512];
+    int isValid = 0;
+    int i = 0;
+
+    if (system("rm -rf " HASHCACHETEST_FOLDER) != 0)
+    {
+        return 1;
+    }
+    mkdir(HASHCACHETEST_FOLDER, 0700);
+    hashCacheTest_writeFile(HASHCACHETEST_FILE_PATH, "abc");
+    hashCacheTest_setTime(HASHCACHETEST_FILE_PATH, 1000000000);
+
+    // miss, then hit
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, NULL), "missing cache misses");
+    hashCacheTest_check((ARUPDATER_HashCache_ComputeFile(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, hex) == ARUPDATER_OK) &&
+                        (strcmp(hex, HASHCACHETEST_MD5_ABC) == 0), "md5 computed on a miss");
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_ABC), "md5 stored");
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_SHA256, HASHCACHETEST_FILE_PATH, NULL), "other algorithm misses");
+    ARUPDATER_HashCache_ComputeFile(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_SHA256, HASHCACHETEST_FILE_PATH, hex);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_SHA256, HASHCACHETEST_FILE_PATH, HASHCACHETEST_SHA256_ABC) &&
+                        hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_ABC) && (hashCacheTest_countLines() == 2), "algorithms kept side by side");
+
+    // replacement, the cached digest is trusted without reading the file
+    hashCacheTest_check((ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, "0123456789ABCDEF0123456789ABCDEF") == ARUPDATER_OK) &&
+                        hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_OTHER) && (hashCacheTest_countLines() == 2), "entry replaced, in lower case");
+    hashCacheTest_check((ARUPDATER_HashCache_ComputeFile(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, hex) == ARUPDATER_OK) &&
+                        (strcmp(hex, HASHCACHETEST_MD5_OTHER) == 0), "digest taken from the cache on a hit");
+    hashCacheTest_check((ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, "0123") == ARUPDATER_ERROR_BAD_PARAMETER) &&
+                        hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_OTHER), "digest of a wrong size refused");
+
+    // any change of the file invalidates its entries
+    hashCacheTest_setTime(HASHCACHETEST_FILE_PATH, 1000000001);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, NULL), "modification time change misses");
+    hashCacheTest_check((ARUPDATER_HashCache_ComputeFile(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, hex) == ARUPDATER_OK) &&
+                        (strcmp(hex, HASHCACHETEST_MD5_ABC) == 0) && (hashCacheTest_countLines() == 2), "stale entry replaced");
+    hashCacheTest_writeFile(HASHCACHETEST_FILE_PATH, "abcd");
+    hashCacheTest_setTime(HASHCACHETEST_FILE_PATH, 1000000001);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, NULL), "size change misses");
+    hashCacheTest_writeFile(HASHCACHETEST_FILE_PATH, "abc");
+    hashCacheTest_setTime(HASHCACHETEST_FILE_PATH, 1000000001);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_ABC), "same key hits again");
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FOLDER "/missing.plf", NULL) &&
+                        (ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FOLDER "/missing.plf", HASHCACHETEST_MD5_ABC) == ARUPDATER_ERROR_SYSTEM), "missing file neither found nor stored");
+
+    // corrupt and truncated lines are never returned, and dropped on the next store
+    unlink(HASHCACHETEST_CACHE_PATH);
+    hashCacheTest_appendCache("garbage\n\n1 2 3\n");
+    hashCacheTest_keyLine(line, sizeof(line), "md5 900150983cd24fb0d6963f7d28e1\n");
+    hashCacheTest_appendCache(line);
+    hashCacheTest_keyLine(line, sizeof(line), "sha256 ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad\n");
+    hashCacheTest_appendCache(line);
+    hashCacheTest_keyLine(line, sizeof(line), "md5 900150983cd24fb0d6963f7d28e17f72");
+    hashCacheTest_appendCache(line);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_SHA256, HASHCACHETEST_FILE_PATH, HASHCACHETEST_SHA256_ABC), "valid line found among corrupt ones");
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FOLDER "/missing.plf", NULL), "corrupt cache misses a missing file");
+    ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_OTHER);
+    hashCacheTest_check((hashCacheTest_countLines() == 2) && hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, HASHCACHETEST_MD5_OTHER) &&
+                        hashCacheTest_isCached(ARUPDATER_HASH_SHA256, HASHCACHETEST_FILE_PATH, HASHCACHETEST_SHA256_ABC), "corrupt lines dropped on store");
+
+    unlink(HASHCACHETEST_CACHE_PATH);
+    hashCacheTest_keyLine(line, sizeof(line), "md5 900150983cd24fb0d6963f7d28e1");
+    hashCacheTest_appendCache(line);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, NULL), "truncated digest misses");
+    hashCacheTest_keyLine(line, sizeof(line), "");
+    hashCacheTest_writeFile(HASHCACHETEST_CACHE_PATH, line);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, HASHCACHETEST_FILE_PATH, NULL), "truncated line misses");
+
+    // the ring keeps the ARUPDATER_HASH_CACHE_MAX_ENTRIES most recent entries
+    unlink(HASHCACHETEST_CACHE_PATH);
+    for (i = 0; i < ARUPDATER_HASH_CACHE_MAX_ENTRIES + 3; i++)
+    {
+        snprintf(path, sizeof(path), HASHCACHETEST_FOLDER "/f%d.plf", i);
+        hashCacheTest_writeFile(path, "abc");
+        ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, path, HASHCACHETEST_MD5_ABC);
+    }
+    hashCacheTest_check((hashCacheTest_countLines() == ARUPDATER_HASH_CACHE_MAX_ENTRIES), "ring bounded");
+    isValid = 1;
+    for (i = 0; i < ARUPDATER_HASH_CACHE_MAX_ENTRIES + 3; i++)
+    {
+        snprintf(path, sizeof(path), HASHCACHETEST_FOLDER "/f%d.plf", i);
+        isValid = isValid && hashCacheTest_isCached(ARUPDATER_HASH_MD5, path, (i < 3) ? NULL : HASHCACHETEST_MD5_ABC);
+    }
+    hashCacheTest_check(isValid, "oldest entries dropped first");
+    snprintf(path, sizeof(path), HASHCACHETEST_FOLDER "/f%d.plf", 3);
+    ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, path, HASHCACHETEST_MD5_OTHER);
+    snprintf(path, sizeof(path), HASHCACHETEST_FOLDER "/f%d.plf", 0);
+    ARUPDATER_HashCache_Store(HASHCACHETEST_CACHE_PATH, ARUPDATER_HASH_MD5, path, HASHCACHETEST_MD5_ABC);
+    snprintf(line, sizeof(line), HASHCACHETEST_FOLDER "/f%d.plf", 3);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, line, HASHCACHETEST_MD5_OTHER) && hashCacheTest_isCached(ARUPDATER_HASH_MD5, path, HASHCACHETEST_MD5_ABC) &&
+                        (hashCacheTest_countLines() == ARUPDATER_HASH_CACHE_MAX_ENTRIES), "replaced entry moved to the newest end");
+    snprintf(path, sizeof(path), HASHCACHETEST_FOLDER "/f%d.plf", 4);
+    hashCacheTest_check(hashCacheTest_isCached(ARUPDATER_HASH_MD5, path, NULL), "next oldest entry dropped");
+
+    if (system("rm -rf " HASHCACHETEST_FOLDER) != 0)
+    {
+        failureCount++;
+    }
+
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
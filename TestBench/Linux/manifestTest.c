@@ -0,0 +1,183 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file manifestTest.c
+ * @brief libARUpdater TestBench checks of the chunk manifest parser and verifier
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Manifest.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define MANIFESTTEST_FILE_PATH          "/tmp/manifestTest.txt"
+
+/* sha256 of "abc" and of "d", the two chunks of "abcd" cut in chunks of 3 bytes */
+#define MANIFESTTEST_DIGEST_ABC         "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+#define MANIFESTTEST_DIGEST_D           "18ac3e7343f016890c510e93f935261169d9e3f565436429830faf0934f4f8e4"
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void manifestTest_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+/**
+ * @brief write a manifest file and load it
+ */
+static ARUPDATER_Manifest_t *manifestTest_load(const char *content, eARUPDATER_ERROR *error)
+{
+    FILE *file = fopen(MANIFESTTEST_FILE_PATH, "wb");
+
+    if (file != NULL)
+    {
+        fputs(content, file);
+        fclose(file);
+    }
+
+    return ARUPDATER_Manifest_New(MANIFESTTEST_FILE_PATH, error);
+}
+
+/**
+ * @brief check that a malformed manifest is refused
+ */
+static void manifestTest_checkRefused(const char *content, const char *name)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Manifest_t *manifest = manifestTest_load(content, &error);
+
+    manifestTest_check((manifest == NULL) && (error == ARUPDATER_ERROR_BAD_PARAMETER), name);
+    ARUPDATER_Manifest_Delete(&manifest);
+}
+
+/**
+ * @brief give data to a verifier in pieces of pieceSize bytes and count the bad chunks
+ */
+static int64_t manifestTest_verify(const ARUPDATER_Manifest_t *manifest, const char *data, size_t size, size_t pieceSize, uint8_t *isBad)
+{
+    ARUPDATER_Manifest_Verifier_t verifier;
+    int64_t badCount = -1;
+    size_t offset = 0;
+
+    if (ARUPDATER_Manifest_Verifier_Init(&verifier, manifest) == ARUPDATER_OK)
+    {
+        for (offset = 0; offset < size; offset += pieceSize)
+        {
+            ARUPDATER_Manifest_Verifier_DataCallback(&verifier, (const uint8_t *)data + offset, ((size - offset) < pieceSize) ? (size - offset) : pieceSize);
+        }
+        badCount = ARUPDATER_Manifest_Verifier_Finish(&verifier);
+        memcpy(isBad, verifier.isBad, (size_t)manifest->chunkCount);
+        ARUPDATER_Manifest_Verifier_Clear(&verifier);
+    }
+
+    return badCount;
+}
+
+int main(int argc, char *argv[])
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Manifest_t *manifest = NULL;
+    uint8_t isBad[2];
+    int64_t offset = 0;
+    size_t size = 0;
+
+    // a valid manifest, the digests are accepted in upper case and with crlf line ends
+    manifest = manifestTest_load("4 3\n" MANIFESTTEST_DIGEST_ABC "\r\n18AC3E7343F016890C510E93F935261169D9E3F565436429830FAF0934F4F8E4\n", &error);
+    manifestTest_check((manifest != NULL) && (error == ARUPDATER_OK), "valid manifest loaded");
+    if (manifest != NULL)
+    {
+        manifestTest_check((manifest->fileSize == 4) && (manifest->chunkSize == 3) && (manifest->chunkCount == 2), "valid manifest sizes");
+        manifestTest_check((manifest->digests[0] == 0xba) && (manifest->digests[31] == 0xad) && (manifest->digests[32] == 0x18) && (manifest->digests[63] == 0xe4), "valid manifest digests");
+
+        ARUPDATER_Manifest_GetChunk(manifest, 1, &offset, &size);
+        manifestTest_check((offset == 3) && (size == 1), "last chunk is shorter");
+
+        manifestTest_check((manifestTest_verify(manifest, "abcd", 4, 4, isBad) == 0), "verifier accepts the file in one piece");
+        manifestTest_check((manifestTest_verify(manifest, "abcd", 4, 1, isBad) == 0), "verifier accepts the file byte by byte");
+        manifestTest_check((manifestTest_verify(manifest, "abXd", 4, 2, isBad) == 1) && (isBad[0] == 1) && (isBad[1] == 0), "verifier finds the corrupted chunk");
+        manifestTest_check((manifestTest_verify(manifest, "abc", 3, 2, isBad) == 1) && (isBad[0] == 0) && (isBad[1] == 1), "verifier marks the missing chunk of a truncated file");
+        manifestTest_check((manifestTest_verify(manifest, "", 0, 1, isBad) == 2), "verifier marks all the chunks of an empty file");
+    }
+    ARUPDATER_Manifest_Delete(&manifest);
+
+    // an empty file has no chunk
+    manifest = manifestTest_load("0 3\n", &error);
+    manifestTest_check((manifest != NULL) && (error == ARUPDATER_OK) && (manifest->chunkCount == 0), "manifest of an empty file");
+    ARUPDATER_Manifest_Delete(&manifest);
+
+    // malformed headers
+    manifestTest_checkRefused("", "empty manifest refused");
+    manifestTest_checkRefused("4\n", "header without chunk size refused");
+    manifestTest_checkRefused("four 3\n", "header with a bad file size refused");
+    manifestTest_checkRefused("4 0\n" MANIFESTTEST_DIGEST_ABC "\n", "null chunk size refused");
+    manifestTest_checkRefused("-4 3\n", "negative file size refused");
+    manifestTest_checkRefused("4 1073741824\n" MANIFESTTEST_DIGEST_ABC "\n", "oversized chunk refused");
+
+    // truncated and corrupted digests
+    manifestTest_checkRefused("4 3\n" MANIFESTTEST_DIGEST_ABC "\n", "missing digest refused");
+    manifestTest_checkRefused("4 3\n" MANIFESTTEST_DIGEST_ABC "\n18ac3e7343f016890c510e93f935261169d9e3f565436429830faf0934f4f8\n", "short digest refused");
+    manifestTest_checkRefused("4 3\n" MANIFESTTEST_DIGEST_ABC "\n18ac3e7343f016890c510e93f935261169d9e3f565436429830faf0934f4f8e4ff\n", "long digest refused");
+    manifestTest_checkRefused("4 3\n" MANIFESTTEST_DIGEST_ABC "\n18ac3e7343f016890c510e93f93526116gd9e3f565436429830faf0934f4f8e4\n", "digest with a bad character refused");
+
+    // a missing file is not a malformed manifest
+    unlink(MANIFESTTEST_FILE_PATH);
+    manifest = ARUPDATER_Manifest_New(MANIFESTTEST_FILE_PATH, &error);
+    manifestTest_check((manifest == NULL) && (error == ARUPDATER_ERROR_SYSTEM), "missing manifest");
+
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,271 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file plfIndexTest.c
+ * @brief libARUpdater TestBench checks of the plf index invalidation and of its handling of the corrupt plf headers
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Plf.h"
+#include "ARUPDATER_PlfIndex.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define PLFINDEXTEST_FOLDER             "/tmp/plfIndexTest"
+#define PLFINDEXTEST_MISSING_FOLDER     "/tmp/plfIndexTest.missing"
+#define PLFINDEXTEST_PLF_SIZE           1000
+
+/* fixed modification times, old enough for the folder not to be racy */
+#define PLFINDEXTEST_TIME               1000000000
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void plfIndexTest_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+/**
+ * @brief set the modification time of a file of the folder, or of the folder itself if fileName is NULL
+ */
+static void plfIndexTest_setTime(const char *fileName, time_t modificationTime)
+{
+    char path[256];
+    struct timespec times[2];
+
+    snprintf(path, sizeof(path), "%s/%s", PLFINDEXTEST_FOLDER, (fileName != NULL) ? fileName : ".");
+    times[0].tv_sec = modificationTime;
+    times[0].tv_nsec = 0;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, path, times, 0);
+}
+
+/**
+ * @brief write a plf into the folder, only its first size bytes if size is lower than the header
+ */
+static void plfIndexTest_writePlf(const char *fileName, int version, int edition, size_t size, time_t modificationTime)
+{
+    uint8_t data[PLFINDEXTEST_PLF_SIZE];
+    plf_phdr_t *header = (plf_phdr_t *)data;
+    char path[256];
+    FILE *file = NULL;
+
+    memset(data, 0, sizeof(data));
+    header->p_magic = PLF_HEADER_MAGIC;
+    header->p_plfversion = PLF_CURRENT_VERSION;
+    header->p_phdrsize = sizeof(plf_phdr_t);
+    header->p_shdrsize = sizeof(plf_shdr_t);
+    header->p_ver = version;
+    header->p_edit = edition;
+    header->p_size = sizeof(data);
+
+    snprintf(path, sizeof(path), "%s/%s", PLFINDEXTEST_FOLDER, fileName);
+    file = fopen(path, "wb");
+    if (file != NULL)
+    {
+        fwrite(data, 1, (size < sizeof(data)) ? size : sizeof(data), file);
+        fclose(file);
+    }
+    plfIndexTest_setTime(fileName, modificationTime);
+}
+
+static void plfIndexTest_remove(const char *fileName)
+{
+    char path[256];
+
+    snprintf(path, sizeof(path), "%s/%s", PLFINDEXTEST_FOLDER, fileName);
+    unlink(path);
+}
+
+/**
+ * @brief check the newest plf of the folder, by its name and by its version
+ */
+static int plfIndexTest_isNewest(const char *fileName, int version)
+{
+    ARUPDATER_Manager_PlfVersion_t newest;
+    char *plfFileName = NULL;
+    int isValid = 0;
+    int dirFd = open(PLFINDEXTEST_FOLDER, O_RDONLY | O_DIRECTORY);
+
+    if ((ARUPDATER_PlfIndex_GetNewest(PLFINDEXTEST_FOLDER, &plfFileName) == ARUPDATER_OK) &&
+        (ARUPDATER_PlfIndex_GetNewestVersionAt(dirFd, &newest) == ARUPDATER_OK))
+    {
+        isValid = ((strcmp(plfFileName, fileName) == 0) && (newest.version == version));
+    }
+
+    free(plfFileName);
+    close(dirFd);
+
+    return isValid;
+}
+
+/**
+ * @brief check the versions listed by the index, the newest first
+ */
+static int plfIndexTest_isListed(const int *expected, int expectedCount)
+{
+    ARUPDATER_Manager_PlfVersion_t versions[8];
+    int count = 0;
+    int i = 0;
+
+    if ((ARUPDATER_PlfIndex_GetVersions(PLFINDEXTEST_FOLDER, versions, 8, &count) != ARUPDATER_OK) || (count != expectedCount))
+    {
+        return 0;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (versions[i].version != expected[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    ARUPDATER_Manager_PlfVersion_t newest;
+    char *plfFileName = NULL;
+    int listed[4];
+    int count = 0;
+    int dirFd = -1;
+
+    if (system("rm -rf " PLFINDEXTEST_FOLDER) != 0)
+    {
+        return 1;
+    }
+    mkdir(PLFINDEXTEST_FOLDER, 0700);
+
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetNewest(PLFINDEXTEST_MISSING_FOLDER, &plfFileName) == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND), "missing folder has no plf");
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetVersions(PLFINDEXTEST_MISSING_FOLDER, NULL, 0, &count) == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND), "missing folder lists no version");
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME);
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetNewest(PLFINDEXTEST_FOLDER, &plfFileName) == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND), "empty folder has no plf");
+
+    // the folder scanned again when its modification time changes
+    plfIndexTest_writePlf("a.plf", 1, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    plfIndexTest_writePlf("b.plf", 3, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    plfIndexTest_writePlf("c.plf", 2, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    plfIndexTest_writePlf("notes.txt", 9, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 10);
+    listed[0] = 3; listed[1] = 2; listed[2] = 1;
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 3) && plfIndexTest_isListed(listed, 3), "plf sorted by version");
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetVersions(PLFINDEXTEST_FOLDER, NULL, 0, &count) == ARUPDATER_OK) && (count == 3), "versions counted without room");
+
+    plfIndexTest_writePlf("d.plf", 3, 1, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 20);
+    plfIndexTest_check(plfIndexTest_isNewest("d.plf", 3), "added plf seen, edition sorted");
+
+    plfIndexTest_remove("d.plf");
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 30);
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 3), "removed plf seen");
+
+    // the newest plf rewritten in place, the folder unchanged
+    plfIndexTest_writePlf("b.plf", 4, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME + 1);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 30);
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 4), "newest plf rewritten with another time seen");
+
+    plfIndexTest_writePlf("b.plf", 5, 0, PLFINDEXTEST_PLF_SIZE - 1, PLFINDEXTEST_TIME + 1);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 30);
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 5), "newest plf rewritten with another size seen");
+
+    // an older plf rewritten in place is seen once the folder is invalidated
+    plfIndexTest_writePlf("a.plf", 6, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME + 1);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 30);
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 5), "unchanged folder served from the index");
+    ARUPDATER_PlfIndex_Invalidate(PLFINDEXTEST_FOLDER);
+    listed[0] = 6; listed[1] = 5; listed[2] = 2;
+    plfIndexTest_check(plfIndexTest_isNewest("a.plf", 6) && plfIndexTest_isListed(listed, 3), "older plf rewritten seen after invalidation");
+
+    // the truncated and corrupt headers sorted last, by name, and not listed
+    plfIndexTest_writePlf("a.plf", 6, 0, sizeof(plf_phdr_t) - 1, PLFINDEXTEST_TIME + 2);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 30);
+    listed[0] = 5; listed[1] = 2;
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 5) && plfIndexTest_isListed(listed, 2), "truncated header skipped");
+
+    plfIndexTest_writePlf("e.plf", 7, 0, 0, PLFINDEXTEST_TIME);
+    plfIndexTest_writePlf("f.plf", 8, 0, PLFINDEXTEST_PLF_SIZE, PLFINDEXTEST_TIME);
+    dirFd = open(PLFINDEXTEST_FOLDER "/f.plf", O_WRONLY);
+    if (dirFd >= 0)
+    {
+        // break the magic
+        pwrite(dirFd, "XXXX", 4, 0);
+        close(dirFd);
+    }
+    plfIndexTest_setTime("f.plf", PLFINDEXTEST_TIME);
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 40);
+    plfIndexTest_check(plfIndexTest_isNewest("b.plf", 5) && plfIndexTest_isListed(listed, 2), "empty file and bad magic skipped");
+
+    plfIndexTest_remove("b.plf");
+    plfIndexTest_remove("c.plf");
+    plfIndexTest_setTime(NULL, PLFINDEXTEST_TIME + 50);
+    dirFd = open(PLFINDEXTEST_FOLDER, O_RDONLY | O_DIRECTORY);
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetNewestVersionAt(dirFd, &newest) == ARUPDATER_ERROR_PLF_BAD_HEADER), "only corrupt plf has no version");
+    close(dirFd);
+    plfIndexTest_check((ARUPDATER_PlfIndex_GetNewest(PLFINDEXTEST_FOLDER, &plfFileName) == ARUPDATER_OK) && (strcmp(plfFileName, "a.plf") == 0), "only corrupt plf named by name order");
+    free(plfFileName);
+    plfIndexTest_check(plfIndexTest_isListed(listed, 0), "only corrupt plf lists no version");
+
+    if (system("rm -rf " PLFINDEXTEST_FOLDER) != 0)
+    {
+        failureCount++;
+    }
+
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
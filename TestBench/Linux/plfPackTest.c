@@ -0,0 +1,324 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file plfPackTest.c
+ * @brief libARUpdater TestBench checks of the plf pack add, select, compact and of its corruption handling
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Plf.h"
+#include "ARUPDATER_PlfPack.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define PLFPACKTEST_PACK_PATH           "/tmp/plfPackTest.pack"
+#define PLFPACKTEST_PLF_PATH            "/tmp/plfPackTest.plf"
+#define PLFPACKTEST_EXTRACTED_PATH      "/tmp/plfPackTest.extracted"
+#define PLFPACKTEST_PRODUCT             0x0901
+#define PLFPACKTEST_OTHER_PRODUCT       0x0902
+#define PLFPACKTEST_PLF_SIZE            5000
+
+/* the fixed layout of the index: a 128 bytes header, then the entries */
+#define PLFPACKTEST_INDEX_HEADER_SIZE   128
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int failureCount = 0;
+
+static void plfPackTest_check(int isValid, const char *name)
+{
+    printf("%-60s %s\n", name, isValid ? "OK" : "FAILED");
+    if (!isValid)
+    {
+        failureCount++;
+    }
+}
+
+/**
+ * @brief write a plf of the given version, its payload filled with the version
+ */
+static void plfPackTest_writePlf(int version)
+{
+    uint8_t data[PLFPACKTEST_PLF_SIZE];
+    plf_phdr_t *header = (plf_phdr_t *)data;
+    FILE *file = fopen(PLFPACKTEST_PLF_PATH, "wb");
+
+    memset(data, version, sizeof(data));
+    memset(header, 0, sizeof(plf_phdr_t));
+    header->p_magic = PLF_HEADER_MAGIC;
+    header->p_plfversion = PLF_CURRENT_VERSION;
+    header->p_phdrsize = sizeof(plf_phdr_t);
+    header->p_shdrsize = sizeof(plf_shdr_t);
+    header->p_ver = version;
+    header->p_size = sizeof(data);
+
+    if (file != NULL)
+    {
+        fwrite(data, 1, sizeof(data), file);
+        fclose(file);
+    }
+}
+
+/**
+ * @brief add a plf of the given version to the pack
+ */
+static eARUPDATER_ERROR plfPackTest_add(uint16_t productId, int version, int maxVersions, int64_t maxBytes)
+{
+    char fileName[32];
+
+    plfPackTest_writePlf(version);
+    snprintf(fileName, sizeof(fileName), "v%d.plf", version);
+
+    return ARUPDATER_PlfPack_Add(PLFPACKTEST_PACK_PATH, productId, PLFPACKTEST_PLF_PATH, fileName, "0123456789abcdef0123456789abcdef", maxVersions, maxBytes);
+}
+
+/**
+ * @return the version of the current plf of a product, -1 if it has none, -2 if the pack is refused
+ */
+static int plfPackTest_current(uint16_t productId)
+{
+    ARUPDATER_PlfPack_Entry_t entry;
+    eARUPDATER_ERROR error = ARUPDATER_PlfPack_Find(PLFPACKTEST_PACK_PATH, productId, &entry);
+
+    return (error == ARUPDATER_OK) ? entry.version : ((error == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND) ? -1 : -2);
+}
+
+/**
+ * @brief check the retained versions of a product, the most recently retained first
+ */
+static int plfPackTest_isRetained(uint16_t productId, const int *expected, int expectedCount)
+{
+    ARUPDATER_Manager_PlfVersion_t versions[8];
+    int count = -1;
+    int i = 0;
+
+    if ((ARUPDATER_PlfPack_GetRetainedVersions(PLFPACKTEST_PACK_PATH, productId, versions, 8, &count) != ARUPDATER_OK) || (count != expectedCount))
+    {
+        return 0;
+    }
+    for (i = 0; i < count; i++)
+    {
+        if (versions[i].version != expected[i])
+        {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief extract the current plf of a product and check its payload
+ */
+static int plfPackTest_extractIs(uint16_t productId, int version)
+{
+    uint8_t data[PLFPACKTEST_PLF_SIZE + 1];
+    int isValid = 0;
+    size_t size = 0;
+    size_t i = 0;
+    FILE *file = NULL;
+
+    if (ARUPDATER_PlfPack_Extract(PLFPACKTEST_PACK_PATH, productId, PLFPACKTEST_EXTRACTED_PATH, NULL) == ARUPDATER_OK)
+    {
+        file = fopen(PLFPACKTEST_EXTRACTED_PATH, "rb");
+    }
+    if (file != NULL)
+    {
+        size = fread(data, 1, sizeof(data), file);
+        fclose(file);
+        isValid = (size == PLFPACKTEST_PLF_SIZE) && (((plf_phdr_t *)data)->p_ver == (Plf_Word)version);
+        for (i = sizeof(plf_phdr_t); (i < size) && isValid; i++)
+        {
+            isValid = (data[i] == (uint8_t)version);
+        }
+    }
+    unlink(PLFPACKTEST_EXTRACTED_PATH);
+
+    return isValid;
+}
+
+static long long plfPackTest_packSize()
+{
+    struct stat statbuf;
+    return (stat(PLFPACKTEST_PACK_PATH, &statbuf) == 0) ? (long long)statbuf.st_size : -1;
+}
+
+/**
+ * @brief get the position of the current entry of a product in the index
+ * @return the offset of the entry in the pack, 0 if it is not found
+ */
+static off_t plfPackTest_getEntryOffset(uint16_t productId)
+{
+    ARUPDATER_PlfPack_Entry_t entry;
+    off_t offset = 0;
+    off_t entryOffset = PLFPACKTEST_INDEX_HEADER_SIZE;
+    int fd = open(PLFPACKTEST_PACK_PATH, O_RDONLY);
+
+    while ((fd >= 0) && (offset == 0) && (entryOffset + sizeof(entry) <= ARUPDATER_PLF_PACK_INDEX_SIZE) &&
+           (pread(fd, &entry, sizeof(entry), entryOffset) == sizeof(entry)))
+    {
+        if ((entry.productId == productId) && (entry.state == ARUPDATER_PLF_PACK_STATE_CURRENT))
+        {
+            offset = entryOffset;
+        }
+        entryOffset += sizeof(entry);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return offset;
+}
+
+/**
+ * @brief overwrite some bytes of the pack
+ */
+static void plfPackTest_corrupt(off_t offset, const void *data, size_t size)
+{
+    int fd = open(PLFPACKTEST_PACK_PATH, O_WRONLY);
+
+    if (fd >= 0)
+    {
+        if (pwrite(fd, data, size, offset) != (ssize_t)size)
+        {
+            printf("cannot corrupt the pack\n");
+        }
+        close(fd);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    ARUPDATER_PlfPack_Entry_t entry;
+    long long size = 0;
+    uint64_t badOffset = 0;
+    off_t entryOffset = 0;
+    int retained[4];
+
+    unlink(PLFPACKTEST_PACK_PATH);
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == -1), "missing pack has no plf");
+
+    // add
+    plfPackTest_check((plfPackTest_add(PLFPACKTEST_PRODUCT, 1, 2, 0) == ARUPDATER_OK), "first plf added");
+    plfPackTest_check((ARUPDATER_PlfPack_Find(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, &entry) == ARUPDATER_OK) &&
+                      (entry.version == 1) && (entry.size == PLFPACKTEST_PLF_SIZE) && (entry.offset == ARUPDATER_PLF_PACK_INDEX_SIZE) &&
+                      (strcmp(entry.fileName, "v1.plf") == 0) && (strcmp(entry.md5, "0123456789abcdef0123456789abcdef") == 0), "first plf found");
+    plfPackTest_check(plfPackTest_extractIs(PLFPACKTEST_PRODUCT, 1), "first plf extracted");
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_OTHER_PRODUCT) == -1), "other product has no plf");
+
+    plfPackTest_add(PLFPACKTEST_PRODUCT, 2, 2, 0);
+    plfPackTest_add(PLFPACKTEST_OTHER_PRODUCT, 50, 2, 0);
+    plfPackTest_add(PLFPACKTEST_PRODUCT, 3, 2, 0);
+    retained[0] = 2; retained[1] = 1;
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 3) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 2), "previous plf retained");
+    plfPackTest_add(PLFPACKTEST_PRODUCT, 4, 2, 0);
+    retained[0] = 3; retained[1] = 2;
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 4) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 2), "oldest retained plf pruned");
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_OTHER_PRODUCT) == 50) && plfPackTest_isRetained(PLFPACKTEST_OTHER_PRODUCT, retained, 0), "other product untouched");
+    plfPackTest_check(plfPackTest_extractIs(PLFPACKTEST_PRODUCT, 4) && plfPackTest_extractIs(PLFPACKTEST_OTHER_PRODUCT, 50), "current plf extracted");
+
+    // select
+    plfPackTest_check((ARUPDATER_PlfPack_Select(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, 2, 0, 0, 0, 0) == ARUPDATER_OK), "retained plf selected");
+    retained[0] = 4; retained[1] = 3;
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 2) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 2), "current plf retained in exchange");
+    plfPackTest_check(plfPackTest_extractIs(PLFPACKTEST_PRODUCT, 2), "selected plf extracted");
+    plfPackTest_check((ARUPDATER_PlfPack_Select(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, 1, 0, 0, 2, 0) == ARUPDATER_ERROR_PLF_FILE_NOT_FOUND), "pruned plf can not be selected");
+    plfPackTest_check((ARUPDATER_PlfPack_Select(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, 3, 0, 0, 1, 0) == ARUPDATER_OK), "retained plf selected with a limit");
+    retained[0] = 4;
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 3) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 1), "retained plf pruned on select");
+
+    // compact
+    size = plfPackTest_packSize();
+    plfPackTest_check((ARUPDATER_PlfPack_Compact(PLFPACKTEST_PACK_PATH) == ARUPDATER_OK) && (plfPackTest_packSize() < size), "deleted plf compacted");
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 3) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 1) && (plfPackTest_current(PLFPACKTEST_OTHER_PRODUCT) == 50), "index kept by the compaction");
+    plfPackTest_check(plfPackTest_extractIs(PLFPACKTEST_PRODUCT, 3) && plfPackTest_extractIs(PLFPACKTEST_OTHER_PRODUCT, 50), "data kept by the compaction");
+
+    // the size limit of the retained plf, the oldest version is deleted first
+    plfPackTest_add(PLFPACKTEST_PRODUCT, 5, 2, PLFPACKTEST_PLF_SIZE);
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == 5) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 1), "retained size limited");
+
+    // an entry pointing past the data is ignored
+    badOffset = (uint64_t)plfPackTest_packSize() * 2;
+    entryOffset = plfPackTest_getEntryOffset(PLFPACKTEST_OTHER_PRODUCT);
+    plfPackTest_check((entryOffset != 0), "entry found before its corruption");
+    plfPackTest_corrupt(entryOffset + offsetof(ARUPDATER_PlfPack_Entry_t, offset), &badOffset, sizeof(badOffset));
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_OTHER_PRODUCT) == -1) && (plfPackTest_current(PLFPACKTEST_PRODUCT) == 5), "entry past the data ignored");
+
+    // a truncated pack is refused, then replaced by the next add
+    if (truncate(PLFPACKTEST_PACK_PATH, ARUPDATER_PLF_PACK_INDEX_SIZE + 100) != 0)
+    {
+        printf("cannot truncate the pack\n");
+    }
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == -2), "truncated data refused");
+    if (truncate(PLFPACKTEST_PACK_PATH, 1000) != 0)
+    {
+        printf("cannot truncate the pack\n");
+    }
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == -2), "truncated index refused");
+    plfPackTest_check((plfPackTest_add(PLFPACKTEST_PRODUCT, 6, 2, 0) == ARUPDATER_OK) && (plfPackTest_current(PLFPACKTEST_PRODUCT) == 6) && plfPackTest_isRetained(PLFPACKTEST_PRODUCT, retained, 0), "truncated pack replaced");
+
+    // a pack with a corrupted header is refused, then replaced by the next add
+    plfPackTest_corrupt(0, "XXXX", 4);
+    plfPackTest_check((plfPackTest_current(PLFPACKTEST_PRODUCT) == -2), "corrupted magic refused");
+    plfPackTest_check((ARUPDATER_PlfPack_Select(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, 6, 0, 0, 0, 0) == ARUPDATER_ERROR_PLF_BAD_PACK), "corrupted pack not selected");
+    plfPackTest_check((plfPackTest_add(PLFPACKTEST_PRODUCT, 7, 2, 0) == ARUPDATER_OK) && (plfPackTest_current(PLFPACKTEST_PRODUCT) == 7) && plfPackTest_extractIs(PLFPACKTEST_PRODUCT, 7), "corrupted pack replaced");
+
+    // a file which is not a plf is not added
+    unlink(PLFPACKTEST_PLF_PATH);
+    plfPackTest_check((ARUPDATER_PlfPack_Add(PLFPACKTEST_PACK_PATH, PLFPACKTEST_PRODUCT, PLFPACKTEST_PACK_PATH, "pack.plf", "", 2, 0) == ARUPDATER_ERROR_PLF_BAD_HEADER) && (plfPackTest_current(PLFPACKTEST_PRODUCT) == 7), "file which is not a plf refused");
+
+    unlink(PLFPACKTEST_PACK_PATH);
+    printf("%d failed\n", failureCount);
+
+    return (failureCount == 0) ? 0 : 1;
+}
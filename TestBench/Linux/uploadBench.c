@@ -0,0 +1,206 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file uploadBench.c
+ * @brief libARUpdater TestBench time to the first uploaded plf byte, against a local ftp server
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <libARUpdater/ARUpdater.h>
+#include <libARDiscovery/ARDISCOVERY_Discovery.h>
+#include <libARSAL/ARSAL.h>
+#include <libARUtils/ARUtils.h>
+#include "ftpServer.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define UPLOADBENCH_FOLDER              "/tmp/uploadBench/"
+#define UPLOADBENCH_ROOT_FOLDER         UPLOADBENCH_FOLDER "root/"
+#define UPLOADBENCH_DEVICE_FOLDER       UPLOADBENCH_FOLDER "device/"
+#define UPLOADBENCH_PRODUCT             ARDISCOVERY_PRODUCT_MINIDRONE
+#define UPLOADBENCH_UPLOADED_SUFFIX     ".tmp"
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int uploadBench_copy(const char *srcPath, const char *dstPath, long maxSize)
+{
+    FILE *src = fopen(srcPath, "rb");
+    FILE *dst = fopen(dstPath, "wb");
+    char buffer[16 * 1024];
+    size_t size = 0;
+    long copied = 0;
+    int ok = ((src != NULL) && (dst != NULL));
+
+    while (ok && ((maxSize < 0) || (copied < maxSize)) && ((size = fread(buffer, 1, sizeof(buffer), src)) > 0))
+    {
+        if ((maxSize >= 0) && (copied + (long)size > maxSize))
+        {
+            size = maxSize - copied;
+        }
+        ok = (fwrite(buffer, 1, size, dst) == size);
+        copied += size;
+    }
+
+    if (src != NULL)
+    {
+        fclose(src);
+    }
+    if (dst != NULL)
+    {
+        fclose(dst);
+    }
+    return ok;
+}
+
+static void uploadBench_run(const char *name, FTPSERVER_t *server, ARUPDATER_Manager_t *manager)
+{
+    FTPSERVER_Stats_t stats;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+
+    FTPSERVER_ResetStats(server);
+    error = (eARUPDATER_ERROR)(intptr_t)ARUPDATER_Uploader_ThreadRun(manager);
+    FTPSERVER_GetStats(server, &stats);
+
+    printf("%-8s %-24s first plf byte %8.2f ms   control connections %2d   data connections %2d   commands %3d   plf bytes %lld\n",
+           name, ARUPDATER_Error_ToString(error), stats.firstPayloadByteUs / 1000.0, stats.controlConnections, stats.dataConnections, stats.commands, (long long)stats.payloadBytes);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *plfPath = (argc > 1) ? argv[1] : NULL;
+    const char *plfName = NULL;
+    char productFolder[256];
+    char path[512];
+    struct stat statbuf;
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    eARSAL_ERROR arsalError = ARSAL_OK;
+    eARUTILS_ERROR ftpError = ARUTILS_OK;
+    ARUPDATER_Manager_t *manager = NULL;
+    ARSAL_MD5_Manager_t *md5Manager = NULL;
+    ARUTILS_Manager_t *ftpManager = NULL;
+    FTPSERVER_t *server = NULL;
+
+    if ((plfPath == NULL) || (stat(plfPath, &statbuf) != 0))
+    {
+        fprintf(stderr, "usage: %s <plf file>\n", argv[0]);
+        return 1;
+    }
+    plfName = strrchr(plfPath, '/');
+    plfName = (plfName != NULL) ? plfName + 1 : plfPath;
+
+    // the plf to upload in the product folder, an empty device
+    snprintf(productFolder, sizeof(productFolder), UPLOADBENCH_ROOT_FOLDER "plfFolder/%04x/", ARDISCOVERY_getProductID(UPLOADBENCH_PRODUCT));
+    snprintf(path, sizeof(path), "rm -rf " UPLOADBENCH_FOLDER " && mkdir -p %s " UPLOADBENCH_DEVICE_FOLDER, productFolder);
+    if (system(path) != 0)
+    {
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s%s", productFolder, plfName);
+    if (uploadBench_copy(plfPath, path, -1) == 0)
+    {
+        return 1;
+    }
+
+    server = FTPSERVER_New(UPLOADBENCH_DEVICE_FOLDER, 0, UPLOADBENCH_UPLOADED_SUFFIX);
+    md5Manager = ARSAL_MD5_Manager_New(&arsalError);
+    ftpManager = ARUTILS_Manager_New(&ftpError);
+    if ((server == NULL) || (arsalError != ARSAL_OK) || (ftpError != ARUTILS_OK))
+    {
+        error = ARUPDATER_ERROR_SYSTEM;
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        ARSAL_MD5_Manager_Init(md5Manager);
+        if (ARUTILS_Manager_InitWifiFtp(ftpManager, "127.0.0.1", FTPSERVER_GetPort(server), "", "") != ARUTILS_OK)
+        {
+            error = ARUPDATER_ERROR_UPLOADER_ARUTILS_ERROR;
+        }
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        manager = ARUPDATER_Manager_New(&error);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Uploader_New(manager, UPLOADBENCH_ROOT_FOLDER, ftpManager, md5Manager, UPLOADBENCH_PRODUCT, NULL, NULL, NULL, NULL);
+    }
+
+    if (error == ARUPDATER_OK)
+    {
+        printf("%s (%lld bytes) uploaded to a local ftp server\n", plfName, (long long)statbuf.st_size);
+
+        // nothing on the device
+        uploadBench_run("new", server, manager);
+
+        // the md5 of the previous upload is still on the device, half of the plf is there
+        snprintf(path, sizeof(path), UPLOADBENCH_DEVICE_FOLDER "%s" UPLOADBENCH_UPLOADED_SUFFIX, plfName);
+        uploadBench_copy(plfPath, path, (long)statbuf.st_size / 2);
+        uploadBench_run("resumed", server, manager);
+
+        ARUPDATER_Uploader_Delete(manager);
+    }
+    else
+    {
+        fprintf(stderr, "error: %s\n", ARUPDATER_Error_ToString(error));
+    }
+
+    ARUPDATER_Manager_Delete(&manager);
+    if (ftpManager != NULL)
+    {
+        ARUTILS_Manager_CloseWifiFtp(ftpManager);
+        ARUTILS_Manager_Delete(&ftpManager);
+    }
+    ARSAL_MD5_Manager_Delete(&md5Manager);
+    FTPSERVER_Delete(&server);
+
+    return (error == ARUPDATER_OK) ? 0 : 1;
+}
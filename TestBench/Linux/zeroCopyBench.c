@@ -0,0 +1,189 @@
+/*
+    Copyright (C) 2014 Parrot SA
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the 
+      distribution.
+    * Neither the name of Parrot nor the names
+      of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+    "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+    LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+    FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+    COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+    INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+    BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+    OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED 
+    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+    OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+    OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+*/
+/**
+ * @file zeroCopyBench.c
+ * @brief libARUpdater TestBench cpu time of the ftp client per MB sent, with the plf copied through a buffer and with sendfile, against a local ftp server
+ * @date 19/10/2026
+ */
+
+/*****************************************
+ *
+ *             include file :
+ *
+ *****************************************/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // RUSAGE_THREAD
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <libARUpdater/ARUpdater.h>
+#include "ARUPDATER_Ftp.h"
+#include "ftpServer.h"
+
+/* ****************************************
+ *
+ *             define :
+ *
+ **************************************** */
+
+#define ZEROCOPYBENCH_FOLDER                "/tmp/zeroCopyBench/"
+#define ZEROCOPYBENCH_REMOTE_PATH           "/zeroCopyBench.bin"
+#define ZEROCOPYBENCH_DEFAULT_REPETITIONS   5
+#define ZEROCOPYBENCH_PATH_SIZE             512
+
+/**
+ * @brief How the file is read
+ */
+typedef struct
+{
+    const char *name;
+    int blockSize;      /**< 0 to adapt it to the link */
+    int isZeroCopy;
+} ZEROCOPYBENCH_Mode_t;
+
+static const ZEROCOPYBENCH_Mode_t zeroCopyBenchModes[] =
+{
+    { "copied 16 KB",       16 * 1024,      0 },
+    { "zero copy 16 KB",    16 * 1024,      1 },
+    { "copied 256 KB",      256 * 1024,     0 },
+    { "zero copy 256 KB",   256 * 1024,     1 },
+    { "copied adaptive",    0,              0 },
+    { "zero copy adaptive", 0,              1 },
+};
+
+/*****************************************
+ *
+ *          implementation :
+ *
+ *****************************************/
+
+static int64_t zeroCopyBench_toUs(const struct timeval *time)
+{
+    return (int64_t)time->tv_sec * 1000000 + time->tv_usec;
+}
+
+static void zeroCopyBench_run(const ZEROCOPYBENCH_Mode_t *mode, int port, int fd, int64_t size, int repetitionCount, const char *filePath)
+{
+    eARUPDATER_ERROR error = ARUPDATER_OK;
+    ARUPDATER_Ftp_t *ftp = NULL;
+    ARUPDATER_Uploader_TransferStats_t stats;
+    struct rusage before;
+    struct rusage after;
+    char command[ZEROCOPYBENCH_PATH_SIZE * 2];
+    int64_t userUs = 0;
+    int64_t systemUs = 0;
+    int64_t durationUs = 0;
+    double sizeMB = (double)size * repetitionCount / (1024 * 1024);
+    int isVerified = 0;
+    int i = 0;
+
+    memset(&stats, 0, sizeof(stats));
+
+    // one session for all the repetitions, only the transfers are measured
+    ftp = ARUPDATER_Ftp_New("127.0.0.1", port, "", "", &error);
+    if (error == ARUPDATER_OK)
+    {
+        error = ARUPDATER_Ftp_Connect(ftp);
+    }
+
+    for (i = 0; (i < repetitionCount) && (error == ARUPDATER_OK); i++)
+    {
+        // the transfer runs in the calling thread, the server runs in its own threads and is not counted
+        getrusage(RUSAGE_THREAD, &before);
+        error = ARUPDATER_Ftp_Put(ftp, ZEROCOPYBENCH_REMOTE_PATH, fd, 0, size, 0, mode->blockSize, mode->isZeroCopy, NULL, NULL, &stats);
+        getrusage(RUSAGE_THREAD, &after);
+
+        userUs += zeroCopyBench_toUs(&after.ru_utime) - zeroCopyBench_toUs(&before.ru_utime);
+        systemUs += zeroCopyBench_toUs(&after.ru_stime) - zeroCopyBench_toUs(&before.ru_stime);
+        durationUs += stats.durationUs;
+    }
+    ARUPDATER_Ftp_Delete(&ftp);
+
+    snprintf(command, sizeof(command), "cmp -s %s " ZEROCOPYBENCH_FOLDER ZEROCOPYBENCH_REMOTE_PATH, filePath);
+    isVerified = ((error == ARUPDATER_OK) && (system(command) == 0));
+
+    printf("  %-20s %8.3f ms cpu/MB (user %8.3f, system %8.3f)   %8.2f MB/s   block %8d   %-9s   %s\n",
+           mode->name, (userUs + systemUs) / 1000.0 / sizeMB, userUs / 1000.0 / sizeMB, systemUs / 1000.0 / sizeMB,
+           (durationUs > 0) ? sizeMB / (durationUs / 1000000.0) : 0.0, stats.blockSize, (stats.isZeroCopy) ? "zero copy" : "copied",
+           (isVerified) ? "verified" : ARUPDATER_Error_ToString(error));
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filePath = (argc > 1) ? argv[1] : NULL;
+    int repetitionCount = (argc > 2) ? atoi(argv[2]) : ZEROCOPYBENCH_DEFAULT_REPETITIONS;
+    FTPSERVER_t *server = NULL;
+    struct stat statbuf;
+    int fd = -1;
+    int i = 0;
+
+    if ((filePath == NULL) || (repetitionCount <= 0) || (stat(filePath, &statbuf) != 0) || (statbuf.st_size <= 0))
+    {
+        fprintf(stderr, "usage: %s <plf file> [repetitions]\n", argv[0]);
+        return 1;
+    }
+
+    if (system("rm -rf " ZEROCOPYBENCH_FOLDER " && mkdir -p " ZEROCOPYBENCH_FOLDER) != 0)
+    {
+        return 1;
+    }
+
+    fd = open(filePath, O_RDONLY);
+    server = FTPSERVER_New(ZEROCOPYBENCH_FOLDER, 0, NULL);
+    if ((fd < 0) || (server == NULL))
+    {
+        fprintf(stderr, "error: %s\n", ARUPDATER_Error_ToString(ARUPDATER_ERROR_SYSTEM));
+    }
+    else
+    {
+        printf("%s (%lld bytes) sent %d times to a local ftp server, cpu time of the sending thread\n", filePath, (long long)statbuf.st_size, repetitionCount);
+
+        for (i = 0; i < (int)(sizeof(zeroCopyBenchModes) / sizeof(zeroCopyBenchModes[0])); i++)
+        {
+            zeroCopyBench_run(&zeroCopyBenchModes[i], FTPSERVER_GetPort(server), fd, statbuf.st_size, repetitionCount, filePath);
+        }
+    }
+
+    FTPSERVER_Delete(&server);
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return ((fd >= 0) && (server != NULL)) ? 0 : 1;
+}